@@ -10,7 +10,10 @@ APP_EXEC := $(DIST_DIR)/cmocka-app
 
 # Application specific flags (use installed SDK from build directory)
 APP_CFLAGS := $(CFLAGS) -I$(SDK_INSTALL_INC_DIR)
-APP_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -lsdk
+ifeq ($(SDK_INLINE),1)
+APP_CFLAGS += -DCALC_INLINE
+endif
+APP_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -lsdk -pthread -ldl
 
 # Build application (depends on sdk_install)
 .PHONY: app
@@ -23,7 +26,7 @@ $(APP_EXEC): $(APP_OBJS)
 	@echo "Application built successfully: $@"
 
 # Compile application source files
-$(APP_OUTPUT_DIR)/%.o: $(APP_SRC_DIR)/%.c
+$(APP_OUTPUT_DIR)/%.o: $(APP_SRC_DIR)/%.c $(SDK_FLAGS_STAMP)
 	@echo "Compiling: $<"
 	@$(MKDIR) $(dir $@)
 	$(CC) $(APP_CFLAGS) -c $< -o $@
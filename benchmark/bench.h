@@ -0,0 +1,87 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/*
+ * Small timing helpers shared by the benchmark programs.
+ *
+ * Each benchmark runs a measurement several times and keeps the fastest
+ * run, which filters out scheduler noise on a shared machine.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_DEFAULT_LEN (1u << 20)   /* Elements per array */
+#define BENCH_DEFAULT_REPS 7           /* Runs per measurement */
+
+/* Monotonic time in nanoseconds */
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Make the compiler assume the memory behind p is read */
+static inline void bench_keep(const void *p) {
+    __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+/* Array length from argv[1], or the default */
+static inline size_t bench_len_arg(int argc, char *argv[]) {
+    if (argc > 1) {
+        long n = strtol(argv[1], NULL, 0);
+        if (n > 0) {
+            return (size_t)n;
+        }
+    }
+    return BENCH_DEFAULT_LEN;
+}
+
+/* Deterministic pseudo-random ints in [lo, hi] */
+static inline void bench_fill(int *buf, size_t n, uint32_t seed, int lo, int hi) {
+    uint64_t range = (uint64_t)((int64_t)hi - lo) + 1;
+    for (size_t i = 0; i < n; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        buf[i] = (int)(lo + (int64_t)(seed % range));
+    }
+}
+
+/* Allocate an int array or exit */
+static inline int* bench_alloc(size_t n) {
+    int *p = (int *)malloc(n * sizeof(int));    // Also compiled as C++
+    if (p == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/*
+ * Time `code` BENCH_DEFAULT_REPS times and store the fastest run (ns)
+ * in `best_ns`.
+ */
+#define BENCH_BEST(best_ns, code)                                   \
+    do {                                                            \
+        (best_ns) = UINT64_MAX;                                     \
+        for (int bench_rep_ = 0; bench_rep_ < BENCH_DEFAULT_REPS; bench_rep_++) { \
+            uint64_t bench_t0_ = bench_now_ns();                    \
+            code;                                                   \
+            uint64_t bench_dt_ = bench_now_ns() - bench_t0_;        \
+            if (bench_dt_ < (best_ns)) {                            \
+                (best_ns) = bench_dt_;                              \
+            }                                                       \
+        }                                                           \
+    } while (0)
+
+/* Print one result row: name, time, throughput and speedup over baseline */
+static inline void bench_report(const char *name, uint64_t ns, size_t items, uint64_t baseline_ns) {
+    printf("  %-40s %10.3f ms %10.1f M/s %8.3f ns/op %7.2fx\n",
+           name, ns / 1e6, items * 1e3 / (double)ns, (double)ns / items,
+           baseline_ns ? (double)baseline_ns / ns : 1.0);
+}
+
+#endif /* __BENCH_H__ */
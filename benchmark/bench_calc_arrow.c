@@ -0,0 +1,114 @@
+/**
+ * @file bench_calc_arrow.c
+ * @brief Benchmark: calc on Arrow columns in place vs copied to int arrays
+ *
+ * Two nullable int32 Arrow columns are added. Rows report rows per second:
+ * - copying both data buffers into int arrays, calc_add_batch, then
+ *   combining the validity bitmaps (the baseline)
+ * - calc_arrow_batch reading the Arrow buffers in place
+ * - calc_arrow_batch with CALC_ARROW_NULL_ON_ERROR
+ *
+ * Usage: bench_calc_arrow [length]   (default 4M)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "calc-arrow.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+
+#define DEFAULT_LEN (4u << 20)
+
+static void release_column(struct ArrowArray *array) {
+    array->release = NULL;
+}
+
+static void column_init(struct ArrowArray *array, const void **buffers, const int *data,
+                        const unsigned char *validity, size_t n) {
+    memset(array, 0, sizeof(*array));
+    buffers[0] = validity;
+    buffers[1] = data;
+    array->length = (int64_t)n;
+    array->null_count = -1;
+    array->n_buffers = 2;
+    array->buffers = buffers;
+    array->release = release_column;
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? bench_len_arg(argc, argv) : DEFAULT_LEN;
+    size_t bytes = CALC_BITMAP_BYTES(n);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *copy_a = bench_alloc(n);
+    int *copy_b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    unsigned char *valid_a = malloc(bytes);
+    unsigned char *valid_b = malloc(bytes);
+    unsigned char *valid_out = malloc(bytes);
+    const void *buffers_a[2];
+    const void *buffers_b[2];
+    struct ArrowArray col_a;
+    struct ArrowArray col_b;
+    struct ArrowArray result;
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    if (valid_a == NULL || valid_b == NULL || valid_out == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill(a, n, 1u, -100000, 100000);
+    bench_fill(b, n, 2u, -100000, 100000);
+    // About 1 row in 16 null in each column
+    for (size_t j = 0; j < bytes; j++) {
+        valid_a[j] = (unsigned char)(j % 2 ? 0xff : 0xfe);
+        valid_b[j] = (unsigned char)(j % 2 ? 0xef : 0xff);
+    }
+    column_init(&col_a, buffers_a, a, valid_a, n);
+    column_init(&col_b, buffers_b, b, valid_b, n);
+
+    printf("calc-arrow benchmark, %zu rows, isa %s\n\n", n, calc_isa_name(calc_batch_isa()));
+
+    BENCH_BEST(baseline_ns, {
+        memcpy(copy_a, a, n * sizeof(int));
+        memcpy(copy_b, b, n * sizeof(int));
+        calc_add_batch(copy_a, copy_b, out, n);
+        for (size_t j = 0; j < bytes; j++) {
+            valid_out[j] = valid_a[j] & valid_b[j];
+        }
+        bench_keep(out);
+        bench_keep(valid_out);
+    });
+    bench_report("copy to int arrays + calc_add_batch", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        if (calc_arrow_batch(CALC_ARROW_ADD, &col_a, &col_b, 0, &result) != 0) {
+            return 1;
+        }
+        bench_keep(result.buffers[1]);
+        result.release(&result);
+    });
+    bench_report("calc_arrow_batch in place", ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        if (calc_arrow_batch(CALC_ARROW_ADD, &col_a, &col_b, CALC_ARROW_NULL_ON_ERROR,
+                             &result) != 0) {
+            return 1;
+        }
+        bench_keep(result.buffers[1]);
+        result.release(&result);
+    });
+    bench_report("calc_arrow_batch, null on error", ns, n, baseline_ns);
+
+    free(a);
+    free(b);
+    free(copy_a);
+    free(copy_b);
+    free(out);
+    free(valid_a);
+    free(valid_b);
+    free(valid_out);
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file bench_calc_async.c
+ * @brief Benchmark: calc-async submission latency and throughput
+ *
+ * 1, 2, 4 and 8 producer threads submit small calc_add_batch jobs to an
+ * executor with 2 workers and a queue of 1024 jobs. Rows report:
+ * - submit: time spent inside calc_async_submit per job, averaged over
+ *   producers (includes waiting on a full queue)
+ * - end to end: jobs per second from the first submission until the
+ *   executor has drained, against running the same jobs synchronously
+ *
+ * Usage: bench_calc_async [jobs per producer]   (default 100000)
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include "bench.h"
+#include "calc-async.h"
+#include "calc-batch.h"
+
+#define JOB_LEN 256
+#define WORKERS 2
+#define CAPACITY 1024
+#define MAX_PRODUCERS 8
+#define ROUNDS 3
+
+struct producer {
+    calc_async_t *async;
+    size_t jobs;
+    const int *a;
+    const int *b;
+    int out[JOB_LEN];
+    uint64_t submit_ns;
+};
+
+static void* produce(void *arg) {
+    struct producer *p = arg;
+    calc_job_desc_t desc = {
+        .kind = CALC_JOB_ADD, .a = p->a, .b = p->b, .out = p->out, .n = JOB_LEN,
+    };
+
+    p->submit_ns = 0;
+    for (size_t i = 0; i < p->jobs; i++) {
+        uint64_t t0 = bench_now_ns();
+        calc_job_t *job = calc_async_submit(p->async, &desc);
+        p->submit_ns += bench_now_ns() - t0;
+        calc_job_release(job);
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    size_t jobs = argc > 1 ? bench_len_arg(argc, argv) : 100000;
+    int *a = bench_alloc(JOB_LEN);
+    int *b = bench_alloc(JOB_LEN);
+    int *out = bench_alloc(JOB_LEN);
+    static struct producer producers[MAX_PRODUCERS];
+    pthread_t threads[MAX_PRODUCERS];
+    uint64_t sync_ns;
+
+    bench_fill(a, JOB_LEN, 1u, -100000, 100000);
+    bench_fill(b, JOB_LEN, 2u, -100000, 100000);
+
+    printf("calc-async benchmark, %zu jobs of %d elements per producer, "
+           "%d workers, queue of %d\n\n", jobs, JOB_LEN, WORKERS, CAPACITY);
+
+    BENCH_BEST(sync_ns, {
+        for (size_t i = 0; i < jobs; i++) {
+            calc_add_batch(a, b, out, JOB_LEN);
+            bench_keep(out);
+        }
+    });
+    printf("synchronous\n");
+    bench_report("calc_add_batch on the caller", sync_ns, jobs, sync_ns);
+
+    for (unsigned n_prod = 1; n_prod <= MAX_PRODUCERS; n_prod *= 2) {
+        uint64_t best_submit = UINT64_MAX;
+        uint64_t best_wall = UINT64_MAX;
+
+        for (int round = 0; round < ROUNDS; round++) {
+            calc_async_t *async = calc_async_create(WORKERS, CAPACITY);
+            uint64_t submit = 0;
+            uint64_t wall;
+            uint64_t t0;
+
+            if (async == NULL) {
+                fprintf(stderr, "cannot create the executor\n");
+                return 1;
+            }
+            t0 = bench_now_ns();
+            for (unsigned p = 0; p < n_prod; p++) {
+                producers[p].async = async;
+                producers[p].jobs = jobs;
+                producers[p].a = a;
+                producers[p].b = b;
+                pthread_create(&threads[p], NULL, produce, &producers[p]);
+            }
+            for (unsigned p = 0; p < n_prod; p++) {
+                pthread_join(threads[p], NULL);
+                submit += producers[p].submit_ns;
+            }
+            calc_async_destroy(async);          // Drains the queue
+            wall = bench_now_ns() - t0;
+            best_wall = wall < best_wall ? wall : best_wall;
+            best_submit = submit / n_prod < best_submit ? submit / n_prod : best_submit;
+        }
+
+        printf("\n%u producer%s\n", n_prod, n_prod > 1 ? "s" : "");
+        bench_report("submit", best_submit, jobs, 0);
+        bench_report("end to end", best_wall, jobs * n_prod, sync_ns * n_prod);
+    }
+
+    free(a);
+    free(b);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file bench_calc_async_coro.cpp
+ * @brief Benchmark: awaits per second of the C++20 coroutine facade
+ *
+ * Each request adds two arrays of 256 ints on an SDK worker. Rows report
+ * requests per second:
+ * - std::async per request (one thread per request, the baseline)
+ * - one coroutine awaiting requests one after the other
+ * - 64 coroutines in flight at once on the same executor
+ *
+ * Usage: bench_calc_async_coro [requests]   (default 100000)
+ */
+
+#include <atomic>
+#include <coroutine>
+#include <future>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "calc-async.hpp"
+
+extern "C" {
+#include "calc-batch.h"
+}
+
+namespace async = sdk::async;
+
+#define JOB_LEN 256
+#define WORKERS 2
+#define IN_FLIGHT 64
+
+/* Started at once, not awaited; reports through the counter */
+struct spawned {
+    struct promise_type {
+        spawned get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+static async::task<void> sequential(async::executor &ex, const int *a, const int *b,
+                                    int *out, size_t requests) {
+    for (size_t i = 0; i < requests; i++) {
+        co_await async::add_batch(ex, a, b, out, JOB_LEN);
+    }
+}
+
+static spawned worker_loop(async::executor &ex, const int *a, const int *b, int *out,
+                           size_t requests, std::atomic<size_t> &left) {
+    for (size_t i = 0; i < requests; i++) {
+        co_await async::add_batch(ex, a, b, out, JOB_LEN);
+    }
+    left.fetch_sub(1, std::memory_order_release);
+}
+
+int main(int argc, char *argv[]) {
+    size_t requests = argc > 1 ? bench_len_arg(argc, argv) : 100000;
+    size_t threaded = requests < 5000 ? requests : 5000;   // std::async is slow
+    int *a = bench_alloc(JOB_LEN);
+    int *b = bench_alloc(JOB_LEN);
+    std::vector<int> outs(IN_FLIGHT * JOB_LEN);
+    async::executor ex(WORKERS, 1024);
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    bench_fill(a, JOB_LEN, 1u, -100000, 100000);
+    bench_fill(b, JOB_LEN, 2u, -100000, 100000);
+
+    printf("calc-async coroutine benchmark, %zu requests of %d elements, %d workers\n\n",
+           requests, JOB_LEN, WORKERS);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < threaded; i++) {
+            std::async(std::launch::async, calc_add_batch, a, b, outs.data(), (size_t)JOB_LEN).get();
+        }
+    });
+    bench_report("std::async per request", baseline_ns, threaded, baseline_ns);
+    // Rows below are compared per request
+    baseline_ns = baseline_ns * requests / threaded;
+
+    BENCH_BEST(ns, {
+        async::sync_wait(sequential(ex, a, b, outs.data(), requests));
+        bench_keep(outs.data());
+    });
+    bench_report("co_await, 1 coroutine", ns, requests, baseline_ns);
+
+    BENCH_BEST(ns, {
+        std::atomic<size_t> left(IN_FLIGHT);
+        for (size_t c = 0; c < IN_FLIGHT; c++) {
+            worker_loop(ex, a, b, outs.data() + c * JOB_LEN, requests / IN_FLIGHT, left);
+        }
+        while (left.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+        bench_keep(outs.data());
+    });
+    bench_report("co_await, 64 coroutines in flight", ns,
+                 requests / IN_FLIGHT * IN_FLIGHT, baseline_ns);
+
+    free(a);
+    free(b);
+    return 0;
+}
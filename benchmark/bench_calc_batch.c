@@ -0,0 +1,68 @@
+/**
+ * @file bench_calc_batch.c
+ * @brief Benchmark: calc_*_batch kernels vs a per-element calc_* loop
+ *
+ * Usage: bench_calc_batch [elements]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-batch.h"
+
+typedef int (*scalar_op)(int a, int b);
+typedef void (*batch_op)(const int *a, const int *b, int *out, size_t n);
+
+static void bench_op(const char *name, scalar_op scalar, batch_op batch,
+                     const int *a, const int *b, int *out, size_t n) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    char label[64];
+
+    printf("\n%s (%zu elements)\n", name, n);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = scalar(a[i], b[i]);
+        }
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "%s loop", name);
+    bench_report(label, baseline_ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            batch(a, b, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "%s_batch [%s]", name, calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    calc_isa_t detected = calc_batch_isa();
+
+    bench_fill(a, n, 1u, -1000000, 1000000);
+    bench_fill(b, n, 2u, -1000, 1000);
+
+    printf("calc batch benchmark, detected instruction set: %s\n", calc_isa_name(detected));
+
+    bench_op("calc_add", calc_add, calc_add_batch, a, b, out, n);
+    bench_op("calc_subtract", calc_subtract, calc_subtract_batch, a, b, out, n);
+    bench_op("calc_multiply", calc_multiply, calc_multiply_batch, a, b, out, n);
+    bench_op("calc_divide", calc_divide, calc_divide_batch, a, b, out, n);
+
+    calc_batch_set_isa(detected);
+    free(a);
+    free(b);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file bench_calc_bigint.c
+ * @brief Benchmark: arbitrary-precision multiplication and division
+ *
+ * Random operands of 4 to 2048 limbs (64-bit). Rows report operations per
+ * second:
+ * - calc_bigint_multiply, schoolbook only (the baseline)
+ * - calc_bigint_multiply, Karatsuba at the default threshold
+ * - calc_bigint_multiply, Karatsuba at half and twice the default threshold
+ * - calc_bigint_divide of a 2n-limb number by an n-limb one
+ *
+ * Usage: bench_calc_bigint [max_limbs]
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "calc-bigint.h"
+
+/* Random n-limb number through the public API: x = x * 2^32 + chunk */
+static void make_number(calc_bigint_t *x, size_t limbs, uint32_t seed) {
+    calc_bigint_t shift = CALC_BIGINT_INIT, chunk = CALC_BIGINT_INIT;
+    int *halves = bench_alloc(2 * limbs);
+
+    bench_fill(halves, 2 * limbs, seed, 0, 0x7fffffff);
+    calc_bigint_set_i64(x, 1);
+    calc_bigint_set_i64(&shift, INT64_C(1) << 32);
+    for (size_t i = 0; i < 2 * limbs; i++) {
+        calc_bigint_multiply(x, &shift, x);
+        calc_bigint_set_i64(&chunk, (int64_t)(uint32_t)halves[i] * 2 + (i & 1));
+        calc_bigint_add(x, &chunk, x);
+    }
+    calc_bigint_free(&shift);
+    calc_bigint_free(&chunk);
+    free(halves);
+}
+
+/* Operations per measurement so every size runs for a few milliseconds */
+static size_t rounds_for(size_t limbs) {
+    size_t rounds = (size_t)(1u << 22) / (limbs * limbs);
+    return rounds ? rounds : 1;
+}
+
+int main(int argc, char *argv[]) {
+    size_t max_limbs = argc > 1 ? bench_len_arg(argc, argv) : 2048;
+    static const size_t sizes[] = { 4, 16, 32, 48, 64, 128, 512, 2048 };
+    const size_t threshold = CALC_BIGINT_KARATSUBA_THRESHOLD;
+    calc_bigint_t a = CALC_BIGINT_INIT, b = CALC_BIGINT_INIT, c = CALC_BIGINT_INIT;
+    calc_bigint_t q = CALC_BIGINT_INIT, r = CALC_BIGINT_INIT;
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    printf("calc-bigint benchmark, default Karatsuba threshold %zu limbs\n", threshold);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= max_limbs; s++) {
+        size_t n = sizes[s];
+        size_t rounds = rounds_for(n);
+        char label[64];
+
+        make_number(&a, n - 1, 1u + (uint32_t)n);
+        make_number(&b, n - 1, 2u + (uint32_t)n);
+        printf("\n%zu x %zu limbs, %zu operations\n", n, n, rounds);
+
+        calc_bigint_set_karatsuba_threshold(SIZE_MAX);
+        BENCH_BEST(baseline_ns, {
+            for (size_t i = 0; i < rounds; i++) {
+                calc_bigint_multiply(&a, &b, &c);
+                bench_keep(c.limbs);
+            }
+        });
+        bench_report("multiply, schoolbook", baseline_ns, rounds, baseline_ns);
+
+        static const size_t scales[][2] = { { 1, 1 }, { 1, 2 }, { 2, 1 } };
+        for (size_t k = 0; k < sizeof(scales) / sizeof(scales[0]); k++) {
+            size_t t = threshold * scales[k][0] / scales[k][1];
+            calc_bigint_set_karatsuba_threshold(t);
+            BENCH_BEST(ns, {
+                for (size_t i = 0; i < rounds; i++) {
+                    calc_bigint_multiply(&a, &b, &c);
+                    bench_keep(c.limbs);
+                }
+            });
+            snprintf(label, sizeof(label), "multiply, Karatsuba threshold %zu", t);
+            bench_report(label, ns, rounds, baseline_ns);
+        }
+        calc_bigint_set_karatsuba_threshold(threshold);
+
+        // c = a * b + a has 2n limbs; divide it by b
+        calc_bigint_multiply(&a, &b, &c);
+        calc_bigint_add(&c, &a, &c);
+        BENCH_BEST(ns, {
+            for (size_t i = 0; i < rounds; i++) {
+                calc_bigint_divide(&c, &b, &q, &r);
+                bench_keep(q.limbs);
+            }
+        });
+        snprintf(label, sizeof(label), "divide %zu / %zu limbs", c.size, b.size);
+        bench_report(label, ns, rounds, baseline_ns);
+    }
+
+    calc_bigint_free(&a);
+    calc_bigint_free(&b);
+    calc_bigint_free(&c);
+    calc_bigint_free(&q);
+    calc_bigint_free(&r);
+    calc_bigint_release_scratch();
+    return 0;
+}
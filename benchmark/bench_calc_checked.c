@@ -0,0 +1,107 @@
+/**
+ * @file bench_calc_checked.c
+ * @brief Benchmark: fused checked batch vs validate-then-compute
+ *
+ * "validate + batch" is what callers do without the checked API: a range
+ * check pass over the operands followed by the unchecked batch kernel.
+ *
+ * Usage: bench_calc_checked [elements]
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+
+typedef void (*batch_op)(const int *a, const int *b, int *out, size_t n);
+typedef size_t (*checked_op)(const int *a, const int *b, int *out,
+                             unsigned char *flags, size_t n);
+typedef int64_t (*wide_op)(int64_t a, int64_t b);
+
+static int64_t wide_add(int64_t a, int64_t b) { return a + b; }
+static int64_t wide_subtract(int64_t a, int64_t b) { return a - b; }
+static int64_t wide_multiply(int64_t a, int64_t b) { return a * b; }
+
+/* Separate validation pass: recompute each element in 64 bits */
+static size_t validate(const int *a, const int *b, unsigned char *flags, size_t n, wide_op op) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i++) {
+        int64_t r = op(a[i], b[i]);
+        int bad = r < INT32_MIN || r > INT32_MAX;
+        if ((i & 7) == 0) {
+            flags[i / 8] = 0;
+        }
+        flags[i / 8] |= (unsigned char)(bad << (i & 7));
+        count += (size_t)bad;
+    }
+    return count;
+}
+
+static void bench_op(const char *name, batch_op batch, checked_op checked, wide_op wide,
+                     const int *a, const int *b, int *out, unsigned char *flags, size_t n) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    size_t count = 0;
+    char label[64];
+
+    printf("\n%s (%zu elements)\n", name, n);
+
+    BENCH_BEST(baseline_ns, {
+        count = validate(a, b, flags, n, wide);
+        batch(a, b, out, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "validate + %s_batch", name);
+    bench_report(label, baseline_ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            batch(a, b, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "%s_batch unchecked [%s]", name, calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            count = checked(a, b, out, flags, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "%s_checked_batch [%s]", name, calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+    printf("  (%zu overflowing elements)\n", count);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    unsigned char *flags = malloc(CALC_BITMAP_BYTES(n));
+    calc_isa_t detected = calc_batch_isa();
+
+    if (flags == NULL) {
+        return 1;
+    }
+    // Wide operand ranges so a small fraction of elements overflow
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+    bench_fill(b, n, 2u, -200000000, 200000000);
+
+    printf("calc checked benchmark, detected instruction set: %s\n", calc_isa_name(detected));
+
+    bench_op("calc_add", calc_add_batch, calc_add_checked_batch, wide_add, a, b, out, flags, n);
+    bench_op("calc_subtract", calc_subtract_batch, calc_subtract_checked_batch, wide_subtract, a, b, out, flags, n);
+    bench_fill(b, n, 3u, -4, 4);
+    bench_op("calc_multiply", calc_multiply_batch, calc_multiply_checked_batch, wide_multiply, a, b, out, flags, n);
+
+    calc_batch_set_isa(detected);
+    free(a);
+    free(b);
+    free(out);
+    free(flags);
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_calc_divide_masked.c
+ * @brief Benchmark: division with scattered zero divisors
+ *
+ * calc_divide branches on b == 0 for every call; the batch kernels mask
+ * zero divisors instead. Each run uses a divisor column with 0%, 1% or
+ * 50% zeros at random positions.
+ *
+ * Usage: bench_calc_divide_masked [elements]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+
+static void bench_density(int percent, const int *a, int *b, int *out,
+                          unsigned char *flags, size_t n) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    int *pick = bench_alloc(n);
+    char label[64];
+
+    // Nonzero divisors, then zeros at random positions
+    bench_fill(b, n, 7u, 1, 2000);
+    bench_fill(pick, n, 8u, 0, 99);
+    for (size_t i = 0; i < n; i++) {
+        b[i] = (pick[i] < percent) ? 0 : ((i & 1) ? b[i] : -b[i]);
+    }
+    free(pick);
+
+    printf("\n%d%% zero divisors (%zu elements)\n", percent, n);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_divide(a[i], b[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("calc_divide loop", baseline_ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            calc_divide_batch(a, b, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "calc_divide_batch [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_divide_batch_masked(a, b, out, flags, n);
+            bench_keep(out);
+            bench_keep(flags);
+        });
+        snprintf(label, sizeof(label), "calc_divide_batch_masked [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    unsigned char *flags = malloc(CALC_BITMAP_BYTES(n));
+    calc_isa_t detected = calc_batch_isa();
+    static const int densities[] = { 0, 1, 50 };
+
+    if (flags == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+
+    printf("calc masked divide benchmark, detected instruction set: %s\n",
+           calc_isa_name(detected));
+
+    for (size_t i = 0; i < sizeof(densities) / sizeof(densities[0]); i++) {
+        bench_density(densities[i], a, b, out, flags, n);
+    }
+
+    calc_batch_set_isa(detected);
+    free(a);
+    free(b);
+    free(out);
+    free(flags);
+    return 0;
+}
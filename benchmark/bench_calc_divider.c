@@ -0,0 +1,87 @@
+/**
+ * @file bench_calc_divider.c
+ * @brief Benchmark: precomputed divider vs hardware division
+ *
+ * Divides an array by one runtime divisor, the pattern of
+ * multi_calc_average (always / 3) and of column normalization.
+ *
+ * Usage: bench_calc_divider [elements]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-divider.h"
+
+static void bench_divisor(int divisor, const int *a, int *b, int *out, size_t n) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    calc_divider_t d;
+    char label[64];
+
+    printf("\ndivisor %d (%zu elements)\n", divisor, n);
+
+    for (size_t i = 0; i < n; i++) {
+        b[i] = divisor;
+    }
+    calc_divider_init(&d, divisor);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_divide(a[i], divisor);
+        }
+        bench_keep(out);
+    });
+    bench_report("calc_divide loop", baseline_ns, n, baseline_ns);
+
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_divider_divide(&d, a[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("calc_divider_divide loop", ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            calc_divide_batch(a, b, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "calc_divide_batch [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_divider_divide_batch(&d, a, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "calc_divider_divide_batch [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    calc_isa_t detected = calc_batch_isa();
+
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+
+    printf("calc divider benchmark, detected instruction set: %s\n", calc_isa_name(detected));
+
+    bench_divisor(3, a, b, out, n);
+    bench_divisor(-7, a, b, out, n);
+    bench_divisor(1000003, a, b, out, n);
+
+    calc_batch_set_isa(detected);
+    free(a);
+    free(b);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file bench_calc_encoded.c
+ * @brief Benchmark: calc_add on run-length and dictionary encoded columns
+ *
+ * Two run-length encoded columns with runs of 1, 4, 64 or 1024 rows on
+ * average (run boundaries differ between the columns) are added:
+ * - decode both with calc_column_decode, then calc_add_batch (the baseline)
+ * - calc_encoded_batch into plain rows
+ * - calc_encoded_batch_rle, output left run-length encoded
+ *
+ * Then two dictionary encoded columns sharing their indices, 16 entries:
+ * decode then add, calc_encoded_batch, and calc_encoded_batch_dict alone.
+ * Rows report rows per second.
+ *
+ * Usage: bench_calc_encoded [length]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-encoded.h"
+
+#define DICT_ENTRIES 16
+
+/* Rows in runs of 1 to 2 * avg_run - 1 rows */
+static void fill_runs(int *rows, size_t n, uint32_t seed, size_t avg_run) {
+    int value = 0;
+
+    for (size_t i = 0; i < n;) {
+        size_t len;
+        int next;
+        seed = seed * 1103515245u + 12345u;
+        len = 1 + (seed >> 8) % (2 * avg_run - 1);
+        // Neighbouring runs differ, so they stay separate runs
+        next = (int)(seed >> 4 & 0xffff);
+        value = next != value ? next : next + 1;
+        for (size_t k = 0; k < len && i < n; k++, i++) {
+            rows[i] = value;
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    int *a_values = bench_alloc(n);
+    int *b_values = bench_alloc(n);
+    int *out_values = bench_alloc(n);
+    uint32_t *a_ends = malloc(n * sizeof(uint32_t));
+    uint32_t *b_ends = malloc(n * sizeof(uint32_t));
+    uint32_t *out_ends = malloc(n * sizeof(uint32_t));
+    static const size_t avg_runs[] = { 1, 4, 64, 1024 };
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    if (a_ends == NULL || b_ends == NULL || out_ends == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    printf("calc-encoded benchmark, %zu rows, isa %s\n", n, calc_isa_name(calc_batch_isa()));
+
+    for (size_t r = 0; r < sizeof(avg_runs) / sizeof(avg_runs[0]); r++) {
+        calc_rle_buffer_t ra = { a_values, a_ends, n, 0 };
+        calc_rle_buffer_t rb = { b_values, b_ends, n, 0 };
+        calc_rle_buffer_t rout = { out_values, out_ends, n, 0 };
+
+        fill_runs(a, n, 1u, avg_runs[r]);
+        fill_runs(b, n, 2u, avg_runs[r]);
+        calc_rle_encode(a, n, &ra);
+        calc_rle_encode(b, n, &rb);
+        calc_column_t ca = { CALC_COLUMN_RLE, n, a_values, ra.runs, a_ends, NULL };
+        calc_column_t cb = { CALC_COLUMN_RLE, n, b_values, rb.runs, b_ends, NULL };
+
+        printf("\nRLE, runs of %zu rows on average (%zu + %zu runs)\n",
+               avg_runs[r], ra.runs, rb.runs);
+
+        BENCH_BEST(baseline_ns, {
+            calc_column_decode(&ca, a);
+            calc_column_decode(&cb, b);
+            calc_add_batch(a, b, out, n);
+            bench_keep(out);
+        });
+        bench_report("decode + calc_add_batch", baseline_ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_encoded_batch(CALC_ENCODED_ADD, &ca, &cb, out);
+            bench_keep(out);
+        });
+        bench_report("calc_encoded_batch", ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_encoded_batch_rle(CALC_ENCODED_ADD, &ca, &cb, &rout);
+            bench_keep(out_values);
+        });
+        bench_report("calc_encoded_batch_rle", ns, n, baseline_ns);
+    }
+
+    // Dictionary columns: a_ends holds the shared indices
+    int a_dict[DICT_ENTRIES];
+    int b_dict[DICT_ENTRIES];
+    int out_dict[DICT_ENTRIES];
+    bench_fill(a_dict, DICT_ENTRIES, 3u, -100000, 100000);
+    bench_fill(b_dict, DICT_ENTRIES, 4u, -100000, 100000);
+    bench_fill(out, n, 5u, 0, DICT_ENTRIES - 1);
+    for (size_t i = 0; i < n; i++) {
+        a_ends[i] = (uint32_t)out[i];
+    }
+    calc_column_t da = { CALC_COLUMN_DICT, n, a_dict, DICT_ENTRIES, NULL, a_ends };
+    calc_column_t db = { CALC_COLUMN_DICT, n, b_dict, DICT_ENTRIES, NULL, a_ends };
+
+    printf("\nDictionary, %d entries, shared indices\n", DICT_ENTRIES);
+
+    BENCH_BEST(baseline_ns, {
+        calc_column_decode(&da, a);
+        calc_column_decode(&db, b);
+        calc_add_batch(a, b, out, n);
+        bench_keep(out);
+    });
+    bench_report("decode + calc_add_batch", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_encoded_batch(CALC_ENCODED_ADD, &da, &db, out);
+        bench_keep(out);
+    });
+    bench_report("calc_encoded_batch", ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_encoded_batch_dict(CALC_ENCODED_ADD, &da, &db, out_dict);
+        bench_keep(out_dict);
+    });
+    bench_report("calc_encoded_batch_dict", ns, n, baseline_ns);
+
+    free(a);
+    free(b);
+    free(out);
+    free(a_values);
+    free(b_values);
+    free(out_values);
+    free(a_ends);
+    free(b_ends);
+    free(out_ends);
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file bench_calc_expr.c
+ * @brief Benchmark: run-time compiled (a + b) * (c - d) vs the C functions
+ *
+ * Rows report rows per second on one core:
+ * - multi_calc_expression called once per row (baseline)
+ * - calc_expr_eval once per row (bytecode interpreted per row)
+ * - calc_expr_eval_batch (bytecode interpreted per block of rows)
+ * - multi_calc_expression_batch (hand-fused kernel, upper bound)
+ *
+ * Usage: bench_calc_expr [rows]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-expr.h"
+#include "multi-calc.h"
+#include "multi-calc-batch.h"
+
+int main(int argc, char *argv[]) {
+    static const char *const names[] = { "a", "b", "c", "d" };
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *c = bench_alloc(n);
+    int *d = bench_alloc(n);
+    int *out = bench_alloc(n);
+    const int *columns[4] = { a, b, c, d };
+    calc_expr_t *expr = calc_expr_compile("(a + b) * (c - d)", names, 4, NULL);
+    calc_isa_t isa = calc_batch_isa();
+    uint64_t baseline_ns;
+    uint64_t ns;
+    char label[64];
+
+    if (expr == NULL) {
+        fprintf(stderr, "failed to compile expression\n");
+        return 1;
+    }
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+    bench_fill(b, n, 2u, -2000000000, 2000000000);
+    bench_fill(c, n, 3u, -2000000000, 2000000000);
+    bench_fill(d, n, 4u, -2000000000, 2000000000);
+
+    printf("calc_expr benchmark, %zu rows, instruction set: %s\n\n", n, calc_isa_name(isa));
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = multi_calc_expression(a[i], b[i], c[i], d[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("multi_calc_expression per row", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            int row[4];
+            row[0] = a[i];
+            row[1] = b[i];
+            row[2] = c[i];
+            row[3] = d[i];
+            out[i] = calc_expr_eval(expr, row);
+        }
+        bench_keep(out);
+    });
+    bench_report("calc_expr_eval per row", ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_expr_eval_batch(expr, columns, out, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "calc_expr_eval_batch [%s]", calc_isa_name(isa));
+    bench_report(label, ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        multi_calc_expression_batch(a, b, c, d, out, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "multi_calc_expression_batch [%s]", calc_isa_name(isa));
+    bench_report(label, ns, n, baseline_ns);
+
+    calc_expr_free(expr);
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(out);
+    return 0;
+}
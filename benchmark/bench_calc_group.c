@@ -0,0 +1,113 @@
+/**
+ * @file bench_calc_group.c
+ * @brief Benchmark: per-key averages, sort-based vs hash group-by
+ *
+ * Rows with 16, 1K, 64K or 1M distinct keys get their per-key count, sum,
+ * min, max and average. Rows report rows per second:
+ * - sort the (key, value) pairs, then multi_calc_average_n and a min/max
+ *   scan per group (the baseline)
+ * - calc_group_add_batch on a single table
+ * - calc_group_add_batch partitioned, one partition per calc-pool thread
+ *
+ * Usage: bench_calc_group [length]   (SDK_CALC_THREADS sets the threads)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-group.h"
+#include "calc-pool.h"
+#include "multi-calc.h"
+
+static int compare_pairs(const void *x, const void *y) {
+    const int *a = x, *b = y;
+    return (a[0] > b[0]) - (a[0] < b[0]);
+}
+
+/* Sort then aggregate each run of equal keys; returns the number of groups */
+static size_t group_by_sort(const int *keys, const int *values, size_t n,
+                            int (*pairs)[2], int *sorted_values, calc_group_result_t *out) {
+    size_t groups = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        pairs[i][0] = keys[i];
+        pairs[i][1] = values[i];
+    }
+    qsort(pairs, n, sizeof(*pairs), compare_pairs);
+    for (size_t i = 0; i < n; i++) {
+        sorted_values[i] = pairs[i][1];
+    }
+    for (size_t begin = 0, end; begin < n; begin = end) {
+        calc_group_result_t *r = &out[groups++];
+        r->min = r->max = sorted_values[begin];
+        for (end = begin; end < n && pairs[end][0] == pairs[begin][0]; end++) {
+            r->min = sorted_values[end] < r->min ? sorted_values[end] : r->min;
+            r->max = sorted_values[end] > r->max ? sorted_values[end] : r->max;
+        }
+        r->key = pairs[begin][0];
+        r->count = (int64_t)(end - begin);
+        r->average = multi_calc_average_n(sorted_values + begin, end - begin);
+    }
+    return groups;
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *keys = bench_alloc(n);
+    int *values = bench_alloc(n);
+    int *sorted_values = bench_alloc(n);
+    int (*pairs)[2] = malloc(n * sizeof(*pairs));
+    calc_group_result_t *results = malloc(n * sizeof(*results));
+    static const int cardinalities[] = { 16, 1 << 10, 1 << 16, 1 << 20 };
+    unsigned threads = calc_pool_threads();
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    if (pairs == NULL || results == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill(values, n, 2u, -100000, 100000);
+
+    printf("calc-group benchmark, %zu rows, %u calc-pool threads\n", n, threads);
+
+    for (size_t c = 0; c < sizeof(cardinalities) / sizeof(cardinalities[0]); c++) {
+        size_t groups = 0;
+
+        bench_fill(keys, n, 1u, 0, cardinalities[c] - 1);
+        printf("\n%d distinct keys\n", cardinalities[c]);
+
+        BENCH_BEST(baseline_ns, {
+            groups = group_by_sort(keys, values, n, pairs, sorted_values, results);
+            bench_keep(results);
+        });
+        bench_report("qsort + multi_calc_average_n", baseline_ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_group_t *group = calc_group_create(0, 1);
+            calc_group_add_batch(group, keys, values, n);
+            groups = calc_group_results(group, results);
+            calc_group_destroy(group);
+            bench_keep(results);
+        });
+        bench_report("calc_group, one table", ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_group_t *group = calc_group_create(0, threads < 2 ? 8 : threads);
+            calc_group_add_batch(group, keys, values, n);
+            groups = calc_group_results(group, results);
+            calc_group_destroy(group);
+            bench_keep(results);
+        });
+        bench_report("calc_group, partitioned", ns, n, baseline_ns);
+        printf("  (%zu groups)\n", groups);
+    }
+
+    free(keys);
+    free(values);
+    free(sorted_values);
+    free(pairs);
+    free(results);
+    return 0;
+}
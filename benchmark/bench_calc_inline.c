@@ -0,0 +1,69 @@
+/**
+ * @file bench_calc_inline.c
+ * @brief Benchmark: inlined calc calls vs calls into libsdk
+ *
+ * Evaluates (a + b) * (c - d), the multi_calc_expression formula, once
+ * through the exported functions and once through the CALC_INLINE path.
+ * The multi_calc_expression row depends on how libsdk was built
+ * (make bench vs make bench SDK_INLINE=0).
+ *
+ * Usage: bench_calc_inline [elements]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+
+#define CALC_INLINE
+#include "calc.h"
+#include "multi-calc.h"
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *c = bench_alloc(n);
+    int *d = bench_alloc(n);
+    int *out = bench_alloc(n);
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    // Small operands: the expression never overflows
+    bench_fill(a, n, 1u, -10000, 10000);
+    bench_fill(b, n, 2u, -10000, 10000);
+    bench_fill(c, n, 3u, -10000, 10000);
+    bench_fill(d, n, 4u, -10000, 10000);
+
+    printf("calc inline benchmark: (a + b) * (c - d), %zu elements\n\n", n);
+
+    // (calc_xxx)(...) suppresses the macro: real calls into libsdk
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = (calc_multiply)((calc_add)(a[i], b[i]), (calc_subtract)(c[i], d[i]));
+        }
+        bench_keep(out);
+    });
+    bench_report("exported calc_* calls", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_multiply(calc_add(a[i], b[i]), calc_subtract(c[i], d[i]));
+        }
+        bench_keep(out);
+    });
+    bench_report("inlined calc_* calls", ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = multi_calc_expression(a[i], b[i], c[i], d[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("multi_calc_expression", ns, n, baseline_ns);
+
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(out);
+    return 0;
+}
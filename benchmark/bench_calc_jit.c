@@ -0,0 +1,99 @@
+/**
+ * @file bench_calc_jit.c
+ * @brief Benchmark: JIT-compiled formulas vs hand-written C and the interpreter
+ *
+ * For (a + b) * (c - d) and (a + b + c) / 3, rows report rows per second
+ * on one core:
+ * - multi_calc_expression / multi_calc_average once per row (baseline)
+ * - calc_expr_eval_batch (bytecode over calc_*_batch kernels)
+ * - calc_jit_eval_batch (native AVX2 code, or the interpreter if the JIT
+ *   is unavailable)
+ *
+ * Usage: bench_calc_jit [rows]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-expr.h"
+#include "calc-jit.h"
+#include "multi-calc.h"
+
+static const char *const names[] = { "a", "b", "c", "d" };
+
+/* Report the interpreter and the JIT for one formula */
+static void bench_formula(const char *source, const int *const *columns, int *out,
+                          size_t n, uint64_t baseline_ns) {
+    calc_expr_t *expr = calc_expr_compile(source, names, 4, NULL);
+    calc_jit_t *jit = calc_jit_compile(source, names, 4, NULL);
+    uint64_t ns;
+    char label[64];
+
+    if (expr == NULL || jit == NULL) {
+        fprintf(stderr, "failed to compile %s\n", source);
+        exit(1);
+    }
+    BENCH_BEST(ns, {
+        calc_expr_eval_batch(expr, columns, out, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "calc_expr_eval_batch [%s]", calc_isa_name(calc_batch_isa()));
+    bench_report(label, ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_jit_eval_batch(jit, columns, out, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "calc_jit_eval_batch [%s]",
+             calc_jit_is_native(jit) ? "native" : "interpreter");
+    bench_report(label, ns, n, baseline_ns);
+
+    calc_expr_free(expr);
+    calc_jit_free(jit);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *c = bench_alloc(n);
+    int *d = bench_alloc(n);
+    int *out = bench_alloc(n);
+    const int *columns[4] = { a, b, c, d };
+    uint64_t baseline_ns;
+
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+    bench_fill(b, n, 2u, -2000000000, 2000000000);
+    bench_fill(c, n, 3u, -2000000000, 2000000000);
+    bench_fill(d, n, 4u, -2000000000, 2000000000);
+
+    printf("calc_jit benchmark, %zu rows, instruction set: %s\n\n",
+           n, calc_isa_name(calc_batch_isa()));
+
+    printf("(a + b) * (c - d)\n");
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = multi_calc_expression(a[i], b[i], c[i], d[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("multi_calc_expression per row", baseline_ns, n, baseline_ns);
+    bench_formula("(a + b) * (c - d)", columns, out, n, baseline_ns);
+
+    printf("\n(a + b + c) / 3\n");
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = multi_calc_average(a[i], b[i], c[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("multi_calc_average per row", baseline_ns, n, baseline_ns);
+    bench_formula("(a + b + c) / 3", columns, out, n, baseline_ns);
+
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file bench_calc_lazy.cpp
+ * @brief Benchmark: fused expression templates vs chained batch calls
+ *
+ * Two expressions are computed over arrays large enough to leave the
+ * caches, so time follows the bytes moved per row (shown in each label):
+ * - (a + b) * (c - d): three calc_*_batch calls through two temporaries,
+ *   multi_calc_expression_batch, and one sdk::lazy loop
+ * - a * 3 + b - c: three calc_*_batch calls, the constant 3 as an array,
+ *   and one sdk::lazy loop with 3 broadcast
+ * Rows report rows per second against the chained calls.
+ *
+ * Usage: bench_calc_lazy [length]   (default 4M)
+ */
+
+#include <span>
+#include <vector>
+#include "bench.h"
+#include "calc-lazy.hpp"
+
+extern "C" {
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "multi-calc-batch.h"
+}
+
+namespace lazy = sdk::lazy;
+
+#define DEFAULT_LEN (4u << 20)
+
+static void report_traffic(size_t chained_bytes, size_t fused_bytes) {
+    printf("  traffic per row: %zu B chained, %zu B fused (%.0f%% less)\n\n",
+           chained_bytes, fused_bytes, 100.0 * (chained_bytes - fused_bytes) / chained_bytes);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? bench_len_arg(argc, argv) : DEFAULT_LEN;
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *c = bench_alloc(n);
+    int *d = bench_alloc(n);
+    int *t1 = bench_alloc(n);
+    int *t2 = bench_alloc(n);
+    int *out = bench_alloc(n);
+    std::vector<int> threes(n, 3);
+    std::span<const int> sa(a, n), sb(b, n), sc(c, n), sd(d, n);
+    std::span<int> sout(out, n);
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    bench_fill(a, n, 1u, -100000, 100000);
+    bench_fill(b, n, 2u, -100000, 100000);
+    bench_fill(c, n, 3u, -100000, 100000);
+    bench_fill(d, n, 4u, -100000, 100000);
+    // Every row on the calling thread
+    calc_pool_set_threads(1);
+
+    printf("calc-lazy benchmark, %zu rows\n\n", n);
+
+    printf("(a + b) * (c - d)\n");
+    BENCH_BEST(baseline_ns, {
+        calc_add_batch(a, b, t1, n);
+        calc_subtract_batch(c, d, t2, n);
+        calc_multiply_batch(t1, t2, out, n);
+        bench_keep(out);
+    });
+    bench_report("chained batch calls (36 B/row)", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        multi_calc_expression_batch(a, b, c, d, out, n);
+        bench_keep(out);
+    });
+    bench_report("multi_calc_expression_batch (20 B/row)", ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        lazy::evaluate(lazy::multiply(lazy::add(sa, sb), lazy::subtract(sc, sd)), sout);
+        bench_keep(out);
+    });
+    bench_report("sdk::lazy fused (20 B/row)", ns, n, baseline_ns);
+    report_traffic(36, 20);
+
+    printf("a * 3 + b - c\n");
+    BENCH_BEST(baseline_ns, {
+        calc_multiply_batch(a, threes.data(), t1, n);
+        calc_add_batch(t1, b, t1, n);
+        calc_subtract_batch(t1, c, out, n);
+        bench_keep(out);
+    });
+    bench_report("chained batch calls (40 B/row)", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        lazy::evaluate(lazy::multiply(sa, 3) + sb - sc, sout);
+        bench_keep(out);
+    });
+    bench_report("sdk::lazy fused (16 B/row)", ns, n, baseline_ns);
+    report_traffic(40, 16);
+
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(t1);
+    free(t2);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file bench_calc_linalg.c
+ * @brief Benchmark: integer dot / axpy / GEMV / GEMM vs calc_add + calc_multiply loops
+ *
+ * Every kernel is timed against the loop it replaces: calc_multiply and
+ * calc_add called per element (the baseline, 32-bit and wrapping), then
+ * the calc-linalg function at each instruction set level the CPU supports.
+ * Rows report GOPS, counting a multiply-add as two operations.
+ *
+ * Usage: bench_calc_linalg [length]   (vector length; matrices are fixed)
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-linalg.h"
+
+/* One result row: name, time, GOPS and speedup over the baseline */
+static void report_gops(const char *name, uint64_t ns, double ops, uint64_t baseline_ns) {
+    printf("  %-40s %10.3f ms %8.2f GOPS %7.2fx\n",
+           name, ns / 1e6, ops / (double)ns, baseline_ns ? (double)baseline_ns / ns : 1.0);
+}
+
+static int64_t* alloc_i64(size_t n) {
+    int64_t *p = malloc(n * sizeof(*p));
+    if (p == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+/* Time one calc-linalg call at every supported instruction set level */
+#define BENCH_ISAS(name, ops, baseline_ns, code)                                        \
+    do {                                                                                \
+        calc_isa_t detected_ = calc_batch_isa();                                        \
+        for (int isa_ = CALC_ISA_SCALAR; isa_ <= CALC_ISA_AVX512; isa_++) {             \
+            uint64_t ns_;                                                               \
+            char label_[64];                                                            \
+            if (calc_batch_set_isa((calc_isa_t)isa_) != 0) {                            \
+                continue;                                                               \
+            }                                                                           \
+            BENCH_BEST(ns_, code);                                                      \
+            snprintf(label_, sizeof(label_), "%s [%s]", name, calc_isa_name((calc_isa_t)isa_)); \
+            report_gops(label_, ns_, ops, baseline_ns);                                 \
+        }                                                                               \
+        calc_batch_set_isa(detected_);                                                  \
+    } while (0)
+
+static void bench_vectors(const int *a, const int *b, int *y32, int64_t *y64, size_t n) {
+    uint64_t baseline_ns;
+    volatile int64_t sink;
+    int64_t dot;
+
+    printf("\ndot (%zu elements)\n", n);
+    BENCH_BEST(baseline_ns, {
+        int s = 0;
+        for (size_t i = 0; i < n; i++) {
+            s = calc_add(s, calc_multiply(a[i], b[i]));
+        }
+        sink = s;
+    });
+    report_gops("calc_add(s, calc_multiply(a, b)) loop", baseline_ns, 2.0 * n, baseline_ns);
+    BENCH_ISAS("calc_dot", 2.0 * n, baseline_ns, {
+        calc_dot(a, b, n, &dot);
+        sink = dot;
+    });
+
+    printf("\naxpy (%zu elements)\n", n);
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            y32[i] = calc_add(y32[i], calc_multiply(3, a[i]));
+        }
+        bench_keep(y32);
+    });
+    report_gops("calc_add(y, calc_multiply(3, x)) loop", baseline_ns, 2.0 * n, baseline_ns);
+    BENCH_ISAS("calc_axpy", 2.0 * n, baseline_ns, {
+        calc_axpy(3, a, y64, n);
+        bench_keep(y64);
+    });
+    (void)sink;
+}
+
+static void bench_gemv(const int *a, const int *x, int64_t *y, size_t rows, size_t cols) {
+    const double ops = 2.0 * rows * cols;
+    uint64_t baseline_ns;
+
+    printf("\nGEMV (%zu x %zu)\n", rows, cols);
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < rows; i++) {
+            int s = 0;
+            for (size_t j = 0; j < cols; j++) {
+                s = calc_add(s, calc_multiply(a[i * cols + j], x[j]));
+            }
+            y[i] = s;
+        }
+        bench_keep(y);
+    });
+    report_gops("calc_add / calc_multiply loop", baseline_ns, ops, baseline_ns);
+    BENCH_ISAS("calc_gemv", ops, baseline_ns, {
+        calc_gemv(a, x, y, rows, cols);
+        bench_keep(y);
+    });
+}
+
+static void bench_gemm(const int *a, const int *b, int64_t *c, size_t size) {
+    const double ops = 2.0 * size * size * size;
+    uint64_t baseline_ns;
+
+    printf("\nGEMM (%zu x %zu x %zu)\n", size, size, size);
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < size; i++) {
+            for (size_t j = 0; j < size; j++) {
+                int s = 0;
+                for (size_t p = 0; p < size; p++) {
+                    s = calc_add(s, calc_multiply(a[i * size + p], b[p * size + j]));
+                }
+                c[i * size + j] = s;
+            }
+        }
+        bench_keep(c);
+    });
+    report_gops("calc_add / calc_multiply loop", baseline_ns, ops, baseline_ns);
+    BENCH_ISAS("calc_gemm", ops, baseline_ns, {
+        calc_gemm(a, b, c, size, size, size);
+        bench_keep(c);
+    });
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    const size_t rows = 1024, cols = 1024;
+    static const size_t gemm_sizes[] = { 32, 128, 256 };
+    size_t len = n > rows * cols ? n : rows * cols;
+    int *a = bench_alloc(len);
+    int *b = bench_alloc(len);
+    int *y32 = bench_alloc(n);
+    int64_t *y64 = alloc_i64(len);
+
+    // Small values: the calc loops do not wrap and GEMM takes its 64-bit path
+    bench_fill(a, len, 1u, -1000, 1000);
+    bench_fill(b, len, 2u, -1000, 1000);
+    bench_fill(y32, n, 3u, -1000, 1000);
+    for (size_t i = 0; i < n; i++) {
+        y64[i] = y32[i];
+    }
+
+    printf("calc-linalg benchmark, best ISA %s\n", calc_isa_name(calc_batch_isa()));
+    bench_vectors(a, b, y32, y64, n);
+    bench_gemv(a, b, y64, rows, cols);
+    for (size_t s = 0; s < sizeof(gemm_sizes) / sizeof(gemm_sizes[0]); s++) {
+        bench_gemm(a, b, y64, gemm_sizes[s]);
+    }
+
+    free(a);
+    free(b);
+    free(y32);
+    free(y64);
+    return 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file bench_calc_ops.c
+ * @brief Benchmark: calls through a calc_ops table vs direct calls
+ *
+ * Each element evaluates (a + b) * (c - d): with direct calls to the
+ * exported calc_*, with the inline bodies, with three indirect calls
+ * through each built-in table, and through multi_calc_expression with
+ * each backend active.
+ *
+ * Usage: bench_calc_ops [elements]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-ops.h"
+#include "multi-calc.h"
+
+/*
+ * Reload the table pointer on every element, as multi_calc does, so the
+ * compiler cannot hoist the loads or prove the targets.
+ */
+static void expression_via(const sdk_calc_ops *volatile *ops, const int *a, const int *b,
+                           int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const sdk_calc_ops *o = *ops;
+        out[i] = o->multiply(o->add(a[i], b[i]), o->subtract(b[i], a[i]));
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    uint64_t baseline_ns;
+    uint64_t ns;
+    char label[64];
+    static const char *const names[] = { "scalar", "checked", "simd" };
+
+    bench_fill(a, n, 1u, -20000, 20000);
+    bench_fill(b, n, 2u, -20000, 20000);
+
+    printf("calc_ops benchmark: (a + b) * (b - a), %zu elements\n\n", n);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_multiply(calc_add(a[i], b[i]), calc_subtract(b[i], a[i]));
+        }
+        bench_keep(out);
+    });
+    bench_report("direct calc_* calls", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_multiply_inline(calc_add_inline(a[i], b[i]),
+                                          calc_subtract_inline(b[i], a[i]));
+        }
+        bench_keep(out);
+    });
+    bench_report("inline calc_*_inline bodies", ns, n, baseline_ns);
+
+    for (size_t k = 0; k < sizeof(names) / sizeof(names[0]); k++) {
+        const sdk_calc_ops *volatile ops = calc_ops_find(names[k]);
+        BENCH_BEST(ns, {
+            expression_via(&ops, a, b, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "indirect calls [%s]", names[k]);
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_ops_take_status();
+
+    for (size_t k = 0; k < sizeof(names) / sizeof(names[0]); k++) {
+        calc_ops_select(names[k]);
+        BENCH_BEST(ns, {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = multi_calc_expression(a[i], b[i], b[i], a[i]);
+            }
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "multi_calc_expression [%s]", names[k]);
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_ops_set(NULL);
+    calc_ops_take_status();
+
+    free(a);
+    free(b);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file bench_calc_pool.c
+ * @brief Benchmark: batch functions on the calc-pool thread pool
+ *
+ * Each batch function runs with 1, 2, 4 ... threads up to the number of
+ * online CPUs; rows report elements per second against the one-thread
+ * time. Inputs of a few million elements leave the caches, so the gain
+ * flattens once memory bandwidth is saturated.
+ *
+ * Usage: bench_calc_pool [length] [max threads]   (default 4M, online CPUs)
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-expr.h"
+#include "calc-pool.h"
+#include "multi-calc-batch.h"
+
+#define DEFAULT_LEN (4u << 20)
+
+static const char *const abcd[] = { "a", "b", "c", "d" };
+
+int main(int argc, char *argv[]) {
+    size_t n = argc > 1 ? bench_len_arg(argc, argv) : DEFAULT_LEN;
+    long cpus = argc > 2 ? strtol(argv[2], NULL, 10) : sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned max_threads = cpus > 1 ? (unsigned)cpus : 1;
+    int *cols[4];
+    int *out = bench_alloc(n);
+    calc_expr_t *expr = calc_expr_compile("(a + b) * (c - d) / 3 + a", abcd, 4, NULL);
+    uint64_t add_ns = 0;
+    uint64_t multi_ns = 0;
+    uint64_t expr_ns = 0;
+    uint64_t ns;
+
+    if (expr == NULL) {
+        fprintf(stderr, "cannot compile the expression\n");
+        return 1;
+    }
+    for (size_t k = 0; k < 4; k++) {
+        cols[k] = bench_alloc(n);
+        bench_fill(cols[k], n, 11u + (unsigned)k, -100000, 100000);
+    }
+
+    printf("calc-pool benchmark, %zu elements, up to %u threads\n\n", n, max_threads);
+
+    for (unsigned threads = 1; ; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+        calc_pool_set_threads(threads);
+        printf("%u thread%s\n", threads, threads > 1 ? "s" : "");
+
+        BENCH_BEST(ns, {
+            calc_add_batch(cols[0], cols[1], out, n);
+            bench_keep(out);
+        });
+        add_ns = threads == 1 ? ns : add_ns;
+        bench_report("calc_add_batch", ns, n, add_ns);
+
+        BENCH_BEST(ns, {
+            multi_calc_expression_batch(cols[0], cols[1], cols[2], cols[3], out, n);
+            bench_keep(out);
+        });
+        multi_ns = threads == 1 ? ns : multi_ns;
+        bench_report("multi_calc_expression_batch", ns, n, multi_ns);
+
+        BENCH_BEST(ns, {
+            calc_expr_eval_batch(expr, (const int *const *)cols, out, n);
+            bench_keep(out);
+        });
+        expr_ns = threads == 1 ? ns : expr_ns;
+        bench_report("calc_expr_eval_batch", ns, n, expr_ns);
+
+        if (threads == max_threads) {
+            break;
+        }
+        printf("\n");
+    }
+
+    calc_pool_set_threads(1);
+    calc_expr_free(expr);
+    for (size_t k = 0; k < 4; k++) {
+        free(cols[k]);
+    }
+    free(out);
+    return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file bench_calc_reduce.c
+ * @brief Benchmark: calc_sum / calc_product vs single-accumulator loops
+ *
+ * Usage: bench_calc_reduce [elements] [threads]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "calc-reduce.h"
+#include "multi-calc.h"
+
+static void bench_sum(const int *a, size_t n, unsigned max_threads) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    volatile int64_t sink;
+    calc_isa_t detected = calc_batch_isa();
+    char label[64];
+
+    printf("\nsum (%zu elements)\n", n);
+
+    BENCH_BEST(baseline_ns, {
+        int64_t s = 0;
+        for (size_t i = 0; i < n; i++) {
+            s += a[i];
+        }
+        sink = s;
+    });
+    bench_report("plain int64 loop", baseline_ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, { sink = calc_sum(a, n); });
+        snprintf(label, sizeof(label), "calc_sum [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_batch_set_isa(detected);
+
+    for (unsigned threads = 2; threads <= max_threads; threads *= 2) {
+        calc_pool_set_threads(threads);
+        BENCH_BEST(ns, { sink = calc_sum(a, n); });
+        snprintf(label, sizeof(label), "calc_sum [%s, %u threads]", calc_isa_name(detected), threads);
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_pool_set_threads(1);
+
+    BENCH_BEST(ns, { sink = multi_calc_average_n(a, n); });
+    bench_report("multi_calc_average_n", ns, n, baseline_ns);
+    (void)sink;
+}
+
+static void bench_product(const int *a, size_t n) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    volatile int64_t sink;
+    int64_t r;
+
+    printf("\nproduct (%zu elements)\n", n);
+
+    BENCH_BEST(baseline_ns, {
+        int64_t p = 1;
+        int overflow = 0;
+        for (size_t i = 0; i < n; i++) {
+            overflow |= __builtin_mul_overflow(p, (int64_t)a[i], &p);
+        }
+        sink = p + overflow;
+    });
+    bench_report("checked int64 loop, 1 accumulator", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, { sink = calc_product(a, n, &r) + r; });
+    bench_report("calc_product", ns, n, baseline_ns);
+    (void)sink;
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    unsigned max_threads = argc > 2 ? (unsigned)strtoul(argv[2], NULL, 0) : 4;
+    int *a = bench_alloc(n);
+    int *ones = bench_alloc(n);
+
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+    // Product input: +-1 so the product never overflows or hits 0
+    bench_fill(ones, n, 2u, 0, 1);
+    for (size_t i = 0; i < n; i++) {
+        ones[i] = ones[i] ? 1 : -1;
+    }
+
+    printf("calc reduce benchmark, detected instruction set: %s\n",
+           calc_isa_name(calc_batch_isa()));
+
+    bench_sum(a, n, max_threads);
+    bench_product(ones, n);
+
+    free(a);
+    free(ones);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file bench_calc_rolling.c
+ * @brief Benchmark: streaming rolling-window statistics vs rescanning
+ *
+ * Rows report samples per second on one core:
+ * - window of 3: multi_calc_average on each overlapping triple (baseline)
+ *   vs calc_rolling_push_batch writing the running means
+ * - window of 256: rescanning the window for mean, min and max after each
+ *   sample (baseline) vs calc_rolling_push + mean / min / max
+ *
+ * Usage: bench_calc_rolling [samples]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-rolling.h"
+#include "multi-calc.h"
+
+#define WIDE_WINDOW 256
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *samples = bench_alloc(n);
+    int *means = bench_alloc(n);
+    int *lows = bench_alloc(n);
+    int *highs = bench_alloc(n);
+    calc_rolling_t *r3 = calc_rolling_create(3);
+    calc_rolling_t *wide = calc_rolling_create(WIDE_WINDOW);
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    if (r3 == NULL || wide == NULL || n < WIDE_WINDOW) {
+        fprintf(stderr, "out of memory or fewer than %d samples\n", WIDE_WINDOW);
+        return 1;
+    }
+    bench_fill(samples, n, 1u, -700000000, 700000000);
+
+    printf("rolling window benchmark, %zu samples\n\n", n);
+
+    printf("window of 3, mean\n");
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 2; i < n; i++) {
+            means[i] = multi_calc_average(samples[i - 2], samples[i - 1], samples[i]);
+        }
+        bench_keep(means);
+    });
+    bench_report("multi_calc_average per triple", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_rolling_reset(r3);
+        calc_rolling_push_batch(r3, samples, n, means);
+        bench_keep(means);
+    });
+    bench_report("calc_rolling_push_batch", ns, n, baseline_ns);
+
+    // Rescanning costs O(window) per sample: time a slice of the stream
+    printf("\nwindow of %d, mean + min + max\n", WIDE_WINDOW);
+    size_t slice = n < 65536 ? n : 65536;
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = WIDE_WINDOW; i < slice; i++) {
+            int64_t sum = 0;
+            int lo = samples[i - WIDE_WINDOW];
+            int hi = lo;
+            for (size_t k = i - WIDE_WINDOW; k < i; k++) {
+                sum += samples[k];
+                lo = samples[k] < lo ? samples[k] : lo;
+                hi = samples[k] > hi ? samples[k] : hi;
+            }
+            means[i] = (int)(sum / WIDE_WINDOW);
+            lows[i] = lo;
+            highs[i] = hi;
+        }
+        bench_keep(means);
+        bench_keep(lows);
+        bench_keep(highs);
+    });
+    bench_report("rescan window per sample", baseline_ns, slice - WIDE_WINDOW, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_rolling_reset(wide);
+        for (size_t i = 0; i < n; i++) {
+            calc_rolling_push(wide, samples[i]);
+            means[i] = calc_rolling_mean(wide);
+            lows[i] = calc_rolling_min(wide);
+            highs[i] = calc_rolling_max(wide);
+        }
+        bench_keep(means);
+        bench_keep(lows);
+        bench_keep(highs);
+    });
+    // Per-sample rates are comparable even though the slices differ
+    bench_report("calc_rolling_push + queries",
+                 ns, n, baseline_ns * n / (slice - WIDE_WINDOW));
+
+    calc_rolling_destroy(r3);
+    calc_rolling_destroy(wide);
+    free(samples);
+    free(means);
+    free(lows);
+    free(highs);
+    return 0;
+}
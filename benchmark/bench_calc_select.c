@@ -0,0 +1,106 @@
+/**
+ * @file bench_calc_select.c
+ * @brief Benchmark: filtered multi_calc_expression with selection bitmaps
+ *
+ * Rows with a + b > threshold get (a + b) * (c - d); the threshold is set
+ * so that 1%, 10%, 50% or 90% of the rows pass. Rows report rows per
+ * second:
+ * - an `if` around multi_calc_expression per row (the baseline)
+ * - calc_add_batch + calc_compare_value_batch + the _bitmap expression
+ * - the same, through a selection vector and the _sel expression
+ *
+ * Usage: bench_calc_select [length]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+#include "calc-select.h"
+#include "multi-calc.h"
+
+static int compare_ints(const void *x, const void *y) {
+    int a = *(const int *)x;
+    int b = *(const int *)y;
+    return (a > b) - (a < b);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *c = bench_alloc(n);
+    int *d = bench_alloc(n);
+    int *sum = bench_alloc(n);
+    int *sorted = bench_alloc(n);
+    int *out = bench_alloc(n);
+    unsigned char *bits = malloc(CALC_BITMAP_BYTES(n));
+    uint32_t *sel = malloc(n * sizeof(*sel));
+    static const int percents[] = { 1, 10, 50, 90 };
+    uint64_t baseline_ns;
+    uint64_t ns;
+
+    if (bits == NULL || sel == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill(a, n, 1u, -100000, 100000);
+    bench_fill(b, n, 2u, -100000, 100000);
+    bench_fill(c, n, 3u, -100000, 100000);
+    bench_fill(d, n, 4u, -100000, 100000);
+    calc_add_batch(a, b, sorted, n);
+    qsort(sorted, n, sizeof(int), compare_ints);
+
+    printf("calc-select benchmark, %zu rows, isa %s\n", n, calc_isa_name(calc_batch_isa()));
+
+    for (size_t p = 0; p < sizeof(percents) / sizeof(percents[0]); p++) {
+        int threshold = sorted[n - 1 - n * (size_t)percents[p] / 100];
+
+        printf("\n%d%% of rows selected\n", percents[p]);
+
+        BENCH_BEST(baseline_ns, {
+            for (size_t i = 0; i < n; i++) {
+                if (a[i] + b[i] > threshold) {
+                    out[i] = multi_calc_expression(a[i], b[i], c[i], d[i]);
+                }
+            }
+            bench_keep(out);
+        });
+        bench_report("if + multi_calc_expression", baseline_ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_add_batch(a, b, sum, n);
+            calc_compare_value_batch(CALC_CMP_GT, sum, threshold, bits, n);
+            bench_keep(bits);
+        });
+        bench_report("compare only (bitmap)", ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_add_batch(a, b, sum, n);
+            calc_compare_value_batch(CALC_CMP_GT, sum, threshold, bits, n);
+            multi_calc_expression_batch_bitmap(a, b, c, d, out, bits, n);
+            bench_keep(out);
+        });
+        bench_report("compare + expression_batch_bitmap", ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            calc_add_batch(a, b, sum, n);
+            calc_compare_value_batch(CALC_CMP_GT, sum, threshold, bits, n);
+            size_t count = calc_bitmap_to_selection(bits, n, sel);
+            multi_calc_expression_batch_sel(a, b, c, d, out, sel, count);
+            bench_keep(out);
+        });
+        bench_report("compare + expression_batch_sel", ns, n, baseline_ns);
+    }
+
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(sum);
+    free(sorted);
+    free(out);
+    free(bits);
+    free(sel);
+    return 0;
+}
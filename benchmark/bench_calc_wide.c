@@ -0,0 +1,169 @@
+/**
+ * @file bench_calc_wide.c
+ * @brief Benchmark: 64-bit and saturating variants vs the int functions
+ *
+ * For every operation, each width/policy pair is timed with the scalar
+ * kernel and with the detected instruction set, against a per-element
+ * loop over the existing int function.
+ *
+ * Usage: bench_calc_wide [elements]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-wide.h"
+
+typedef int (*scalar_op)(int a, int b);
+typedef void (*batch_op)(const int *a, const int *b, int *out, size_t n);
+typedef void (*batch_i64_op)(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+
+struct wide_ops {
+    const char *name;
+    scalar_op scalar;
+    batch_op batch;
+    batch_op sat;
+    batch_i64_op wrap64;
+    batch_i64_op sat64;
+};
+
+struct inputs {
+    const int *a;
+    const int *b;
+    const int64_t *a64;
+    const int64_t *b64;
+    int *out;
+    int64_t *out64;
+    size_t n;
+};
+
+static int isa_levels(calc_isa_t detected, calc_isa_t levels[2]) {
+    levels[0] = CALC_ISA_SCALAR;
+    levels[1] = detected;
+    return detected == CALC_ISA_SCALAR ? 1 : 2;
+}
+
+static void bench_op(const struct wide_ops *op, const struct inputs *in, calc_isa_t detected) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    calc_isa_t levels[2];
+    int n_levels = isa_levels(detected, levels);
+    size_t n = in->n;
+    char label[64];
+
+    printf("\n%s (%zu elements)\n", op->name, n);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            in->out[i] = op->scalar(in->a[i], in->b[i]);
+        }
+        bench_keep(in->out);
+    });
+    snprintf(label, sizeof(label), "%s loop (int)", op->name);
+    bench_report(label, baseline_ns, n, baseline_ns);
+
+    for (int l = 0; l < n_levels; l++) {
+        const char *isa = calc_isa_name(levels[l]);
+        calc_batch_set_isa(levels[l]);
+
+        BENCH_BEST(ns, { op->batch(in->a, in->b, in->out, n); bench_keep(in->out); });
+        snprintf(label, sizeof(label), "int wrap [%s]", isa);
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, { op->sat(in->a, in->b, in->out, n); bench_keep(in->out); });
+        snprintf(label, sizeof(label), "int saturate [%s]", isa);
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, { op->wrap64(in->a64, in->b64, in->out64, n); bench_keep(in->out64); });
+        snprintf(label, sizeof(label), "int64 wrap [%s]", isa);
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, { op->sat64(in->a64, in->b64, in->out64, n); bench_keep(in->out64); });
+        snprintf(label, sizeof(label), "int64 saturate [%s]", isa);
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_batch_set_isa(detected);
+}
+
+static void bench_sum(const struct inputs *in, calc_isa_t detected) {
+    uint64_t baseline_ns;
+    uint64_t ns;
+    calc_isa_t levels[2];
+    int n_levels = isa_levels(detected, levels);
+    size_t n = in->n;
+    volatile int64_t sink;
+    char label[64];
+
+    printf("\nsum (%zu elements)\n", n);
+
+    // Naive reference: one 128-bit add per element
+    BENCH_BEST(baseline_ns, {
+        __int128 total = 0;
+        for (size_t i = 0; i < n; i++) {
+            total += in->a64[i];
+        }
+        sink = (int64_t)total;
+    });
+    bench_report("__int128 loop", baseline_ns, n, baseline_ns);
+
+    for (int l = 0; l < n_levels; l++) {
+        calc_batch_set_isa(levels[l]);
+        BENCH_BEST(ns, { sink = (int64_t)calc_sum_i64(in->a64, n).lo; });
+        snprintf(label, sizeof(label), "calc_sum_i64 [%s]", calc_isa_name(levels[l]));
+        bench_report(label, ns, n, baseline_ns);
+    }
+    (void)sink;
+    calc_batch_set_isa(detected);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *out = bench_alloc(n);
+    int64_t *a64 = malloc(n * sizeof(int64_t));
+    int64_t *b64 = malloc(n * sizeof(int64_t));
+    int64_t *out64 = malloc(n * sizeof(int64_t));
+    calc_isa_t detected = calc_batch_isa();
+
+    if (a64 == NULL || b64 == NULL || out64 == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // Wide operand ranges so that some results saturate
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+    bench_fill(b, n, 2u, -100000, 100000);
+    for (size_t i = 0; i < n; i++) {
+        a64[i] = (int64_t)a[i] * 4000000000;
+        b64[i] = (int64_t)b[i] * 100000;
+    }
+
+    const struct wide_ops ops[] = {
+        { "add", calc_add, calc_add_batch, calc_add_sat_batch,
+          calc_add_i64_batch, calc_add_sat_i64_batch },
+        { "subtract", calc_subtract, calc_subtract_batch, calc_subtract_sat_batch,
+          calc_subtract_i64_batch, calc_subtract_sat_i64_batch },
+        { "multiply", calc_multiply, calc_multiply_batch, calc_multiply_sat_batch,
+          calc_multiply_i64_batch, calc_multiply_sat_i64_batch },
+        { "divide", calc_divide, calc_divide_batch, calc_divide_sat_batch,
+          calc_divide_i64_batch, calc_divide_sat_i64_batch },
+    };
+    const struct inputs in = { a, b, a64, b64, out, out64, n };
+
+    printf("calc wide benchmark, detected instruction set: %s\n", calc_isa_name(detected));
+
+    for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); i++) {
+        bench_op(&ops[i], &in, detected);
+    }
+    bench_sum(&in, detected);
+
+    free(a);
+    free(b);
+    free(out);
+    free(a64);
+    free(b64);
+    free(out64);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file bench_greeting.c
+ * @brief Benchmark: say_hello behind a mutex vs say_hello_r, 1 to 8 threads
+ *
+ * Every thread formats greetings in a loop. Rows report calls per second
+ * summed over the threads:
+ * - locked say_hello: the pattern the static buffer forces on threaded
+ *   callers (global mutex, call, copy the text out, unlock); the baseline
+ *   for each thread count
+ * - say_hello_r: straight into a buffer on the thread's stack
+ *
+ * Usage: bench_greeting [calls per thread]   (default 1000000)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "bench.h"
+#include "greeting.h"
+
+#define MAX_THREADS 8
+#define ROUNDS 3
+
+static pthread_mutex_t greeting_lock = PTHREAD_MUTEX_INITIALIZER;
+
+struct worker {
+    size_t calls;
+    char name[16];
+    char text[64];
+};
+
+static void* run_locked(void *arg) {
+    struct worker *w = arg;
+
+    for (size_t i = 0; i < w->calls; i++) {
+        pthread_mutex_lock(&greeting_lock);
+        snprintf(w->text, sizeof(w->text), "%s", say_hello(w->name));
+        pthread_mutex_unlock(&greeting_lock);
+        bench_keep(w->text);
+    }
+    return NULL;
+}
+
+static void* run_reentrant(void *arg) {
+    struct worker *w = arg;
+    char text[64];
+
+    for (size_t i = 0; i < w->calls; i++) {
+        say_hello_r(w->name, text, sizeof(text));
+        bench_keep(text);
+    }
+    memcpy(w->text, text, sizeof(text));
+    return NULL;
+}
+
+/* Best wall time of ROUNDS runs of `fn` on n_threads threads */
+static uint64_t time_threads(void* (*fn)(void *), struct worker *workers, unsigned n_threads) {
+    pthread_t threads[MAX_THREADS];
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        uint64_t t0 = bench_now_ns();
+        uint64_t wall;
+
+        for (unsigned t = 0; t < n_threads; t++) {
+            pthread_create(&threads[t], NULL, fn, &workers[t]);
+        }
+        for (unsigned t = 0; t < n_threads; t++) {
+            pthread_join(threads[t], NULL);
+        }
+        wall = bench_now_ns() - t0;
+        best = wall < best ? wall : best;
+    }
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+    size_t calls = argc > 1 ? bench_len_arg(argc, argv) : 1000000;
+    static struct worker workers[MAX_THREADS];
+
+    for (unsigned t = 0; t < MAX_THREADS; t++) {
+        workers[t].calls = calls;
+        snprintf(workers[t].name, sizeof(workers[t].name), "User%u", t);
+    }
+
+    printf("greeting benchmark, %zu calls per thread\n", calls);
+    for (unsigned n_threads = 1; n_threads <= MAX_THREADS; n_threads *= 2) {
+        uint64_t locked_ns = time_threads(run_locked, workers, n_threads);
+        uint64_t reentrant_ns = time_threads(run_reentrant, workers, n_threads);
+
+        printf("\n%u thread%s\n", n_threads, n_threads > 1 ? "s" : "");
+        bench_report("locked say_hello + copy", locked_ns, calls * n_threads, locked_ns);
+        bench_report("say_hello_r", reentrant_ns, calls * n_threads, locked_ns);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file bench_multi_calc_batch.c
+ * @brief Benchmark: fused (a + b) * (c - d) kernels vs per-call evaluation
+ *
+ * Rows report tuples per second on one core:
+ * - multi_calc_expression called once per tuple (baseline)
+ * - three calc_*_batch passes through two temporary columns
+ * - multi_calc_expression_batch (columns) and _batch_aos (tuples) for
+ *   every instruction set the CPU supports
+ *
+ * Usage: bench_multi_calc_batch [tuples]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc-batch.h"
+#include "multi-calc.h"
+#include "multi-calc-batch.h"
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *a = bench_alloc(n);
+    int *b = bench_alloc(n);
+    int *c = bench_alloc(n);
+    int *d = bench_alloc(n);
+    int *sum = bench_alloc(n);
+    int *diff = bench_alloc(n);
+    int *out = bench_alloc(n);
+    multi_calc_tuple_t *tuples = malloc(n * sizeof(*tuples));
+    calc_isa_t detected = calc_batch_isa();
+    uint64_t baseline_ns;
+    uint64_t ns;
+    char label[64];
+
+    if (tuples == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    bench_fill(a, n, 1u, -2000000000, 2000000000);
+    bench_fill(b, n, 2u, -2000000000, 2000000000);
+    bench_fill(c, n, 3u, -2000000000, 2000000000);
+    bench_fill(d, n, 4u, -2000000000, 2000000000);
+    for (size_t i = 0; i < n; i++) {
+        tuples[i].a = a[i];
+        tuples[i].b = b[i];
+        tuples[i].c = c[i];
+        tuples[i].d = d[i];
+    }
+
+    printf("multi_calc_expression batch benchmark, %zu tuples, detected instruction set: %s\n\n",
+           n, calc_isa_name(detected));
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = multi_calc_expression(a[i], b[i], c[i], d[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("multi_calc_expression per tuple", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        calc_add_batch(a, b, sum, n);
+        calc_subtract_batch(c, d, diff, n);
+        calc_multiply_batch(sum, diff, out, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "3 x calc_*_batch [%s]", calc_isa_name(detected));
+    bench_report(label, ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            multi_calc_expression_batch(a, b, c, d, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "fused, columns [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+
+        BENCH_BEST(ns, {
+            multi_calc_expression_batch_aos(tuples, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "fused, tuples [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+
+    calc_batch_set_isa(detected);
+    free(a);
+    free(b);
+    free(c);
+    free(d);
+    free(sum);
+    free(diff);
+    free(out);
+    free(tuples);
+    return 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file bench_multi_calc_poly.c
+ * @brief Benchmark: powers and polynomials, chained calc calls vs batch kernels
+ *
+ * x^13 and a degree-8 polynomial over an int array. Rows report elements
+ * per second:
+ * - one calc_multiply (and calc_add) call per factor or coefficient per
+ *   element (the baseline)
+ * - calc_pow / multi_calc_poly per element
+ * - calc_pow_batch / multi_calc_poly_batch at each instruction set level
+ * - the checked batch functions at the best level
+ *
+ * Usage: bench_multi_calc_poly [length]
+ */
+
+#include <stdio.h>
+#include "bench.h"
+#include "calc.h"
+#include "calc-batch.h"
+#include "multi-calc-poly.h"
+
+#define EXPONENT 13
+
+static const int coeffs[] = { 3, -1, 4, 1, -5, 9, 2, -6, 5 };
+#define COUNT (sizeof(coeffs) / sizeof(coeffs[0]))
+
+static void bench_pow(const int *x, int *out, unsigned char *flags, size_t n) {
+    calc_isa_t detected = calc_batch_isa();
+    uint64_t baseline_ns;
+    uint64_t ns;
+    char label[64];
+
+    printf("\nx^%d (%zu elements)\n", EXPONENT, n);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            int r = 1;
+            for (int e = 0; e < EXPONENT; e++) {
+                r = calc_multiply(r, x[i]);
+            }
+            out[i] = r;
+        }
+        bench_keep(out);
+    });
+    bench_report("chained calc_multiply", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = calc_pow(x[i], EXPONENT);
+        }
+        bench_keep(out);
+    });
+    bench_report("calc_pow per element", ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            calc_pow_batch(x, EXPONENT, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "calc_pow_batch [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_batch_set_isa(detected);
+
+    BENCH_BEST(ns, {
+        calc_pow_checked_batch(x, EXPONENT, out, flags, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "calc_pow_checked_batch [%s]", calc_isa_name(detected));
+    bench_report(label, ns, n, baseline_ns);
+}
+
+static void bench_poly(const int *x, int *out, unsigned char *flags, size_t n) {
+    calc_isa_t detected = calc_batch_isa();
+    uint64_t baseline_ns;
+    uint64_t ns;
+    char label[64];
+
+    printf("\ndegree-%zu polynomial (%zu elements)\n", COUNT - 1, n);
+
+    BENCH_BEST(baseline_ns, {
+        for (size_t i = 0; i < n; i++) {
+            // Naive chained form: sum of coeffs[k] * x^k
+            int r = 0;
+            int power = 1;
+            for (size_t k = 0; k < COUNT; k++) {
+                r = calc_add(r, calc_multiply(coeffs[k], power));
+                power = calc_multiply(power, x[i]);
+            }
+            out[i] = r;
+        }
+        bench_keep(out);
+    });
+    bench_report("chained calc_multiply / calc_add", baseline_ns, n, baseline_ns);
+
+    BENCH_BEST(ns, {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = multi_calc_poly(coeffs, COUNT, x[i]);
+        }
+        bench_keep(out);
+    });
+    bench_report("multi_calc_poly per element", ns, n, baseline_ns);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        BENCH_BEST(ns, {
+            multi_calc_poly_batch(coeffs, COUNT, x, out, n);
+            bench_keep(out);
+        });
+        snprintf(label, sizeof(label), "multi_calc_poly_batch [%s]", calc_isa_name((calc_isa_t)isa));
+        bench_report(label, ns, n, baseline_ns);
+    }
+    calc_batch_set_isa(detected);
+
+    BENCH_BEST(ns, {
+        multi_calc_poly_checked_batch(coeffs, COUNT, x, out, flags, n);
+        bench_keep(out);
+    });
+    snprintf(label, sizeof(label), "multi_calc_poly_checked_batch [%s]", calc_isa_name(detected));
+    bench_report(label, ns, n, baseline_ns);
+}
+
+int main(int argc, char *argv[]) {
+    size_t n = bench_len_arg(argc, argv);
+    int *x = bench_alloc(n);
+    int *out = bench_alloc(n);
+    unsigned char *flags = malloc((n + 7) / 8);
+
+    if (flags == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    // Small values: x^13 and the polynomial stay within int
+    bench_fill(x, n, 1u, -4, 4);
+
+    printf("multi-calc-poly benchmark\n");
+    bench_pow(x, out, flags, n);
+    bench_poly(x, out, flags, n);
+
+    free(x);
+    free(out);
+    free(flags);
+    return 0;
+}
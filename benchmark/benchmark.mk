@@ -0,0 +1,65 @@
+# Benchmark build rules
+#
+# Every benchmark/bench_*.c (or bench_*.cpp, C++20) file becomes one
+# executable in $(DIST_DIR), linked against the installed SDK like the
+# application.
+
+# Benchmark source files
+BENCH_SRC_DIR := benchmark
+BENCH_OUTPUT_DIR := $(OUTPUT_DIR)/benchmark
+BENCH_SRCS := $(wildcard $(BENCH_SRC_DIR)/bench_*.c)
+BENCH_CXX_SRCS := $(wildcard $(BENCH_SRC_DIR)/bench_*.cpp)
+BENCH_CXX_EXECS := $(patsubst $(BENCH_SRC_DIR)/%.cpp, $(DIST_DIR)/%, $(BENCH_CXX_SRCS))
+BENCH_EXECS := $(patsubst $(BENCH_SRC_DIR)/%.c, $(DIST_DIR)/%, $(BENCH_SRCS)) $(BENCH_CXX_EXECS)
+
+# Benchmark specific flags (optimized, use installed SDK from build directory)
+BENCH_CFLAGS := $(CFLAGS) -O2 -I$(SDK_INSTALL_INC_DIR)
+BENCH_CXXFLAGS := $(CFLAGS) -O2 -std=c++20 -I$(SDK_INSTALL_INC_DIR)
+BENCH_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -lsdk -pthread -ldl
+
+# Build and run all benchmarks
+.PHONY: bench
+bench: bench_build
+	@for b in $(BENCH_EXECS); do \
+		echo ""; \
+		echo "========================================"; \
+		echo "Running $$b"; \
+		echo "========================================"; \
+		$$b || exit 1; \
+	done
+
+# Build benchmarks only (without running)
+.PHONY: bench_build
+bench_build: sdk_install $(BENCH_EXECS)
+	@echo "Benchmark executables built successfully"
+
+# Keep object files (they are intermediates of a pattern rule chain)
+.PRECIOUS: $(BENCH_OUTPUT_DIR)/%.o $(BENCH_OUTPUT_DIR)/%.cpp.o
+
+# Link benchmark executables
+$(DIST_DIR)/bench_%: $(BENCH_OUTPUT_DIR)/bench_%.o $(SDK_LIB)
+	@echo "Building benchmark: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(BENCH_LDFLAGS)
+
+# Link C++ benchmark executables (static pattern: wins over the rule above)
+$(BENCH_CXX_EXECS): $(DIST_DIR)/%: $(BENCH_OUTPUT_DIR)/%.cpp.o $(SDK_LIB)
+	@echo "Building benchmark: $@"
+	@$(MKDIR) $(dir $@)
+	$(CXX) $< -o $@ $(BENCH_LDFLAGS)
+
+# Compile benchmark source files
+$(BENCH_OUTPUT_DIR)/%.o: $(BENCH_SRC_DIR)/%.c $(BENCH_SRC_DIR)/bench.h
+	@echo "Compiling: $<"
+	@$(MKDIR) $(dir $@)
+	$(CC) $(BENCH_CFLAGS) -c $< -o $@
+
+$(BENCH_OUTPUT_DIR)/%.cpp.o: $(BENCH_SRC_DIR)/%.cpp $(BENCH_SRC_DIR)/bench.h
+	@echo "Compiling: $<"
+	@$(MKDIR) $(dir $@)
+	$(CXX) $(BENCH_CXXFLAGS) -c $< -o $@
+
+# Clean benchmark artifacts
+.PHONY: clean-bench
+clean-bench:
+	$(RM) $(BENCH_OUTPUT_DIR) $(BENCH_EXECS)
@@ -0,0 +1,498 @@
+#ifndef __CALC_ASYNC_HPP__
+#define __CALC_ASYNC_HPP__
+
+#if !defined(__cpp_impl_coroutine)
+#error "calc-async.hpp needs C++20 coroutines (-std=c++20)"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <utility>
+
+extern "C" {
+#include "calc-async.h"
+}
+
+/*
+ * Header-only C++20 coroutine facade over calc-async.h
+ *
+ * The batch functions below return awaitables: co_await submits the job
+ * to an sdk::async::executor and the coroutine resumes on the worker
+ * thread that ran it, so no thread is parked per request. An await does
+ * not allocate in steady state: the awaiter lives in the coroutine frame
+ * and calc-async recycles its job records. If the queue is full the work
+ * runs on the awaiting thread instead of blocking it, which also keeps a
+ * coroutine already running on a worker from waiting on its own queue.
+ *
+ * sdk::async::task<T> is a lazily started coroutine whose frames come
+ * from a pool of recycled blocks; sync_wait() runs one from plain code.
+ */
+
+namespace sdk {
+namespace async {
+
+/**
+ * Owner of a calc_async_t executor
+ */
+class executor {
+public:
+    /**
+     * @param workers Worker threads; 0 for one per online CPU
+     * @param capacity Queued jobs before awaits run inline
+     * @throw std::bad_alloc if the executor cannot be created
+     */
+    explicit executor(unsigned workers = 0, std::size_t capacity = 1024)
+        : handle_(calc_async_create(workers, capacity)) {
+        if (handle_ == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+
+    /** Runs every queued job, then stops the workers */
+    ~executor() { calc_async_destroy(handle_); }
+
+    executor(const executor &) = delete;
+    executor &operator=(const executor &) = delete;
+
+    calc_async_t *get() const noexcept { return handle_; }
+
+private:
+    calc_async_t *handle_;
+};
+
+/**
+ * Awaitable for one job; returned by the functions below
+ */
+class job_awaiter {
+public:
+    job_awaiter(executor &ex, const calc_job_desc_t &desc) noexcept
+        : async_(ex.get()), desc_(desc) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    /* Returns false (no suspension) when the job is already done */
+    bool await_suspend(std::coroutine_handle<> caller) noexcept {
+        job_ = calc_async_try_submit(async_, &desc_);
+        if (job_ == nullptr) {
+            calc_job_run(&desc_);
+            return false;
+        }
+        caller_ = caller;
+        calc_job_then(job_, &on_done, this);
+        // Whichever of this thread and the callback comes second resumes
+        // the caller, so a job done early never nests a resume in here
+        return !armed_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    void await_resume() noexcept { calc_job_release(job_); }
+
+private:
+    static void on_done(calc_job_t *, void *arg) {
+        job_awaiter *self = static_cast<job_awaiter *>(arg);
+        std::coroutine_handle<> caller = self->caller_;
+        if (self->armed_.exchange(true, std::memory_order_acq_rel)) {
+            caller.resume();
+        }
+    }
+
+    calc_async_t *async_;
+    calc_job_desc_t desc_;
+    calc_job_t *job_ = nullptr;
+    std::coroutine_handle<> caller_;
+    std::atomic<bool> armed_{false};
+};
+
+/*============================================================================
+ * Batches (same results as the C functions of the same name)
+ *===========================================================================*/
+
+inline job_awaiter add_batch(executor &ex, const int *a, const int *b, int *out, std::size_t n) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_ADD;
+    d.a = a;
+    d.b = b;
+    d.out = out;
+    d.n = n;
+    return job_awaiter(ex, d);
+}
+
+inline job_awaiter subtract_batch(executor &ex, const int *a, const int *b, int *out, std::size_t n) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_SUBTRACT;
+    d.a = a;
+    d.b = b;
+    d.out = out;
+    d.n = n;
+    return job_awaiter(ex, d);
+}
+
+inline job_awaiter multiply_batch(executor &ex, const int *a, const int *b, int *out, std::size_t n) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_MULTIPLY;
+    d.a = a;
+    d.b = b;
+    d.out = out;
+    d.n = n;
+    return job_awaiter(ex, d);
+}
+
+inline job_awaiter divide_batch(executor &ex, const int *a, const int *b, int *out, std::size_t n) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_DIVIDE;
+    d.a = a;
+    d.b = b;
+    d.out = out;
+    d.n = n;
+    return job_awaiter(ex, d);
+}
+
+/** (a + b) * (c - d) per element, as multi_calc_expression_batch */
+inline job_awaiter expression_batch(executor &ex, const int *a, const int *b, const int *c,
+                                    const int *d, int *out, std::size_t n) {
+    calc_job_desc_t desc{};
+    desc.kind = CALC_JOB_EXPRESSION;
+    desc.a = a;
+    desc.b = b;
+    desc.c = c;
+    desc.d = d;
+    desc.out = out;
+    desc.n = n;
+    return job_awaiter(ex, desc);
+}
+
+/** say_hello(names[i]) into text + i * text_size (0 for CALC_JOB_TEXT_LEN) */
+inline job_awaiter say_hello(executor &ex, const char *const *names, std::size_t n,
+                             char *text, std::size_t text_size = 0) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_HELLO;
+    d.names = names;
+    d.n = n;
+    d.text = text;
+    d.text_size = text_size;
+    return job_awaiter(ex, d);
+}
+
+/** say_goodbye(names[i]) into text + i * text_size (0 for CALC_JOB_TEXT_LEN) */
+inline job_awaiter say_goodbye(executor &ex, const char *const *names, std::size_t n,
+                               char *text, std::size_t text_size = 0) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_GOODBYE;
+    d.names = names;
+    d.n = n;
+    d.text = text;
+    d.text_size = text_size;
+    return job_awaiter(ex, d);
+}
+
+namespace detail {
+
+inline void no_op(void *) {}
+
+} // namespace detail
+
+/** Move the coroutine onto a worker of ex */
+inline job_awaiter schedule(executor &ex) {
+    calc_job_desc_t d{};
+    d.kind = CALC_JOB_CUSTOM;
+    d.fn = detail::no_op;
+    return job_awaiter(ex, d);
+}
+
+/*============================================================================
+ * Coroutine frames
+ *===========================================================================*/
+
+namespace detail {
+
+/*
+ * Recycled coroutine frames in size classes of 64 bytes up to 1 KiB.
+ * Frames are often freed on a worker and allocated again on the caller,
+ * so the free lists are shared, behind one mutex per class.
+ */
+class frame_pool {
+public:
+    static constexpr std::size_t granule = 64;
+    static constexpr std::size_t classes = 16;
+    static constexpr std::size_t max_free = 256;   /* Blocks kept per class */
+
+    void *allocate(std::size_t size) {
+        std::size_t c = (size + granule - 1) / granule;
+        if (c == 0 || c > classes) {
+            return ::operator new(size);
+        }
+        {
+            std::lock_guard<std::mutex> lock(lists_[c - 1].lock);
+            if (block *b = lists_[c - 1].head) {
+                lists_[c - 1].head = b->next;
+                lists_[c - 1].count--;
+                return b;
+            }
+        }
+        return ::operator new(c * granule);
+    }
+
+    void deallocate(void *p, std::size_t size) noexcept {
+        std::size_t c = (size + granule - 1) / granule;
+        if (c == 0 || c > classes) {
+            ::operator delete(p);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(lists_[c - 1].lock);
+            if (lists_[c - 1].count < max_free) {
+                lists_[c - 1].head = new (p) block{lists_[c - 1].head};
+                lists_[c - 1].count++;
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+private:
+    struct block {
+        block *next;
+    };
+    struct free_list {
+        std::mutex lock;
+        block *head = nullptr;
+        std::size_t count = 0;
+    };
+    free_list lists_[classes];
+};
+
+inline frame_pool frames;
+
+/* Frame allocation, continuation and exception shared by every promise */
+class promise_base {
+public:
+    static void *operator new(std::size_t size) { return frames.allocate(size); }
+    static void operator delete(void *p, std::size_t size) noexcept { frames.deallocate(p, size); }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    struct final_awaiter {
+        bool await_ready() const noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+            std::coroutine_handle<> next = self.promise().continuation_;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+    final_awaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    std::coroutine_handle<> continuation_;
+    std::exception_ptr exception_;
+};
+
+} // namespace detail
+
+/*============================================================================
+ * Tasks
+ *===========================================================================*/
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+template <typename T>
+class task_promise : public promise_base {
+public:
+    task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U &&value) { value_.emplace(std::forward<U>(value)); }
+
+    T result() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class task_promise<void> : public promise_base {
+public:
+    task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void result() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * Lazily started coroutine returning T
+ *
+ * The body starts when the task is awaited and may finish on any thread;
+ * the awaiting coroutine resumes where it finished.
+ */
+template <typename T>
+class task {
+public:
+    using promise_type = detail::task_promise<T>;
+
+    task(task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    task &operator=(task &&other) noexcept {
+        if (this != &other) {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    task(const task &) = delete;
+    task &operator=(const task &) = delete;
+    ~task() { destroy(); }
+
+    struct awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+            handle.promise().continuation_ = caller;
+            return handle;
+        }
+        T await_resume() { return handle.promise().result(); }
+    };
+
+    awaiter operator co_await() && noexcept { return awaiter{handle_}; }
+    awaiter operator co_await() & noexcept { return awaiter{handle_}; }
+
+private:
+    friend promise_type;
+    template <typename U>
+    friend U sync_wait(task<U> t);
+
+    explicit task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    void destroy() noexcept {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+task<T> task_promise<T>::get_return_object() noexcept {
+    return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept {
+    return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+/* Set from the final suspension point of the coroutine waited for */
+class blocking_event {
+public:
+    void set() {
+        std::lock_guard<std::mutex> lock(lock_);
+        done_ = true;
+        cv_.notify_one();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(lock_);
+        cv_.wait(lock, [this] { return done_; });
+    }
+
+private:
+    std::mutex lock_;
+    std::condition_variable cv_;
+    bool done_ = false;
+};
+
+/* Coroutine that starts a task and signals the event once it is done */
+class sync_waiter {
+public:
+    struct promise_type : promise_base {
+        blocking_event *event = nullptr;
+
+        sync_waiter get_return_object() noexcept {
+            return sync_waiter(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        struct final_awaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+                self.promise().event->set();
+            }
+            void await_resume() const noexcept {}
+        };
+        final_awaiter final_suspend() const noexcept { return {}; }
+        void return_void() noexcept {}
+    };
+
+    explicit sync_waiter(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+    sync_waiter(const sync_waiter &) = delete;
+    sync_waiter &operator=(const sync_waiter &) = delete;
+    ~sync_waiter() { handle_.destroy(); }
+
+    void run(blocking_event &event) {
+        handle_.promise().event = &event;
+        handle_.resume();
+        event.wait();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/* Waits for the task without taking its result, so exceptions stay in it */
+template <typename P>
+struct completion {
+    std::coroutine_handle<P> handle;
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle.promise().continuation_ = caller;
+        return handle;
+    }
+    void await_resume() const noexcept {}
+};
+
+template <typename P>
+sync_waiter wait_for(std::coroutine_handle<P> handle) {
+    co_await completion<P>{handle};
+}
+
+} // namespace detail
+
+/**
+ * Run a task and block the calling thread until it is done
+ * @param t Task to run
+ * @return Value of the task
+ * @throw Whatever the task threw
+ */
+template <typename T>
+T sync_wait(task<T> t) {
+    detail::blocking_event done;
+    detail::sync_waiter waiter = detail::wait_for(t.handle_);
+
+    waiter.run(done);
+    return t.handle_.promise().result();
+}
+
+} // namespace async
+} // namespace sdk
+
+#endif /* __CALC_ASYNC_HPP__ */
@@ -0,0 +1,100 @@
+#ifndef __CALC_BATCH_H__
+#define __CALC_BATCH_H__
+
+#include <stddef.h>
+
+/**
+ * Instruction set levels used by the batch kernels
+ *
+ * The best level supported by the running CPU is detected on first use.
+ * Levels are ordered, so a CPU supporting one level supports all lower ones.
+ */
+typedef enum {
+    CALC_ISA_SCALAR = 0,    /* Portable C loop */
+    CALC_ISA_SSE2,          /* 128-bit, 4 ints per step */
+    CALC_ISA_AVX2,          /* 256-bit, 8 ints per step */
+    CALC_ISA_AVX512,        /* 512-bit, 16 ints per step (AVX-512F) */
+} calc_isa_t;
+
+/**
+ * Add two integer arrays element by element
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array, out[i] = a[i] + b[i] (may alias a or b)
+ * @param n Number of elements
+ *
+ * @note Overflow wraps around (two's complement), same as calc_add
+ */
+void calc_add_batch(const int *a, const int *b, int *out, size_t n);
+
+/**
+ * Subtract two integer arrays element by element
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array, out[i] = a[i] - b[i] (may alias a or b)
+ * @param n Number of elements
+ *
+ * @note Overflow wraps around (two's complement), same as calc_subtract
+ */
+void calc_subtract_batch(const int *a, const int *b, int *out, size_t n);
+
+/**
+ * Multiply two integer arrays element by element
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array, out[i] = a[i] * b[i] (may alias a or b)
+ * @param n Number of elements
+ *
+ * @note Overflow wraps around (two's complement), same as calc_multiply
+ */
+void calc_multiply_batch(const int *a, const int *b, int *out, size_t n);
+
+/**
+ * Divide two integer arrays element by element
+ * @param a Dividend array
+ * @param b Divisor array
+ * @param out Result array, out[i] = a[i] / b[i] (may alias a or b)
+ * @param n Number of elements
+ *
+ * @note out[i] is 0 where b[i] is 0, same as calc_divide
+ * @note INT_MIN / -1 wraps to INT_MIN instead of trapping
+ */
+void calc_divide_batch(const int *a, const int *b, int *out, size_t n);
+
+/**
+ * Divide two integer arrays and record where the divisor is zero
+ * @param a Dividend array
+ * @param b Divisor array
+ * @param out Result array, same values as calc_divide_batch (may alias a or b)
+ * @param zero_flags Bitmap of CALC_BITMAP_BYTES(n) bytes (calc-checked.h),
+ *                   bit i set if b[i] is 0 (may be NULL)
+ * @param n Number of elements
+ * @return Number of zero divisors
+ *
+ * @note Zero divisors are masked out instead of branched around, so the
+ *       speed does not depend on how many zeros there are or where
+ */
+size_t calc_divide_batch_masked(const int *a, const int *b, int *out,
+                                unsigned char *zero_flags, size_t n);
+
+/**
+ * Get the instruction set level used by the batch kernels
+ * @return Forced level if set with calc_batch_set_isa, else best detected level
+ */
+calc_isa_t calc_batch_isa(void);
+
+/**
+ * Force the batch kernels to a given instruction set level
+ * @param isa Level to use (useful for tests and benchmarks)
+ * @return 0 on success, -1 if the CPU does not support the level
+ */
+int calc_batch_set_isa(calc_isa_t isa);
+
+/**
+ * Get a printable name for an instruction set level
+ * @param isa Level
+ * @return Static string such as "avx2", or "unknown"
+ */
+const char* calc_isa_name(calc_isa_t isa);
+
+#endif /* __CALC_BATCH_H__ */
@@ -0,0 +1,187 @@
+#ifndef __CALC_BIGINT_H__
+#define __CALC_BIGINT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc-checked.h"
+
+/*
+ * Arbitrary-precision integers
+ *
+ * Same operations and semantics as calc.h, without overflow: division
+ * truncates toward zero and a zero divisor gives 0. A number is a sign
+ * and a magnitude in 64-bit limbs, least significant first, owned by the
+ * calc_bigint_t and grown with realloc as needed.
+ *
+ * Multiplication is schoolbook below the Karatsuba threshold and
+ * Karatsuba above it (unbalanced operands are cut into pieces of the
+ * shorter one's size); division is Knuth's algorithm D. Temporaries come
+ * from a per-thread scratch arena that is sized once per operation and
+ * kept between calls (and freed when the thread exits), so a steady
+ * stream of operations of similar sizes allocates nothing but result limbs.
+ *
+ * Results may alias operands. A calc_bigint_t must not be used by two
+ * threads at once; different ones can be used concurrently.
+ */
+
+/**
+ * Default Karatsuba threshold in limbs (64-bit), tuned with bench_calc_bigint
+ */
+#define CALC_BIGINT_KARATSUBA_THRESHOLD 32
+
+/**
+ * Arbitrary-precision integer
+ */
+typedef struct {
+    uint64_t *limbs;            /* Magnitude, least significant limb first */
+    size_t size;                /* Limbs in use, no leading zero limb (0 for 0) */
+    size_t capacity;            /* Limbs allocated */
+    int negative;               /* 1 if below zero (never set for 0) */
+} calc_bigint_t;
+
+/**
+ * Static initializer: the value 0, nothing allocated
+ */
+#define CALC_BIGINT_INIT { NULL, 0, 0, 0 }
+
+/*============================================================================
+ * Lifetime and conversions
+ *===========================================================================*/
+
+/**
+ * Initialize to 0 without allocating
+ * @param x Number
+ */
+void calc_bigint_init(calc_bigint_t *x);
+
+/**
+ * Free the limbs of a number (it is 0 afterwards and can be reused)
+ * @param x Number
+ */
+void calc_bigint_free(calc_bigint_t *x);
+
+/**
+ * Set from a 64-bit integer
+ * @param x Number
+ * @param v Value
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_bigint_set_i64(calc_bigint_t *x, int64_t v);
+
+/**
+ * Copy a number
+ * @param dst Destination
+ * @param src Source
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_bigint_copy(calc_bigint_t *dst, const calc_bigint_t *src);
+
+/**
+ * Convert to a 64-bit integer
+ * @param x Number
+ * @param v Receives the value, or its low 64 bits (two's complement) if it
+ *          does not fit
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if x does not fit in an int64_t
+ */
+calc_status_t calc_bigint_to_i64(const calc_bigint_t *x, int64_t *v);
+
+/**
+ * Set from a decimal string
+ * @param x Number (unchanged on failure)
+ * @param s Optional sign followed by decimal digits, nothing else
+ * @return 0 on success, -1 on a malformed string or if out of memory
+ */
+int calc_bigint_set_str(calc_bigint_t *x, const char *s);
+
+/**
+ * Format as a decimal string
+ * @param x Number
+ * @param buf Receives at most size - 1 characters and a terminating NUL
+ *            (may be NULL if size is 0)
+ * @param size Size of buf
+ * @return Length of the full string (like snprintf), 0 if out of memory
+ */
+size_t calc_bigint_to_str(const calc_bigint_t *x, char *buf, size_t size);
+
+/**
+ * Compare two numbers
+ * @param a First number
+ * @param b Second number
+ * @return -1, 0 or 1 as a is below, equal to or above b
+ */
+int calc_bigint_compare(const calc_bigint_t *a, const calc_bigint_t *b);
+
+/*============================================================================
+ * Arithmetic
+ *
+ * Return 0 on success, -1 if out of memory (out is then unspecified but
+ * still valid).
+ *===========================================================================*/
+
+/**
+ * Add two numbers
+ * @param a First operand
+ * @param b Second operand
+ * @param out Receives a + b (may alias a or b)
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_bigint_add(const calc_bigint_t *a, const calc_bigint_t *b, calc_bigint_t *out);
+
+/**
+ * Subtract two numbers
+ * @param a First operand
+ * @param b Second operand
+ * @param out Receives a - b (may alias a or b)
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_bigint_subtract(const calc_bigint_t *a, const calc_bigint_t *b, calc_bigint_t *out);
+
+/**
+ * Multiply two numbers
+ * @param a First operand
+ * @param b Second operand
+ * @param out Receives a * b (may alias a or b)
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_bigint_multiply(const calc_bigint_t *a, const calc_bigint_t *b, calc_bigint_t *out);
+
+/**
+ * Divide two numbers
+ * @param a Dividend
+ * @param b Divisor
+ * @param quotient Receives a / b truncated toward zero, 0 if b is 0 (may
+ *                 alias a or b; may be NULL)
+ * @param remainder Receives a - b * quotient, with the sign of a, 0 if b
+ *                  is 0 (may alias a or b, not quotient; may be NULL)
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_bigint_divide(const calc_bigint_t *a, const calc_bigint_t *b,
+                       calc_bigint_t *quotient, calc_bigint_t *remainder);
+
+/*============================================================================
+ * Tuning
+ *===========================================================================*/
+
+/**
+ * Set the Karatsuba threshold of all threads
+ * @param limbs Operands of at least this many limbs (both) use Karatsuba;
+ *              values below 4 are raised to 4, SIZE_MAX disables it
+ */
+void calc_bigint_set_karatsuba_threshold(size_t limbs);
+
+/**
+ * Get the Karatsuba threshold
+ * @return Value set by calc_bigint_set_karatsuba_threshold
+ *         (CALC_BIGINT_KARATSUBA_THRESHOLD by default)
+ */
+size_t calc_bigint_karatsuba_threshold(void);
+
+/**
+ * Free the calling thread's scratch arena now
+ * @note The arena is freed automatically when its thread exits; call this
+ *       to give the memory back earlier, e.g. after a burst of large
+ *       operations. The next operation allocates a new one
+ */
+void calc_bigint_release_scratch(void);
+
+#endif /* __CALC_BIGINT_H__ */
@@ -0,0 +1,111 @@
+#ifndef __CALC_CHECKED_H__
+#define __CALC_CHECKED_H__
+
+#include <stddef.h>
+
+/**
+ * Status returned by the checked calc functions
+ */
+typedef enum {
+    CALC_OK = 0,                /* Result is exact */
+    CALC_ERR_OVERFLOW,          /* Result does not fit in an int (wrapped value stored) */
+    CALC_ERR_DIV_BY_ZERO,       /* Divisor is zero (0 stored) */
+} calc_status_t;
+
+/**
+ * Number of bytes needed for a per-element status bitmap of n elements
+ *
+ * Bit i of the bitmap is bit (i % 8) of byte (i / 8), least significant bit
+ * first (the same layout as Arrow validity bitmaps).
+ */
+#define CALC_BITMAP_BYTES(n) (((n) + 7) / 8)
+
+/**
+ * Add two integers with overflow detection
+ * @param a First operand
+ * @param b Second operand
+ * @param result Receives a + b (wrapped around on overflow)
+ * @return CALC_OK or CALC_ERR_OVERFLOW
+ */
+calc_status_t calc_add_checked(int a, int b, int *result);
+
+/**
+ * Subtract two integers with overflow detection
+ * @param a First operand
+ * @param b Second operand
+ * @param result Receives a - b (wrapped around on overflow)
+ * @return CALC_OK or CALC_ERR_OVERFLOW
+ */
+calc_status_t calc_subtract_checked(int a, int b, int *result);
+
+/**
+ * Multiply two integers with overflow detection
+ * @param a First operand
+ * @param b Second operand
+ * @param result Receives a * b (wrapped around on overflow)
+ * @return CALC_OK or CALC_ERR_OVERFLOW
+ */
+calc_status_t calc_multiply_checked(int a, int b, int *result);
+
+/**
+ * Divide two integers with error detection
+ * @param a Dividend
+ * @param b Divisor
+ * @param result Receives a / b; 0 if b is 0, INT_MIN for INT_MIN / -1
+ * @return CALC_OK, CALC_ERR_DIV_BY_ZERO or CALC_ERR_OVERFLOW (INT_MIN / -1)
+ */
+calc_status_t calc_divide_checked(int a, int b, int *result);
+
+/**
+ * Add two integer arrays and flag overflowing elements
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array, out[i] = a[i] + b[i] wrapped (may alias a or b)
+ * @param flags Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if element i
+ *              overflowed (may be NULL if only the count is needed)
+ * @param n Number of elements
+ * @return Number of elements that overflowed
+ */
+size_t calc_add_checked_batch(const int *a, const int *b, int *out,
+                              unsigned char *flags, size_t n);
+
+/**
+ * Subtract two integer arrays and flag overflowing elements
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array, out[i] = a[i] - b[i] wrapped (may alias a or b)
+ * @param flags Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if element i
+ *              overflowed (may be NULL)
+ * @param n Number of elements
+ * @return Number of elements that overflowed
+ */
+size_t calc_subtract_checked_batch(const int *a, const int *b, int *out,
+                                   unsigned char *flags, size_t n);
+
+/**
+ * Multiply two integer arrays and flag overflowing elements
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array, out[i] = a[i] * b[i] wrapped (may alias a or b)
+ * @param flags Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if element i
+ *              overflowed (may be NULL)
+ * @param n Number of elements
+ * @return Number of elements that overflowed
+ */
+size_t calc_multiply_checked_batch(const int *a, const int *b, int *out,
+                                   unsigned char *flags, size_t n);
+
+/**
+ * Divide two integer arrays and flag failed elements
+ * @param a Dividend array
+ * @param b Divisor array
+ * @param out Result array, same values as calc_divide_checked (may alias a or b)
+ * @param flags Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if element i
+ *              had a zero divisor or was INT_MIN / -1 (may be NULL)
+ * @param n Number of elements
+ * @return Number of flagged elements
+ */
+size_t calc_divide_checked_batch(const int *a, const int *b, int *out,
+                                 unsigned char *flags, size_t n);
+
+#endif /* __CALC_CHECKED_H__ */
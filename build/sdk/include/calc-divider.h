@@ -0,0 +1,48 @@
+#ifndef __CALC_DIVIDER_H__
+#define __CALC_DIVIDER_H__
+
+#include <stddef.h>
+
+/**
+ * Precomputed divider for repeated division by the same integer
+ *
+ * calc_divider_init() turns the divisor into a "magic number" multiplier
+ * and shift once (Granlund-Montgomery / libdivide technique), so each
+ * division becomes a multiply, an add and two shifts instead of a hardware
+ * divide. Treat the fields as read-only.
+ */
+typedef struct {
+    int divisor;        /* Original divisor */
+    int magic;          /* Multiplier: high 32 bits of dividend * magic */
+    int add;            /* Correction after the multiply: +1 add, -1 subtract dividend */
+    int shift;          /* Arithmetic right shift after the correction */
+    int kind;           /* Internal: which algorithm handles this divisor */
+} calc_divider_t;
+
+/**
+ * Precompute a divider
+ * @param d Divider to initialize
+ * @param divisor Divisor (0 is allowed: every quotient is then 0)
+ */
+void calc_divider_init(calc_divider_t *d, int divisor);
+
+/**
+ * Divide using a precomputed divider
+ * @param d Divider from calc_divider_init
+ * @param a Dividend
+ * @return Same value as calc_divide(a, d->divisor): truncated quotient,
+ *         0 if the divisor is 0
+ * @note INT_MIN / -1 wraps to INT_MIN instead of trapping
+ */
+int calc_divider_divide(const calc_divider_t *d, int a);
+
+/**
+ * Divide an array by a precomputed divider
+ * @param d Divider from calc_divider_init
+ * @param a Dividend array
+ * @param out Result array, out[i] = calc_divider_divide(d, a[i]) (may alias a)
+ * @param n Number of elements
+ */
+void calc_divider_divide_batch(const calc_divider_t *d, const int *a, int *out, size_t n);
+
+#endif /* __CALC_DIVIDER_H__ */
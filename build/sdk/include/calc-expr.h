@@ -0,0 +1,73 @@
+#ifndef __CALC_EXPR_H__
+#define __CALC_EXPR_H__
+
+#include <stddef.h>
+
+/*
+ * Arithmetic expressions compiled at run time
+ *
+ * Grammar (whitespace is ignored):
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/') unary)*
+ *   unary   := '-' unary | primary
+ *   primary := number | name | '(' expr ')'
+ *
+ * Numbers are decimal, 0 to INT_MAX. Names are C identifiers bound to the
+ * variable list given to calc_expr_compile. Operators evaluate like the
+ * calc_*_batch functions: + - * wrap around on overflow, division by zero
+ * gives 0 and INT_MIN / -1 gives INT_MIN. Unary minus is 0 - x.
+ *
+ * The expression is compiled to register bytecode (constant parts are
+ * folded) and evaluated a block of rows at a time with the calc_*_batch
+ * kernels, so dispatch costs once per block instead of once per row.
+ */
+
+/**
+ * Maximum number of variables of an expression
+ */
+#define CALC_EXPR_MAX_VARS 64
+
+/**
+ * Compiled expression (opaque)
+ */
+typedef struct calc_expr calc_expr_t;
+
+/**
+ * Compile an expression
+ * @param source Expression text
+ * @param names Variable names; variable i is column i at evaluation
+ * @param n_vars Number of variables (at most CALC_EXPR_MAX_VARS)
+ * @param error_pos If not NULL, set to the offset in source where
+ *                  compilation failed
+ * @return Compiled expression, or NULL on a syntax error, an unknown name,
+ *         a literal above INT_MAX, nesting too deep or out of memory
+ */
+calc_expr_t* calc_expr_compile(const char *source, const char *const *names,
+                               size_t n_vars, size_t *error_pos);
+
+/**
+ * Evaluate an expression over columns of variable values
+ * @param expr Compiled expression
+ * @param columns columns[i] holds n values of variable i
+ * @param out Result array (may alias a column)
+ * @param n Number of rows
+ * @return 0 on success, -1 if scratch memory could not be allocated
+ */
+int calc_expr_eval_batch(const calc_expr_t *expr, const int *const *columns,
+                         int *out, size_t n);
+
+/**
+ * Evaluate an expression for one row
+ * @param expr Compiled expression
+ * @param values values[i] is the value of variable i
+ * @return Result, same as calc_expr_eval_batch with one row
+ */
+int calc_expr_eval(const calc_expr_t *expr, const int *values);
+
+/**
+ * Free a compiled expression
+ * @param expr Expression (NULL is ignored)
+ */
+void calc_expr_free(calc_expr_t *expr);
+
+#endif /* __CALC_EXPR_H__ */
@@ -0,0 +1,278 @@
+#ifndef __CALC_LAZY_HPP__
+#define __CALC_LAZY_HPP__
+
+#if __cplusplus < 202002L
+#error "calc-lazy.hpp needs C++20 (-std=c++20)"
+#endif
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include "calc.hpp"
+
+/*
+ * Header-only expression templates over the sdk::calc primitives
+ *
+ * add / subtract / multiply / divide on columns (std::span or any other
+ * contiguous range of integers) compute nothing: they return a small
+ * node whose type records the expression tree. evaluate() then runs one
+ * loop over the rows, so multiply(add(a, b), subtract(c, d)) reads each
+ * column once and writes the output once, with no temporary arrays in
+ * between. Every row gives the same result as sdk::calc, hence as the
+ * calc_*_batch functions.
+ *
+ * The loop works in blocks of a fixed number of rows, a shape GCC's -O2
+ * vectorizer accepts without -O3; division has no SIMD instruction and
+ * stays scalar. Nodes hold spans and values, not references, so an
+ * expression can be stored and evaluated later while its columns live.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define SDK_LAZY_IVDEP _Pragma("GCC ivdep")
+#else
+#define SDK_LAZY_IVDEP
+#endif
+
+namespace sdk {
+namespace lazy {
+
+/**
+ * Rows per block of the evaluation loop
+ */
+inline constexpr std::size_t block_rows = 16;
+
+/**
+ * Leaf: a column of integers
+ */
+template <typename T>
+class column {
+public:
+    using value_type = T;
+
+    constexpr explicit column(std::span<const T> data) noexcept : data_(data) {}
+    constexpr T operator[](std::size_t i) const noexcept { return data_[i]; }
+    constexpr std::size_t size() const noexcept { return data_.size(); }
+
+private:
+    std::span<const T> data_;
+};
+
+/**
+ * Leaf: the same value on every row
+ */
+template <typename T>
+class scalar {
+public:
+    using value_type = T;
+
+    constexpr explicit scalar(T value) noexcept : value_(value) {}
+    constexpr T operator[](std::size_t) const noexcept { return value_; }
+    constexpr std::size_t size() const noexcept { return SIZE_MAX; }
+
+private:
+    T value_;
+};
+
+/**
+ * Node: Op applied row by row to two sub-expressions
+ */
+template <typename Op, typename L, typename R>
+class binary {
+public:
+    static_assert(std::is_same_v<typename L::value_type, typename R::value_type>,
+                  "both operands of a calc expression must have the same integer type");
+    using value_type = typename L::value_type;
+
+    constexpr binary(L lhs, R rhs) noexcept : lhs_(lhs), rhs_(rhs) {}
+    constexpr value_type operator[](std::size_t i) const noexcept {
+        return Op::apply(lhs_[i], rhs_[i]);
+    }
+    /* Rows of the shortest column (SIZE_MAX for scalars only) */
+    constexpr std::size_t size() const noexcept {
+        return lhs_.size() < rhs_.size() ? lhs_.size() : rhs_.size();
+    }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+namespace detail {
+
+struct add_op {
+    template <typename T>
+    static constexpr T apply(T a, T b) noexcept { return calc::add(a, b); }
+};
+
+struct subtract_op {
+    template <typename T>
+    static constexpr T apply(T a, T b) noexcept { return calc::subtract(a, b); }
+};
+
+struct multiply_op {
+    template <typename T>
+    static constexpr T apply(T a, T b) noexcept { return calc::multiply(a, b); }
+};
+
+struct divide_op {
+    template <typename T>
+    static constexpr T apply(T a, T b) noexcept { return calc::divide(a, b); }
+};
+
+template <typename X>
+struct is_node : std::false_type {};
+template <typename T>
+struct is_node<column<T>> : std::true_type {};
+template <typename T>
+struct is_node<scalar<T>> : std::true_type {};
+template <typename Op, typename L, typename R>
+struct is_node<binary<Op, L, R>> : std::true_type {};
+
+} // namespace detail
+
+/** Expression node */
+template <typename X>
+concept node = detail::is_node<std::remove_cvref_t<X>>::value;
+
+/** Contiguous range of integers, used as a column */
+template <typename X>
+concept integer_range = std::ranges::contiguous_range<X> && std::ranges::sized_range<X> &&
+                        std::integral<std::ranges::range_value_t<X>> &&
+                        !std::same_as<std::ranges::range_value_t<X>, bool>;
+
+/** Anything add / subtract / multiply / divide accept */
+template <typename X>
+concept operand = node<X> || integer_range<X>;
+
+namespace detail {
+
+template <node X>
+constexpr std::remove_cvref_t<X> as_node(X &&x) noexcept {
+    return x;
+}
+
+template <integer_range X>
+constexpr auto as_node(X &&x) noexcept {
+    using T = std::ranges::range_value_t<X>;
+    return column<T>(std::span<const T>(std::ranges::data(x), std::ranges::size(x)));
+}
+
+template <operand X>
+using node_of = decltype(as_node(std::declval<X>()));
+
+template <operand X>
+using value_of = typename node_of<X>::value_type;
+
+} // namespace detail
+
+/*============================================================================
+ * Building expressions
+ *
+ * Each operation takes two operands, or an operand and a value of its
+ * type (broadcast to every row). Operators do the same when one side is
+ * already a node.
+ *===========================================================================*/
+
+#define SDK_LAZY_BINARY(name, op, sym)                                                  \
+    template <operand L, operand R>                                                     \
+    constexpr auto name(L &&lhs, R &&rhs) noexcept {                                    \
+        return binary<detail::op, detail::node_of<L>, detail::node_of<R>>(              \
+            detail::as_node(lhs), detail::as_node(rhs));                                \
+    }                                                                                   \
+    template <operand L>                                                                \
+    constexpr auto name(L &&lhs, std::type_identity_t<detail::value_of<L>> rhs) noexcept { \
+        using T = detail::value_of<L>;                                                  \
+        return binary<detail::op, detail::node_of<L>, scalar<T>>(                       \
+            detail::as_node(lhs), scalar<T>(rhs));                                      \
+    }                                                                                   \
+    template <operand R>                                                                \
+    constexpr auto name(std::type_identity_t<detail::value_of<R>> lhs, R &&rhs) noexcept { \
+        using T = detail::value_of<R>;                                                  \
+        return binary<detail::op, scalar<T>, detail::node_of<R>>(                       \
+            scalar<T>(lhs), detail::as_node(rhs));                                      \
+    }                                                                                   \
+    template <operand L, operand R>                                                     \
+        requires(node<L> || node<R>)                                                    \
+    constexpr auto operator sym(L &&lhs, R &&rhs) noexcept {                            \
+        return name(lhs, rhs);                                                          \
+    }                                                                                   \
+    template <node L>                                                                   \
+    constexpr auto operator sym(L &&lhs, std::type_identity_t<detail::value_of<L>> rhs) noexcept { \
+        return name(lhs, rhs);                                                          \
+    }                                                                                   \
+    template <node R>                                                                   \
+    constexpr auto operator sym(std::type_identity_t<detail::value_of<R>> lhs, R &&rhs) noexcept { \
+        return name(lhs, rhs);                                                          \
+    }
+
+/** Row-wise a + b, wrapping around on overflow */
+SDK_LAZY_BINARY(add, add_op, +)
+/** Row-wise a - b, wrapping around on overflow */
+SDK_LAZY_BINARY(subtract, subtract_op, -)
+/** Row-wise a * b, wrapping around on overflow */
+SDK_LAZY_BINARY(multiply, multiply_op, *)
+/** Row-wise a / b: 0 where b is 0, MIN / -1 wraps to MIN */
+SDK_LAZY_BINARY(divide, divide_op, /)
+
+#undef SDK_LAZY_BINARY
+
+/*============================================================================
+ * Evaluation
+ *===========================================================================*/
+
+namespace detail {
+
+template <node E>
+constexpr void evaluate_into(const E &e, typename E::value_type *out, std::size_t n) noexcept {
+    std::size_t i = 0;
+
+    for (; i + block_rows <= n; i += block_rows) {
+        // Row-wise: out[i + k] only depends on row i + k of the columns
+        SDK_LAZY_IVDEP
+        for (std::size_t k = 0; k < block_rows; k++) {
+            out[i + k] = e[i + k];
+        }
+    }
+    for (; i < n; i++) {
+        out[i] = e[i];
+    }
+}
+
+} // namespace detail
+
+/**
+ * Evaluate an expression into out, in one pass
+ * @param expr Expression (or a single column)
+ * @param out Output rows (std::span, std::vector, array...); every column
+ *            must have at least as many rows
+ * @note out may be one of the columns, but must not partially overlap one
+ */
+template <operand E, integer_range O>
+    requires std::same_as<std::ranges::range_reference_t<O>, detail::value_of<E> &>
+constexpr void evaluate(E &&expr, O &&out) noexcept {
+    detail::evaluate_into(detail::as_node(expr), std::ranges::data(out), std::ranges::size(out));
+}
+
+/**
+ * Evaluate an expression into a new vector
+ * @param expr Expression with at least one column
+ * @return One value per row of the shortest column
+ */
+template <operand E>
+std::vector<detail::value_of<E>> evaluate(E &&expr) {
+    const detail::node_of<E> e = detail::as_node(expr);
+    std::vector<detail::value_of<E>> out(e.size());
+    detail::evaluate_into(e, out.data(), out.size());
+    return out;
+}
+
+} // namespace lazy
+} // namespace sdk
+
+#undef SDK_LAZY_IVDEP
+
+#endif /* __CALC_LAZY_HPP__ */
@@ -0,0 +1,100 @@
+#ifndef __CALC_OPS_H__
+#define __CALC_OPS_H__
+
+#include <stddef.h>
+#include "calc-checked.h"
+
+/**
+ * Version of the sdk_calc_ops layout, checked when loading a backend
+ */
+#define SDK_CALC_OPS_ABI 1
+
+/**
+ * Symbol a backend shared object exports: a const sdk_calc_ops
+ */
+#define SDK_CALC_OPS_SYMBOL "sdk_calc_backend"
+
+/**
+ * Environment variable read on first use to pick the active backend:
+ * a built-in name ("scalar", "checked", "simd") or a shared object path
+ */
+#define SDK_CALC_OPS_ENV "SDK_CALC_BACKEND"
+
+/**
+ * Table of calc operations (a "backend")
+ *
+ * multi_calc_* call through the active table, so the implementation can
+ * be swapped at run time. Batch entries have the calc_*_batch signature.
+ */
+typedef struct sdk_calc_ops {
+    unsigned abi;                                   /* SDK_CALC_OPS_ABI */
+    const char *name;                               /* Backend name */
+    int (*add)(int a, int b);
+    int (*subtract)(int a, int b);
+    int (*multiply)(int a, int b);
+    int (*divide)(int a, int b);
+    void (*add_batch)(const int *a, const int *b, int *out, size_t n);
+    void (*subtract_batch)(const int *a, const int *b, int *out, size_t n);
+    void (*multiply_batch)(const int *a, const int *b, int *out, size_t n);
+    void (*divide_batch)(const int *a, const int *b, int *out, size_t n);
+} sdk_calc_ops;
+
+/**
+ * Built-in backends
+ *
+ * calc_ops_scalar: calc_* and per-element loops (the default; calls go
+ *                  through the calc_* symbols, so --wrap mocks still work)
+ * calc_ops_checked: calc_*_checked, errors recorded for calc_ops_take_status
+ * calc_ops_simd:   inlined calc_* bodies and the calc_*_batch SIMD kernels
+ */
+extern const sdk_calc_ops calc_ops_scalar;
+extern const sdk_calc_ops calc_ops_checked;
+extern const sdk_calc_ops calc_ops_simd;
+
+/**
+ * Get the active backend
+ * @return Active table, never NULL
+ * @note The first call selects the backend named by SDK_CALC_BACKEND, or
+ *       calc_ops_scalar if it is unset or invalid
+ */
+const sdk_calc_ops* calc_ops_get(void);
+
+/**
+ * Set the active backend
+ * @param ops Table to use (must stay valid), NULL for calc_ops_scalar
+ * @return 0 on success, -1 if the table has a different ABI version or a
+ *         NULL entry
+ */
+int calc_ops_set(const sdk_calc_ops *ops);
+
+/**
+ * Find a built-in backend by name
+ * @param name "scalar", "checked" or "simd"
+ * @return Table, or NULL if there is no such backend
+ */
+const sdk_calc_ops* calc_ops_find(const char *name);
+
+/**
+ * Load a backend from a shared object
+ * @param path Path passed to dlopen
+ * @return Table exported as SDK_CALC_OPS_SYMBOL, or NULL if the library or
+ *         symbol is missing, the ABI version does not match or an entry
+ *         is NULL
+ * @note The library is never unloaded
+ */
+const sdk_calc_ops* calc_ops_load(const char *path);
+
+/**
+ * Select the active backend by name or shared object path
+ * @param spec Built-in name, or a path (anything containing '/')
+ * @return 0 on success, -1 if the backend cannot be found or loaded
+ */
+int calc_ops_select(const char *spec);
+
+/**
+ * Get and clear the first error seen by calc_ops_checked on this thread
+ * @return CALC_OK if no operation failed since the last call
+ */
+calc_status_t calc_ops_take_status(void);
+
+#endif /* __CALC_OPS_H__ */
@@ -0,0 +1,78 @@
+#ifndef __CALC_POOL_H__
+#define __CALC_POOL_H__
+
+#include <stddef.h>
+
+/*
+ * Work-stealing thread pool shared by the SDK
+ *
+ * calc_pool_parallel_for() splits an index range in halves down to the
+ * grain size. Each worker keeps the halves it splits off in its own deque
+ * and works on the newest one; idle workers steal the oldest (largest)
+ * range from another deque. The calling thread takes part in the work,
+ * and calls may be nested inside a range function.
+ *
+ * The pool starts with 1 thread, so everything runs on the calling thread
+ * until calc_pool_set_threads() or the SDK_CALC_THREADS environment
+ * variable (read on first use) asks for more. Workers start lazily.
+ *
+ * calc_*_batch, calc_divide_batch_masked, multi_calc_expression_batch*,
+ * calc_expr_eval_batch and calc_jit_eval_batch split inputs of at least
+ * 2 * CALC_POOL_BATCH_GRAIN elements across the pool; calc_sum and
+ * calc_product split inputs of at least 2 * CALC_REDUCE_MIN_PER_THREAD.
+ */
+
+/**
+ * Largest number of threads of the pool (calling thread included)
+ */
+#define CALC_POOL_MAX_THREADS 256
+
+/**
+ * Elements per range when the SDK batch functions run on the pool
+ */
+#define CALC_POOL_BATCH_GRAIN (1u << 16)
+
+/**
+ * Environment variable read on first use for the thread count
+ * ("0" for one thread per online CPU)
+ */
+#define CALC_POOL_ENV "SDK_CALC_THREADS"
+
+/**
+ * Function run on one range of a parallel for
+ * @param ctx Context given to calc_pool_parallel_for
+ * @param begin First index of the range
+ * @param end One past the last index of the range
+ */
+typedef void (*calc_pool_fn)(void *ctx, size_t begin, size_t end);
+
+/**
+ * Set the number of threads
+ * @param threads Thread count including the calling thread; 0 for one
+ *                per online CPU, 1 to run everything on the calling thread
+ * @note Stops the current workers. Must not be called while a parallel
+ *       for is running.
+ */
+void calc_pool_set_threads(unsigned threads);
+
+/**
+ * Get the number of threads
+ * @return Value set by calc_pool_set_threads or SDK_CALC_THREADS (1 by default)
+ */
+unsigned calc_pool_threads(void);
+
+/**
+ * Run fn over [begin, end) on the pool and wait for it
+ * @param begin First index
+ * @param end One past the last index
+ * @param grain Largest range given to one call of fn (0 picks about
+ *              8 ranges per thread)
+ * @param fn Function called on disjoint ranges covering [begin, end)
+ * @param ctx Passed to fn
+ * @note Ranges run in no particular order and on any thread. With one
+ *       thread, fn is called on consecutive ranges on the calling thread.
+ */
+void calc_pool_parallel_for(size_t begin, size_t end, size_t grain,
+                            calc_pool_fn fn, void *ctx);
+
+#endif /* __CALC_POOL_H__ */
@@ -0,0 +1,54 @@
+#ifndef __CALC_REDUCE_H__
+#define __CALC_REDUCE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc-checked.h"
+
+/**
+ * Minimum number of elements per thread for the multi-threaded split
+ *
+ * Inputs are split across the calc-pool threads (calc_pool_set_threads or
+ * SDK_CALC_THREADS). Inputs shorter than twice this value are always
+ * reduced on the calling thread: handing a range to another thread costs
+ * more than summing it.
+ */
+#define CALC_REDUCE_MIN_PER_THREAD (1u << 18)
+
+/**
+ * Sum an integer array
+ * @param a Array to sum
+ * @param n Number of elements
+ * @return Sum of all elements, accumulated in 64 bits
+ * @note Exact for n <= 2^32, more than fits in memory on typical targets
+ */
+int64_t calc_sum(const int *a, size_t n);
+
+/**
+ * Multiply all elements of an integer array
+ * @param a Array to multiply
+ * @param n Number of elements
+ * @param result Receives the product, accumulated in 64 bits (wrapped
+ *               around on overflow, 1 for an empty array)
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if the product does not fit in an
+ *         int64_t
+ */
+calc_status_t calc_product(const int *a, size_t n, int64_t *result);
+
+/**
+ * Set the number of calc-pool threads
+ * @param threads Thread count; 0 or 1 disables the multi-threaded split
+ *                (the default)
+ * @deprecated Same as calc_pool_set_threads(threads ? threads : 1): the
+ *             setting is shared by every SDK function that uses the pool
+ */
+void calc_reduce_set_threads(unsigned threads);
+
+/**
+ * Get the number of calc-pool threads
+ * @return calc_pool_threads()
+ * @deprecated Use calc_pool_threads
+ */
+unsigned calc_reduce_threads(void);
+
+#endif /* __CALC_REDUCE_H__ */
@@ -0,0 +1,104 @@
+#ifndef __CALC_ROLLING_H__
+#define __CALC_ROLLING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Rolling-window statistics over a stream of samples
+ *
+ * The window holds the last `window` samples pushed (fewer until it has
+ * filled). Each push costs O(1) amortized whatever the window size: the
+ * sums are updated incrementally and min / max come from monotonic queues.
+ *
+ * Integer results truncate toward zero like calc_divide. Sums are exact
+ * (64-bit, 128-bit for squares), so for a window of 3 the mean equals
+ * multi_calc_average of the last three samples whenever their sum fits in
+ * an int (the same guarantee as multi_calc_average_n).
+ */
+
+/**
+ * Rolling window (opaque)
+ */
+typedef struct calc_rolling calc_rolling_t;
+
+/**
+ * Create a rolling window
+ * @param window Number of samples kept (1 to UINT32_MAX)
+ * @return New window, or NULL if window is out of range or out of memory
+ */
+calc_rolling_t* calc_rolling_create(size_t window);
+
+/**
+ * Destroy a rolling window
+ * @param r Window (NULL is ignored)
+ */
+void calc_rolling_destroy(calc_rolling_t *r);
+
+/**
+ * Drop every sample, keeping the window size
+ * @param r Window
+ */
+void calc_rolling_reset(calc_rolling_t *r);
+
+/**
+ * Push one sample, evicting the oldest one if the window is full
+ * @param r Window
+ * @param sample New sample
+ */
+void calc_rolling_push(calc_rolling_t *r, int sample);
+
+/**
+ * Push an array of samples
+ * @param r Window
+ * @param samples Samples, oldest first
+ * @param n Number of samples
+ * @param means If not NULL, means[i] receives calc_rolling_mean() right
+ *              after samples[i] is pushed (may alias samples)
+ */
+void calc_rolling_push_batch(calc_rolling_t *r, const int *samples, size_t n, int *means);
+
+/**
+ * Get the number of samples currently in the window
+ * @param r Window
+ * @return Samples in the window, at most the window size
+ */
+size_t calc_rolling_count(const calc_rolling_t *r);
+
+/**
+ * Get the sum of the window
+ * @param r Window
+ * @return Exact sum, 0 if the window is empty
+ */
+int64_t calc_rolling_sum(const calc_rolling_t *r);
+
+/**
+ * Get the mean of the window
+ * @param r Window
+ * @return Sum / count truncated toward zero, 0 if the window is empty
+ */
+int calc_rolling_mean(const calc_rolling_t *r);
+
+/**
+ * Get the smallest sample of the window
+ * @param r Window
+ * @return Minimum, 0 if the window is empty
+ */
+int calc_rolling_min(const calc_rolling_t *r);
+
+/**
+ * Get the largest sample of the window
+ * @param r Window
+ * @return Maximum, 0 if the window is empty
+ */
+int calc_rolling_max(const calc_rolling_t *r);
+
+/**
+ * Get the population variance of the window
+ * @param r Window
+ * @return (count * sum of squares - sum^2) / count^2, computed exactly and
+ *         truncated toward zero; 0 if the window is empty
+ */
+int64_t calc_rolling_variance(const calc_rolling_t *r);
+
+#endif /* __CALC_ROLLING_H__ */
@@ -0,0 +1,191 @@
+#ifndef __CALC_SELECT_H__
+#define __CALC_SELECT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Row selection for the batch functions
+ *
+ * Comparison kernels turn columns into selection bitmaps (bit i of byte
+ * i / 8, least significant bit first: the CALC_BITMAP_BYTES layout of
+ * calc-checked.h, which is also the Arrow validity layout). Bitmaps can be
+ * combined, or turned into selection vectors: ascending row indices.
+ *
+ * The _sel and _bitmap variants of the batch functions only compute the
+ * selected rows and write them at their own index in `out`; other rows of
+ * `out` are left untouched, so nothing is compacted or copied back. Use
+ * bitmaps when many rows are selected (whole vectors are computed and
+ * stored under a mask) and selection vectors when few are.
+ */
+
+/**
+ * Comparison of a calc_compare_* kernel
+ */
+typedef enum {
+    CALC_CMP_EQ,                /* a == b */
+    CALC_CMP_NE,                /* a != b */
+    CALC_CMP_LT,                /* a < b */
+    CALC_CMP_LE,                /* a <= b */
+    CALC_CMP_GT,                /* a > b */
+    CALC_CMP_GE,                /* a >= b */
+} calc_cmp_t;
+
+/*============================================================================
+ * Comparisons
+ *===========================================================================*/
+
+/**
+ * Compare two integer arrays element by element
+ * @param cmp Comparison
+ * @param a First operand array
+ * @param b Second operand array
+ * @param bits Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if
+ *             a[i] cmp b[i]; unused bits of the last byte are cleared
+ * @param n Number of elements
+ * @return Number of bits set (0 with every bit cleared if cmp is unknown)
+ *
+ * @note SIMD (instruction set from calc_batch_isa), 8 to 16 rows per step
+ */
+size_t calc_compare_batch(calc_cmp_t cmp, const int *a, const int *b,
+                          unsigned char *bits, size_t n);
+
+/**
+ * Compare an integer array with a value
+ * @param cmp Comparison
+ * @param a Array
+ * @param value Right-hand side of every comparison
+ * @param bits Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if a[i] cmp value
+ * @param n Number of elements
+ * @return Number of bits set (0 with every bit cleared if cmp is unknown)
+ */
+size_t calc_compare_value_batch(calc_cmp_t cmp, const int *a, int value,
+                                unsigned char *bits, size_t n);
+
+/**
+ * Intersect two bitmaps
+ * @param x First bitmap
+ * @param y Second bitmap
+ * @param out Result, out = x & y (may alias x or y)
+ * @param n Number of bits
+ * @return Number of bits set in out
+ */
+size_t calc_bitmap_and(const unsigned char *x, const unsigned char *y,
+                       unsigned char *out, size_t n);
+
+/**
+ * Unite two bitmaps
+ * @param x First bitmap
+ * @param y Second bitmap
+ * @param out Result, out = x | y (may alias x or y)
+ * @param n Number of bits
+ * @return Number of bits set in out
+ */
+size_t calc_bitmap_or(const unsigned char *x, const unsigned char *y,
+                      unsigned char *out, size_t n);
+
+/**
+ * Turn a bitmap into a selection vector
+ * @param bits Bitmap of n bits
+ * @param n Number of bits (at most UINT32_MAX + 1)
+ * @param sel Receives the indices of the set bits in ascending order; room
+ *            for as many entries as bits set (n at most)
+ * @return Number of indices written
+ */
+size_t calc_bitmap_to_selection(const unsigned char *bits, size_t n, uint32_t *sel);
+
+/*============================================================================
+ * Batch functions over selection vectors
+ *
+ * out[sel[k]] = a[sel[k]] op b[sel[k]] for k < count. Same results as
+ * calc_*_batch on those rows; other rows of out are not written.
+ *===========================================================================*/
+
+/**
+ * Add the selected elements of two integer arrays
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array (may alias a or b)
+ * @param sel Row indices (in any order, without duplicates if out aliases
+ *            an input)
+ * @param count Number of indices
+ */
+void calc_add_batch_sel(const int *a, const int *b, int *out,
+                        const uint32_t *sel, size_t count);
+
+/** Subtract the selected elements (see calc_add_batch_sel) */
+void calc_subtract_batch_sel(const int *a, const int *b, int *out,
+                             const uint32_t *sel, size_t count);
+
+/** Multiply the selected elements (see calc_add_batch_sel) */
+void calc_multiply_batch_sel(const int *a, const int *b, int *out,
+                             const uint32_t *sel, size_t count);
+
+/** Divide the selected elements, 0 for zero divisors (see calc_add_batch_sel) */
+void calc_divide_batch_sel(const int *a, const int *b, int *out,
+                           const uint32_t *sel, size_t count);
+
+/**
+ * Calculate (a + b) * (c - d) for the selected rows
+ * @param a First operand column
+ * @param b Second operand column
+ * @param c Third operand column
+ * @param d Fourth operand column
+ * @param out Result column (may alias any input)
+ * @param sel Row indices
+ * @param count Number of indices
+ */
+void multi_calc_expression_batch_sel(const int *a, const int *b, const int *c,
+                                     const int *d, int *out,
+                                     const uint32_t *sel, size_t count);
+
+/*============================================================================
+ * Batch functions over bitmaps
+ *
+ * Rows whose bit is set in `bits` (CALC_BITMAP_BYTES(n) bytes) get the
+ * calc_*_batch result; other rows of out are not written. Groups of rows
+ * with no bit set are skipped, and full groups are stored as vectors.
+ *===========================================================================*/
+
+/**
+ * Add the selected elements of two integer arrays
+ * @param a First operand array
+ * @param b Second operand array
+ * @param out Result array (may alias a or b)
+ * @param bits Selection bitmap
+ * @param n Number of elements
+ */
+void calc_add_batch_bitmap(const int *a, const int *b, int *out,
+                           const unsigned char *bits, size_t n);
+
+/** Subtract the selected elements (see calc_add_batch_bitmap) */
+void calc_subtract_batch_bitmap(const int *a, const int *b, int *out,
+                                const unsigned char *bits, size_t n);
+
+/** Multiply the selected elements (see calc_add_batch_bitmap) */
+void calc_multiply_batch_bitmap(const int *a, const int *b, int *out,
+                                const unsigned char *bits, size_t n);
+
+/**
+ * Divide the selected elements, 0 for zero divisors (see
+ * calc_add_batch_bitmap)
+ * @note Scalar: only the selected rows are divided
+ */
+void calc_divide_batch_bitmap(const int *a, const int *b, int *out,
+                              const unsigned char *bits, size_t n);
+
+/**
+ * Calculate (a + b) * (c - d) for the rows selected by a bitmap
+ * @param a First operand column
+ * @param b Second operand column
+ * @param c Third operand column
+ * @param d Fourth operand column
+ * @param out Result column (may alias any input)
+ * @param bits Selection bitmap
+ * @param n Number of rows
+ */
+void multi_calc_expression_batch_bitmap(const int *a, const int *b, const int *c,
+                                        const int *d, int *out,
+                                        const unsigned char *bits, size_t n);
+
+#endif /* __CALC_SELECT_H__ */
@@ -0,0 +1,82 @@
+#ifndef __CALC_H__
+#define __CALC_H__
+
+/**
+ * Add two integers
+ * @param a First operand
+ * @param b Second operand
+ * @return Sum of a and b
+ */
+int calc_add(int a, int b);
+
+/**
+ * Subtract two integers
+ * @param a First operand
+ * @param b Second operand
+ * @return Difference of a and b (a - b)
+ */
+int calc_subtract(int a, int b);
+
+/**
+ * Multiply two integers
+ * @param a First operand
+ * @param b Second operand
+ * @return Product of a and b
+ */
+int calc_multiply(int a, int b);
+
+/**
+ * Divide two integers
+ * @param a Dividend
+ * @param b Divisor (should not be zero)
+ * @return Quotient of a and b (a / b)
+ * @note Returns 0 if divisor is 0
+ */
+int calc_divide(int a, int b);
+
+/*
+ * Inline implementations
+ *
+ * These are the bodies of the functions above; calc.c exports them as
+ * real symbols. Define CALC_INLINE (-DCALC_INLINE) to make calls such as
+ * calc_add(a, b) expand to the inline version instead of a call into
+ * libsdk. Only calls are replaced: taking the address (calc_add) or
+ * writing (calc_add)(a, b) still uses the exported function.
+ *
+ * Code built with CALC_INLINE no longer calls calc_*, so -Wl,--wrap=calc_*
+ * cannot intercept it. Build the SDK for unit tests without CALC_INLINE.
+ */
+#if defined(__GNUC__)
+#define CALC_ALWAYS_INLINE static inline __attribute__((always_inline))
+#else
+#define CALC_ALWAYS_INLINE static inline
+#endif
+
+CALC_ALWAYS_INLINE int calc_add_inline(int a, int b) {
+    return a + b;
+}
+
+CALC_ALWAYS_INLINE int calc_subtract_inline(int a, int b) {
+    return a - b;
+}
+
+CALC_ALWAYS_INLINE int calc_multiply_inline(int a, int b) {
+    return a * b;
+}
+
+CALC_ALWAYS_INLINE int calc_divide_inline(int a, int b) {
+    // Handle division by zero
+    if (b == 0) {
+        return 0;
+    }
+    return a / b;
+}
+
+#if defined(CALC_INLINE) && !defined(CALC_IMPLEMENTATION)
+#define calc_add(a, b) calc_add_inline((a), (b))
+#define calc_subtract(a, b) calc_subtract_inline((a), (b))
+#define calc_multiply(a, b) calc_multiply_inline((a), (b))
+#define calc_divide(a, b) calc_divide_inline((a), (b))
+#endif
+
+#endif /* __CALC_H__ */
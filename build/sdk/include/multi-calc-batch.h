@@ -0,0 +1,45 @@
+#ifndef __MULTI_CALC_BATCH_H__
+#define __MULTI_CALC_BATCH_H__
+
+#include <stddef.h>
+
+/**
+ * One multi_calc_expression input, for array-of-structs data
+ */
+typedef struct {
+    int a;
+    int b;
+    int c;
+    int d;
+} multi_calc_tuple_t;
+
+/**
+ * Calculate (a + b) * (c - d) for columns of operands
+ * @param a First operand column
+ * @param b Second operand column
+ * @param c Third operand column
+ * @param d Fourth operand column
+ * @param out Result column, out[i] = (a[i] + b[i]) * (c[i] - d[i])
+ *            (may alias any input)
+ * @param n Number of tuples
+ *
+ * @note One fused SIMD pass (instruction set from calc_batch_isa), no
+ *       intermediate arrays. Overflow wraps around like calc_add etc.
+ * @note Does not go through the calc_ops backend
+ */
+void multi_calc_expression_batch(const int *a, const int *b, const int *c,
+                                 const int *d, int *out, size_t n);
+
+/**
+ * Calculate (a + b) * (c - d) for an array of tuples
+ * @param tuples Input tuples
+ * @param out Result array, out[i] = multi_calc_expression of tuples[i]
+ * @param n Number of tuples
+ *
+ * @note Tuples are transposed into columns in registers (a 4x4 transpose
+ *       within each 128-bit lane, the same for SSE2, AVX2 and AVX-512),
+ *       then use the same kernel as multi_calc_expression_batch
+ */
+void multi_calc_expression_batch_aos(const multi_calc_tuple_t *tuples, int *out, size_t n);
+
+#endif /* __MULTI_CALC_BATCH_H__ */
@@ -0,0 +1,43 @@
+#ifndef __MULTI_CALC_H__
+#define __MULTI_CALC_H__
+
+#include <stddef.h>
+
+/**
+ * Calculate expression: (a + b) * (c - d)
+ * @param a First operand
+ * @param b Second operand
+ * @param c Third operand
+ * @param d Fourth operand
+ * @return Result of (a + b) * (c - d)
+ *
+ * @note This function depends on calc_add, calc_subtract, calc_multiply,
+ *       or the same entries of the active calc_ops backend
+ */
+int multi_calc_expression(int a, int b, int c, int d);
+
+/**
+ * Calculate average of three integers
+ * @param a First number
+ * @param b Second number
+ * @param c Third number
+ * @return Average of a, b, c (integer division)
+ *
+ * @note This function depends on calc_add, calc_divide, or the same
+ *       entries of the active calc_ops backend
+ */
+int multi_calc_average(int a, int b, int c);
+
+/**
+ * Calculate average of an integer array
+ * @param values Array of numbers
+ * @param n Number of elements
+ * @return Average of the elements (integer division, truncated toward
+ *         zero like multi_calc_average), 0 if n is 0
+ *
+ * @note The sum is accumulated in 64 bits (calc_sum), so unlike
+ *       multi_calc_average it cannot overflow
+ */
+int multi_calc_average_n(const int *values, size_t n);
+
+#endif /* __MULTI_CALC_H__ */
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef __MULTI_CALC_HPP__
+#define __MULTI_CALC_HPP__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc.hpp"
+
+/*
+ * Header-only C++ facade over multi-calc.h
+ *
+ * Same formulas as the C functions, built on the sdk::calc templates
+ * (see calc.hpp for the overflow and division rules). The C functions use
+ * the active calc_ops backend; these always use the default semantics.
+ */
+
+namespace sdk {
+namespace multi_calc {
+namespace detail {
+
+/* Split in halves so the recursion depth is log2(n) in constant expressions */
+constexpr int64_t sum(const int *values, size_t n) {
+    return n == 0 ? 0
+         : n == 1 ? values[0]
+         : sum(values, n / 2) + sum(values + n / 2, n - n / 2);
+}
+
+} // namespace detail
+
+/**
+ * Calculate expression: (a + b) * (c - d)
+ * @param a First operand
+ * @param b Second operand
+ * @param c Third operand
+ * @param d Fourth operand
+ * @return Result of (a + b) * (c - d), wrapping around on overflow
+ */
+template <typename T>
+constexpr T expression(T a, T b, T c, T d) {
+    return calc::multiply(calc::add(a, b), calc::subtract(c, d));
+}
+
+/**
+ * Calculate average of three integers
+ * @param a First number
+ * @param b Second number
+ * @param c Third number
+ * @return (a + b + c) / 3, the sum wrapping around on overflow
+ */
+template <typename T>
+constexpr T average(T a, T b, T c) {
+    return calc::divide(calc::add(calc::add(a, b), c), T(3));
+}
+
+/**
+ * Calculate average of an integer array
+ * @param values Array of numbers
+ * @param n Number of elements
+ * @return Average of the elements (truncated toward zero), 0 if n is 0
+ *
+ * @note Like multi_calc_average_n, the sum is 64-bit and cannot overflow
+ */
+constexpr int average_n(const int *values, size_t n) {
+    return n == 0 ? 0 : static_cast<int>(detail::sum(values, n) / static_cast<int64_t>(n));
+}
+
+template <size_t N>
+constexpr int average_n(const int (&values)[N]) {
+    return average_n(values, N);
+}
+
+} // namespace multi_calc
+} // namespace sdk
+
+#endif /* __MULTI_CALC_HPP__ */
@@ -0,0 +1,132 @@
+#ifndef __CALC_ARROW_H__
+#define __CALC_ARROW_H__
+
+#include <stdint.h>
+
+/*
+ * Batch calc on Apache Arrow int32 columns
+ *
+ * Inputs and outputs use the Arrow C Data Interface, so columns coming
+ * from any Arrow implementation are read in place: the data buffers go
+ * straight to the batch kernels, without copying them into int arrays and
+ * without linking an Arrow library.
+ *
+ * A result row is null when a row of any input is null. With
+ * CALC_ARROW_NULL_ON_ERROR, rows that overflow or divide by zero become
+ * nulls as well. Values under null rows are unspecified, as in Arrow.
+ */
+
+/*============================================================================
+ * Arrow C Data Interface (https://arrow.apache.org/docs/format/CDataInterface.html)
+ *
+ * Defined here unless an Arrow header already did, as the specification
+ * asks.
+ *===========================================================================*/
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+/**
+ * Option: rows that overflow, divide by zero or compute INT_MIN / -1 are
+ * null in the result (otherwise they hold the calc_*_batch value)
+ */
+#define CALC_ARROW_NULL_ON_ERROR (1u << 0)
+
+/**
+ * Operation of calc_arrow_batch
+ */
+typedef enum {
+    CALC_ARROW_ADD,             /* calc_add_batch */
+    CALC_ARROW_SUBTRACT,        /* calc_subtract_batch */
+    CALC_ARROW_MULTIPLY,        /* calc_multiply_batch */
+    CALC_ARROW_DIVIDE,          /* calc_divide_batch */
+} calc_arrow_op_t;
+
+/**
+ * Check that a schema describes a column calc_arrow_* accepts
+ * @param schema Schema of the column
+ * @return 0 if it is a plain int32 column (format "i"), -1 otherwise
+ */
+int calc_arrow_check_schema(const struct ArrowSchema *schema);
+
+/**
+ * Export the schema of result columns (nullable int32)
+ * @param name Column name, copied (NULL for none)
+ * @param out Receives the schema; the caller calls out->release
+ * @return 0 on success, -1 if out of memory
+ */
+int calc_arrow_export_schema(const char *name, struct ArrowSchema *out);
+
+/**
+ * Apply a calc operation to two int32 columns
+ * @param op Operation
+ * @param a First operand column
+ * @param b Second operand column, as long as a
+ * @param flags 0 or CALC_ARROW_NULL_ON_ERROR
+ * @param out Receives the result column (offset 0, 64-byte aligned
+ *            buffers); the caller calls out->release
+ * @return 0 on success, -1 if an input is not a live int32 array (see
+ *         calc_arrow_check_schema), the lengths differ, op is unknown or
+ *         out of memory; out is left untouched on failure
+ * @note Without CALC_ARROW_NULL_ON_ERROR, large columns are split across
+ *       the calc-pool like calc_*_batch
+ */
+int calc_arrow_batch(calc_arrow_op_t op, const struct ArrowArray *a,
+                     const struct ArrowArray *b, unsigned flags, struct ArrowArray *out);
+
+/**
+ * Calculate (a + b) * (c - d) over four int32 columns
+ * @param a First operand column
+ * @param b Second operand column
+ * @param c Third operand column
+ * @param d Fourth operand column
+ * @param flags 0 or CALC_ARROW_NULL_ON_ERROR (any step overflowing
+ *              makes the row null)
+ * @param out Receives the result column; the caller calls out->release
+ * @return 0 on success, -1 on invalid input or out of memory (see
+ *         calc_arrow_batch)
+ */
+int calc_arrow_expression_batch(const struct ArrowArray *a, const struct ArrowArray *b,
+                                const struct ArrowArray *c, const struct ArrowArray *d,
+                                unsigned flags, struct ArrowArray *out);
+
+#endif /* __CALC_ARROW_H__ */
@@ -0,0 +1,150 @@
+#ifndef __CALC_ASYNC_H__
+#define __CALC_ASYNC_H__
+
+#include <stddef.h>
+
+/*
+ * Asynchronous SDK jobs
+ *
+ * A calc_async_t executor owns worker threads fed by a bounded lock-free
+ * queue. Submitting a job returns a handle at once; the job runs on a
+ * worker and the handle can be polled, waited on or given a completion
+ * callback. When the queue is full, calc_async_submit() blocks until a
+ * worker frees a slot and calc_async_try_submit() fails instead, so a
+ * caller is never left with an unbounded backlog.
+ *
+ * Buffers named in a job must stay valid until the job is done.
+ */
+
+/**
+ * Size of each greeting written by CALC_JOB_HELLO / CALC_JOB_GOODBYE
+ * when text_size is 0 (same as the say_hello buffer)
+ */
+#define CALC_JOB_TEXT_LEN 256
+
+/**
+ * Work done by a job
+ */
+typedef enum {
+    CALC_JOB_ADD,               /* calc_add_batch(a, b, out, n) */
+    CALC_JOB_SUBTRACT,          /* calc_subtract_batch(a, b, out, n) */
+    CALC_JOB_MULTIPLY,          /* calc_multiply_batch(a, b, out, n) */
+    CALC_JOB_DIVIDE,            /* calc_divide_batch(a, b, out, n) */
+    CALC_JOB_EXPRESSION,        /* multi_calc_expression_batch(a, b, c, d, out, n) */
+    CALC_JOB_HELLO,             /* say_hello(names[i]) into text, n names */
+    CALC_JOB_GOODBYE,           /* say_goodbye(names[i]) into text, n names */
+    CALC_JOB_CUSTOM,            /* fn(arg) */
+} calc_job_kind_t;
+
+/**
+ * Job description, copied at submission. Fields not used by the kind
+ * are ignored.
+ */
+typedef struct {
+    calc_job_kind_t kind;
+    const int *a;
+    const int *b;
+    const int *c;
+    const int *d;
+    int *out;
+    size_t n;                   /* Elements, or names for greetings */
+    const char *const *names;
+    char *text;                 /* Greeting i at text + i * text_size */
+    size_t text_size;           /* 0 for CALC_JOB_TEXT_LEN */
+    void (*fn)(void *arg);
+    void *arg;
+} calc_job_desc_t;
+
+/**
+ * State of a job
+ */
+typedef enum {
+    CALC_JOB_QUEUED,
+    CALC_JOB_RUNNING,
+    CALC_JOB_DONE,
+} calc_job_state_t;
+
+typedef struct calc_async calc_async_t;
+typedef struct calc_job calc_job_t;
+
+/**
+ * Completion callback
+ * @param job The finished job (valid during the call even if released)
+ * @param arg Argument given to calc_job_then
+ */
+typedef void (*calc_job_callback)(calc_job_t *job, void *arg);
+
+/**
+ * Create an executor
+ * @param workers Worker threads; 0 for one per online CPU
+ * @param capacity Queued jobs before submission blocks (rounded up to a
+ *                 power of 2, at least 2)
+ * @return Executor, or NULL if out of memory or no worker could start
+ */
+calc_async_t* calc_async_create(unsigned workers, size_t capacity);
+
+/**
+ * Run every queued job, stop the workers and free the executor
+ * @param async Executor (NULL is ignored)
+ * @note Job handles stay valid until released.
+ */
+void calc_async_destroy(calc_async_t *async);
+
+/**
+ * Submit a job, waiting while the queue is full
+ * @param async Executor
+ * @param desc Job description
+ * @return Job handle to release with calc_job_release, or NULL if the
+ *         kind is unknown or out of memory
+ */
+calc_job_t* calc_async_submit(calc_async_t *async, const calc_job_desc_t *desc);
+
+/**
+ * Submit a job unless the queue is full
+ * @param async Executor
+ * @param desc Job description
+ * @return Job handle, or NULL if the queue is full, the kind is unknown
+ *         or out of memory
+ */
+calc_job_t* calc_async_try_submit(calc_async_t *async, const calc_job_desc_t *desc);
+
+/**
+ * Run a job description on the calling thread, without an executor
+ * @param desc Job description (kind must be valid)
+ * @note For callers that prefer doing the work themselves to waiting on
+ *       a full queue (see calc_async_try_submit)
+ */
+void calc_job_run(const calc_job_desc_t *desc);
+
+/**
+ * Get the state of a job without blocking
+ * @param job Job handle
+ * @return CALC_JOB_QUEUED, CALC_JOB_RUNNING or CALC_JOB_DONE
+ */
+calc_job_state_t calc_job_poll(const calc_job_t *job);
+
+/**
+ * Wait until a job is done
+ * @param job Job handle
+ */
+void calc_job_wait(calc_job_t *job);
+
+/**
+ * Call a function once the job is done
+ * @param job Job handle
+ * @param cb Callback, run on the worker thread, or at once on the calling
+ *           thread if the job is already done
+ * @param arg Passed to cb
+ * @return 0 on success, -1 if the job already has a callback
+ */
+int calc_job_then(calc_job_t *job, calc_job_callback cb, void *arg);
+
+/**
+ * Release a job handle
+ * @param job Job handle (NULL is ignored)
+ * @note A job released before it is done still runs, and its callback
+ *       still fires.
+ */
+void calc_job_release(calc_job_t *job);
+
+#endif /* __CALC_ASYNC_H__ */
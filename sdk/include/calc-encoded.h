@@ -0,0 +1,161 @@
+#ifndef __CALC_ENCODED_H__
+#define __CALC_ENCODED_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Batch calc on run-length and dictionary encoded columns
+ *
+ * A column is plain (one value per row), run-length encoded (one value
+ * per run of equal rows, with the row where each run ends, as in Arrow's
+ * run-end encoding) or dictionary encoded (one index per row into a
+ * table of distinct values). Operands may mix encodings.
+ *
+ * Work follows the encoded size: where every operand is inside a run,
+ * the operation is computed once for the whole run; dictionary operands
+ * sharing their indices are combined entry by entry. Other rows go
+ * through the calc_*_batch kernels a chunk at a time. Results are those
+ * of calc_*_batch on the decoded columns.
+ */
+
+/**
+ * Encoding of a column
+ */
+typedef enum {
+    CALC_COLUMN_PLAIN,          /* values[i] is row i */
+    CALC_COLUMN_RLE,            /* values[r] fills rows [run_ends[r - 1], run_ends[r]) */
+    CALC_COLUMN_DICT,           /* values[indices[i]] is row i */
+} calc_encoding_t;
+
+/**
+ * Column description (the column does not own its arrays)
+ */
+typedef struct {
+    calc_encoding_t encoding;
+    size_t length;              /* Rows (at most UINT32_MAX) */
+    const int *values;          /* Rows, run values or dictionary */
+    size_t count;               /* RLE: runs; DICT: dictionary entries */
+    const uint32_t *run_ends;   /* RLE: exclusive end row of each run, ascending,
+                                   the last one equal to length */
+    const uint32_t *indices;    /* DICT: entry of each row (each below count) */
+} calc_column_t;
+
+/**
+ * Run-length encoded output
+ */
+typedef struct {
+    int *values;
+    uint32_t *run_ends;
+    size_t capacity;            /* Room in values and run_ends */
+    size_t runs;                /* Set on success */
+} calc_rle_buffer_t;
+
+/**
+ * Operation of calc_encoded_batch*
+ */
+typedef enum {
+    CALC_ENCODED_ADD,           /* calc_add_batch */
+    CALC_ENCODED_SUBTRACT,      /* calc_subtract_batch */
+    CALC_ENCODED_MULTIPLY,      /* calc_multiply_batch */
+    CALC_ENCODED_DIVIDE,        /* calc_divide_batch */
+} calc_encoded_op_t;
+
+/*============================================================================
+ * Encoding helpers
+ *===========================================================================*/
+
+/**
+ * Run-length encode an integer array
+ * @param in Rows
+ * @param n Number of rows (at most UINT32_MAX)
+ * @param out Receives the runs; capacity n is always enough
+ * @return 0 on success, -1 if n is too large or out is too small
+ */
+int calc_rle_encode(const int *in, size_t n, calc_rle_buffer_t *out);
+
+/**
+ * Decode a column into plain rows
+ * @param col Column
+ * @param out Receives col->length rows
+ * @return 0 on success, -1 if the column is malformed
+ */
+int calc_column_decode(const calc_column_t *col, int *out);
+
+/*============================================================================
+ * Computing on encoded columns
+ *
+ * Columns must have the same length. Malformed columns (unknown encoding,
+ * run ends not ascending or not ending at length) are rejected before
+ * anything is written. Dictionary indices are trusted.
+ *===========================================================================*/
+
+/**
+ * Apply a calc operation to two columns, into plain rows
+ * @param op Operation
+ * @param a First operand column
+ * @param b Second operand column
+ * @param out Receives a->length rows
+ * @return 0 on success, -1 on malformed columns, different lengths or an
+ *         unknown op
+ */
+int calc_encoded_batch(calc_encoded_op_t op, const calc_column_t *a,
+                       const calc_column_t *b, int *out);
+
+/**
+ * Apply a calc operation to two columns, into runs
+ * @param op Operation
+ * @param a First operand column
+ * @param b Second operand column
+ * @param out Receives the runs; equal neighbouring results share a run.
+ *            a->count + b->count runs are always enough for two RLE
+ *            columns, the number of rows otherwise.
+ * @return 0 on success, -1 on invalid input (see calc_encoded_batch) or
+ *         if out is too small (its contents are then unspecified)
+ */
+int calc_encoded_batch_rle(calc_encoded_op_t op, const calc_column_t *a,
+                           const calc_column_t *b, calc_rle_buffer_t *out);
+
+/**
+ * Apply a calc operation to dictionary entries
+ * @param op Operation
+ * @param a First operand column
+ * @param b Second operand column
+ * @param dict Receives one result per dictionary entry (the smaller count
+ *             if both columns are dictionaries); the result column is the
+ *             dictionary operand's indices over dict
+ * @return 0 on success, -1 unless both columns are dictionary encoded
+ *         with the same indices array, or one is and the other holds a
+ *         single run
+ */
+int calc_encoded_batch_dict(calc_encoded_op_t op, const calc_column_t *a,
+                            const calc_column_t *b, int *dict);
+
+/**
+ * Calculate (a + b) * (c - d) over four columns, into plain rows
+ * @param a First operand column
+ * @param b Second operand column
+ * @param c Third operand column
+ * @param d Fourth operand column
+ * @param out Receives a->length rows
+ * @return 0 on success, -1 on malformed columns or different lengths
+ */
+int multi_calc_expression_encoded(const calc_column_t *a, const calc_column_t *b,
+                                  const calc_column_t *c, const calc_column_t *d,
+                                  int *out);
+
+/**
+ * Calculate (a + b) * (c - d) over four columns, into runs
+ * @param a First operand column
+ * @param b Second operand column
+ * @param c Third operand column
+ * @param d Fourth operand column
+ * @param out Receives the runs (the sum of the operand run counts is
+ *            always enough when all are RLE)
+ * @return 0 on success, -1 on invalid input or if out is too small
+ */
+int multi_calc_expression_encoded_rle(const calc_column_t *a, const calc_column_t *b,
+                                      const calc_column_t *c, const calc_column_t *d,
+                                      calc_rle_buffer_t *out);
+
+#endif /* __CALC_ENCODED_H__ */
@@ -0,0 +1,120 @@
+#ifndef __CALC_GROUP_H__
+#define __CALC_GROUP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Hash group-by aggregation
+ *
+ * Rows are (key, value) pairs; the aggregator keeps the count, sum, min
+ * and max of the values of every distinct key, so per-key averages need
+ * neither sorting nor one multi_calc_average_n call per group.
+ *
+ * Keys live in open-addressing hash tables with linear probing: a byte of
+ * hash bits per slot is probed first, keys and aggregates sit in separate
+ * arrays, so a lookup touches one or two cache lines.
+ *
+ * An aggregator can split its keys into partitions by hash, each a table
+ * of its own. Large batches are then scattered by partition, and the
+ * partitions are aggregated on the calc-pool threads, each by one thread
+ * without locks. Meant for high-cardinality keys, where one shared table
+ * would not stay in cache.
+ */
+
+/**
+ * Largest number of partitions
+ */
+#define CALC_GROUP_MAX_PARTITIONS 64
+
+/**
+ * Minimum batch size for the partitioned mode
+ *
+ * Shorter batches are aggregated on the calling thread, row by row.
+ */
+#define CALC_GROUP_PARTITION_MIN (1u << 16)
+
+/**
+ * Aggregator (opaque)
+ */
+typedef struct calc_group calc_group_t;
+
+/**
+ * Aggregates of one key
+ */
+typedef struct {
+    int key;
+    int min;
+    int max;
+    int average;                /* sum / count, truncated toward zero like
+                                   calc_divide (always fits: min <= average <= max) */
+    int64_t sum;
+    int64_t count;
+} calc_group_result_t;
+
+/**
+ * Create an aggregator
+ * @param expected_keys Distinct keys expected (tables grow past it, this
+ *                      only avoids rehashing)
+ * @param partitions Number of partitions (at most CALC_GROUP_MAX_PARTITIONS),
+ *                   typically calc_pool_threads(); 0 or 1 keeps a single
+ *                   table aggregated on the calling thread
+ * @return Aggregator, or NULL if out of memory or too many partitions
+ */
+calc_group_t* calc_group_create(size_t expected_keys, unsigned partitions);
+
+/**
+ * Destroy an aggregator
+ * @param group Aggregator (NULL is ignored)
+ */
+void calc_group_destroy(calc_group_t *group);
+
+/**
+ * Aggregate a batch of rows
+ * @param group Aggregator
+ * @param keys Key of every row
+ * @param values Value of every row
+ * @param n Number of rows
+ * @return 0 on success, -1 if a table could not grow (the rows before the
+ *         failing one of its partition are aggregated)
+ *
+ * @note Batches accumulate: calling this twice is the same as calling it
+ *       once on the concatenated rows
+ * @note Not thread-safe for the same aggregator. Batches of at least
+ *       CALC_GROUP_PARTITION_MIN rows into a partitioned aggregator run on
+ *       the calc-pool (calc_pool_parallel_for) and need n * 8 bytes of
+ *       scratch memory; without it they are aggregated row by row.
+ */
+int calc_group_add_batch(calc_group_t *group, const int *keys, const int *values, size_t n);
+
+/**
+ * Number of distinct keys aggregated
+ * @param group Aggregator
+ * @return Number of keys
+ */
+size_t calc_group_size(const calc_group_t *group);
+
+/**
+ * Look up the aggregates of a key
+ * @param group Aggregator
+ * @param key Key
+ * @param result Receives the aggregates
+ * @return 0 on success, -1 if no row had this key
+ */
+int calc_group_find(const calc_group_t *group, int key, calc_group_result_t *result);
+
+/**
+ * Read all aggregates
+ * @param group Aggregator
+ * @param out Receives calc_group_size entries, in no particular order
+ * @return Number of entries written
+ */
+size_t calc_group_results(const calc_group_t *group, calc_group_result_t *out);
+
+/**
+ * Forget every key, keeping the allocated tables
+ * @param group Aggregator
+ */
+void calc_group_clear(calc_group_t *group);
+
+#endif /* __CALC_GROUP_H__ */
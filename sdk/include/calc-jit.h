@@ -0,0 +1,63 @@
+#ifndef __CALC_JIT_H__
+#define __CALC_JIT_H__
+
+#include <stddef.h>
+
+/*
+ * Native code for calc-expr expressions
+ *
+ * Expressions take the calc-expr grammar and semantics (see calc-expr.h).
+ * On x86-64 with AVX2 selected by calc_batch_isa(), the bytecode is
+ * translated to a loop of AVX2 instructions, 8 rows per iteration, placed
+ * in mmap'd executable pages. Division keeps calc_divide_batch semantics:
+ * a zero divisor gives 0 and INT_MIN / -1 gives INT_MIN.
+ *
+ * When native code cannot be generated (other CPUs, a lower instruction set
+ * selected, more than 11 temporary registers, executable memory refused),
+ * the expression still compiles and runs on the calc-expr interpreter.
+ */
+
+/**
+ * Expression compiled to native code (opaque)
+ */
+typedef struct calc_jit calc_jit_t;
+
+/**
+ * Compile an expression
+ * @param source Expression text
+ * @param names Variable names; variable i is column i at evaluation
+ * @param n_vars Number of variables (at most CALC_EXPR_MAX_VARS)
+ * @param error_pos If not NULL, set to the offset in source where
+ *                  compilation failed
+ * @return Compiled expression, or NULL on the errors of calc_expr_compile
+ * @note The instruction set is sampled once, here
+ */
+calc_jit_t* calc_jit_compile(const char *source, const char *const *names,
+                             size_t n_vars, size_t *error_pos);
+
+/**
+ * Check whether an expression runs as native code
+ * @param jit Compiled expression
+ * @return 1 for native code, 0 when it falls back to the interpreter
+ */
+int calc_jit_is_native(const calc_jit_t *jit);
+
+/**
+ * Evaluate an expression over columns of variable values
+ * @param jit Compiled expression
+ * @param columns columns[i] holds n values of variable i
+ * @param out Result array (may alias a column)
+ * @param n Number of rows
+ * @return 0 on success, -1 if the interpreter could not allocate scratch
+ *         memory
+ */
+int calc_jit_eval_batch(const calc_jit_t *jit, const int *const *columns,
+                        int *out, size_t n);
+
+/**
+ * Free a compiled expression and its code pages
+ * @param jit Compiled expression (NULL is ignored)
+ */
+void calc_jit_free(calc_jit_t *jit);
+
+#endif /* __CALC_JIT_H__ */
@@ -0,0 +1,85 @@
+#ifndef __CALC_LINALG_H__
+#define __CALC_LINALG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc-checked.h"
+
+/*
+ * Integer vector and matrix kernels
+ *
+ * Products of two ints are formed exactly in 64 bits and accumulated
+ * without losing precision, so every result is the exact mathematical
+ * value; CALC_ERR_OVERFLOW only means that value does not fit in the
+ * int64_t it is stored in (its low 64 bits are stored then, like
+ * calc_product). Matrices are row-major and dense.
+ *
+ * Kernels follow calc_batch_isa(): AVX2 and AVX-512 use 32x32->64-bit
+ * vector multiplies, the scalar and SSE2 levels (SSE2 has no signed
+ * 32-bit multiply) use the portable loops.
+ */
+
+/*============================================================================
+ * Vector kernels
+ *===========================================================================*/
+
+/**
+ * Dot product of two integer arrays
+ * @param a First array
+ * @param b Second array
+ * @param n Number of elements
+ * @param result Receives sum of a[i] * b[i] (0 for n == 0)
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if the sum does not fit in an
+ *         int64_t
+ */
+calc_status_t calc_dot(const int *a, const int *b, size_t n, int64_t *result);
+
+/**
+ * Add a scaled integer array to a 64-bit array
+ * @param alpha Scale factor
+ * @param x Array to scale
+ * @param y Accumulator array, y[i] += alpha * x[i] (wrapped around on
+ *          overflow)
+ * @param n Number of elements
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if some y[i] overflowed
+ */
+calc_status_t calc_axpy(int alpha, const int *x, int64_t *y, size_t n);
+
+/*============================================================================
+ * Matrix kernels
+ *===========================================================================*/
+
+/**
+ * Matrix-vector product
+ * @param a Matrix of rows x cols ints
+ * @param x Vector of cols ints
+ * @param y Receives rows results, y[i] = dot(row i of a, x)
+ * @param rows Number of rows
+ * @param cols Number of columns
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if some y[i] does not fit in an
+ *         int64_t
+ * @note Rows are processed four at a time so each x element loaded feeds
+ *       four rows
+ */
+calc_status_t calc_gemv(const int *a, const int *x, int64_t *y, size_t rows, size_t cols);
+
+/**
+ * Matrix-matrix product
+ * @param a Left matrix of m x k ints
+ * @param b Right matrix of k x n ints
+ * @param c Receives the m x n product (must not overlap a or b)
+ * @param m Rows of a and c
+ * @param k Columns of a, rows of b
+ * @param n Columns of b and c
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if some element of c does not
+ *         fit in an int64_t
+ * @note When k * max|a| * max|b| fits in an int64_t (checked with one
+ *       pass over a and b) no partial sum can overflow and the blocked
+ *       SIMD kernel accumulates in 64 bits; otherwise a slower scalar
+ *       loop accumulates in 128 bits. Sized for matrices up to a few
+ *       hundred rows and columns: b is blocked for the cache but not
+ *       packed.
+ */
+calc_status_t calc_gemm(const int *a, const int *b, int64_t *c, size_t m, size_t k, size_t n);
+
+#endif /* __CALC_LINALG_H__ */
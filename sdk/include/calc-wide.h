@@ -0,0 +1,91 @@
+#ifndef __CALC_WIDE_H__
+#define __CALC_WIDE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc-checked.h"
+
+/*
+ * 64-bit and saturating variants of the calc functions
+ *
+ * Every function comes in a scalar and a batch form with the same
+ * semantics as calc.h / calc-batch.h:
+ *   _i64      int64_t operands, overflow wraps around
+ *   _sat      int operands, overflow clamps to INT_MIN / INT_MAX
+ *   _sat_i64  int64_t operands, overflow clamps to INT64_MIN / INT64_MAX
+ *
+ * Division by zero returns 0. MIN / -1 wraps to MIN for _i64 and clamps
+ * to MAX for the saturating variants. Batch outputs may alias the inputs.
+ */
+
+/**
+ * 128-bit signed integer, value = hi * 2^64 + lo
+ */
+typedef struct {
+    int64_t hi;         /* High 64 bits (carries the sign) */
+    uint64_t lo;        /* Low 64 bits */
+} calc_i128_t;
+
+/*============================================================================
+ * 64-bit, wrap around on overflow
+ *===========================================================================*/
+
+int64_t calc_add_i64(int64_t a, int64_t b);
+int64_t calc_subtract_i64(int64_t a, int64_t b);
+int64_t calc_multiply_i64(int64_t a, int64_t b);
+int64_t calc_divide_i64(int64_t a, int64_t b);
+
+void calc_add_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+void calc_subtract_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+void calc_multiply_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+void calc_divide_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+
+/*============================================================================
+ * 32-bit, saturate on overflow
+ *===========================================================================*/
+
+int calc_add_sat(int a, int b);
+int calc_subtract_sat(int a, int b);
+int calc_multiply_sat(int a, int b);
+int calc_divide_sat(int a, int b);
+
+void calc_add_sat_batch(const int *a, const int *b, int *out, size_t n);
+void calc_subtract_sat_batch(const int *a, const int *b, int *out, size_t n);
+void calc_multiply_sat_batch(const int *a, const int *b, int *out, size_t n);
+void calc_divide_sat_batch(const int *a, const int *b, int *out, size_t n);
+
+/*============================================================================
+ * 64-bit, saturate on overflow
+ *===========================================================================*/
+
+int64_t calc_add_sat_i64(int64_t a, int64_t b);
+int64_t calc_subtract_sat_i64(int64_t a, int64_t b);
+int64_t calc_multiply_sat_i64(int64_t a, int64_t b);
+int64_t calc_divide_sat_i64(int64_t a, int64_t b);
+
+void calc_add_sat_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+void calc_subtract_sat_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+void calc_multiply_sat_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+void calc_divide_sat_i64_batch(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+
+/*============================================================================
+ * 128-bit accumulation
+ *===========================================================================*/
+
+/**
+ * Sum an int64_t array without overflow
+ * @param a Array to sum
+ * @param n Number of elements
+ * @return Exact sum as a 128-bit integer
+ */
+calc_i128_t calc_sum_i64(const int64_t *a, size_t n);
+
+/**
+ * Narrow a 128-bit integer to int64_t
+ * @param v Value to convert
+ * @param result Receives the low 64 bits of v
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if v does not fit in an int64_t
+ */
+calc_status_t calc_i128_to_i64(calc_i128_t v, int64_t *result);
+
+#endif /* __CALC_WIDE_H__ */
@@ -0,0 +1,103 @@
+#ifndef __CALC_HPP__
+#define __CALC_HPP__
+
+#include <type_traits>
+
+/*
+ * Header-only C++ facade over calc.h
+ *
+ * constexpr templates with the same results as the C functions, so calls
+ * with constant operands fold at compile time and each integer type gets
+ * its own inlined instantiation. Requires C++11.
+ *
+ * Semantics, for any integer type T (bool excluded):
+ *   add / subtract / multiply  wrap around on overflow (calc.c does the
+ *                              same in practice; here it is well defined)
+ *   divide                     0 if b is 0, truncates toward zero, and
+ *                              MIN / -1 wraps to MIN like calc_divide_batch
+ *                              and calc_divide_i64 (calc_divide traps there)
+ *
+ * The names are sdk::calc::add etc. rather than calc_add so they are not
+ * replaced by the CALC_INLINE macros of calc.h.
+ */
+
+namespace sdk {
+namespace calc {
+namespace detail {
+
+/* Unsigned type the arithmetic is done in: at least unsigned int, so
+ * narrow types are not promoted back to (overflowing) signed int */
+template <typename T>
+struct wide {
+    typedef typename std::common_type<typename std::make_unsigned<T>::type, unsigned>::type type;
+};
+
+template <typename T>
+constexpr typename wide<T>::type widen(T v) {
+    return static_cast<typename wide<T>::type>(v);
+}
+
+template <typename T>
+struct check_type {
+    static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value,
+                  "sdk::calc needs an integer type");
+    typedef T type;
+};
+
+template <typename T>
+constexpr T negate(T a) {
+    return static_cast<T>(widen<T>(0) - widen(a));
+}
+
+} // namespace detail
+
+/**
+ * Add two integers, wrapping around on overflow
+ * @param a First operand
+ * @param b Second operand
+ * @return Sum of a and b
+ */
+template <typename T>
+constexpr typename detail::check_type<T>::type add(T a, T b) {
+    return static_cast<T>(detail::widen(a) + detail::widen(b));
+}
+
+/**
+ * Subtract two integers, wrapping around on overflow
+ * @param a First operand
+ * @param b Second operand
+ * @return Difference of a and b (a - b)
+ */
+template <typename T>
+constexpr typename detail::check_type<T>::type subtract(T a, T b) {
+    return static_cast<T>(detail::widen(a) - detail::widen(b));
+}
+
+/**
+ * Multiply two integers, wrapping around on overflow
+ * @param a First operand
+ * @param b Second operand
+ * @return Product of a and b
+ */
+template <typename T>
+constexpr typename detail::check_type<T>::type multiply(T a, T b) {
+    return static_cast<T>(detail::widen(a) * detail::widen(b));
+}
+
+/**
+ * Divide two integers
+ * @param a Dividend
+ * @param b Divisor
+ * @return Quotient of a / b, 0 if b is 0, MIN if a is MIN and b is -1
+ */
+template <typename T>
+constexpr typename detail::check_type<T>::type divide(T a, T b) {
+    return b == 0 ? T(0)
+         : (std::is_signed<T>::value && b == static_cast<T>(-1)) ? detail::negate(a)
+         : static_cast<T>(a / b);
+}
+
+} // namespace calc
+} // namespace sdk
+
+#endif /* __CALC_HPP__ */
@@ -1,10 +1,15 @@
 #ifndef __GREETING_H__
 #define __GREETING_H__
 
+#include <stddef.h>
+
 /**
  * Say hello to a person
  * @param name The person's name to greet
  * @return Greeting message string (static buffer)
+ *
+ * @note Not thread-safe: the buffer is shared by every caller. Use
+ *       say_hello_r from several threads
  */
 const char* say_hello(const char* name);
 
@@ -12,7 +17,30 @@ const char* say_hello(const char* name);
  * Say goodbye to a person
  * @param name The person's name to say goodbye to
  * @return Farewell message string (static buffer)
+ *
+ * @note Not thread-safe, see say_goodbye_r
  */
 const char* say_goodbye(const char* name);
 
+/**
+ * Say hello to a person into a caller buffer (reentrant)
+ * @param name The person's name to greet (NULL or "" for a stranger)
+ * @param buf Receives at most size - 1 characters and a terminating NUL
+ *            (may be NULL if size is 0)
+ * @param size Size of buf
+ * @return Length of the full message (like snprintf); the message was
+ *         truncated if this is size or more
+ */
+size_t say_hello_r(const char* name, char* buf, size_t size);
+
+/**
+ * Say goodbye to a person into a caller buffer (reentrant)
+ * @param name The person's name to say goodbye to (NULL or "" for a stranger)
+ * @param buf Receives at most size - 1 characters and a terminating NUL
+ *            (may be NULL if size is 0)
+ * @param size Size of buf
+ * @return Length of the full message (like snprintf)
+ */
+size_t say_goodbye_r(const char* name, char* buf, size_t size);
+
 #endif /* __GREETING_H__ */
\ No newline at end of file
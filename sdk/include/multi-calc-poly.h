@@ -0,0 +1,123 @@
+#ifndef __MULTI_CALC_POLY_H__
+#define __MULTI_CALC_POLY_H__
+
+#include <stddef.h>
+#include "calc-checked.h"
+
+/*
+ * Integer powers and polynomials
+ *
+ * Powers use exponentiation by squaring, polynomials Horner's rule, so
+ * x^e takes about 2 log2(e) multiplies and a degree-d polynomial d
+ * multiply-adds. Plain versions wrap around on overflow like calc_multiply;
+ * the checked versions store the same wrapped values and report overflow.
+ *
+ * Coefficients are in ascending order: coeffs[i] multiplies x^i.
+ */
+
+/*============================================================================
+ * Scalar
+ *===========================================================================*/
+
+/**
+ * Raise an integer to a power
+ * @param base Base
+ * @param exponent Exponent
+ * @return base^exponent (wrapped around on overflow), 1 if exponent is 0
+ *
+ * @note This function depends on calc_multiply, or the same entry of the
+ *       active calc_ops backend
+ */
+int calc_pow(int base, unsigned exponent);
+
+/**
+ * Evaluate a polynomial
+ * @param coeffs Coefficients, coeffs[i] for x^i
+ * @param count Number of coefficients (degree + 1)
+ * @param x Point to evaluate at
+ * @return coeffs[0] + coeffs[1] * x + ... (wrapped around on overflow),
+ *         0 if count is 0
+ *
+ * @note This function depends on calc_add, calc_multiply, or the same
+ *       entries of the active calc_ops backend
+ */
+int multi_calc_poly(const int *coeffs, size_t count, int x);
+
+/**
+ * Raise an integer to a power with overflow detection
+ * @param base Base
+ * @param exponent Exponent
+ * @param result Receives base^exponent (wrapped around on overflow)
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if base^exponent does not fit in
+ *         an int
+ */
+calc_status_t calc_pow_checked(int base, unsigned exponent, int *result);
+
+/**
+ * Evaluate a polynomial with overflow detection
+ * @param coeffs Coefficients, coeffs[i] for x^i
+ * @param count Number of coefficients (degree + 1)
+ * @param x Point to evaluate at
+ * @param result Receives the same value as multi_calc_poly
+ * @return CALC_OK, or CALC_ERR_OVERFLOW if some multiply or add of the
+ *         Horner steps overflowed (as if chaining calc_multiply_checked and
+ *         calc_add_checked)
+ */
+calc_status_t multi_calc_poly_checked(const int *coeffs, size_t count, int x, int *result);
+
+/*============================================================================
+ * Batch
+ *
+ * One SIMD pass (instruction set from calc_batch_isa), split across the
+ * calc-pool threads for long inputs. These do not go through the calc_ops
+ * backend.
+ *===========================================================================*/
+
+/**
+ * Raise an integer array to a common power
+ * @param base Base array
+ * @param exponent Exponent shared by all elements
+ * @param out Result array, out[i] = calc_pow(base[i], exponent) (may alias base)
+ * @param n Number of elements
+ */
+void calc_pow_batch(const int *base, unsigned exponent, int *out, size_t n);
+
+/**
+ * Evaluate a polynomial at every element of an array
+ * @param coeffs Coefficients, coeffs[i] for x^i
+ * @param count Number of coefficients (degree + 1)
+ * @param x Points to evaluate at
+ * @param out Result array, out[i] = multi_calc_poly(coeffs, count, x[i])
+ *            (may alias x)
+ * @param n Number of elements
+ */
+void multi_calc_poly_batch(const int *coeffs, size_t count, const int *x, int *out, size_t n);
+
+/**
+ * Raise an integer array to a common power and flag overflowing elements
+ * @param base Base array
+ * @param exponent Exponent shared by all elements
+ * @param out Result array, same values as calc_pow_batch (may alias base)
+ * @param flags Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if element i
+ *              overflowed (may be NULL if only the count is needed)
+ * @param n Number of elements
+ * @return Number of elements that overflowed
+ */
+size_t calc_pow_checked_batch(const int *base, unsigned exponent, int *out,
+                              unsigned char *flags, size_t n);
+
+/**
+ * Evaluate a polynomial at every element of an array and flag overflows
+ * @param coeffs Coefficients, coeffs[i] for x^i
+ * @param count Number of coefficients (degree + 1)
+ * @param x Points to evaluate at
+ * @param out Result array, same values as multi_calc_poly_batch (may alias x)
+ * @param flags Bitmap of CALC_BITMAP_BYTES(n) bytes, bit i set if element i
+ *              overflowed like multi_calc_poly_checked (may be NULL)
+ * @param n Number of elements
+ * @return Number of elements that overflowed
+ */
+size_t multi_calc_poly_checked_batch(const int *coeffs, size_t count, const int *x,
+                                     int *out, unsigned char *flags, size_t n);
+
+#endif /* __MULTI_CALC_POLY_H__ */
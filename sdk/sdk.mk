@@ -5,13 +5,19 @@ SDK_SRC_DIR := sdk/src
 SDK_INC_DIR := sdk/include
 SDK_SRCS := $(wildcard $(SDK_SRC_DIR)/*.c)
 SDK_OBJS := $(patsubst $(SDK_SRC_DIR)/%.c, $(SDK_OUTPUT_DIR)/%.o, $(SDK_SRCS))
-SDK_HEADERS := $(wildcard $(SDK_INC_DIR)/*.h)
+SDK_HEADERS := $(wildcard $(SDK_INC_DIR)/*.h $(SDK_INC_DIR)/*.hpp)
 
 # SDK library name
 SDK_LIB := $(OUTPUT_DIR)/libsdk.a
 
-# SDK specific flags
-SDK_CFLAGS := $(CFLAGS) -I$(SDK_INC_DIR)
+# SDK specific flags (optimized: the batch kernels are performance critical)
+SDK_CFLAGS := $(CFLAGS) -O2 -I$(SDK_INC_DIR)
+ifeq ($(SDK_INLINE),1)
+SDK_CFLAGS += -DCALC_INLINE
+endif
+
+# Records SDK_CFLAGS so objects are rebuilt when SDK_INLINE changes
+SDK_FLAGS_STAMP := $(SDK_OUTPUT_DIR)/.cflags
 
 # Build SDK library
 .PHONY: sdk
@@ -23,8 +29,15 @@ $(SDK_LIB): $(SDK_OBJS)
 	$(AR) $(ARFLAGS) $@ $^
 	@echo "SDK library built successfully: $@"
 
+$(SDK_FLAGS_STAMP): FORCE
+	@$(MKDIR) $(dir $@)
+	@echo '$(SDK_CFLAGS)' | cmp -s - $@ || echo '$(SDK_CFLAGS)' > $@
+
+.PHONY: FORCE
+FORCE:
+
 # Compile SDK source files
-$(SDK_OUTPUT_DIR)/%.o: $(SDK_SRC_DIR)/%.c
+$(SDK_OUTPUT_DIR)/%.o: $(SDK_SRC_DIR)/%.c $(SDK_FLAGS_STAMP)
 	@echo "Compiling: $<"
 	@$(MKDIR) $(dir $@)
 	$(CC) $(SDK_CFLAGS) -c $< -o $@
@@ -0,0 +1,310 @@
+#include <stdlib.h>
+#include <string.h>
+#include "calc-arrow.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+#include "multi-calc-batch.h"
+
+#define ARROW_ALIGNMENT 64      /* Buffer alignment recommended by Arrow */
+
+/*
+ * Result column: this header, the validity bitmap and the data, in one
+ * block freed by the release callback
+ */
+typedef struct {
+    const void *buffers[2];
+} result_block;
+
+/* Input column, positioned at its offset */
+typedef struct {
+    const int *data;
+    const unsigned char *validity;  /* NULL if no row is null */
+    size_t bit_offset;              /* Of row 0 in validity */
+} column;
+
+static size_t align_up(size_t n) {
+    return (n + ARROW_ALIGNMENT - 1) & ~(size_t)(ARROW_ALIGNMENT - 1);
+}
+
+/*============================================================================
+ * Inputs
+ *===========================================================================*/
+
+static int column_open(const struct ArrowArray *array, int64_t length, column *col) {
+    if (array == NULL || array->release == NULL || array->length != length ||
+        array->offset < 0 || array->n_buffers != 2 || array->n_children != 0 ||
+        array->dictionary != NULL || array->buffers == NULL) {
+        return -1;
+    }
+    if (array->buffers[1] == NULL) {
+        if (length != 0) {
+            return -1;
+        }
+        col->data = NULL;
+    } else {
+        col->data = (const int *)array->buffers[1] + array->offset;
+    }
+    // buffers[0] may be NULL when the null count is 0 or unknown (-1)
+    col->validity = array->null_count != 0 ? (const unsigned char *)array->buffers[0] : NULL;
+    col->bit_offset = (size_t)array->offset;
+    return 0;
+}
+
+static int columns_open(const struct ArrowArray *const *arrays, column *cols, int count) {
+    if (arrays[0] == NULL || arrays[0]->length < 0 ||
+        (uint64_t)arrays[0]->length > SIZE_MAX / 8) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (column_open(arrays[i], arrays[0]->length, &cols[i]) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Validity bitmaps
+ *===========================================================================*/
+
+/* dst &= n bits of src starting at bit `offset` */
+static void bitmap_and(unsigned char *dst, const unsigned char *src, size_t offset, size_t n) {
+    size_t bytes = CALC_BITMAP_BYTES(n);
+    unsigned shift = (unsigned)(offset % 8);
+
+    src += offset / 8;
+    if (shift == 0) {
+        for (size_t j = 0; j < bytes; j++) {
+            dst[j] &= src[j];
+        }
+        return;
+    }
+    // Bit j of the result straddles two source bytes; do not read past the last
+    size_t src_bytes = CALC_BITMAP_BYTES(n + shift);
+    for (size_t j = 0; j < bytes; j++) {
+        unsigned v = (unsigned)src[j] >> shift;
+        if (j + 1 < src_bytes) {
+            v |= (unsigned)src[j + 1] << (8 - shift);
+        }
+        dst[j] &= (unsigned char)v;
+    }
+}
+
+static size_t bitmap_count_zeros(const unsigned char *bits, size_t n) {
+    size_t ones = 0;
+    size_t j = 0;
+
+    for (; j + 8 <= n / 8; j += 8) {
+        uint64_t word;
+        memcpy(&word, bits + j, sizeof(word));
+        ones += (size_t)__builtin_popcountll(word);
+    }
+    for (; j < CALC_BITMAP_BYTES(n); j++) {
+        ones += (size_t)__builtin_popcount(bits[j]);
+    }
+    return n - ones;
+}
+
+/*============================================================================
+ * Results
+ *===========================================================================*/
+
+static void release_array(struct ArrowArray *array) {
+    free(array->private_data);
+    array->release = NULL;
+}
+
+static result_block* result_alloc(size_t n, unsigned char **validity, int **data) {
+    size_t head = align_up(sizeof(result_block));
+    size_t bits = align_up(CALC_BITMAP_BYTES(n));
+    unsigned char *block = aligned_alloc(ARROW_ALIGNMENT, head + bits + align_up(n * sizeof(int)));
+
+    if (block == NULL) {
+        return NULL;
+    }
+    *validity = block + head;
+    *data = (int *)(void *)(block + head + bits);
+    return (result_block *)(void *)block;
+}
+
+/*
+ * Combine the input validity into `validity` (which holds the rows still
+ * valid after errors) and hand the result over to `out`
+ */
+static void result_export(result_block *res, const column *cols, int count,
+                          unsigned char *validity, int *data, size_t n,
+                          size_t errors, struct ArrowArray *out) {
+    size_t nulls = errors;
+    int inputs_null = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (cols[i].validity != NULL) {
+            bitmap_and(validity, cols[i].validity, cols[i].bit_offset, n);
+            inputs_null = 1;
+        }
+    }
+    if (n % 8 != 0) {
+        validity[n / 8] &= (unsigned char)((1u << (n % 8)) - 1);
+    }
+    if (inputs_null) {
+        nulls = bitmap_count_zeros(validity, n);
+    }
+
+    res->buffers[0] = nulls != 0 ? validity : NULL;
+    res->buffers[1] = data;
+    memset(out, 0, sizeof(*out));
+    out->length = (int64_t)n;
+    out->null_count = (int64_t)nulls;
+    out->n_buffers = 2;
+    out->buffers = res->buffers;
+    out->release = release_array;
+    out->private_data = res;
+}
+
+/*============================================================================
+ * Public API
+ *===========================================================================*/
+
+int calc_arrow_check_schema(const struct ArrowSchema *schema) {
+    if (schema == NULL || schema->release == NULL || schema->format == NULL ||
+        strcmp(schema->format, "i") != 0 || schema->n_children != 0 ||
+        schema->dictionary != NULL) {
+        return -1;
+    }
+    return 0;
+}
+
+static void release_schema(struct ArrowSchema *schema) {
+    free((void *)schema->name);
+    schema->release = NULL;
+}
+
+int calc_arrow_export_schema(const char *name, struct ArrowSchema *out) {
+    char *copy = NULL;
+
+    if (name != NULL) {
+        copy = strdup(name);
+        if (copy == NULL) {
+            return -1;
+        }
+    }
+    memset(out, 0, sizeof(*out));
+    out->format = "i";
+    out->name = copy;
+    out->flags = ARROW_FLAG_NULLABLE;
+    out->release = release_schema;
+    return 0;
+}
+
+int calc_arrow_batch(calc_arrow_op_t op, const struct ArrowArray *a,
+                     const struct ArrowArray *b, unsigned flags, struct ArrowArray *out) {
+    const struct ArrowArray *arrays[2] = { a, b };
+    column cols[2];
+    unsigned char *validity;
+    int *data;
+    size_t errors = 0;
+
+    if (out == NULL || (unsigned)op > CALC_ARROW_DIVIDE || columns_open(arrays, cols, 2) != 0) {
+        return -1;
+    }
+    size_t n = (size_t)a->length;
+    result_block *res = result_alloc(n, &validity, &data);
+    if (res == NULL) {
+        return -1;
+    }
+
+    if (flags & CALC_ARROW_NULL_ON_ERROR) {
+        // The checked kernels flag errors in the validity bitmap, then valid = !error
+        switch (op) {
+        case CALC_ARROW_ADD:
+            errors = calc_add_checked_batch(cols[0].data, cols[1].data, data, validity, n);
+            break;
+        case CALC_ARROW_SUBTRACT:
+            errors = calc_subtract_checked_batch(cols[0].data, cols[1].data, data, validity, n);
+            break;
+        case CALC_ARROW_MULTIPLY:
+            errors = calc_multiply_checked_batch(cols[0].data, cols[1].data, data, validity, n);
+            break;
+        case CALC_ARROW_DIVIDE:
+            errors = calc_divide_checked_batch(cols[0].data, cols[1].data, data, validity, n);
+            break;
+        }
+        for (size_t j = 0; j < CALC_BITMAP_BYTES(n); j++) {
+            validity[j] = (unsigned char)~validity[j];
+        }
+    } else {
+        switch (op) {
+        case CALC_ARROW_ADD:
+            calc_add_batch(cols[0].data, cols[1].data, data, n);
+            break;
+        case CALC_ARROW_SUBTRACT:
+            calc_subtract_batch(cols[0].data, cols[1].data, data, n);
+            break;
+        case CALC_ARROW_MULTIPLY:
+            calc_multiply_batch(cols[0].data, cols[1].data, data, n);
+            break;
+        case CALC_ARROW_DIVIDE:
+            calc_divide_batch(cols[0].data, cols[1].data, data, n);
+            break;
+        }
+        memset(validity, 0xff, CALC_BITMAP_BYTES(n));
+    }
+
+    result_export(res, cols, 2, validity, data, n, errors, out);
+    return 0;
+}
+
+/* (a + b) * (c - d), bit i of flags set if any step overflows for row i */
+static size_t expression_checked(const int *a, const int *b, const int *c, const int *d,
+                                 int *out, unsigned char *flags, size_t n) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i += 8) {
+        size_t len = (n - i < 8) ? n - i : 8;
+        unsigned bits = 0;
+        for (size_t j = 0; j < len; j++) {
+            int sum, diff;
+            int overflow = __builtin_add_overflow(a[i + j], b[i + j], &sum);
+            overflow |= __builtin_sub_overflow(c[i + j], d[i + j], &diff);
+            overflow |= __builtin_mul_overflow(sum, diff, &out[i + j]);
+            bits |= (unsigned)overflow << j;
+        }
+        count += (size_t)__builtin_popcount(bits);
+        flags[i / 8] = (unsigned char)bits;
+    }
+    return count;
+}
+
+int calc_arrow_expression_batch(const struct ArrowArray *a, const struct ArrowArray *b,
+                                const struct ArrowArray *c, const struct ArrowArray *d,
+                                unsigned flags, struct ArrowArray *out) {
+    const struct ArrowArray *arrays[4] = { a, b, c, d };
+    column cols[4];
+    unsigned char *validity;
+    int *data;
+    size_t errors = 0;
+
+    if (out == NULL || columns_open(arrays, cols, 4) != 0) {
+        return -1;
+    }
+    size_t n = (size_t)a->length;
+    result_block *res = result_alloc(n, &validity, &data);
+    if (res == NULL) {
+        return -1;
+    }
+
+    if (flags & CALC_ARROW_NULL_ON_ERROR) {
+        errors = expression_checked(cols[0].data, cols[1].data, cols[2].data, cols[3].data,
+                                    data, validity, n);
+        for (size_t j = 0; j < CALC_BITMAP_BYTES(n); j++) {
+            validity[j] = (unsigned char)~validity[j];
+        }
+    } else {
+        multi_calc_expression_batch(cols[0].data, cols[1].data, cols[2].data, cols[3].data,
+                                    data, n);
+        memset(validity, 0xff, CALC_BITMAP_BYTES(n));
+    }
+
+    result_export(res, cols, 4, validity, data, n, errors, out);
+    return 0;
+}
@@ -0,0 +1,403 @@
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "calc-async.h"
+#include "calc-batch.h"
+#include "greeting.h"
+#include "multi-calc-batch.h"
+
+#define CACHE_LINE 64
+#define MAX_WORKERS 256
+#define MAX_CAPACITY ((size_t)1 << 30)  /* Fits a semaphore count */
+#define IDLE_SPINS 16           /* Polls of an empty queue before a worker sleeps */
+#define JOB_CACHE_SIZE 1024     /* Finished jobs kept for reuse (power of 2) */
+
+struct calc_job {
+    calc_job_desc_t desc;
+    int state;                  /* calc_job_state_t (atomic) */
+    int refs;                   /* Caller + executor (atomic) */
+    pthread_mutex_t lock;       /* Guards cb, waiters and the done wake-up */
+    pthread_cond_t done;
+    unsigned waiters;
+    calc_job_callback cb;
+    void *cb_arg;
+};
+
+/*
+ * Bounded MPMC queue (D. Vyukov). Each cell carries a sequence number:
+ * seq == pos means free for the producer claiming pos, seq == pos + 1
+ * means filled for the consumer claiming pos. Producers and consumers
+ * claim positions with a CAS and never take a lock.
+ */
+typedef struct {
+    size_t seq;                 /* Atomic */
+    calc_job_t *job;
+} queue_cell;
+
+typedef struct {
+    queue_cell *cells;
+    size_t mask;
+    char pad0[CACHE_LINE];
+    size_t enqueue_pos;         /* Atomic, own cache line */
+    char pad1[CACHE_LINE];
+    size_t dequeue_pos;         /* Atomic, own cache line */
+    char pad2[CACHE_LINE];
+} job_ring;
+
+struct calc_async {
+    job_ring queue;
+    // Sleeping only: a full queue blocks producers, an empty one workers
+    sem_t items;
+    sem_t space;
+    unsigned workers;
+    pthread_t threads[MAX_WORKERS];
+};
+
+/*
+ * Released jobs wait here for the next submission, so that a steady flow
+ * of jobs does not go through malloc. Shared by every executor: a handle
+ * may be released after its executor is gone.
+ */
+static job_ring job_cache;
+static queue_cell job_cache_cells[JOB_CACHE_SIZE];
+static pthread_once_t job_cache_once = PTHREAD_ONCE_INIT;
+
+/*============================================================================
+ * Queue
+ *===========================================================================*/
+
+static void ring_init(job_ring *q, queue_cell *cells, size_t cap) {
+    for (size_t i = 0; i < cap; i++) {
+        cells[i].seq = i;
+    }
+    q->cells = cells;
+    q->mask = cap - 1;
+    q->enqueue_pos = 0;
+    q->dequeue_pos = 0;
+}
+
+static int ring_push(job_ring *q, calc_job_t *job) {
+    size_t pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        queue_cell *cell = &q->cells[pos & q->mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->job = job;
+                __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;           // Full
+        } else {
+            pos = __atomic_load_n(&q->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int ring_pop(job_ring *q, calc_job_t **job) {
+    size_t pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        queue_cell *cell = &q->cells[pos & q->mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&q->dequeue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *job = cell->job;
+                __atomic_store_n(&cell->seq, pos + q->mask + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;           // Empty
+        } else {
+            pos = __atomic_load_n(&q->dequeue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void sem_wait_retry(sem_t *sem) {
+    while (sem_wait(sem) != 0 && errno == EINTR) {
+    }
+}
+
+/*
+ * A slot is reserved through `space` first. The push can still find the
+ * cell busy while a worker that claimed it has not released it yet, so
+ * it retries until that worker finishes.
+ */
+static void enqueue_reserved(calc_async_t *q, calc_job_t *job) {
+    while (!ring_push(&q->queue, job)) {
+        sched_yield();
+    }
+    sem_post(&q->items);
+}
+
+/* Same for an item counted by `items` whose cell is not published yet */
+static calc_job_t* dequeue_counted(calc_async_t *q) {
+    calc_job_t *job;
+
+    // A busy producer usually refills the queue within a few yields, which
+    // is far cheaper than a futex sleep and wake-up per job
+    for (int spin = 0; sem_trywait(&q->items) != 0; spin++) {
+        if (spin == IDLE_SPINS) {
+            sem_wait_retry(&q->items);
+            break;
+        }
+        sched_yield();
+    }
+    while (!ring_pop(&q->queue, &job)) {
+        sched_yield();
+    }
+    sem_post(&q->space);
+    return job;
+}
+
+/*============================================================================
+ * Jobs
+ *===========================================================================*/
+
+/* The _r functions write straight into the job's text, no lock needed */
+static void greet(const calc_job_desc_t *d, size_t (*say_r)(const char *, char *, size_t)) {
+    size_t size = d->text_size ? d->text_size : CALC_JOB_TEXT_LEN;
+
+    for (size_t i = 0; i < d->n; i++) {
+        say_r(d->names[i], d->text + i * size, size);
+    }
+}
+
+static void run_job(calc_job_t *job) {
+    calc_job_callback cb;
+    void *cb_arg;
+
+    __atomic_store_n(&job->state, CALC_JOB_RUNNING, __ATOMIC_RELAXED);
+    calc_job_run(&job->desc);
+
+    pthread_mutex_lock(&job->lock);
+    __atomic_store_n(&job->state, CALC_JOB_DONE, __ATOMIC_RELEASE);
+    cb = job->cb;
+    cb_arg = job->cb_arg;
+    if (job->waiters > 0) {
+        pthread_cond_broadcast(&job->done);
+    }
+    pthread_mutex_unlock(&job->lock);
+    if (cb != NULL) {
+        cb(job, cb_arg);
+    }
+    calc_job_release(job);
+}
+
+/* Back to the cache, or to malloc once the cache is full */
+static void free_job(calc_job_t *job) {
+    if (!ring_push(&job_cache, job)) {
+        pthread_mutex_destroy(&job->lock);
+        pthread_cond_destroy(&job->done);
+        free(job);
+    }
+}
+
+static void* worker_main(void *arg) {
+    calc_async_t *async = arg;
+    calc_job_t *job;
+
+    // A NULL job is the stop signal, queued behind every real job
+    while ((job = dequeue_counted(async)) != NULL) {
+        run_job(job);
+    }
+    return NULL;
+}
+
+static void job_cache_init(void) {
+    ring_init(&job_cache, job_cache_cells, JOB_CACHE_SIZE);
+}
+
+static calc_job_t* new_job(const calc_job_desc_t *desc) {
+    calc_job_t *job;
+
+    if ((unsigned)desc->kind > CALC_JOB_CUSTOM) {
+        return NULL;
+    }
+    pthread_once(&job_cache_once, job_cache_init);
+    if (!ring_pop(&job_cache, &job)) {
+        job = malloc(sizeof(*job));
+        if (job == NULL) {
+            return NULL;
+        }
+        pthread_mutex_init(&job->lock, NULL);
+        pthread_cond_init(&job->done, NULL);
+    }
+    job->desc = *desc;
+    job->state = CALC_JOB_QUEUED;
+    job->refs = 2;
+    job->waiters = 0;
+    job->cb = NULL;
+    job->cb_arg = NULL;
+    return job;
+}
+
+/*============================================================================
+ * Public functions
+ *===========================================================================*/
+
+calc_async_t* calc_async_create(unsigned workers, size_t capacity) {
+    calc_async_t *async;
+    queue_cell *cells;
+    size_t cap = 2;
+
+    if (workers == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (unsigned)cpus : 1;
+    }
+    workers = workers > MAX_WORKERS ? MAX_WORKERS : workers;
+    while (cap < capacity && cap < MAX_CAPACITY) {
+        cap *= 2;
+    }
+    async = calloc(1, sizeof(*async));
+    if (async == NULL) {
+        return NULL;
+    }
+    cells = malloc(cap * sizeof(*cells));
+    if (cells == NULL) {
+        free(async);
+        return NULL;
+    }
+    ring_init(&async->queue, cells, cap);
+    sem_init(&async->items, 0, 0);
+    sem_init(&async->space, 0, (unsigned)cap);
+
+    for (unsigned w = 0; w < workers; w++) {
+        if (pthread_create(&async->threads[async->workers], NULL, worker_main, async) == 0) {
+            async->workers++;
+        }
+    }
+    if (async->workers == 0) {
+        sem_destroy(&async->items);
+        sem_destroy(&async->space);
+        free(async->queue.cells);
+        free(async);
+        return NULL;
+    }
+    return async;
+}
+
+void calc_async_destroy(calc_async_t *async) {
+    if (async == NULL) {
+        return;
+    }
+    for (unsigned w = 0; w < async->workers; w++) {
+        sem_wait_retry(&async->space);
+        enqueue_reserved(async, NULL);
+    }
+    for (unsigned w = 0; w < async->workers; w++) {
+        pthread_join(async->threads[w], NULL);
+    }
+    sem_destroy(&async->items);
+    sem_destroy(&async->space);
+    free(async->queue.cells);
+    free(async);
+}
+
+calc_job_t* calc_async_submit(calc_async_t *async, const calc_job_desc_t *desc) {
+    calc_job_t *job = new_job(desc);
+
+    if (job != NULL) {
+        sem_wait_retry(&async->space);
+        enqueue_reserved(async, job);
+    }
+    return job;
+}
+
+calc_job_t* calc_async_try_submit(calc_async_t *async, const calc_job_desc_t *desc) {
+    calc_job_t *job = new_job(desc);
+
+    if (job == NULL) {
+        return NULL;
+    }
+    while (sem_trywait(&async->space) != 0) {
+        if (errno != EINTR) {
+            // Full: nobody else has seen the job
+            free_job(job);
+            return NULL;
+        }
+    }
+    enqueue_reserved(async, job);
+    return job;
+}
+
+void calc_job_run(const calc_job_desc_t *d) {
+    switch (d->kind) {
+    case CALC_JOB_ADD:
+        calc_add_batch(d->a, d->b, d->out, d->n);
+        break;
+    case CALC_JOB_SUBTRACT:
+        calc_subtract_batch(d->a, d->b, d->out, d->n);
+        break;
+    case CALC_JOB_MULTIPLY:
+        calc_multiply_batch(d->a, d->b, d->out, d->n);
+        break;
+    case CALC_JOB_DIVIDE:
+        calc_divide_batch(d->a, d->b, d->out, d->n);
+        break;
+    case CALC_JOB_EXPRESSION:
+        multi_calc_expression_batch(d->a, d->b, d->c, d->d, d->out, d->n);
+        break;
+    case CALC_JOB_HELLO:
+        greet(d, say_hello_r);
+        break;
+    case CALC_JOB_GOODBYE:
+        greet(d, say_goodbye_r);
+        break;
+    case CALC_JOB_CUSTOM:
+        d->fn(d->arg);
+        break;
+    }
+}
+
+calc_job_state_t calc_job_poll(const calc_job_t *job) {
+    return (calc_job_state_t)__atomic_load_n(&job->state, __ATOMIC_ACQUIRE);
+}
+
+void calc_job_wait(calc_job_t *job) {
+    if (calc_job_poll(job) == CALC_JOB_DONE) {
+        return;
+    }
+    pthread_mutex_lock(&job->lock);
+    job->waiters++;
+    while (__atomic_load_n(&job->state, __ATOMIC_ACQUIRE) != CALC_JOB_DONE) {
+        pthread_cond_wait(&job->done, &job->lock);
+    }
+    job->waiters--;
+    pthread_mutex_unlock(&job->lock);
+}
+
+int calc_job_then(calc_job_t *job, calc_job_callback cb, void *arg) {
+    pthread_mutex_lock(&job->lock);
+    if (job->cb != NULL) {
+        pthread_mutex_unlock(&job->lock);
+        return -1;
+    }
+    job->cb = cb;
+    job->cb_arg = arg;
+    if (__atomic_load_n(&job->state, __ATOMIC_ACQUIRE) == CALC_JOB_DONE) {
+        // The worker has already looked for a callback
+        pthread_mutex_unlock(&job->lock);
+        cb(job, arg);
+        return 0;
+    }
+    pthread_mutex_unlock(&job->lock);
+    return 0;
+}
+
+void calc_job_release(calc_job_t *job) {
+    if (job != NULL && __atomic_sub_fetch(&job->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        free_job(job);
+    }
+}
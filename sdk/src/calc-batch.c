@@ -0,0 +1,401 @@
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "simd.h"
+
+/*============================================================================
+ * Scalar kernels
+ *
+ * Arithmetic is done on unsigned values so overflow wraps instead of being
+ * undefined behaviour; the result matches what calc_* produce on the targets
+ * the SDK is built for.
+ *===========================================================================*/
+
+static void add_scalar(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (int)((unsigned)a[i] + (unsigned)b[i]);
+    }
+}
+
+static void subtract_scalar(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (int)((unsigned)a[i] - (unsigned)b[i]);
+    }
+}
+
+static void multiply_scalar(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (int)((unsigned)a[i] * (unsigned)b[i]);
+    }
+}
+
+/*
+ * Branchless scalar division: zero and -1 divisors are replaced by 1, the
+ * quotient is then negated for -1 and cleared for 0 with masks. Scattered
+ * zero divisors cost nothing extra, and INT_MIN / -1 wraps to INT_MIN.
+ */
+static inline int divide_branchless(int a, int b) {
+    int zero = b == 0;
+    int minus_one = b == -1;
+    int q = a / ((b | zero) + 2 * minus_one);
+    unsigned neg = 0u - (unsigned)minus_one;
+    q = (int)(((unsigned)q ^ neg) + (unsigned)minus_one);
+    return q & (zero - 1);
+}
+
+static void divide_scalar(const int *a, const int *b, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = divide_branchless(a[i], b[i]);
+    }
+}
+
+/*
+ * Masked division: groups of 8 elements fill one byte of the zero divisor
+ * bitmap. SIMD kernels hand their tail over at a multiple of 8.
+ */
+typedef size_t (*masked_kernel)(const int *a, const int *b, int *out,
+                                unsigned char *flags, size_t n);
+
+static size_t divide_masked_scalar(const int *a, const int *b, int *out,
+                                   unsigned char *flags, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i += 8) {
+        size_t len = (n - i < 8) ? n - i : 8;
+        unsigned bits = 0;
+        for (size_t j = 0; j < len; j++) {
+            bits |= (unsigned)(b[i + j] == 0) << j;
+            out[i + j] = divide_branchless(a[i + j], b[i + j]);
+        }
+        count += (size_t)__builtin_popcount(bits);
+        if (flags != NULL) {
+            flags[i / 8] = (unsigned char)bits;
+        }
+    }
+    return count;
+}
+
+#if SDK_SIMD_X86
+
+/*
+ * Generate a SIMD kernel: full vectors go through `op`, the tail is handed
+ * to the scalar kernel.
+ */
+#define SIMD_BINARY_KERNEL(name, target, vec, width, load, store, op, tail) \
+    target static void name(const int *a, const int *b, int *out, size_t n) { \
+        size_t i = 0;                                                       \
+        for (; i + (width) <= n; i += (width)) {                            \
+            vec va = load((const void *)(a + i));                           \
+            vec vb = load((const void *)(b + i));                           \
+            store((void *)(out + i), op(va, vb));                           \
+        }                                                                   \
+        tail(a + i, b + i, out + i, n - i);                                 \
+    }
+
+/*
+ * Generate a masked division kernel: `step` divides `width` elements
+ * (a multiple of 8) and returns their zero divisor mask.
+ */
+#define SIMD_MASKED_KERNEL(name, target, width, step, tail)                  \
+    target static size_t name(const int *a, const int *b, int *out,          \
+                              unsigned char *flags, size_t n) {              \
+        size_t count = 0;                                                    \
+        size_t i = 0;                                                        \
+        for (; i + (width) <= n; i += (width)) {                             \
+            unsigned bits = step(a + i, b + i, out + i);                     \
+            count += (size_t)__builtin_popcount(bits);                       \
+            if (flags != NULL) {                                             \
+                for (size_t k = 0; k < (width) / 8; k++) {                   \
+                    flags[i / 8 + k] = (unsigned char)(bits >> (8 * k));     \
+                }                                                            \
+            }                                                                \
+        }                                                                    \
+        return count + tail(a + i, b + i, out + i,                           \
+                            flags != NULL ? flags + i / 8 : NULL, n - i);    \
+    }
+
+/*
+ * Integer division has no SIMD instruction, so it is done in double
+ * precision: every int32 is exact in a double, and the correctly rounded
+ * quotient never crosses an integer boundary, so truncation gives the same
+ * result as C division. Zero divisors are replaced by 1 and the lane is
+ * cleared afterwards.
+ */
+
+/*============================================================================
+ * SSE2 kernels (4 x int32)
+ *===========================================================================*/
+
+SDK_TARGET_SSE2 static inline __m128i div_sse2(__m128i a, __m128i b) {
+    __m128i zero = _mm_cmpeq_epi32(b, _mm_setzero_si128());
+    b = _mm_or_si128(_mm_andnot_si128(zero, b), _mm_and_si128(zero, _mm_set1_epi32(1)));
+    __m128i q01 = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b)));
+    __m128i a23 = _mm_shuffle_epi32(a, _MM_SHUFFLE(3, 2, 3, 2));
+    __m128i b23 = _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 2, 3, 2));
+    __m128i q23 = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(a23), _mm_cvtepi32_pd(b23)));
+    return _mm_andnot_si128(zero, _mm_unpacklo_epi64(q01, q23));
+}
+
+SIMD_BINARY_KERNEL(add_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                   _mm_loadu_si128, _mm_storeu_si128, _mm_add_epi32, add_scalar)
+SIMD_BINARY_KERNEL(subtract_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                   _mm_loadu_si128, _mm_storeu_si128, _mm_sub_epi32, subtract_scalar)
+SIMD_BINARY_KERNEL(multiply_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                   _mm_loadu_si128, _mm_storeu_si128, mullo_sse2, multiply_scalar)
+SIMD_BINARY_KERNEL(divide_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                   _mm_loadu_si128, _mm_storeu_si128, div_sse2, divide_scalar)
+
+SDK_TARGET_SSE2 static inline unsigned divide_masked_step_sse2(const int *a, const int *b, int *out) {
+    unsigned bits = 0;
+    for (int k = 0; k < 2; k++) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(const void *)(a + 4 * k));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(const void *)(b + 4 * k));
+        __m128i zero = _mm_cmpeq_epi32(vb, _mm_setzero_si128());
+        _mm_storeu_si128((__m128i *)(void *)(out + 4 * k), div_sse2(va, vb));
+        bits |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(zero)) << (4 * k);
+    }
+    return bits;
+}
+
+SIMD_MASKED_KERNEL(divide_masked_sse2, SDK_TARGET_SSE2, 8,
+                   divide_masked_step_sse2, divide_masked_scalar)
+
+/*============================================================================
+ * AVX2 kernels (8 x int32)
+ *===========================================================================*/
+
+SDK_TARGET_AVX2 static inline __m256i div_avx2(__m256i a, __m256i b) {
+    __m256i zero = _mm256_cmpeq_epi32(b, _mm256_setzero_si256());
+    b = _mm256_blendv_epi8(b, _mm256_set1_epi32(1), zero);
+    __m128i lo = _mm256_cvttpd_epi32(_mm256_div_pd(
+        _mm256_cvtepi32_pd(_mm256_castsi256_si128(a)),
+        _mm256_cvtepi32_pd(_mm256_castsi256_si128(b))));
+    __m128i hi = _mm256_cvttpd_epi32(_mm256_div_pd(
+        _mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1)),
+        _mm256_cvtepi32_pd(_mm256_extracti128_si256(b, 1))));
+    return _mm256_andnot_si256(zero, _mm256_set_m128i(hi, lo));
+}
+
+SIMD_BINARY_KERNEL(add_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                   _mm256_loadu_si256, _mm256_storeu_si256, _mm256_add_epi32, add_scalar)
+SIMD_BINARY_KERNEL(subtract_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                   _mm256_loadu_si256, _mm256_storeu_si256, _mm256_sub_epi32, subtract_scalar)
+SIMD_BINARY_KERNEL(multiply_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                   _mm256_loadu_si256, _mm256_storeu_si256, _mm256_mullo_epi32, multiply_scalar)
+SIMD_BINARY_KERNEL(divide_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                   _mm256_loadu_si256, _mm256_storeu_si256, div_avx2, divide_scalar)
+
+SDK_TARGET_AVX2 static inline unsigned divide_masked_step_avx2(const int *a, const int *b, int *out) {
+    __m256i va = _mm256_loadu_si256((const __m256i *)(const void *)a);
+    __m256i vb = _mm256_loadu_si256((const __m256i *)(const void *)b);
+    __m256i zero = _mm256_cmpeq_epi32(vb, _mm256_setzero_si256());
+    _mm256_storeu_si256((__m256i *)(void *)out, div_avx2(va, vb));
+    return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(zero));
+}
+
+SIMD_MASKED_KERNEL(divide_masked_avx2, SDK_TARGET_AVX2, 8,
+                   divide_masked_step_avx2, divide_masked_scalar)
+
+/*============================================================================
+ * AVX-512 kernels (16 x int32)
+ *===========================================================================*/
+
+SDK_TARGET_AVX512 static inline __m512i div_avx512(__m512i a, __m512i b) {
+    __mmask16 nonzero = _mm512_test_epi32_mask(b, b);
+    b = _mm512_mask_blend_epi32(nonzero, _mm512_set1_epi32(1), b);
+    __m256i lo = _mm512_cvttpd_epi32(_mm512_div_pd(
+        _mm512_cvtepi32_pd(_mm512_castsi512_si256(a)),
+        _mm512_cvtepi32_pd(_mm512_castsi512_si256(b))));
+    __m256i hi = _mm512_cvttpd_epi32(_mm512_div_pd(
+        _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(a, 1)),
+        _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(b, 1))));
+    return _mm512_maskz_mov_epi32(nonzero,
+        _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+}
+
+SIMD_BINARY_KERNEL(add_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                   _mm512_loadu_si512, _mm512_storeu_si512, _mm512_add_epi32, add_scalar)
+SIMD_BINARY_KERNEL(subtract_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                   _mm512_loadu_si512, _mm512_storeu_si512, _mm512_sub_epi32, subtract_scalar)
+SIMD_BINARY_KERNEL(multiply_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                   _mm512_loadu_si512, _mm512_storeu_si512, _mm512_mullo_epi32, multiply_scalar)
+SIMD_BINARY_KERNEL(divide_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                   _mm512_loadu_si512, _mm512_storeu_si512, div_avx512, divide_scalar)
+
+SDK_TARGET_AVX512 static inline unsigned divide_masked_step_avx512(const int *a, const int *b, int *out) {
+    __m512i va = _mm512_loadu_si512((const void *)a);
+    __m512i vb = _mm512_loadu_si512((const void *)b);
+    _mm512_storeu_si512((void *)out, div_avx512(va, vb));
+    return (unsigned)(__mmask16)~_mm512_test_epi32_mask(vb, vb);
+}
+
+SIMD_MASKED_KERNEL(divide_masked_avx512, SDK_TARGET_AVX512, 16,
+                   divide_masked_step_avx512, divide_masked_scalar)
+
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * Dispatch tables, indexed by calc_isa_t
+ *===========================================================================*/
+
+typedef void (*batch_kernel)(const int *a, const int *b, int *out, size_t n);
+
+#if SDK_SIMD_X86
+static const batch_kernel add_kernels[] = {
+    add_scalar, add_sse2, add_avx2, add_avx512,
+};
+static const batch_kernel subtract_kernels[] = {
+    subtract_scalar, subtract_sse2, subtract_avx2, subtract_avx512,
+};
+static const batch_kernel multiply_kernels[] = {
+    multiply_scalar, multiply_sse2, multiply_avx2, multiply_avx512,
+};
+static const batch_kernel divide_kernels[] = {
+    divide_scalar, divide_sse2, divide_avx2, divide_avx512,
+};
+static const masked_kernel divide_masked_kernels[] = {
+    divide_masked_scalar, divide_masked_sse2, divide_masked_avx2, divide_masked_avx512,
+};
+#else
+static const batch_kernel add_kernels[] = { add_scalar };
+static const batch_kernel subtract_kernels[] = { subtract_scalar };
+static const batch_kernel multiply_kernels[] = { multiply_scalar };
+static const batch_kernel divide_kernels[] = { divide_scalar };
+static const masked_kernel divide_masked_kernels[] = { divide_masked_scalar };
+#endif
+
+/*============================================================================
+ * Multi-threaded split (calc-pool)
+ *===========================================================================*/
+
+typedef struct {
+    batch_kernel kernel;
+    const int *a;
+    const int *b;
+    int *out;
+} binary_job;
+
+static void binary_range(void *ctx, size_t begin, size_t end) {
+    const binary_job *job = ctx;
+    job->kernel(job->a + begin, job->b + begin, job->out + begin, end - begin);
+}
+
+static void run_binary(batch_kernel kernel, const int *a, const int *b, int *out, size_t n) {
+    binary_job job = { kernel, a, b, out };
+
+    if (n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        kernel(a, b, out, n);
+        return;
+    }
+    calc_pool_parallel_for(0, n, CALC_POOL_BATCH_GRAIN, binary_range, &job);
+}
+
+/* Masked division is split by bitmap byte, so ranges start at multiples of 8 */
+typedef struct {
+    masked_kernel kernel;
+    const int *a;
+    const int *b;
+    int *out;
+    unsigned char *flags;
+    size_t n;
+    size_t zeros;               /* Atomic */
+} masked_job;
+
+static void masked_range(void *ctx, size_t begin, size_t end) {
+    masked_job *job = ctx;
+    size_t first = begin * 8;
+    size_t last = end * 8 < job->n ? end * 8 : job->n;
+    size_t zeros = job->kernel(job->a + first, job->b + first, job->out + first,
+                               job->flags != NULL ? job->flags + begin : NULL, last - first);
+    __atomic_add_fetch(&job->zeros, zeros, __ATOMIC_RELAXED);
+}
+
+void calc_add_batch(const int *a, const int *b, int *out, size_t n) {
+    run_binary(add_kernels[calc_batch_isa()], a, b, out, n);
+}
+
+void calc_subtract_batch(const int *a, const int *b, int *out, size_t n) {
+    run_binary(subtract_kernels[calc_batch_isa()], a, b, out, n);
+}
+
+void calc_multiply_batch(const int *a, const int *b, int *out, size_t n) {
+    run_binary(multiply_kernels[calc_batch_isa()], a, b, out, n);
+}
+
+void calc_divide_batch(const int *a, const int *b, int *out, size_t n) {
+    run_binary(divide_kernels[calc_batch_isa()], a, b, out, n);
+}
+
+size_t calc_divide_batch_masked(const int *a, const int *b, int *out,
+                                unsigned char *zero_flags, size_t n) {
+    masked_kernel kernel = divide_masked_kernels[calc_batch_isa()];
+    masked_job job = { kernel, a, b, out, zero_flags, n, 0 };
+
+    if (n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        return kernel(a, b, out, zero_flags, n);
+    }
+    calc_pool_parallel_for(0, (n + 7) / 8, CALC_POOL_BATCH_GRAIN / 8, masked_range, &job);
+    return job.zeros;
+}
+
+/*============================================================================
+ * CPU feature detection
+ *===========================================================================*/
+
+static int supported_isa = -1;  // Best level the CPU supports
+static int active_isa = -1;     // Level in use (forced or supported_isa)
+
+static calc_isa_t detect_isa(void) {
+#if SDK_SIMD_X86
+    // __builtin_cpu_supports also checks the OS saves the wider registers
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return CALC_ISA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return CALC_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return CALC_ISA_SSE2;
+    }
+#endif
+    return CALC_ISA_SCALAR;
+}
+
+static calc_isa_t get_supported_isa(void) {
+    int isa = __atomic_load_n(&supported_isa, __ATOMIC_RELAXED);
+    if (isa < 0) {
+        isa = (int)detect_isa();
+        __atomic_store_n(&supported_isa, isa, __ATOMIC_RELAXED);
+    }
+    return (calc_isa_t)isa;
+}
+
+calc_isa_t calc_batch_isa(void) {
+    int isa = __atomic_load_n(&active_isa, __ATOMIC_RELAXED);
+    if (isa < 0) {
+        isa = (int)get_supported_isa();
+        __atomic_store_n(&active_isa, isa, __ATOMIC_RELAXED);
+    }
+    return (calc_isa_t)isa;
+}
+
+int calc_batch_set_isa(calc_isa_t isa) {
+    if ((int)isa < 0 || isa > get_supported_isa()) {
+        return -1;
+    }
+    __atomic_store_n(&active_isa, (int)isa, __ATOMIC_RELAXED);
+    return 0;
+}
+
+const char* calc_isa_name(calc_isa_t isa) {
+    switch (isa) {
+    case CALC_ISA_SCALAR:
+        return "scalar";
+    case CALC_ISA_SSE2:
+        return "sse2";
+    case CALC_ISA_AVX2:
+        return "avx2";
+    case CALC_ISA_AVX512:
+        return "avx512";
+    }
+    return "unknown";
+}
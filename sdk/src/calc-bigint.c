@@ -0,0 +1,660 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "calc-bigint.h"
+
+#define MIN_KARATSUBA 4         /* Smallest threshold: halves of at least 2 limbs */
+#define DECIMAL_BASE 10000000000000000000ull    /* 10^19, the largest power of 10 in a limb */
+#define DECIMAL_DIGITS 19
+
+typedef unsigned __int128 u128;
+
+/*============================================================================
+ * Scratch arena
+ *
+ * One block per thread. Every public operation computes an upper bound of
+ * its temporaries and reserves it first (the only place the block can be
+ * reallocated, no temporary is alive then); the kernels then take limbs
+ * from it like a stack and give them back by restoring `used`. A
+ * thread-specific key frees the block when its thread exits.
+ *===========================================================================*/
+
+typedef struct {
+    uint64_t *base;
+    size_t capacity;
+    size_t used;
+} limb_arena;
+
+static __thread limb_arena arena;
+static pthread_key_t arena_key;
+static pthread_once_t arena_key_once = PTHREAD_ONCE_INIT;
+static int arena_key_ok;
+
+static size_t karatsuba_limbs = CALC_BIGINT_KARATSUBA_THRESHOLD;
+
+static void arena_destroy(void *p) {
+    limb_arena *a = p;
+
+    free(a->base);
+    a->base = NULL;
+    a->capacity = 0;
+}
+
+static void arena_key_create(void) {
+    arena_key_ok = pthread_key_create(&arena_key, arena_destroy) == 0;
+}
+
+static int arena_reserve(size_t limbs) {
+    arena.used = 0;
+    if (limbs <= arena.capacity) {
+        return 0;
+    }
+    // First block of this thread: have it freed at thread exit
+    if (arena.capacity == 0) {
+        pthread_once(&arena_key_once, arena_key_create);
+        if (arena_key_ok) {
+            pthread_setspecific(arena_key, &arena);
+        }
+    }
+    // Grow geometrically so that slowly growing sizes do not reallocate each time
+    if (limbs < 2 * arena.capacity) {
+        limbs = 2 * arena.capacity;
+    }
+    free(arena.base);
+    arena.base = malloc(limbs * sizeof(uint64_t));
+    arena.capacity = arena.base != NULL ? limbs : 0;
+    return arena.base != NULL ? 0 : -1;
+}
+
+static uint64_t *arena_take(size_t limbs) {
+    uint64_t *p = arena.base + arena.used;
+    arena.used += limbs;
+    return p;
+}
+
+/*============================================================================
+ * Limb kernels
+ *
+ * Magnitudes are arrays of limbs; results may alias the first operand.
+ *===========================================================================*/
+
+/* r = a + b over n limbs, returns the carry */
+static uint64_t limbs_add_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n) {
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        u128 s = (u128)a[i] + b[i] + carry;
+        r[i] = (uint64_t)s;
+        carry = (uint64_t)(s >> 64);
+    }
+    return carry;
+}
+
+/* r = a - b over n limbs, returns the borrow */
+static uint64_t limbs_sub_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n) {
+    uint64_t borrow = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t d = a[i] - b[i];
+        uint64_t next = (a[i] < b[i]) | (d < borrow);
+        r[i] = d - borrow;
+        borrow = next;
+    }
+    return borrow;
+}
+
+/* r = a + b, an >= bn, returns the carry out of limb an - 1 */
+static uint64_t limbs_add(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    uint64_t carry = limbs_add_n(r, a, b, bn);
+
+    for (size_t i = bn; i < an; i++) {
+        r[i] = a[i] + carry;
+        carry = r[i] < carry;
+    }
+    return carry;
+}
+
+/* r = a - b, an >= bn, returns the borrow */
+static uint64_t limbs_sub(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    uint64_t borrow = limbs_sub_n(r, a, b, bn);
+
+    for (size_t i = bn; i < an; i++) {
+        uint64_t x = a[i];      // Read before writing: r may alias a
+        r[i] = x - borrow;
+        borrow = x < borrow;
+    }
+    return borrow;
+}
+
+/* r += t where r has rn >= tn limbs; the carry stops as soon as it is 0 */
+static void limbs_add_into(uint64_t *r, size_t rn, const uint64_t *t, size_t tn) {
+    uint64_t carry = limbs_add_n(r, r, t, tn);
+
+    for (size_t i = tn; carry && i < rn; i++) {
+        r[i] += carry;
+        carry = r[i] == 0;
+    }
+}
+
+/* Compare a and b, zero-extended to their larger size */
+static int limbs_cmp(const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    for (size_t i = an > bn ? an : bn; i-- > 0;) {
+        uint64_t x = i < an ? a[i] : 0;
+        uint64_t y = i < bn ? b[i] : 0;
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/* r = a * m over n limbs, returns the high limb */
+static uint64_t limbs_mul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t m) {
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        u128 p = (u128)a[i] * m + carry;
+        r[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    return carry;
+}
+
+/* r += a * m over n limbs, returns the carry into limb n */
+static uint64_t limbs_addmul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t m) {
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        u128 p = (u128)a[i] * m + r[i] + carry;
+        r[i] = (uint64_t)p;
+        carry = (uint64_t)(p >> 64);
+    }
+    return carry;
+}
+
+/* q = a / d over n limbs (q may be a), returns the remainder */
+static uint64_t limbs_div_1(uint64_t *q, const uint64_t *a, size_t n, uint64_t d) {
+    uint64_t rem = 0;
+
+    for (size_t i = n; i-- > 0;) {
+        u128 num = (u128)rem << 64 | a[i];
+        q[i] = (uint64_t)(num / d);
+        rem = (uint64_t)(num % d);
+    }
+    return rem;
+}
+
+/*============================================================================
+ * Multiplication
+ *
+ * r has room for an + bn limbs and must not overlap the operands.
+ *===========================================================================*/
+
+static void mul_schoolbook(uint64_t *r, const uint64_t *a, size_t an,
+                           const uint64_t *b, size_t bn) {
+    r[an] = limbs_mul_1(r, a, an, b[0]);
+    for (size_t j = 1; j < bn; j++) {
+        r[an + j] = limbs_addmul_1(r + j, a, an, b[j]);
+    }
+}
+
+/* Scratch limbs of mul_karatsuba on n limbs: 6h + 1 per level, h = ceil(n / 2) */
+static size_t karatsuba_scratch(size_t n, size_t threshold) {
+    size_t total = 0;
+
+    while (n >= threshold) {
+        size_t h = n - n / 2;
+        total += 6 * h + 1;
+        n = h;
+    }
+    return total;
+}
+
+/*
+ * r = a * b, both n limbs. With a = a1 B^l + a0 and b = b1 B^l + b0:
+ * a1 b0 + a0 b1 = a0 b0 + a1 b1 - (a1 - a0)(b1 - b0), three half-size
+ * products instead of four. The differences are kept as magnitude and
+ * sign so that no carry limb is needed.
+ */
+static void mul_karatsuba(uint64_t *r, const uint64_t *a, const uint64_t *b,
+                          size_t n, size_t threshold) {
+    size_t l = n / 2;
+    size_t h = n - l;
+    size_t mark = arena.used;
+    uint64_t *da, *db, *t, *mid;
+    int neg;
+
+    if (n < threshold) {
+        mul_schoolbook(r, a, n, b, n);
+        return;
+    }
+    da = arena_take(h);
+    db = arena_take(h);
+    t = arena_take(2 * h);
+    mid = arena_take(2 * h + 1);
+
+    // |a1 - a0| and |b1 - b0| in h limbs; if a1 < a0, a1 fits in l limbs
+    neg = 0;
+    if (limbs_cmp(a + l, h, a, l) >= 0) {
+        limbs_sub(da, a + l, h, a, l);
+    } else {
+        limbs_sub_n(da, a, a + l, l);
+        da[h - 1] = h > l ? 0 : da[h - 1];
+        neg ^= 1;
+    }
+    if (limbs_cmp(b + l, h, b, l) >= 0) {
+        limbs_sub(db, b + l, h, b, l);
+    } else {
+        limbs_sub_n(db, b, b + l, l);
+        db[h - 1] = h > l ? 0 : db[h - 1];
+        neg ^= 1;
+    }
+
+    mul_karatsuba(r, a, b, l, threshold);                   // a0 b0 in r[0, 2l)
+    mul_karatsuba(r + 2 * l, a + l, b + l, h, threshold);   // a1 b1 in r[2l, 2n)
+    mul_karatsuba(t, da, db, h, threshold);
+
+    mid[2 * h] = limbs_add(mid, r + 2 * l, 2 * h, r, 2 * l);
+    if (neg) {
+        limbs_add(mid, mid, 2 * h + 1, t, 2 * h);
+    } else {
+        limbs_sub(mid, mid, 2 * h + 1, t, 2 * h);
+    }
+    limbs_add_into(r + l, l + 2 * h, mid, 2 * h + 1);
+    arena.used = mark;
+}
+
+/* Scratch limbs of mul_limbs(an, bn), an >= bn */
+static size_t mul_scratch(size_t an, size_t bn, size_t threshold) {
+    if (bn < threshold) {
+        return 0;
+    }
+    if (an == bn) {
+        return karatsuba_scratch(bn, threshold);
+    }
+    size_t rest = an % bn;
+    size_t piece = karatsuba_scratch(bn, threshold);
+    size_t tail = rest ? mul_scratch(bn, rest, threshold) : 0;
+    return 2 * bn + (piece > tail ? piece : tail);
+}
+
+/* r = a * b, an >= bn >= 1 */
+static void mul_limbs(uint64_t *r, const uint64_t *a, size_t an,
+                      const uint64_t *b, size_t bn, size_t threshold) {
+    size_t mark = arena.used;
+    uint64_t *t;
+
+    if (bn < threshold) {
+        mul_schoolbook(r, a, an, b, bn);
+        return;
+    }
+    if (an == bn) {
+        mul_karatsuba(r, a, b, bn, threshold);
+        return;
+    }
+    // Unbalanced: pieces of a the size of b, each product added in place
+    t = arena_take(2 * bn);
+    memset(r, 0, (an + bn) * sizeof(uint64_t));
+    for (size_t i = 0; i < an; i += bn) {
+        size_t piece = an - i < bn ? an - i : bn;
+        if (piece == bn) {
+            mul_karatsuba(t, a + i, b, bn, threshold);
+        } else {
+            mul_limbs(t, b, bn, a + i, piece, threshold);
+        }
+        limbs_add_into(r + i, an + bn - i, t, piece + bn);
+    }
+    arena.used = mark;
+}
+
+/*============================================================================
+ * Division (Knuth, TAOCP vol. 2, 4.3.1, algorithm D)
+ *===========================================================================*/
+
+/*
+ * q (un - vn + 1 limbs) and rem (vn limbs) of u / v, un >= vn >= 2, the
+ * top limb of v not 0. Takes un + vn + 1 scratch limbs.
+ */
+static void div_knuth(uint64_t *q, uint64_t *rem, const uint64_t *u, size_t un,
+                      const uint64_t *v, size_t vn) {
+    size_t mark = arena.used;
+    int s = __builtin_clzll(v[vn - 1]);
+    uint64_t *nv = arena_take(vn);
+    uint64_t *nu = arena_take(un + 1);
+
+    // Normalize: shift so that the top bit of v is set
+    for (size_t i = vn - 1; i > 0; i--) {
+        nv[i] = s ? v[i] << s | v[i - 1] >> (64 - s) : v[i];
+    }
+    nv[0] = v[0] << s;
+    nu[un] = s ? u[un - 1] >> (64 - s) : 0;
+    for (size_t i = un - 1; i > 0; i--) {
+        nu[i] = s ? u[i] << s | u[i - 1] >> (64 - s) : u[i];
+    }
+    nu[0] = u[0] << s;
+
+    for (size_t j = un - vn + 1; j-- > 0;) {
+        // Estimate from the top two limbs, then correct with the third
+        u128 num = (u128)nu[j + vn] << 64 | nu[j + vn - 1];
+        u128 qhat = num / nv[vn - 1];
+        u128 rhat = num % nv[vn - 1];
+        while (qhat >> 64 || qhat * nv[vn - 2] > (rhat << 64 | nu[j + vn - 2])) {
+            qhat--;
+            rhat += nv[vn - 1];
+            if (rhat >> 64) {
+                break;
+            }
+        }
+
+        // nu[j, j + vn] -= qhat * nv
+        uint64_t borrow = 0;
+        uint64_t carry = 0;
+        for (size_t i = 0; i < vn; i++) {
+            u128 p = qhat * nv[i] + carry;
+            uint64_t lo = (uint64_t)p;
+            uint64_t d = nu[i + j] - lo;
+            carry = (uint64_t)(p >> 64);
+            uint64_t next = (nu[i + j] < lo) | (d < borrow);
+            nu[i + j] = d - borrow;
+            borrow = next;
+        }
+        uint64_t top = nu[j + vn];
+        nu[j + vn] = top - carry - borrow;
+        q[j] = (uint64_t)qhat;
+
+        // Rarely one too many: add v back
+        if (top < carry || top - carry < borrow) {
+            q[j]--;
+            nu[j + vn] += limbs_add_n(nu + j, nu + j, nv, vn);
+        }
+    }
+
+    for (size_t i = 0; i < vn; i++) {
+        rem[i] = s ? nu[i] >> s | nu[i + 1] << (64 - s) : nu[i];
+    }
+    arena.used = mark;
+}
+
+/*============================================================================
+ * Numbers
+ *===========================================================================*/
+
+static int reserve(calc_bigint_t *x, size_t limbs) {
+    uint64_t *p;
+
+    if (limbs <= x->capacity) {
+        return 0;
+    }
+    p = realloc(x->limbs, limbs * sizeof(uint64_t));
+    if (p == NULL) {
+        return -1;
+    }
+    x->limbs = p;
+    x->capacity = limbs;
+    return 0;
+}
+
+/* Drop leading zero limbs; 0 is never negative */
+static void normalize(calc_bigint_t *x, size_t size, int negative) {
+    while (size > 0 && x->limbs[size - 1] == 0) {
+        size--;
+    }
+    x->size = size;
+    x->negative = size > 0 && negative;
+}
+
+/* out = magnitude from limbs (may be in the arena, not in out) */
+static int assign(calc_bigint_t *out, const uint64_t *limbs, size_t size, int negative) {
+    if (reserve(out, size) != 0) {
+        return -1;
+    }
+    if (size > 0) {
+        memcpy(out->limbs, limbs, size * sizeof(uint64_t));
+    }
+    normalize(out, size, negative);
+    return 0;
+}
+
+void calc_bigint_init(calc_bigint_t *x) {
+    calc_bigint_t zero = CALC_BIGINT_INIT;
+    *x = zero;
+}
+
+void calc_bigint_free(calc_bigint_t *x) {
+    free(x->limbs);
+    calc_bigint_init(x);
+}
+
+int calc_bigint_set_i64(calc_bigint_t *x, int64_t v) {
+    uint64_t magnitude = v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+    return assign(x, &magnitude, 1, v < 0);
+}
+
+int calc_bigint_copy(calc_bigint_t *dst, const calc_bigint_t *src) {
+    return dst == src ? 0 : assign(dst, src->limbs, src->size, src->negative);
+}
+
+calc_status_t calc_bigint_to_i64(const calc_bigint_t *x, int64_t *v) {
+    uint64_t magnitude = x->size > 0 ? x->limbs[0] : 0;
+    uint64_t limit = x->negative ? (uint64_t)1 << 63 : ((uint64_t)1 << 63) - 1;
+
+    *v = (int64_t)(x->negative ? 0 - magnitude : magnitude);
+    return x->size <= 1 && magnitude <= limit ? CALC_OK : CALC_ERR_OVERFLOW;
+}
+
+int calc_bigint_set_str(calc_bigint_t *x, const char *s) {
+    int negative = *s == '-';
+    size_t digits;
+    size_t size = 0;
+
+    s += *s == '-' || *s == '+';
+    digits = strspn(s, "0123456789");
+    if (digits == 0 || s[digits] != '\0' || reserve(x, digits / DECIMAL_DIGITS + 1) != 0) {
+        return -1;
+    }
+    // Chunks of up to 19 digits: x = x * 10^k + chunk
+    for (size_t i = 0; i < digits;) {
+        size_t k = (digits - i) % DECIMAL_DIGITS ? (digits - i) % DECIMAL_DIGITS : DECIMAL_DIGITS;
+        uint64_t chunk = 0, scale = 1;
+        for (size_t end = i + k; i < end; i++) {
+            chunk = chunk * 10 + (uint64_t)(s[i] - '0');
+            scale *= 10;
+        }
+        uint64_t carry = limbs_mul_1(x->limbs, x->limbs, size, scale);
+        for (size_t j = 0; chunk && j < size; j++) {
+            x->limbs[j] += chunk;
+            chunk = x->limbs[j] < chunk;
+        }
+        // carry < 10^19, so adding the last carry of the chunk cannot wrap
+        carry += chunk;
+        if (carry) {
+            x->limbs[size++] = carry;
+        }
+    }
+    normalize(x, size, negative);
+    return 0;
+}
+
+size_t calc_bigint_to_str(const calc_bigint_t *x, char *buf, size_t size) {
+    size_t n = x->size;
+    size_t chunks = 0;
+    size_t length;
+    uint64_t *t, *digits;
+    char head[DECIMAL_DIGITS + 2];
+
+    if (arena_reserve(n + n * 64 / 63 + 1) != 0) {
+        return 0;
+    }
+    t = arena_take(n);
+    digits = arena_take(n * 64 / 63 + 1);
+    if (n > 0) {
+        memcpy(t, x->limbs, n * sizeof(uint64_t));
+    }
+    // Groups of 19 digits, least significant first
+    do {
+        digits[chunks++] = limbs_div_1(t, t, n, DECIMAL_BASE);
+        while (n > 0 && t[n - 1] == 0) {
+            n--;
+        }
+    } while (n > 0);
+
+    length = (size_t)snprintf(head, sizeof(head), "%s%llu", x->negative ? "-" : "",
+                              (unsigned long long)digits[chunks - 1]);
+    length += (chunks - 1) * DECIMAL_DIGITS;
+    if (size > 0) {
+        char *end = buf + size - 1;
+        char *p = buf;
+        for (const char *h = head; *h && p < end; h++) {
+            *p++ = *h;
+        }
+        for (size_t c = chunks - 1; c-- > 0 && p < end;) {
+            char group[DECIMAL_DIGITS + 1];
+            snprintf(group, sizeof(group), "%019llu", (unsigned long long)digits[c]);
+            for (const char *g = group; *g && p < end; g++) {
+                *p++ = *g;
+            }
+        }
+        *p = '\0';
+    }
+    return length;
+}
+
+int calc_bigint_compare(const calc_bigint_t *a, const calc_bigint_t *b) {
+    int c;
+
+    if (a->negative != b->negative) {
+        return a->negative ? -1 : 1;
+    }
+    c = a->size != b->size ? (a->size < b->size ? -1 : 1)
+                           : limbs_cmp(a->limbs, a->size, b->limbs, b->size);
+    return a->negative ? -c : c;
+}
+
+/*============================================================================
+ * Arithmetic
+ *===========================================================================*/
+
+/* out = a + (-1)^b_negative |b| */
+static int add_signed(const calc_bigint_t *a, const calc_bigint_t *b, int b_negative,
+                      calc_bigint_t *out) {
+    size_t an = a->size, bn = b->size;
+    int a_negative = a->negative;
+    const calc_bigint_t *big = a, *small = b;
+    int negative = a_negative;
+
+    // Grow first: out may be a or b, whose limbs move with it
+    if (reserve(out, (an > bn ? an : bn) + 1) != 0) {
+        return -1;
+    }
+    if (a_negative == b_negative) {
+        if (an < bn) {
+            big = b;
+            small = a;
+        }
+        out->limbs[big->size] = limbs_add(out->limbs, big->limbs, big->size,
+                                          small->limbs, small->size);
+        normalize(out, big->size + 1, negative);
+        return 0;
+    }
+    // Different signs: the larger magnitude minus the smaller one
+    if (an < bn || (an == bn && limbs_cmp(a->limbs, an, b->limbs, bn) < 0)) {
+        big = b;
+        small = a;
+        negative = b_negative;
+    }
+    limbs_sub(out->limbs, big->limbs, big->size, small->limbs, small->size);
+    normalize(out, big->size, negative);
+    return 0;
+}
+
+int calc_bigint_add(const calc_bigint_t *a, const calc_bigint_t *b, calc_bigint_t *out) {
+    return add_signed(a, b, b->negative, out);
+}
+
+int calc_bigint_subtract(const calc_bigint_t *a, const calc_bigint_t *b, calc_bigint_t *out) {
+    return add_signed(a, b, !b->negative && b->size > 0, out);
+}
+
+int calc_bigint_multiply(const calc_bigint_t *a, const calc_bigint_t *b, calc_bigint_t *out) {
+    size_t threshold = calc_bigint_karatsuba_threshold();
+    int negative = a->negative != b->negative;
+    uint64_t *r;
+
+    if (a->size == 0 || b->size == 0) {
+        normalize(out, 0, 0);
+        return 0;
+    }
+    if (a->size < b->size) {
+        const calc_bigint_t *t = a;
+        a = b;
+        b = t;
+    }
+    if (arena_reserve(a->size + b->size + mul_scratch(a->size, b->size, threshold)) != 0) {
+        return -1;
+    }
+    r = arena_take(a->size + b->size);
+    mul_limbs(r, a->limbs, a->size, b->limbs, b->size, threshold);
+    return assign(out, r, a->size + b->size, negative);
+}
+
+int calc_bigint_divide(const calc_bigint_t *a, const calc_bigint_t *b,
+                       calc_bigint_t *quotient, calc_bigint_t *remainder) {
+    size_t an = a->size, bn = b->size;
+    int q_negative = a->negative != b->negative;
+    int r_negative = a->negative;
+    uint64_t *q, *r;
+
+    if (bn == 0 || an < bn) {
+        // Zero divisor: 0 and 0, like calc_divide; |a| < |b|: 0 and a
+        if (remainder != NULL) {
+            if (bn == 0) {
+                normalize(remainder, 0, 0);
+            } else if (calc_bigint_copy(remainder, a) != 0) {
+                return -1;
+            }
+        }
+        if (quotient != NULL) {
+            normalize(quotient, 0, 0);
+        }
+        return 0;
+    }
+    if (arena_reserve((an - bn + 1) + bn + (an + bn + 1)) != 0) {
+        return -1;
+    }
+    q = arena_take(an - bn + 1);
+    r = arena_take(bn);
+    if (bn == 1) {
+        r[0] = limbs_div_1(q, a->limbs, an, b->limbs[0]);
+    } else {
+        div_knuth(q, r, a->limbs, an, b->limbs, bn);
+    }
+    // Both results are in the arena: writing one cannot clobber the operands of the other
+    if (quotient != NULL && assign(quotient, q, an - bn + 1, q_negative) != 0) {
+        return -1;
+    }
+    if (remainder != NULL && assign(remainder, r, bn, r_negative) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Tuning
+ *===========================================================================*/
+
+void calc_bigint_set_karatsuba_threshold(size_t limbs) {
+    __atomic_store_n(&karatsuba_limbs, limbs < MIN_KARATSUBA ? MIN_KARATSUBA : limbs,
+                     __ATOMIC_RELAXED);
+}
+
+size_t calc_bigint_karatsuba_threshold(void) {
+    return __atomic_load_n(&karatsuba_limbs, __ATOMIC_RELAXED);
+}
+
+void calc_bigint_release_scratch(void) {
+    free(arena.base);
+    arena.base = NULL;
+    arena.capacity = 0;
+    arena.used = 0;
+}
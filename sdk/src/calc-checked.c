@@ -0,0 +1,270 @@
+#include <limits.h>
+#include "calc-checked.h"
+#include "calc-batch.h"
+#include "simd.h"
+
+/*============================================================================
+ * Scalar checked functions
+ *===========================================================================*/
+
+calc_status_t calc_add_checked(int a, int b, int *result) {
+    return __builtin_add_overflow(a, b, result) ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t calc_subtract_checked(int a, int b, int *result) {
+    return __builtin_sub_overflow(a, b, result) ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t calc_multiply_checked(int a, int b, int *result) {
+    return __builtin_mul_overflow(a, b, result) ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t calc_divide_checked(int a, int b, int *result) {
+    if (b == 0) {
+        *result = 0;
+        return CALC_ERR_DIV_BY_ZERO;
+    }
+    if (a == INT_MIN && b == -1) {
+        *result = INT_MIN;
+        return CALC_ERR_OVERFLOW;
+    }
+    *result = a / b;
+    return CALC_OK;
+}
+
+/*============================================================================
+ * Scalar batch kernels
+ *
+ * Work in groups of 8 elements so each group produces one bitmap byte.
+ * SIMD kernels hand their tail over at a multiple of 8, so the tail always
+ * starts on a byte boundary of the bitmap.
+ *===========================================================================*/
+
+typedef size_t (*checked_kernel)(const int *a, const int *b, int *out,
+                                 unsigned char *flags, size_t n);
+
+#define SCALAR_CHECKED_KERNEL(name, builtin)                                  \
+    static size_t name(const int *a, const int *b, int *out,                  \
+                       unsigned char *flags, size_t n) {                      \
+        size_t count = 0;                                                     \
+        for (size_t i = 0; i < n; i += 8) {                                   \
+            size_t len = (n - i < 8) ? n - i : 8;                             \
+            unsigned bits = 0;                                                \
+            for (size_t j = 0; j < len; j++) {                                \
+                int r;                                                        \
+                bits |= (unsigned)builtin(a[i + j], b[i + j], &r) << j;       \
+                out[i + j] = r;                                               \
+            }                                                                 \
+            count += (size_t)__builtin_popcount(bits);                        \
+            if (flags != NULL) {                                              \
+                flags[i / 8] = (unsigned char)bits;                           \
+            }                                                                 \
+        }                                                                     \
+        return count;                                                         \
+    }
+
+SCALAR_CHECKED_KERNEL(add_checked_scalar, __builtin_add_overflow)
+SCALAR_CHECKED_KERNEL(subtract_checked_scalar, __builtin_sub_overflow)
+SCALAR_CHECKED_KERNEL(multiply_checked_scalar, __builtin_mul_overflow)
+
+static size_t divide_checked_scalar(const int *a, const int *b, int *out,
+                                    unsigned char *flags, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i += 8) {
+        size_t len = (n - i < 8) ? n - i : 8;
+        unsigned bits = 0;
+        for (size_t j = 0; j < len; j++) {
+            int r;
+            bits |= (unsigned)(calc_divide_checked(a[i + j], b[i + j], &r) != CALC_OK) << j;
+            out[i + j] = r;
+        }
+        count += (size_t)__builtin_popcount(bits);
+        if (flags != NULL) {
+            flags[i / 8] = (unsigned char)bits;
+        }
+    }
+    return count;
+}
+
+#if SDK_SIMD_X86
+
+/*
+ * Generate a SIMD kernel that handles `width` elements per step. `op`
+ * computes one step, stores the wrapped results and returns the overflow
+ * mask of the step (bit j = element j).
+ */
+#define SIMD_CHECKED_KERNEL(name, target, width, op, tail)                   \
+    target static size_t name(const int *a, const int *b, int *out,          \
+                              unsigned char *flags, size_t n) {              \
+        size_t count = 0;                                                    \
+        size_t i = 0;                                                        \
+        for (; i + (width) <= n; i += (width)) {                             \
+            unsigned bits = op(a + i, b + i, out + i);                       \
+            count += (size_t)__builtin_popcount(bits);                       \
+            if (flags != NULL) {                                             \
+                for (size_t k = 0; k < (width) / 8; k++) {                   \
+                    flags[i / 8 + k] = (unsigned char)(bits >> (8 * k));     \
+                }                                                            \
+            }                                                                \
+        }                                                                    \
+        return count + tail(a + i, b + i, out + i,                           \
+                            flags != NULL ? flags + i / 8 : NULL, n - i);    \
+    }
+
+/*
+ * Signed overflow of r = a + b happened iff a and b have the same sign and
+ * r has a different one: sign bit of (a ^ r) & (b ^ r).
+ * For r = a - b: sign bit of (a ^ b) & (a ^ r).
+ */
+
+/*============================================================================
+ * SSE2 kernels (two vectors per step, so each step fills one bitmap byte)
+ *===========================================================================*/
+
+SDK_TARGET_SSE2 static inline unsigned add_ovf_sse2(__m128i a, __m128i b, int *out) {
+    __m128i r = _mm_add_epi32(a, b);
+    _mm_storeu_si128((__m128i *)(void *)out, r);
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(
+        _mm_and_si128(_mm_xor_si128(a, r), _mm_xor_si128(b, r))));
+}
+
+SDK_TARGET_SSE2 static inline unsigned sub_ovf_sse2(__m128i a, __m128i b, int *out) {
+    __m128i r = _mm_sub_epi32(a, b);
+    _mm_storeu_si128((__m128i *)(void *)out, r);
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(
+        _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, r))));
+}
+
+#define SSE2_STEP(name, vec_op)                                              \
+    SDK_TARGET_SSE2 static inline unsigned name(const int *a, const int *b, int *out) { \
+        __m128i a0 = _mm_loadu_si128((const __m128i *)(const void *)a);      \
+        __m128i b0 = _mm_loadu_si128((const __m128i *)(const void *)b);      \
+        __m128i a1 = _mm_loadu_si128((const __m128i *)(const void *)(a + 4)); \
+        __m128i b1 = _mm_loadu_si128((const __m128i *)(const void *)(b + 4)); \
+        unsigned lo = vec_op(a0, b0, out);                                   \
+        return lo | (vec_op(a1, b1, out + 4) << 4);                          \
+    }
+
+SSE2_STEP(add_step_sse2, add_ovf_sse2)
+SSE2_STEP(sub_step_sse2, sub_ovf_sse2)
+
+SIMD_CHECKED_KERNEL(add_checked_sse2, SDK_TARGET_SSE2, 8, add_step_sse2, add_checked_scalar)
+SIMD_CHECKED_KERNEL(subtract_checked_sse2, SDK_TARGET_SSE2, 8, sub_step_sse2, subtract_checked_scalar)
+
+/*============================================================================
+ * AVX2 kernels (8 x int32, one bitmap byte per step)
+ *===========================================================================*/
+
+SDK_TARGET_AVX2 static inline unsigned add_ovf_avx2(__m256i a, __m256i b, int *out) {
+    unsigned overflow;
+    _mm256_storeu_si256((__m256i *)(void *)out, add_wrap_avx2(a, b, &overflow));
+    return overflow;
+}
+
+SDK_TARGET_AVX2 static inline unsigned sub_ovf_avx2(__m256i a, __m256i b, int *out) {
+    __m256i r = _mm256_sub_epi32(a, b);
+    _mm256_storeu_si256((__m256i *)(void *)out, r);
+    return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, r))));
+}
+
+SDK_TARGET_AVX2 static inline unsigned mul_ovf_avx2(__m256i a, __m256i b, int *out) {
+    unsigned overflow;
+    _mm256_storeu_si256((__m256i *)(void *)out, mullo_wrap_avx2(a, b, &overflow));
+    return overflow;
+}
+
+#define AVX2_STEP(name, vec_op)                                              \
+    SDK_TARGET_AVX2 static inline unsigned name(const int *a, const int *b, int *out) { \
+        return vec_op(_mm256_loadu_si256((const __m256i *)(const void *)a),  \
+                      _mm256_loadu_si256((const __m256i *)(const void *)b), out); \
+    }
+
+AVX2_STEP(add_step_avx2, add_ovf_avx2)
+AVX2_STEP(sub_step_avx2, sub_ovf_avx2)
+AVX2_STEP(mul_step_avx2, mul_ovf_avx2)
+
+SIMD_CHECKED_KERNEL(add_checked_avx2, SDK_TARGET_AVX2, 8, add_step_avx2, add_checked_scalar)
+SIMD_CHECKED_KERNEL(subtract_checked_avx2, SDK_TARGET_AVX2, 8, sub_step_avx2, subtract_checked_scalar)
+SIMD_CHECKED_KERNEL(multiply_checked_avx2, SDK_TARGET_AVX2, 8, mul_step_avx2, multiply_checked_scalar)
+
+/*============================================================================
+ * AVX-512 kernels (16 x int32, two bitmap bytes per step)
+ *===========================================================================*/
+
+SDK_TARGET_AVX512 static inline unsigned add_ovf_avx512(__m512i a, __m512i b, int *out) {
+    unsigned overflow;
+    _mm512_storeu_si512((void *)out, add_wrap_avx512(a, b, &overflow));
+    return overflow;
+}
+
+SDK_TARGET_AVX512 static inline unsigned sub_ovf_avx512(__m512i a, __m512i b, int *out) {
+    __m512i r = _mm512_sub_epi32(a, b);
+    _mm512_storeu_si512((void *)out, r);
+    return _mm512_cmplt_epi32_mask(
+        _mm512_and_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(a, r)),
+        _mm512_setzero_si512());
+}
+
+SDK_TARGET_AVX512 static inline unsigned mul_ovf_avx512(__m512i a, __m512i b, int *out) {
+    unsigned overflow;
+    _mm512_storeu_si512((void *)out, mullo_wrap_avx512(a, b, &overflow));
+    return overflow;
+}
+
+#define AVX512_STEP(name, vec_op)                                            \
+    SDK_TARGET_AVX512 static inline unsigned name(const int *a, const int *b, int *out) { \
+        return vec_op(_mm512_loadu_si512((const void *)a),                   \
+                      _mm512_loadu_si512((const void *)b), out);             \
+    }
+
+AVX512_STEP(add_step_avx512, add_ovf_avx512)
+AVX512_STEP(sub_step_avx512, sub_ovf_avx512)
+AVX512_STEP(mul_step_avx512, mul_ovf_avx512)
+
+SIMD_CHECKED_KERNEL(add_checked_avx512, SDK_TARGET_AVX512, 16, add_step_avx512, add_checked_scalar)
+SIMD_CHECKED_KERNEL(subtract_checked_avx512, SDK_TARGET_AVX512, 16, sub_step_avx512, subtract_checked_scalar)
+SIMD_CHECKED_KERNEL(multiply_checked_avx512, SDK_TARGET_AVX512, 16, mul_step_avx512, multiply_checked_scalar)
+
+/*============================================================================
+ * Dispatch tables, indexed by calc_isa_t
+ *
+ * SSE2 has no signed 32x32->64 multiply, so multiply falls back to the
+ * overflow builtins there. Division is dominated by the divide itself and
+ * always uses the fused scalar loop.
+ *===========================================================================*/
+
+static const checked_kernel add_kernels[] = {
+    add_checked_scalar, add_checked_sse2, add_checked_avx2, add_checked_avx512,
+};
+static const checked_kernel subtract_kernels[] = {
+    subtract_checked_scalar, subtract_checked_sse2, subtract_checked_avx2, subtract_checked_avx512,
+};
+static const checked_kernel multiply_kernels[] = {
+    multiply_checked_scalar, multiply_checked_scalar, multiply_checked_avx2, multiply_checked_avx512,
+};
+#else
+static const checked_kernel add_kernels[] = { add_checked_scalar };
+static const checked_kernel subtract_kernels[] = { subtract_checked_scalar };
+static const checked_kernel multiply_kernels[] = { multiply_checked_scalar };
+#endif /* SDK_SIMD_X86 */
+
+size_t calc_add_checked_batch(const int *a, const int *b, int *out,
+                              unsigned char *flags, size_t n) {
+    return add_kernels[calc_batch_isa()](a, b, out, flags, n);
+}
+
+size_t calc_subtract_checked_batch(const int *a, const int *b, int *out,
+                                   unsigned char *flags, size_t n) {
+    return subtract_kernels[calc_batch_isa()](a, b, out, flags, n);
+}
+
+size_t calc_multiply_checked_batch(const int *a, const int *b, int *out,
+                                   unsigned char *flags, size_t n) {
+    return multiply_kernels[calc_batch_isa()](a, b, out, flags, n);
+}
+
+size_t calc_divide_checked_batch(const int *a, const int *b, int *out,
+                                 unsigned char *flags, size_t n) {
+    return divide_checked_scalar(a, b, out, flags, n);
+}
@@ -0,0 +1,233 @@
+#include <stdint.h>
+#include <string.h>
+#include "calc-divider.h"
+#include "calc-batch.h"
+#include "simd.h"
+
+/* Values of calc_divider_t.kind */
+enum {
+    DIVIDER_ZERO = 0,   /* divisor 0: quotient is always 0 */
+    DIVIDER_ONE,        /* divisor +-1: copy or negate */
+    DIVIDER_INT_MIN,    /* divisor INT_MIN: quotient is 1 for INT_MIN, else 0 */
+    DIVIDER_MAGIC,      /* 2 <= |divisor| < 2^31: multiply by magic number */
+};
+
+/*============================================================================
+ * Magic number computation
+ *
+ * Hacker's Delight, 2nd ed., figure 10-1: find the smallest shift p >= 32
+ * such that M = ceil(2^p / |d|) gives exact truncated quotients for every
+ * 32-bit dividend, then q = (mulhs(M, a) [+/- a]) >> (p - 32), plus 1 when
+ * the result is negative.
+ *===========================================================================*/
+
+void calc_divider_init(calc_divider_t *d, int divisor) {
+    memset(d, 0, sizeof(*d));
+    d->divisor = divisor;
+
+    if (divisor == 0) {
+        d->kind = DIVIDER_ZERO;
+        return;
+    }
+    if (divisor == 1 || divisor == -1) {
+        d->kind = DIVIDER_ONE;
+        return;
+    }
+    if (divisor == INT32_MIN) {
+        d->kind = DIVIDER_INT_MIN;
+        return;
+    }
+
+    const uint32_t two31 = 0x80000000u;
+    uint32_t ad = divisor < 0 ? 0u - (uint32_t)divisor : (uint32_t)divisor;
+    uint32_t t = two31 + ((uint32_t)divisor >> 31);
+    uint32_t anc = t - 1 - t % ad;      // Absolute value of nc
+    uint32_t q1 = two31 / anc;
+    uint32_t r1 = two31 - q1 * anc;
+    uint32_t q2 = two31 / ad;
+    uint32_t r2 = two31 - q2 * ad;
+    uint32_t delta;
+    int p = 31;
+
+    do {
+        p++;
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= anc) {
+            q1++;
+            r1 -= anc;
+        }
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= ad) {
+            q2++;
+            r2 -= ad;
+        }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    uint32_t magic = q2 + 1;
+    if (divisor < 0) {
+        magic = 0u - magic;
+    }
+    d->magic = (int)magic;
+    d->shift = p - 32;
+    // The magic number does not fit in a signed int for some divisors;
+    // its sign flip is compensated by adding (or subtracting) the dividend
+    if (divisor > 0 && d->magic < 0) {
+        d->add = 1;
+    } else if (divisor < 0 && d->magic > 0) {
+        d->add = -1;
+    }
+    d->kind = DIVIDER_MAGIC;
+}
+
+/*============================================================================
+ * Scalar division
+ *===========================================================================*/
+
+static inline int divide_magic(const calc_divider_t *d, int a) {
+    int32_t q = (int32_t)(((int64_t)a * d->magic) >> 32);
+    q = (int32_t)((uint32_t)q + (uint32_t)a * (uint32_t)d->add);
+    q >>= d->shift;
+    return (int)((uint32_t)q + ((uint32_t)q >> 31));
+}
+
+static inline int divide_one(const calc_divider_t *d, int a) {
+    // Negating INT_MIN wraps to INT_MIN
+    return d->divisor == 1 ? a : (int)(0u - (uint32_t)a);
+}
+
+int calc_divider_divide(const calc_divider_t *d, int a) {
+    switch (d->kind) {
+    case DIVIDER_MAGIC:
+        return divide_magic(d, a);
+    case DIVIDER_ONE:
+        return divide_one(d, a);
+    case DIVIDER_INT_MIN:
+        return a == INT32_MIN;
+    default:
+        return 0;
+    }
+}
+
+/*============================================================================
+ * Batch kernels for the magic number path
+ *===========================================================================*/
+
+typedef void (*magic_kernel)(const calc_divider_t *d, const int *a, int *out, size_t n);
+
+static void magic_scalar(const calc_divider_t *d, const int *a, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = divide_magic(d, a[i]);
+    }
+}
+
+#if SDK_SIMD_X86
+
+/*
+ * The add correction is applied as (a ^ neg) - neg masked by `use`:
+ * neg is all ones to subtract the dividend, `use` is all ones when a
+ * correction is needed at all.
+ */
+
+SDK_TARGET_SSE2 static void magic_sse2(const calc_divider_t *d, const int *a, int *out, size_t n) {
+    const __m128i magic = _mm_set1_epi32(d->magic);
+    const __m128i neg = _mm_set1_epi32(d->add < 0 ? -1 : 0);
+    const __m128i use = _mm_set1_epi32(d->add != 0 ? -1 : 0);
+    // SSE2 only has an unsigned 32x32->64 multiply: fix up the high half,
+    // mulhs(a, m) = mulhu(a, m) - (a < 0 ? m : 0) - (m < 0 ? a : 0)
+    const __m128i magic_neg = _mm_srai_epi32(magic, 31);
+    const __m128i shift = _mm_cvtsi32_si128(d->shift);
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(const void *)(a + i));
+        __m128i even = _mm_mul_epu32(va, magic);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(va, 32), magic);
+        __m128i hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 3, 1)),
+                                        _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 3, 1)));
+        hi = _mm_sub_epi32(hi, _mm_and_si128(_mm_srai_epi32(va, 31), magic));
+        hi = _mm_sub_epi32(hi, _mm_and_si128(magic_neg, va));
+        __m128i corr = _mm_sub_epi32(_mm_xor_si128(va, neg), neg);
+        __m128i q = _mm_add_epi32(hi, _mm_and_si128(corr, use));
+        q = _mm_sra_epi32(q, shift);
+        q = _mm_add_epi32(q, _mm_srli_epi32(q, 31));
+        _mm_storeu_si128((__m128i *)(void *)(out + i), q);
+    }
+    magic_scalar(d, a + i, out + i, n - i);
+}
+
+SDK_TARGET_AVX2 static void magic_avx2(const calc_divider_t *d, const int *a, int *out, size_t n) {
+    const __m256i magic = _mm256_set1_epi32(d->magic);
+    const __m256i neg = _mm256_set1_epi32(d->add < 0 ? -1 : 0);
+    const __m256i use = _mm256_set1_epi32(d->add != 0 ? -1 : 0);
+    const __m128i shift = _mm_cvtsi32_si128(d->shift);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(const void *)(a + i));
+        // High halves of the signed 64-bit products: even lanes shifted
+        // down, odd lanes already in place
+        __m256i even = _mm256_mul_epi32(va, magic);
+        __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(va, 32), magic);
+        __m256i hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        __m256i corr = _mm256_sub_epi32(_mm256_xor_si256(va, neg), neg);
+        __m256i q = _mm256_add_epi32(hi, _mm256_and_si256(corr, use));
+        q = _mm256_sra_epi32(q, shift);
+        q = _mm256_add_epi32(q, _mm256_srli_epi32(q, 31));
+        _mm256_storeu_si256((__m256i *)(void *)(out + i), q);
+    }
+    magic_scalar(d, a + i, out + i, n - i);
+}
+
+SDK_TARGET_AVX512 static void magic_avx512(const calc_divider_t *d, const int *a, int *out, size_t n) {
+    const __m512i magic = _mm512_set1_epi32(d->magic);
+    const __m512i neg = _mm512_set1_epi32(d->add < 0 ? -1 : 0);
+    const __m512i use = _mm512_set1_epi32(d->add != 0 ? -1 : 0);
+    const __m128i shift = _mm_cvtsi32_si128(d->shift);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m512i va = _mm512_loadu_si512((const void *)(a + i));
+        __m512i even = _mm512_mul_epi32(va, magic);
+        __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(va, 32), magic);
+        __m512i hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+        __m512i corr = _mm512_sub_epi32(_mm512_xor_si512(va, neg), neg);
+        __m512i q = _mm512_add_epi32(hi, _mm512_and_si512(corr, use));
+        q = _mm512_sra_epi32(q, shift);
+        q = _mm512_add_epi32(q, _mm512_srli_epi32(q, 31));
+        _mm512_storeu_si512((void *)(out + i), q);
+    }
+    magic_scalar(d, a + i, out + i, n - i);
+}
+
+static const magic_kernel magic_kernels[] = {
+    magic_scalar, magic_sse2, magic_avx2, magic_avx512,
+};
+#else
+static const magic_kernel magic_kernels[] = { magic_scalar };
+#endif /* SDK_SIMD_X86 */
+
+void calc_divider_divide_batch(const calc_divider_t *d, const int *a, int *out, size_t n) {
+    switch (d->kind) {
+    case DIVIDER_MAGIC:
+        magic_kernels[calc_batch_isa()](d, a, out, n);
+        break;
+    case DIVIDER_ONE:
+        for (size_t i = 0; i < n; i++) {
+            out[i] = divide_one(d, a[i]);
+        }
+        break;
+    case DIVIDER_INT_MIN:
+        for (size_t i = 0; i < n; i++) {
+            out[i] = a[i] == INT32_MIN;
+        }
+        break;
+    default:
+        for (size_t i = 0; i < n; i++) {
+            out[i] = 0;
+        }
+        break;
+    }
+}
@@ -0,0 +1,422 @@
+#include <stdlib.h>
+#include <string.h>
+#include "calc-encoded.h"
+#include "calc-batch.h"
+#include "multi-calc-batch.h"
+
+#define CHUNK 256               /* Rows per batch kernel call outside shared runs */
+#define MAX_INPUTS 4            /* Operands of multi_calc_expression */
+
+/* Batch kernel over k operand arrays */
+typedef void (*rows_fn)(const int *const *in, int *out, size_t n);
+
+static void copy_rows(const int *const *in, int *out, size_t n) {
+    memcpy(out, in[0], n * sizeof(int));
+}
+
+static void add_rows(const int *const *in, int *out, size_t n) {
+    calc_add_batch(in[0], in[1], out, n);
+}
+
+static void subtract_rows(const int *const *in, int *out, size_t n) {
+    calc_subtract_batch(in[0], in[1], out, n);
+}
+
+static void multiply_rows(const int *const *in, int *out, size_t n) {
+    calc_multiply_batch(in[0], in[1], out, n);
+}
+
+static void divide_rows(const int *const *in, int *out, size_t n) {
+    calc_divide_batch(in[0], in[1], out, n);
+}
+
+static void expression_rows(const int *const *in, int *out, size_t n) {
+    multi_calc_expression_batch(in[0], in[1], in[2], in[3], out, n);
+}
+
+static rows_fn op_rows(calc_encoded_op_t op) {
+    static const rows_fn fns[] = { add_rows, subtract_rows, multiply_rows, divide_rows };
+    return (unsigned)op < sizeof(fns) / sizeof(fns[0]) ? fns[op] : NULL;
+}
+
+/* Fixed-size inner blocks let the compiler vectorize the stores */
+static void fill(int *p, size_t n, int value) {
+    for (; n >= 16; p += 16, n -= 16) {
+        for (size_t k = 0; k < 16; k++) {
+            p[k] = value;
+        }
+    }
+    for (size_t k = 0; k < n; k++) {
+        p[k] = value;
+    }
+}
+
+/*============================================================================
+ * Inputs
+ *===========================================================================*/
+
+static int column_check(const calc_column_t *col, size_t length) {
+    if (col == NULL || col->length != length || length > UINT32_MAX) {
+        return -1;
+    }
+    switch (col->encoding) {
+    case CALC_COLUMN_PLAIN:
+        return length == 0 || col->values != NULL ? 0 : -1;
+    case CALC_COLUMN_RLE: {
+        uint32_t prev = 0;
+        if (length == 0) {
+            return 0;
+        }
+        if (col->values == NULL || col->run_ends == NULL || col->count == 0) {
+            return -1;
+        }
+        for (size_t r = 0; r < col->count; r++) {
+            if (col->run_ends[r] <= prev) {
+                return -1;
+            }
+            prev = col->run_ends[r];
+        }
+        return prev == length ? 0 : -1;
+    }
+    case CALC_COLUMN_DICT:
+        return length == 0 || (col->values != NULL && col->indices != NULL &&
+                               col->count != 0) ? 0 : -1;
+    }
+    return -1;
+}
+
+static int columns_check(const calc_column_t *const *cols, int k) {
+    if (cols[0] == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < k; i++) {
+        if (column_check(cols[i], cols[0]->length) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Position in an input column */
+typedef struct {
+    const calc_column_t *col;
+    size_t run;                 /* RLE: run holding the current row */
+    int uniform;                /* RLE: rows holds one run value throughout */
+    int rows[CHUNK];            /* RLE and DICT: decoded rows */
+} cursor;
+
+/* Rows [pos, pos + n) of a column, n <= CHUNK, pos ascending between calls */
+static const int *cursor_rows(cursor *c, size_t pos, size_t n) {
+    const calc_column_t *col = c->col;
+
+    switch (col->encoding) {
+    case CALC_COLUMN_PLAIN:
+        return col->values + pos;
+    case CALC_COLUMN_RLE:
+        while (col->run_ends[c->run] <= pos) {
+            c->run++;
+        }
+        // Inside one run the buffer is refilled only when the value changes
+        if (col->run_ends[c->run] >= pos + n) {
+            if (!c->uniform || c->rows[0] != col->values[c->run]) {
+                fill(c->rows, CHUNK, col->values[c->run]);
+                c->uniform = 1;
+            }
+            return c->rows;
+        }
+        c->uniform = 0;
+        for (size_t j = 0; j < n; c->run++) {
+            size_t end = col->run_ends[c->run] - pos;
+            end = end < n ? end : n;
+            fill(c->rows + j, end - j, col->values[c->run]);
+            j = end;
+        }
+        c->run--;
+        return c->rows;
+    case CALC_COLUMN_DICT:
+        for (size_t j = 0; j < n; j++) {
+            c->rows[j] = col->values[col->indices[pos + j]];
+        }
+        return c->rows;
+    }
+    return NULL;
+}
+
+/*
+ * Dictionary operands sharing one indices array, the others constant (a
+ * single run): the result is the operation over the dictionary entries.
+ * Returns the shared indices, NULL if the operands do not have that shape.
+ */
+static const uint32_t *shared_indices(const calc_column_t *const *cols, int k, size_t *count) {
+    const uint32_t *indices = NULL;
+
+    *count = SIZE_MAX;
+    for (int i = 0; i < k; i++) {
+        const calc_column_t *col = cols[i];
+        if (col->length == 0) {
+            return NULL;
+        }
+        if (col->encoding == CALC_COLUMN_DICT) {
+            if (indices != NULL && col->indices != indices) {
+                return NULL;
+            }
+            indices = col->indices;
+            *count = col->count < *count ? col->count : *count;
+        } else if (col->encoding != CALC_COLUMN_RLE || col->count != 1) {
+            return NULL;
+        }
+    }
+    return indices;
+}
+
+/* dict[e] = fn(entry e of every operand) for e < count */
+static void evaluate_dict(rows_fn fn, const calc_column_t *const *cols, int k,
+                          size_t count, int *dict) {
+    int constants[MAX_INPUTS][CHUNK];
+    const int *in[MAX_INPUTS];
+
+    for (int i = 0; i < k; i++) {
+        if (cols[i]->encoding == CALC_COLUMN_RLE) {
+            fill(constants[i], CHUNK, cols[i]->values[0]);
+        }
+    }
+    for (size_t e = 0; e < count; e += CHUNK) {
+        size_t len = count - e < CHUNK ? count - e : CHUNK;
+        for (int i = 0; i < k; i++) {
+            in[i] = cols[i]->encoding == CALC_COLUMN_DICT ? cols[i]->values + e : constants[i];
+        }
+        fn(in, dict + e, len);
+    }
+}
+
+/*============================================================================
+ * Outputs
+ *===========================================================================*/
+
+/* Plain rows, or runs if out is NULL */
+typedef struct {
+    int *out;
+    calc_rle_buffer_t *rle;
+    int rows[CHUNK];            /* Results of a chunk before they become runs */
+} sink;
+
+/* Rows [begin, end) all hold value */
+static int sink_run(sink *s, size_t begin, size_t end, int value) {
+    calc_rle_buffer_t *rle = s->rle;
+
+    if (s->out != NULL) {
+        fill(s->out + begin, end - begin, value);
+        return 0;
+    }
+    // Runs arrive in row order: extend the last one if the value repeats
+    if (rle->runs > 0 && rle->values[rle->runs - 1] == value) {
+        rle->run_ends[rle->runs - 1] = (uint32_t)end;
+        return 0;
+    }
+    if (rle->runs == rle->capacity) {
+        return -1;
+    }
+    rle->values[rle->runs] = value;
+    rle->run_ends[rle->runs] = (uint32_t)end;
+    rle->runs++;
+    return 0;
+}
+
+/*============================================================================
+ * Evaluation
+ *===========================================================================*/
+
+/*
+ * Every operand run-length encoded: walk the segments between run ends of
+ * any operand, computing one value per segment, a chunk of segments per
+ * kernel call
+ */
+static int evaluate_runs(rows_fn fn, const calc_column_t *const *cols, int k, sink *s) {
+    size_t n = cols[0]->length;
+    size_t run[MAX_INPUTS] = { 0 };
+    int values[MAX_INPUTS][CHUNK];
+    const int *in[MAX_INPUTS];
+    uint32_t ends[CHUNK];
+    size_t pos = 0;
+
+    for (int i = 0; i < k; i++) {
+        in[i] = values[i];
+    }
+    while (pos < n) {
+        size_t begin = pos;
+        size_t m = 0;
+
+        for (; m < CHUNK && pos < n; m++) {
+            size_t end = n;
+            for (int i = 0; i < k; i++) {
+                if (cols[i]->run_ends[run[i]] == pos) {
+                    run[i]++;
+                }
+                values[i][m] = cols[i]->values[run[i]];
+                end = cols[i]->run_ends[run[i]] < end ? cols[i]->run_ends[run[i]] : end;
+            }
+            ends[m] = (uint32_t)end;
+            pos = end;
+        }
+        fn(in, s->rows, m);
+        for (size_t j = 0; j < m; j++) {
+            if (sink_run(s, begin, ends[j], s->rows[j]) != 0) {
+                return -1;
+            }
+            begin = ends[j];
+        }
+    }
+    return 0;
+}
+
+/* Dictionary operands with shared indices: through a result dictionary */
+static int evaluate_shared_dict(rows_fn fn, const calc_column_t *const *cols, int k, int *out) {
+    size_t n = cols[0]->length;
+    size_t count;
+    const uint32_t *indices = shared_indices(cols, k, &count);
+    int *dict;
+
+    // Not worth it unless the dictionary is smaller than the column
+    if (indices == NULL || count >= n || (dict = malloc(count * sizeof(int))) == NULL) {
+        return -1;
+    }
+    evaluate_dict(fn, cols, k, count, dict);
+    for (size_t i = 0; i < n; i++) {
+        out[i] = dict[indices[i]];
+    }
+    free(dict);
+    return 0;
+}
+
+/* Operands of any encoding, CHUNK rows at a time through the batch kernel */
+static int evaluate(rows_fn fn, const calc_column_t *const *cols, int k, sink *s) {
+    cursor cur[MAX_INPUTS];
+    const int *in[MAX_INPUTS];
+    int all_runs = 1;
+    size_t n;
+
+    if (columns_check(cols, k) != 0) {
+        return -1;
+    }
+    n = cols[0]->length;
+    for (int i = 0; i < k; i++) {
+        all_runs &= cols[i]->encoding == CALC_COLUMN_RLE;
+    }
+    if (s->rle != NULL) {
+        s->rle->runs = 0;
+    }
+    if (all_runs) {
+        return evaluate_runs(fn, cols, k, s);
+    }
+    if (s->out != NULL && k > 1 && evaluate_shared_dict(fn, cols, k, s->out) == 0) {
+        return 0;
+    }
+
+    for (int i = 0; i < k; i++) {
+        cur[i].col = cols[i];
+        cur[i].run = 0;
+        cur[i].uniform = 0;
+    }
+    for (size_t pos = 0; pos < n; pos += CHUNK) {
+        size_t len = n - pos < CHUNK ? n - pos : CHUNK;
+        for (int i = 0; i < k; i++) {
+            in[i] = cursor_rows(&cur[i], pos, len);
+        }
+        if (s->out != NULL) {
+            fn(in, s->out + pos, len);
+            continue;
+        }
+        fn(in, s->rows, len);
+        for (size_t j = 0; j < len; j++) {
+            if (sink_run(s, pos + j, pos + j + 1, s->rows[j]) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Encoding helpers
+ *===========================================================================*/
+
+int calc_rle_encode(const int *in, size_t n, calc_rle_buffer_t *out) {
+    size_t runs = 0;
+
+    if (n > UINT32_MAX) {
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (runs > 0 && out->values[runs - 1] == in[i]) {
+            out->run_ends[runs - 1] = (uint32_t)(i + 1);
+            continue;
+        }
+        if (runs == out->capacity) {
+            return -1;
+        }
+        out->values[runs] = in[i];
+        out->run_ends[runs] = (uint32_t)(i + 1);
+        runs++;
+    }
+    out->runs = runs;
+    return 0;
+}
+
+int calc_column_decode(const calc_column_t *col, int *out) {
+    sink s = { .out = out };
+    return evaluate(copy_rows, &col, 1, &s);
+}
+
+/*============================================================================
+ * Computing on encoded columns
+ *===========================================================================*/
+
+int calc_encoded_batch(calc_encoded_op_t op, const calc_column_t *a,
+                       const calc_column_t *b, int *out) {
+    const calc_column_t *cols[] = { a, b };
+    rows_fn fn = op_rows(op);
+    sink s = { .out = out };
+
+    return fn != NULL ? evaluate(fn, cols, 2, &s) : -1;
+}
+
+int calc_encoded_batch_rle(calc_encoded_op_t op, const calc_column_t *a,
+                           const calc_column_t *b, calc_rle_buffer_t *out) {
+    const calc_column_t *cols[] = { a, b };
+    rows_fn fn = op_rows(op);
+    sink s = { .rle = out };
+
+    return fn != NULL ? evaluate(fn, cols, 2, &s) : -1;
+}
+
+int calc_encoded_batch_dict(calc_encoded_op_t op, const calc_column_t *a,
+                            const calc_column_t *b, int *dict) {
+    const calc_column_t *cols[] = { a, b };
+    rows_fn fn = op_rows(op);
+    size_t count;
+
+    if (fn == NULL || columns_check(cols, 2) != 0 ||
+        shared_indices(cols, 2, &count) == NULL) {
+        return -1;
+    }
+    evaluate_dict(fn, cols, 2, count, dict);
+    return 0;
+}
+
+int multi_calc_expression_encoded(const calc_column_t *a, const calc_column_t *b,
+                                  const calc_column_t *c, const calc_column_t *d,
+                                  int *out) {
+    const calc_column_t *cols[] = { a, b, c, d };
+    sink s = { .out = out };
+
+    return evaluate(expression_rows, cols, 4, &s);
+}
+
+int multi_calc_expression_encoded_rle(const calc_column_t *a, const calc_column_t *b,
+                                      const calc_column_t *c, const calc_column_t *d,
+                                      calc_rle_buffer_t *out) {
+    const calc_column_t *cols[] = { a, b, c, d };
+    sink s = { .rle = out };
+
+    return evaluate(expression_rows, cols, 4, &s);
+}
@@ -0,0 +1,50 @@
+#ifndef __SDK_CALC_EXPR_IR_H__
+#define __SDK_CALC_EXPR_IR_H__
+
+/*
+ * Bytecode of compiled calc-expr expressions (not installed).
+ *
+ * Shared by the interpreter in calc-expr.c and the native code generator
+ * in calc-jit.c.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "calc-expr.h"
+
+/*============================================================================
+ * Bytecode
+ *
+ * Every instruction is dst = lhs op rhs. Operands are 16-bit references:
+ * the top two bits say whether they name a temporary register, a variable
+ * column or a constant, the rest is the index. The last instruction
+ * writes the output.
+ *===========================================================================*/
+
+enum { OP_ADD, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE };
+
+#define REF_TEMP  0x0000u
+#define REF_VAR   0x4000u
+#define REF_CONST 0x8000u
+#define REF_OUT   0xC000u
+#define REF_KIND(r)  ((unsigned)(r) & 0xC000u)
+#define REF_INDEX(r) ((unsigned)(r) & 0x3FFFu)
+#define MAX_REFS     0x3FFFu    /* Instructions or constants per expression */
+
+typedef struct {
+    uint8_t op;
+    uint16_t dst;
+    uint16_t lhs;
+    uint16_t rhs;
+} expr_instr;
+
+struct calc_expr {
+    expr_instr *code;
+    size_t n_code;
+    int *consts;
+    size_t n_consts;
+    unsigned n_temps;
+    uint16_t result;            /* Used when there is no code */
+};
+
+#endif /* __SDK_CALC_EXPR_IR_H__ */
@@ -0,0 +1,427 @@
+#include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "calc-expr.h"
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "calc-expr-ir.h"
+
+#define EXPR_BLOCK 512          /* Rows per block in calc_expr_eval_batch */
+#define MAX_TEMPS 32            /* Temporary registers (expression depth) */
+#define MAX_NESTING 256         /* Parentheses and unary minus */
+
+/* Scalar semantics of the opcodes, same as the calc_*_batch kernels */
+static int apply_op(unsigned op, int a, int b) {
+    switch (op) {
+    case OP_ADD:
+        return (int)((unsigned)a + (unsigned)b);
+    case OP_SUBTRACT:
+        return (int)((unsigned)a - (unsigned)b);
+    case OP_MULTIPLY:
+        return (int)((unsigned)a * (unsigned)b);
+    default:
+        if (b == 0) {
+            return 0;
+        }
+        return b == -1 ? (int)(0u - (unsigned)a) : a / b;
+    }
+}
+
+/*============================================================================
+ * Compiler (recursive descent, emits code while parsing)
+ *
+ * `depth` is the first free temporary register. An operator whose left
+ * operand sits in register `depth` evaluates its right operand from
+ * `depth + 1` and writes back to `depth`.
+ *===========================================================================*/
+
+typedef struct {
+    const char *pos;
+    const char *const *names;
+    size_t n_vars;
+    expr_instr *code;
+    size_t n_code, cap_code;
+    int *consts;
+    size_t n_consts, cap_consts;
+    unsigned n_temps;
+    unsigned nesting;
+    int failed;
+} compiler;
+
+static uint16_t fail(compiler *c, const char *at) {
+    if (!c->failed) {
+        c->failed = 1;
+        c->pos = at;
+    }
+    return 0;
+}
+
+static void skip_space(compiler *c) {
+    while (isspace((unsigned char)*c->pos)) {
+        c->pos++;
+    }
+}
+
+static uint16_t add_const(compiler *c, int value) {
+    if (c->failed || c->n_consts > MAX_REFS) {
+        return fail(c, c->pos);
+    }
+    if (c->n_consts == c->cap_consts) {
+        size_t cap = c->cap_consts ? 2 * c->cap_consts : 8;
+        int *p = realloc(c->consts, cap * sizeof(*p));
+        if (p == NULL) {
+            return fail(c, c->pos);
+        }
+        c->consts = p;
+        c->cap_consts = cap;
+    }
+    c->consts[c->n_consts] = value;
+    return (uint16_t)(REF_CONST | c->n_consts++);
+}
+
+static uint16_t emit(compiler *c, unsigned op, uint16_t lhs, uint16_t rhs, unsigned depth) {
+    expr_instr *ins;
+
+    if (c->failed) {
+        return 0;
+    }
+    if (REF_KIND(lhs) == REF_CONST && REF_KIND(rhs) == REF_CONST) {
+        return add_const(c, apply_op(op, c->consts[REF_INDEX(lhs)], c->consts[REF_INDEX(rhs)]));
+    }
+    if (depth >= MAX_TEMPS || c->n_code > MAX_REFS) {
+        return fail(c, c->pos);
+    }
+    if (c->n_code == c->cap_code) {
+        size_t cap = c->cap_code ? 2 * c->cap_code : 8;
+        expr_instr *p = realloc(c->code, cap * sizeof(*p));
+        if (p == NULL) {
+            return fail(c, c->pos);
+        }
+        c->code = p;
+        c->cap_code = cap;
+    }
+    ins = &c->code[c->n_code++];
+    ins->op = (uint8_t)op;
+    ins->dst = (uint16_t)(REF_TEMP | depth);
+    ins->lhs = lhs;
+    ins->rhs = rhs;
+    if (depth + 1 > c->n_temps) {
+        c->n_temps = depth + 1;
+    }
+    return ins->dst;
+}
+
+static uint16_t parse_expr(compiler *c, unsigned depth);
+
+static uint16_t parse_primary(compiler *c, unsigned depth) {
+    const char *start;
+
+    skip_space(c);
+    start = c->pos;
+    if (isdigit((unsigned char)*c->pos)) {
+        long long value = 0;
+        while (isdigit((unsigned char)*c->pos)) {
+            value = value * 10 + (*c->pos++ - '0');
+            if (value > INT_MAX) {
+                return fail(c, start);
+            }
+        }
+        return add_const(c, (int)value);
+    }
+    if (isalpha((unsigned char)*c->pos) || *c->pos == '_') {
+        size_t len;
+        while (isalnum((unsigned char)*c->pos) || *c->pos == '_') {
+            c->pos++;
+        }
+        len = (size_t)(c->pos - start);
+        for (size_t i = 0; i < c->n_vars; i++) {
+            if (strncmp(c->names[i], start, len) == 0 && c->names[i][len] == '\0') {
+                return (uint16_t)(REF_VAR | i);
+            }
+        }
+        return fail(c, start);
+    }
+    if (*c->pos == '(') {
+        uint16_t r;
+        if (++c->nesting > MAX_NESTING) {
+            return fail(c, start);
+        }
+        c->pos++;
+        r = parse_expr(c, depth);
+        skip_space(c);
+        if (*c->pos != ')') {
+            return fail(c, c->pos);
+        }
+        c->pos++;
+        c->nesting--;
+        return r;
+    }
+    return fail(c, start);
+}
+
+static uint16_t parse_unary(compiler *c, unsigned depth) {
+    skip_space(c);
+    if (*c->pos == '-') {
+        const char *start = c->pos++;
+        uint16_t zero, x;
+        if (++c->nesting > MAX_NESTING) {
+            return fail(c, start);
+        }
+        zero = add_const(c, 0);
+        x = parse_unary(c, depth);
+        c->nesting--;
+        return emit(c, OP_SUBTRACT, zero, x, depth);
+    }
+    return parse_primary(c, depth);
+}
+
+static uint16_t parse_term(compiler *c, unsigned depth) {
+    uint16_t lhs = parse_unary(c, depth);
+
+    for (;;) {
+        unsigned op;
+        uint16_t rhs;
+        skip_space(c);
+        if (c->failed || (*c->pos != '*' && *c->pos != '/')) {
+            return lhs;
+        }
+        op = *c->pos++ == '*' ? OP_MULTIPLY : OP_DIVIDE;
+        rhs = parse_unary(c, depth + (REF_KIND(lhs) == REF_TEMP));
+        lhs = emit(c, op, lhs, rhs, depth);
+    }
+}
+
+static uint16_t parse_expr(compiler *c, unsigned depth) {
+    uint16_t lhs = parse_term(c, depth);
+
+    for (;;) {
+        unsigned op;
+        uint16_t rhs;
+        skip_space(c);
+        if (c->failed || (*c->pos != '+' && *c->pos != '-')) {
+            return lhs;
+        }
+        op = *c->pos++ == '+' ? OP_ADD : OP_SUBTRACT;
+        rhs = parse_term(c, depth + (REF_KIND(lhs) == REF_TEMP));
+        lhs = emit(c, op, lhs, rhs, depth);
+    }
+}
+
+/* Folding leaves dead constants behind: keep only referenced ones */
+static void compact_consts(calc_expr_t *expr) {
+    uint16_t *map = malloc(expr->n_consts * sizeof(*map));
+    size_t used = 0;
+
+    if (map == NULL) {
+        return;         // Dead constants only cost a broadcast per call
+    }
+    memset(map, 0xFF, expr->n_consts * sizeof(*map));
+#define MARK(ref)                                                           \
+    do {                                                                    \
+        if (REF_KIND(ref) == REF_CONST) {                                   \
+            map[REF_INDEX(ref)] = 0;                                        \
+        }                                                                   \
+    } while (0)
+#define REMAP(ref)                                                          \
+    do {                                                                    \
+        if (REF_KIND(ref) == REF_CONST) {                                   \
+            (ref) = (uint16_t)(REF_CONST | map[REF_INDEX(ref)]);            \
+        }                                                                   \
+    } while (0)
+
+    for (size_t k = 0; k < expr->n_code; k++) {
+        MARK(expr->code[k].lhs);
+        MARK(expr->code[k].rhs);
+    }
+    MARK(expr->result);
+
+    // Survivors keep their order, so each moves to an index no higher than
+    // its own and no live constant is overwritten before it is copied
+    for (size_t i = 0; i < expr->n_consts; i++) {
+        if (map[i] != 0xFFFF) {
+            expr->consts[used] = expr->consts[i];
+            map[i] = (uint16_t)used++;
+        }
+    }
+
+    for (size_t k = 0; k < expr->n_code; k++) {
+        REMAP(expr->code[k].lhs);
+        REMAP(expr->code[k].rhs);
+    }
+    REMAP(expr->result);
+#undef MARK
+#undef REMAP
+    expr->n_consts = used;
+    free(map);
+}
+
+calc_expr_t* calc_expr_compile(const char *source, const char *const *names,
+                               size_t n_vars, size_t *error_pos) {
+    compiler c;
+    calc_expr_t *expr;
+    uint16_t result;
+
+    if (source == NULL || n_vars > CALC_EXPR_MAX_VARS) {
+        if (error_pos != NULL) {
+            *error_pos = 0;
+        }
+        return NULL;
+    }
+    memset(&c, 0, sizeof(c));
+    c.pos = source;
+    c.names = names;
+    c.n_vars = n_vars;
+
+    result = parse_expr(&c, 0);
+    skip_space(&c);
+    if (!c.failed && *c.pos != '\0') {
+        fail(&c, c.pos);
+    }
+    expr = c.failed ? NULL : malloc(sizeof(*expr));
+    if (expr == NULL) {
+        if (error_pos != NULL) {
+            *error_pos = (size_t)(c.pos - source);
+        }
+        free(c.code);
+        free(c.consts);
+        return NULL;
+    }
+
+    expr->code = c.code;
+    expr->n_code = c.n_code;
+    expr->consts = c.consts;
+    expr->n_consts = c.n_consts;
+    expr->n_temps = c.n_temps;
+    expr->result = result;
+    compact_consts(expr);
+    if (expr->n_code > 0) {
+        // The root operator is always emitted last
+        expr->code[expr->n_code - 1].dst = REF_OUT;
+    }
+    return expr;
+}
+
+void calc_expr_free(calc_expr_t *expr) {
+    if (expr != NULL) {
+        free(expr->code);
+        free(expr->consts);
+        free(expr);
+    }
+}
+
+/*============================================================================
+ * Evaluation
+ *===========================================================================*/
+
+typedef void (*batch_op)(const int *a, const int *b, int *out, size_t n);
+
+static const batch_op batch_ops[] = {
+    calc_add_batch, calc_subtract_batch, calc_multiply_batch, calc_divide_batch,
+};
+
+/* Rows [begin, end) a block at a time; columns and out are indexed by row */
+static int eval_rows(const calc_expr_t *expr, const int *const *columns, int *out,
+                     size_t begin, size_t end) {
+    size_t block = end - begin < EXPR_BLOCK ? end - begin : EXPR_BLOCK;
+    int *scratch;
+    int *consts;
+
+    // Temporary registers, then one broadcast block per constant
+    scratch = malloc((expr->n_temps + expr->n_consts) * block * sizeof(*scratch));
+    if (scratch == NULL) {
+        return -1;
+    }
+    consts = scratch + expr->n_temps * block;
+    for (size_t k = 0; k < expr->n_consts; k++) {
+        for (size_t i = 0; i < block; i++) {
+            consts[k * block + i] = expr->consts[k];
+        }
+    }
+
+#define OPERAND(ref)                                                        \
+    (REF_KIND(ref) == REF_VAR ? columns[REF_INDEX(ref)] + base              \
+     : REF_KIND(ref) == REF_CONST ? consts + REF_INDEX(ref) * block          \
+     : scratch + REF_INDEX(ref) * block)
+
+    for (size_t base = begin; base < end; base += block) {
+        size_t len = end - base < block ? end - base : block;
+        for (size_t k = 0; k < expr->n_code; k++) {
+            const expr_instr *ins = &expr->code[k];
+            int *dst = ins->dst == REF_OUT ? out + base : scratch + REF_INDEX(ins->dst) * block;
+            batch_ops[ins->op](OPERAND(ins->lhs), OPERAND(ins->rhs), dst, len);
+        }
+    }
+#undef OPERAND
+
+    free(scratch);
+    return 0;
+}
+
+typedef struct {
+    const calc_expr_t *expr;
+    const int *const *columns;
+    int *out;
+    int status;                 /* Atomic: -1 once any range failed */
+} eval_job;
+
+static void eval_range(void *ctx, size_t begin, size_t end) {
+    eval_job *job = ctx;
+    if (eval_rows(job->expr, job->columns, job->out, begin, end) != 0) {
+        __atomic_store_n(&job->status, -1, __ATOMIC_RELAXED);
+    }
+}
+
+int calc_expr_eval_batch(const calc_expr_t *expr, const int *const *columns,
+                         int *out, size_t n) {
+    eval_job job = { expr, columns, out, 0 };
+
+    if (n == 0) {
+        return 0;
+    }
+    if (expr->n_code == 0) {
+        // A lone variable or constant
+        if (REF_KIND(expr->result) == REF_VAR) {
+            memmove(out, columns[REF_INDEX(expr->result)], n * sizeof(*out));
+        } else {
+            for (size_t i = 0; i < n; i++) {
+                out[i] = expr->consts[REF_INDEX(expr->result)];
+            }
+        }
+        return 0;
+    }
+    if (n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        return eval_rows(expr, columns, out, 0, n);
+    }
+    // Ranges write disjoint rows of out, so aliasing a column stays safe
+    calc_pool_parallel_for(0, n, CALC_POOL_BATCH_GRAIN, eval_range, &job);
+    return job.status;
+}
+
+int calc_expr_eval(const calc_expr_t *expr, const int *values) {
+    int temps[MAX_TEMPS];
+    int result = 0;
+
+    if (expr->n_code == 0) {
+        return REF_KIND(expr->result) == REF_VAR ? values[REF_INDEX(expr->result)]
+                                                 : expr->consts[REF_INDEX(expr->result)];
+    }
+
+#define OPERAND(ref)                                                        \
+    (REF_KIND(ref) == REF_VAR ? values[REF_INDEX(ref)]                      \
+     : REF_KIND(ref) == REF_CONST ? expr->consts[REF_INDEX(ref)]            \
+     : temps[REF_INDEX(ref)])
+
+    for (size_t k = 0; k < expr->n_code; k++) {
+        const expr_instr *ins = &expr->code[k];
+        int r = apply_op(ins->op, OPERAND(ins->lhs), OPERAND(ins->rhs));
+        if (ins->dst == REF_OUT) {
+            result = r;
+        } else {
+            temps[REF_INDEX(ins->dst)] = r;
+        }
+    }
+#undef OPERAND
+    return result;
+}
@@ -0,0 +1,381 @@
+#include <stdlib.h>
+#include <string.h>
+#include "calc-group.h"
+#include "calc-pool.h"
+
+#define MIN_CAPACITY 16         /* Slots of a new table (power of 2) */
+#define BLOCK 64                /* Rows hashed and prefetched ahead of the probes */
+#define SLICE_ROWS (1u << 15)   /* Rows per slice when scattering by partition */
+#define MAX_SLICES 64
+
+/*============================================================================
+ * Hash tables
+ *
+ * Linear probing, at most half full. ctrl holds 0 for an empty slot, or
+ * 0x80 | 7 hash bits: probes compare that byte before touching keys.
+ * Aggregates are updated together, so they stay in one array of structs.
+ *===========================================================================*/
+
+typedef struct {
+    int64_t sum;
+    int64_t count;
+    int min;
+    int max;
+} group_agg;
+
+typedef struct {
+    unsigned char *ctrl;
+    int *keys;
+    group_agg *aggs;
+    size_t mask;                /* Capacity - 1 */
+    size_t size;
+} group_table;
+
+struct calc_group {
+    unsigned partitions;
+    group_table tables[];
+};
+
+/* Murmur3 finalizer: partition from the top bits, tag below, slot from the bottom */
+static inline uint64_t hash_key(int key) {
+    uint64_t h = (uint32_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline unsigned partition_of(uint64_t h, unsigned partitions) {
+    return (unsigned)(((h >> 32) * partitions) >> 32);
+}
+
+static inline unsigned char tag_of(uint64_t h) {
+    return (unsigned char)(0x80 | (h >> 24 & 0x7f));
+}
+
+static int table_init(group_table *t, size_t capacity) {
+    t->ctrl = calloc(capacity, 1);
+    t->keys = malloc(capacity * sizeof(int));
+    t->aggs = malloc(capacity * sizeof(group_agg));
+    t->mask = capacity - 1;
+    t->size = 0;
+    if (t->ctrl == NULL || t->keys == NULL || t->aggs == NULL) {
+        free(t->ctrl);
+        free(t->keys);
+        free(t->aggs);
+        return -1;
+    }
+    return 0;
+}
+
+static void table_free(group_table *t) {
+    free(t->ctrl);
+    free(t->keys);
+    free(t->aggs);
+}
+
+/* Slot of key, or of the empty slot ending its probe sequence */
+static inline size_t table_probe(const group_table *t, uint64_t h, int key) {
+    unsigned char tag = tag_of(h);
+    size_t i = h & t->mask;
+
+    for (;;) {
+        unsigned char c = t->ctrl[i];
+        if (c == 0 || (c == tag && t->keys[i] == key)) {
+            return i;
+        }
+        i = (i + 1) & t->mask;
+    }
+}
+
+static int table_grow(group_table *t) {
+    group_table bigger;
+
+    if (table_init(&bigger, 2 * (t->mask + 1)) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i <= t->mask; i++) {
+        if (t->ctrl[i] != 0) {
+            uint64_t h = hash_key(t->keys[i]);
+            size_t j = table_probe(&bigger, h, t->keys[i]);
+            bigger.ctrl[j] = t->ctrl[i];
+            bigger.keys[j] = t->keys[i];
+            bigger.aggs[j] = t->aggs[i];
+        }
+    }
+    bigger.size = t->size;
+    table_free(t);
+    *t = bigger;
+    return 0;
+}
+
+static inline int table_add(group_table *t, uint64_t h, int key, int value) {
+    size_t i = table_probe(t, h, key);
+    group_agg *agg;
+
+    if (t->ctrl[i] == 0) {
+        if (2 * (t->size + 1) > t->mask + 1) {
+            if (table_grow(t) != 0) {
+                return -1;
+            }
+            i = table_probe(t, h, key);
+        }
+        t->ctrl[i] = tag_of(h);
+        t->keys[i] = key;
+        t->aggs[i].sum = value;
+        t->aggs[i].count = 1;
+        t->aggs[i].min = value;
+        t->aggs[i].max = value;
+        t->size++;
+        return 0;
+    }
+    agg = &t->aggs[i];
+    agg->sum += value;
+    agg->count++;
+    agg->min = value < agg->min ? value : agg->min;
+    agg->max = value > agg->max ? value : agg->max;
+    return 0;
+}
+
+/*
+ * Rows into tables split by partition, a block at a time: hashing the
+ * block first and prefetching its slots keeps several cache misses in
+ * flight
+ */
+static int add_rows(group_table *tables, unsigned partitions,
+                    const int *keys, const int *values, size_t n) {
+    uint64_t h[BLOCK];
+
+    for (size_t i = 0; i < n; i += BLOCK) {
+        size_t len = n - i < BLOCK ? n - i : BLOCK;
+        for (size_t j = 0; j < len; j++) {
+            const group_table *t;
+            h[j] = hash_key(keys[i + j]);
+            t = &tables[partition_of(h[j], partitions)];
+            __builtin_prefetch(&t->ctrl[h[j] & t->mask]);
+            __builtin_prefetch(&t->keys[h[j] & t->mask]);
+        }
+        for (size_t j = 0; j < len; j++) {
+            group_table *t = &tables[partition_of(h[j], partitions)];
+            if (table_add(t, h[j], keys[i + j], values[i + j]) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Partitioned batches
+ *
+ * Slices of the batch count their rows per partition, then scatter them
+ * into one contiguous range per partition (slice order kept inside it).
+ * Each partition is then aggregated by a single calc-pool range.
+ *===========================================================================*/
+
+typedef struct {
+    calc_group_t *group;
+    const int *keys;
+    const int *values;
+    size_t n;
+    size_t slices;
+    size_t (*offsets)[CALC_GROUP_MAX_PARTITIONS];   /* Per slice and partition */
+    int *scattered_keys;
+    int *scattered_values;
+    size_t starts[CALC_GROUP_MAX_PARTITIONS + 1];   /* Of each partition's range */
+    int failed;
+} scatter_job;
+
+static void slice_bounds(const scatter_job *job, size_t s, size_t *begin, size_t *end) {
+    *begin = job->n / job->slices * s;
+    *end = s + 1 == job->slices ? job->n : job->n / job->slices * (s + 1);
+}
+
+static void count_slices(void *ctx, size_t first, size_t last) {
+    scatter_job *job = ctx;
+    unsigned partitions = job->group->partitions;
+
+    for (size_t s = first; s < last; s++) {
+        size_t begin, end;
+        slice_bounds(job, s, &begin, &end);
+        memset(job->offsets[s], 0, sizeof(job->offsets[s]));
+        for (size_t i = begin; i < end; i++) {
+            job->offsets[s][partition_of(hash_key(job->keys[i]), partitions)]++;
+        }
+    }
+}
+
+static void scatter_slices(void *ctx, size_t first, size_t last) {
+    scatter_job *job = ctx;
+    unsigned partitions = job->group->partitions;
+
+    for (size_t s = first; s < last; s++) {
+        size_t *offsets = job->offsets[s];
+        size_t begin, end;
+        slice_bounds(job, s, &begin, &end);
+        for (size_t i = begin; i < end; i++) {
+            size_t to = offsets[partition_of(hash_key(job->keys[i]), partitions)]++;
+            job->scattered_keys[to] = job->keys[i];
+            job->scattered_values[to] = job->values[i];
+        }
+    }
+}
+
+static void aggregate_partitions(void *ctx, size_t first, size_t last) {
+    scatter_job *job = ctx;
+
+    for (size_t p = first; p < last; p++) {
+        size_t begin = job->starts[p];
+        if (add_rows(&job->group->tables[p], 1, job->scattered_keys + begin,
+                     job->scattered_values + begin, job->starts[p + 1] - begin) != 0) {
+            __atomic_store_n(&job->failed, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* -1 if the scratch memory cannot be allocated: nothing was aggregated */
+static int add_partitioned(calc_group_t *group, const int *keys, const int *values,
+                           size_t n, int *result) {
+    scatter_job job = { group, keys, values, n, 0, NULL, NULL, NULL, { 0 }, 0 };
+    unsigned partitions = group->partitions;
+    size_t total = 0;
+
+    job.slices = n / SLICE_ROWS;
+    job.slices = job.slices < 1 ? 1 : job.slices > MAX_SLICES ? MAX_SLICES : job.slices;
+    job.offsets = malloc(job.slices * sizeof(*job.offsets));
+    job.scattered_keys = malloc(n * sizeof(int));
+    job.scattered_values = malloc(n * sizeof(int));
+    if (job.offsets == NULL || job.scattered_keys == NULL || job.scattered_values == NULL) {
+        free(job.offsets);
+        free(job.scattered_keys);
+        free(job.scattered_values);
+        return -1;
+    }
+
+    calc_pool_parallel_for(0, job.slices, 1, count_slices, &job);
+    // Counts become the first destination of each slice in each partition
+    for (unsigned p = 0; p < partitions; p++) {
+        job.starts[p] = total;
+        for (size_t s = 0; s < job.slices; s++) {
+            size_t count = job.offsets[s][p];
+            job.offsets[s][p] = total;
+            total += count;
+        }
+    }
+    job.starts[partitions] = total;
+    calc_pool_parallel_for(0, job.slices, 1, scatter_slices, &job);
+    calc_pool_parallel_for(0, partitions, 1, aggregate_partitions, &job);
+
+    free(job.offsets);
+    free(job.scattered_keys);
+    free(job.scattered_values);
+    *result = job.failed ? -1 : 0;
+    return 0;
+}
+
+/*============================================================================
+ * Public functions
+ *===========================================================================*/
+
+calc_group_t* calc_group_create(size_t expected_keys, unsigned partitions) {
+    calc_group_t *group;
+    size_t capacity = MIN_CAPACITY;
+
+    if (partitions > CALC_GROUP_MAX_PARTITIONS) {
+        return NULL;
+    }
+    partitions = partitions ? partitions : 1;
+    group = malloc(sizeof(*group) + partitions * sizeof(group_table));
+    if (group == NULL) {
+        return NULL;
+    }
+    // Half full once the expected keys are in
+    while (capacity / 2 < expected_keys / partitions + 1 && capacity <= SIZE_MAX / 4) {
+        capacity *= 2;
+    }
+    group->partitions = partitions;
+    for (unsigned p = 0; p < partitions; p++) {
+        if (table_init(&group->tables[p], capacity) != 0) {
+            group->partitions = p;
+            calc_group_destroy(group);
+            return NULL;
+        }
+    }
+    return group;
+}
+
+void calc_group_destroy(calc_group_t *group) {
+    if (group == NULL) {
+        return;
+    }
+    for (unsigned p = 0; p < group->partitions; p++) {
+        table_free(&group->tables[p]);
+    }
+    free(group);
+}
+
+int calc_group_add_batch(calc_group_t *group, const int *keys, const int *values, size_t n) {
+    int result;
+
+    if (group->partitions > 1 && n >= CALC_GROUP_PARTITION_MIN &&
+        add_partitioned(group, keys, values, n, &result) == 0) {
+        return result;
+    }
+    return add_rows(group->tables, group->partitions, keys, values, n);
+}
+
+size_t calc_group_size(const calc_group_t *group) {
+    size_t size = 0;
+
+    for (unsigned p = 0; p < group->partitions; p++) {
+        size += group->tables[p].size;
+    }
+    return size;
+}
+
+static void fill_result(const group_table *t, size_t i, calc_group_result_t *result) {
+    const group_agg *agg = &t->aggs[i];
+
+    result->key = t->keys[i];
+    result->min = agg->min;
+    result->max = agg->max;
+    result->average = (int)(agg->sum / agg->count);
+    result->sum = agg->sum;
+    result->count = agg->count;
+}
+
+int calc_group_find(const calc_group_t *group, int key, calc_group_result_t *result) {
+    uint64_t h = hash_key(key);
+    const group_table *t = &group->tables[partition_of(h, group->partitions)];
+    size_t i = table_probe(t, h, key);
+
+    if (t->ctrl[i] == 0) {
+        return -1;
+    }
+    fill_result(t, i, result);
+    return 0;
+}
+
+size_t calc_group_results(const calc_group_t *group, calc_group_result_t *out) {
+    size_t k = 0;
+
+    for (unsigned p = 0; p < group->partitions; p++) {
+        const group_table *t = &group->tables[p];
+        for (size_t i = 0; i <= t->mask; i++) {
+            if (t->ctrl[i] != 0) {
+                fill_result(t, i, &out[k++]);
+            }
+        }
+    }
+    return k;
+}
+
+void calc_group_clear(calc_group_t *group) {
+    for (unsigned p = 0; p < group->partitions; p++) {
+        group_table *t = &group->tables[p];
+        memset(t->ctrl, 0, t->mask + 1);
+        t->size = 0;
+    }
+}
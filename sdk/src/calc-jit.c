@@ -0,0 +1,371 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "calc-jit.h"
+#include "calc-batch.h"
+#include "calc-expr-ir.h"
+#include "calc-pool.h"
+
+#if defined(__x86_64__) && defined(__unix__)
+#define SDK_JIT_NATIVE 1
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define SDK_JIT_NATIVE 0
+#endif
+
+#define JIT_LANES 8             /* int32 lanes of a ymm register */
+#define JIT_TEMP_REGS 11        /* ymm0-ymm10 hold temporaries */
+
+/* Generated code: rows [0, n) with n a multiple of JIT_LANES */
+typedef void (*jit_fn)(const int *const *columns, int *out, size_t n);
+
+struct calc_jit {
+    calc_expr_t *expr;
+    size_t n_vars;
+    jit_fn fn;                  /* NULL: interpreter only */
+    void *pages;
+    size_t pages_size;
+};
+
+#if SDK_JIT_NATIVE
+
+/*============================================================================
+ * x86-64 encoder
+ *
+ * Registers of the generated function (System V ABI):
+ *   rdi columns, rsi out, rdx row count, rcx row index, rax column pointer
+ *   ymm0-ymm10 temporaries (the result is in ymm0), ymm11-ymm15 scratch
+ *
+ * The page starts with the constant pool, one broadcast ymm per constant,
+ * followed by the code, so constants are addressed RIP-relative with
+ * displacements known while emitting.
+ *===========================================================================*/
+
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+    size_t cap;
+    size_t pool_size;
+    int failed;
+} jit_buf;
+
+enum { OPD_REG, OPD_COLUMN, OPD_OUT, OPD_CONST };
+
+typedef struct {
+    int kind;
+    unsigned index;
+} operand;
+
+enum { MAP_0F = 1, MAP_0F38 = 2, MAP_0F3A = 3 };
+enum { PP_NONE = 0, PP_66 = 1, PP_F3 = 2 };
+
+#define NO_IMM (-1)
+#define REG(i) ((operand){ OPD_REG, (i) })
+
+static void put(jit_buf *b, const void *bytes, size_t n) {
+    if (b->failed) {
+        return;
+    }
+    if (b->len + n > b->cap) {
+        size_t cap = b->cap ? 2 * b->cap : 1024;
+        uint8_t *p = realloc(b->buf, cap);
+        if (p == NULL) {
+            b->failed = 1;
+            return;
+        }
+        b->buf = p;
+        b->cap = cap;
+    }
+    memcpy(b->buf + b->len, bytes, n);
+    b->len += n;
+}
+
+static void put1(jit_buf *b, unsigned byte) {
+    uint8_t v = (uint8_t)byte;
+    put(b, &v, 1);
+}
+
+static void put4(jit_buf *b, int32_t signed_value) {
+    uint32_t value = (uint32_t)signed_value;
+    uint8_t v[4] = {
+        (uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24),
+    };
+    put(b, v, sizeof(v));
+}
+
+/*
+ * Emit a 256-bit VEX instruction: ModRM.reg = reg, VEX.vvvv = vvvv (0 when
+ * unused), ModRM.rm = rm. A column operand first loads its pointer to rax.
+ */
+static void vex(jit_buf *b, unsigned map, unsigned pp, unsigned opcode,
+                unsigned reg, unsigned vvvv, operand rm, int imm) {
+    unsigned rm_reg = rm.kind == OPD_REG ? rm.index : 0;
+
+    if (rm.kind == OPD_COLUMN) {
+        put1(b, 0x48);                          // mov rax, [rdi + 8 * index]
+        put1(b, 0x8B);
+        put1(b, 0x87);
+        put4(b, (int32_t)(rm.index * sizeof(void *)));
+    }
+    put1(b, 0xC4);
+    put1(b, ((reg & 8) ? 0 : 0x80) | 0x40 | ((rm_reg & 8) ? 0 : 0x20) | map);
+    put1(b, ((~vvvv & 15u) << 3) | 0x04 | pp);  // W0, L1 (256-bit)
+    put1(b, opcode);
+    switch (rm.kind) {
+    case OPD_REG:
+        put1(b, 0xC0 | (reg & 7) << 3 | (rm_reg & 7));
+        break;
+    case OPD_COLUMN:
+        put1(b, 0x04 | (reg & 7) << 3);         // [rax + rcx * 4]
+        put1(b, 0x88);
+        break;
+    case OPD_OUT:
+        put1(b, 0x04 | (reg & 7) << 3);         // [rsi + rcx * 4]
+        put1(b, 0x8E);
+        break;
+    default: {
+        // [rip + disp32]; rip is the end of the instruction
+        size_t end = b->pool_size + b->len + 1 + 4 + (imm != NO_IMM);
+        put1(b, 0x05 | (reg & 7) << 3);
+        put4(b, (int32_t)((int64_t)rm.index * 32 - (int64_t)end));
+        break;
+    }
+    }
+    if (imm != NO_IMM) {
+        put1(b, (unsigned)imm);
+    }
+}
+
+#define VMOVDQU_LOAD(b, r, src)      vex(b, MAP_0F, PP_F3, 0x6F, r, 0, src, NO_IMM)
+#define VMOVDQU_STORE(b, r)          vex(b, MAP_0F, PP_F3, 0x7F, r, 0, (operand){ OPD_OUT, 0 }, NO_IMM)
+#define VPXOR(b, d, s1, s2)          vex(b, MAP_0F, PP_66, 0xEF, d, s1, REG(s2), NO_IMM)
+#define VPCMPEQD(b, d, s1, s2)       vex(b, MAP_0F, PP_66, 0x76, d, s1, REG(s2), NO_IMM)
+#define VPANDN(b, d, s1, s2)         vex(b, MAP_0F, PP_66, 0xDF, d, s1, REG(s2), NO_IMM)
+#define VPBLENDVB(b, d, s1, s2, m)   vex(b, MAP_0F3A, PP_66, 0x4C, d, s1, s2, (int)((m) << 4))
+#define VCVTDQ2PD(b, d, s)           vex(b, MAP_0F, PP_F3, 0xE6, d, 0, REG(s), NO_IMM)
+#define VCVTTPD2DQ(b, d, s)          vex(b, MAP_0F, PP_66, 0xE6, d, 0, REG(s), NO_IMM)
+#define VDIVPD(b, d, s1, s2)         vex(b, MAP_0F, PP_66, 0x5E, d, s1, REG(s2), NO_IMM)
+#define VEXTRACTI128_HI(b, d, s)     vex(b, MAP_0F3A, PP_66, 0x39, s, 0, REG(d), 1)
+#define VINSERTI128_HI(b, d, s1, s2) vex(b, MAP_0F3A, PP_66, 0x38, d, s1, REG(s2), 1)
+
+static operand operand_of(uint16_t ref) {
+    switch (REF_KIND(ref)) {
+    case REF_VAR:
+        return (operand){ OPD_COLUMN, REF_INDEX(ref) };
+    case REF_CONST:
+        return (operand){ OPD_CONST, REF_INDEX(ref) };
+    default:
+        return REG(REF_INDEX(ref));
+    }
+}
+
+/*
+ * d = a / b with calc_divide_batch semantics, as div_avx2 in calc-batch.c:
+ * zero divisors become 1 and are masked to 0 afterwards; each half is
+ * divided in double precision, exact for 32-bit operands, and INT_MIN / -1
+ * converts to the out-of-range result INT_MIN.
+ */
+static void emit_divide(jit_buf *b, unsigned d, operand a, operand div, operand one) {
+    VMOVDQU_LOAD(b, 12, a);
+    VMOVDQU_LOAD(b, 13, div);
+    VPXOR(b, 11, 11, 11);
+    VPCMPEQD(b, 11, 13, 11);                    // ymm11 = zero divisor mask
+    VPBLENDVB(b, 13, 13, one, 11);
+    VCVTDQ2PD(b, 14, 12);
+    VCVTDQ2PD(b, 15, 13);
+    VDIVPD(b, 14, 14, 15);
+    VCVTTPD2DQ(b, 14, 14);                      // xmm14 = low 4 quotients
+    VEXTRACTI128_HI(b, 12, 12);
+    VCVTDQ2PD(b, 12, 12);
+    VEXTRACTI128_HI(b, 13, 13);
+    VCVTDQ2PD(b, 13, 13);
+    VDIVPD(b, 12, 12, 13);
+    VCVTTPD2DQ(b, 12, 12);                      // xmm12 = high 4 quotients
+    VINSERTI128_HI(b, 14, 14, 12);
+    VPANDN(b, d, 11, 14);
+}
+
+static void emit_function(jit_buf *b, const calc_expr_t *expr) {
+    static const uint8_t prologue[] = {
+        0x31, 0xC9,                             // xor ecx, ecx
+        0x48, 0x85, 0xD2,                       // test rdx, rdx
+        0x0F, 0x84, 0, 0, 0, 0,                 // jz end
+    };
+    static const uint8_t step[] = {
+        0x48, 0x83, 0xC1, JIT_LANES,            // add rcx, 8
+        0x48, 0x39, 0xD1,                       // cmp rcx, rdx
+        0x0F, 0x82,                             // jb loop (rel32 follows)
+    };
+    static const uint8_t epilogue[] = {
+        0xC5, 0xF8, 0x77,                       // vzeroupper
+        0xC3,                                   // ret
+    };
+    operand one = { OPD_CONST, (unsigned)expr->n_consts };
+    size_t loop;
+
+    put(b, prologue, sizeof(prologue));
+    loop = b->len;
+    for (size_t k = 0; k < expr->n_code; k++) {
+        const expr_instr *ins = &expr->code[k];
+        unsigned d = ins->dst == REF_OUT ? 0 : REF_INDEX(ins->dst);
+        operand lhs = operand_of(ins->lhs);
+        operand rhs = operand_of(ins->rhs);
+
+        if (ins->op == OP_DIVIDE) {
+            emit_divide(b, d, lhs, rhs, one);
+            continue;
+        }
+        if (lhs.kind != OPD_REG) {
+            VMOVDQU_LOAD(b, 12, lhs);
+            lhs = REG(12);
+        }
+        switch (ins->op) {
+        case OP_ADD:
+            vex(b, MAP_0F, PP_66, 0xFE, d, lhs.index, rhs, NO_IMM);     // vpaddd
+            break;
+        case OP_SUBTRACT:
+            vex(b, MAP_0F, PP_66, 0xFA, d, lhs.index, rhs, NO_IMM);     // vpsubd
+            break;
+        default:
+            vex(b, MAP_0F38, PP_66, 0x40, d, lhs.index, rhs, NO_IMM);   // vpmulld
+            break;
+        }
+    }
+    VMOVDQU_STORE(b, 0);
+    put(b, step, sizeof(step));
+    put4(b, (int32_t)((int64_t)loop - (int64_t)(b->len + 4)));
+    if (!b->failed) {
+        int32_t skip = (int32_t)(b->len - sizeof(prologue));
+        memcpy(b->buf + sizeof(prologue) - 4, &skip, sizeof(skip));
+    }
+    put(b, epilogue, sizeof(epilogue));
+}
+
+/* Translate to native code, or leave jit->fn NULL */
+static void compile_native(calc_jit_t *jit) {
+    const calc_expr_t *expr = jit->expr;
+    jit_buf b = { NULL, 0, 0, (expr->n_consts + 1) * 32, 0 };
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    uint8_t *pages;
+
+    if (calc_batch_isa() < CALC_ISA_AVX2 || expr->n_code == 0 ||
+        expr->n_temps > JIT_TEMP_REGS) {
+        return;
+    }
+    emit_function(&b, expr);
+    if (b.failed) {
+        free(b.buf);
+        return;
+    }
+
+    jit->pages_size = (b.pool_size + b.len + page - 1) / page * page;
+    pages = mmap(NULL, jit->pages_size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) {
+        free(b.buf);
+        return;
+    }
+    // Constant pool (the extra slot is the 1 used for zero divisors)
+    for (size_t k = 0; k <= expr->n_consts; k++) {
+        int value = k < expr->n_consts ? expr->consts[k] : 1;
+        for (size_t lane = 0; lane < JIT_LANES; lane++) {
+            memcpy(pages + k * 32 + lane * sizeof(int), &value, sizeof(int));
+        }
+    }
+    memcpy(pages + b.pool_size, b.buf, b.len);
+    free(b.buf);
+    // Never writable and executable at the same time
+    if (mprotect(pages, jit->pages_size, PROT_READ | PROT_EXEC) != 0) {
+        munmap(pages, jit->pages_size);
+        return;
+    }
+    jit->pages = pages;
+    jit->fn = (jit_fn)(uintptr_t)(pages + b.pool_size);
+}
+
+#endif /* SDK_JIT_NATIVE */
+
+/*============================================================================
+ * Public API
+ *===========================================================================*/
+
+calc_jit_t* calc_jit_compile(const char *source, const char *const *names,
+                             size_t n_vars, size_t *error_pos) {
+    calc_jit_t *jit;
+    calc_expr_t *expr = calc_expr_compile(source, names, n_vars, error_pos);
+
+    if (expr == NULL) {
+        return NULL;
+    }
+    jit = calloc(1, sizeof(*jit));
+    if (jit == NULL) {
+        calc_expr_free(expr);
+        return NULL;
+    }
+    jit->expr = expr;
+    jit->n_vars = n_vars;
+#if SDK_JIT_NATIVE
+    compile_native(jit);
+#endif
+    return jit;
+}
+
+int calc_jit_is_native(const calc_jit_t *jit) {
+    return jit->fn != NULL;
+}
+
+/* Split by groups of JIT_LANES rows, so every range stays on the vector loop */
+typedef struct {
+    const calc_jit_t *jit;
+    const int *const *columns;
+    int *out;
+} jit_job;
+
+static void jit_range(void *ctx, size_t begin, size_t end) {
+    const jit_job *job = ctx;
+    const int *columns[CALC_EXPR_MAX_VARS];
+
+    for (size_t v = 0; v < job->jit->n_vars; v++) {
+        columns[v] = job->columns[v] + begin * JIT_LANES;
+    }
+    job->jit->fn(columns, job->out + begin * JIT_LANES, (end - begin) * JIT_LANES);
+}
+
+int calc_jit_eval_batch(const calc_jit_t *jit, const int *const *columns,
+                        int *out, size_t n) {
+    size_t head = n - n % JIT_LANES;
+    int row[CALC_EXPR_MAX_VARS];
+    jit_job job = { jit, columns, out };
+
+    if (jit->fn == NULL) {
+        return calc_expr_eval_batch(jit->expr, columns, out, n);
+    }
+    if (n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        jit->fn(columns, out, head);
+    } else {
+        calc_pool_parallel_for(0, head / JIT_LANES, CALC_POOL_BATCH_GRAIN / JIT_LANES,
+                               jit_range, &job);
+    }
+    // Fewer than JIT_LANES rows left
+    for (size_t i = head; i < n; i++) {
+        for (size_t v = 0; v < jit->n_vars; v++) {
+            row[v] = columns[v][i];
+        }
+        out[i] = calc_expr_eval(jit->expr, row);
+    }
+    return 0;
+}
+
+void calc_jit_free(calc_jit_t *jit) {
+    if (jit == NULL) {
+        return;
+    }
+#if SDK_JIT_NATIVE
+    if (jit->pages != NULL) {
+        munmap(jit->pages, jit->pages_size);
+    }
+#endif
+    calc_expr_free(jit->expr);
+    free(jit);
+}
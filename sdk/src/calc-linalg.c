@@ -0,0 +1,460 @@
+#include <string.h>
+#include "calc-linalg.h"
+#include "calc-batch.h"
+#include "simd.h"
+
+/* Elements per call of the split-accumulation kernels (see below) */
+#define SPLIT_BLOCK (1u << 28)
+
+/* GEMM cache blocking: a KC x NC block of b (128 KB) stays in L2 */
+#define GEMM_KC 128
+#define GEMM_NC 256
+
+/* Columns of c accumulated at once by the 128-bit GEMM loop */
+#define GEMM_EXACT_COLS 64
+
+/* Store an exact sum as an int64_t; returns 1 if it did not fit (wrapped) */
+static inline int store_exact(__int128 sum, int64_t *out) {
+    *out = (int64_t)(uint64_t)(unsigned __int128)sum;
+    return sum != (__int128)*out;
+}
+
+/*============================================================================
+ * Split accumulation
+ *
+ * A product of two ints lies in (-2^62, 2^62], so u = p + 2^62 is in
+ * [0, 2^63]: its high half (u >> 32, at most 2^31) and low half (below
+ * 2^32) are summed in separate 64-bit lanes, which cannot wrap for fewer
+ * than 2^31 terms per lane. The exact sum is then
+ *   sum(hi) * 2^32 + sum(lo) - count * 2^62
+ * computed in 128 bits. This keeps dot products and GEMV exact with plain
+ * 64-bit vector adds.
+ *===========================================================================*/
+
+#define PRODUCT_BIAS (UINT64_C(1) << 62)
+
+static inline __int128 split_value(uint64_t hi, uint64_t lo, uint64_t count) {
+    return (__int128)(((unsigned __int128)hi << 32) + lo) - ((__int128)count << 62);
+}
+
+/* Exact sum of n products for n <= SPLIT_BLOCK */
+typedef __int128 (*dot_kernel)(const int *a, const int *b, size_t n);
+
+/* Add the dot products of four rows (stride ints apart) with x to sums */
+typedef void (*rows4_kernel)(const int *a, size_t stride, const int *x, size_t n,
+                             __int128 sums[4]);
+
+/* y[i] += alpha * x[i]; returns 1 if some y[i] wrapped */
+typedef int (*axpy_kernel)(int alpha, const int *x, int64_t *y, size_t n);
+
+/*============================================================================
+ * Scalar kernels
+ *===========================================================================*/
+
+static __int128 dot_scalar(const int *a, const int *b, size_t n) {
+    __int128 s0 = 0, s1 = 0;
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        s0 += (int64_t)a[i] * b[i];
+        s1 += (int64_t)a[i + 1] * b[i + 1];
+    }
+    if (i < n) {
+        s0 += (int64_t)a[i] * b[i];
+    }
+    return s0 + s1;
+}
+
+static void rows4_scalar(const int *a, size_t stride, const int *x, size_t n, __int128 sums[4]) {
+    __int128 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for (size_t j = 0; j < n; j++) {
+        int64_t v = x[j];
+        s0 += a[j] * v;
+        s1 += a[stride + j] * v;
+        s2 += a[2 * stride + j] * v;
+        s3 += a[3 * stride + j] * v;
+    }
+    sums[0] += s0;
+    sums[1] += s1;
+    sums[2] += s2;
+    sums[3] += s3;
+}
+
+static int axpy_scalar(int alpha, const int *x, int64_t *y, size_t n) {
+    int overflow = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        overflow |= __builtin_add_overflow(y[i], (int64_t)alpha * x[i], &y[i]);
+    }
+    return overflow;
+}
+
+/* c[rows x cols] += a[rows x kc] * b[kc x cols], 64-bit accumulation */
+static void gemm_scalar(const int *a, size_t lda, const int *b, size_t ldb,
+                        int64_t *c, size_t ldc, size_t rows, size_t kc, size_t cols) {
+    for (size_t i = 0; i < rows; i++) {
+        int64_t *ci = c + i * ldc;
+        for (size_t p = 0; p < kc; p++) {
+            const int64_t av = a[i * lda + p];
+            const int *bp = b + p * ldb;
+            for (size_t j = 0; j < cols; j++) {
+                ci[j] += av * bp[j];
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * SIMD kernels
+ *
+ * _mm256_mul_epi32 / _mm512_mul_epi32 multiply the low (even) int of each
+ * 64-bit lane; the odd ints are shifted down first. GEMM micro-kernels
+ * keep a 4-row tile of c in registers across the whole KC block.
+ *===========================================================================*/
+
+#if SDK_SIMD_X86
+
+SDK_TARGET_AVX2 static inline uint64_t hsum_avx2(__m256i v) {
+    __m128i h = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    h = _mm_add_epi64(h, _mm_unpackhi_epi64(h, h));
+    return (uint64_t)_mm_cvtsi128_si64(h);
+}
+
+SDK_TARGET_AVX2 static inline void split_add_avx2(__m256i p, __m256i *hi, __m256i *lo) {
+    __m256i u = _mm256_add_epi64(p, _mm256_set1_epi64x((long long)PRODUCT_BIAS));
+    *hi = _mm256_add_epi64(*hi, _mm256_srli_epi64(u, 32));
+    *lo = _mm256_add_epi64(*lo, _mm256_and_si256(u, _mm256_set1_epi64x(0xffffffff)));
+}
+
+SDK_TARGET_AVX2 static __int128 dot_avx2(const int *a, const int *b, size_t n) {
+    __m256i hi0 = _mm256_setzero_si256(), lo0 = _mm256_setzero_si256();
+    __m256i hi1 = _mm256_setzero_si256(), lo1 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(const void *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(const void *)(b + i));
+        split_add_avx2(_mm256_mul_epi32(va, vb), &hi0, &lo0);
+        split_add_avx2(_mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)),
+                       &hi1, &lo1);
+    }
+    return split_value(hsum_avx2(_mm256_add_epi64(hi0, hi1)),
+                       hsum_avx2(_mm256_add_epi64(lo0, lo1)), i)
+           + dot_scalar(a + i, b + i, n - i);
+}
+
+SDK_TARGET_AVX2 static void rows4_avx2(const int *a, size_t stride, const int *x, size_t n,
+                                       __int128 sums[4]) {
+    __m256i hi[4], lo[4];
+    size_t j = 0;
+
+    for (int r = 0; r < 4; r++) {
+        hi[r] = lo[r] = _mm256_setzero_si256();
+    }
+    for (; j + 8 <= n; j += 8) {
+        __m256i vx = _mm256_loadu_si256((const __m256i *)(const void *)(x + j));
+        __m256i vx_odd = _mm256_srli_epi64(vx, 32);
+        for (int r = 0; r < 4; r++) {
+            __m256i va = _mm256_loadu_si256((const __m256i *)(const void *)(a + r * stride + j));
+            split_add_avx2(_mm256_mul_epi32(va, vx), &hi[r], &lo[r]);
+            split_add_avx2(_mm256_mul_epi32(_mm256_srli_epi64(va, 32), vx_odd), &hi[r], &lo[r]);
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        sums[r] += split_value(hsum_avx2(hi[r]), hsum_avx2(lo[r]), j)
+                   + dot_scalar(a + r * stride + j, x + j, n - j);
+    }
+}
+
+SDK_TARGET_AVX2 static int axpy_avx2(int alpha, const int *x, int64_t *y, size_t n) {
+    const __m256i va = _mm256_set1_epi32(alpha);
+    __m256i wrapped = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256i p = _mm256_mul_epi32(_mm256_cvtepi32_epi64(
+                        _mm_loadu_si128((const __m128i *)(const void *)(x + i))), va);
+        __m256i vy = _mm256_loadu_si256((const __m256i *)(const void *)(y + i));
+        __m256i r = _mm256_add_epi64(vy, p);
+        // Signed overflow: r has the sign of neither operand
+        wrapped = _mm256_or_si256(wrapped, _mm256_and_si256(_mm256_xor_si256(r, vy),
+                                                            _mm256_xor_si256(r, p)));
+        _mm256_storeu_si256((__m256i *)(void *)(y + i), r);
+    }
+    return (_mm256_movemask_pd(_mm256_castsi256_pd(wrapped)) != 0)
+           | axpy_scalar(alpha, x + i, y + i, n - i);
+}
+
+/* c[4 x 8] += a[4 x kc] * b[kc x 8] */
+SDK_TARGET_AVX2 static void micro_avx2(const int *a, size_t lda, const int *b, size_t ldb,
+                                       int64_t *c, size_t ldc, size_t kc) {
+    __m256i c0[4], c1[4];
+
+    for (int r = 0; r < 4; r++) {
+        c0[r] = _mm256_loadu_si256((const __m256i *)(const void *)(c + r * ldc));
+        c1[r] = _mm256_loadu_si256((const __m256i *)(const void *)(c + r * ldc + 4));
+    }
+    for (size_t p = 0; p < kc; p++) {
+        const int *bp = b + p * ldb;
+        __m256i b0 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(const void *)bp));
+        __m256i b1 = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(const void *)(bp + 4)));
+        for (int r = 0; r < 4; r++) {
+            __m256i av = _mm256_set1_epi32(a[r * lda + p]);
+            c0[r] = _mm256_add_epi64(c0[r], _mm256_mul_epi32(av, b0));
+            c1[r] = _mm256_add_epi64(c1[r], _mm256_mul_epi32(av, b1));
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        _mm256_storeu_si256((__m256i *)(void *)(c + r * ldc), c0[r]);
+        _mm256_storeu_si256((__m256i *)(void *)(c + r * ldc + 4), c1[r]);
+    }
+}
+
+SDK_TARGET_AVX512 static inline void split_add_avx512(__m512i p, __m512i *hi, __m512i *lo) {
+    __m512i u = _mm512_add_epi64(p, _mm512_set1_epi64((long long)PRODUCT_BIAS));
+    *hi = _mm512_add_epi64(*hi, _mm512_srli_epi64(u, 32));
+    *lo = _mm512_add_epi64(*lo, _mm512_and_si512(u, _mm512_set1_epi64(0xffffffff)));
+}
+
+SDK_TARGET_AVX512 static __int128 dot_avx512(const int *a, const int *b, size_t n) {
+    __m512i hi0 = _mm512_setzero_si512(), lo0 = _mm512_setzero_si512();
+    __m512i hi1 = _mm512_setzero_si512(), lo1 = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        __m512i va = _mm512_loadu_si512((const void *)(a + i));
+        __m512i vb = _mm512_loadu_si512((const void *)(b + i));
+        split_add_avx512(_mm512_mul_epi32(va, vb), &hi0, &lo0);
+        split_add_avx512(_mm512_mul_epi32(_mm512_srli_epi64(va, 32), _mm512_srli_epi64(vb, 32)),
+                         &hi1, &lo1);
+    }
+    return split_value((uint64_t)_mm512_reduce_add_epi64(_mm512_add_epi64(hi0, hi1)),
+                       (uint64_t)_mm512_reduce_add_epi64(_mm512_add_epi64(lo0, lo1)), i)
+           + dot_scalar(a + i, b + i, n - i);
+}
+
+SDK_TARGET_AVX512 static void rows4_avx512(const int *a, size_t stride, const int *x, size_t n,
+                                           __int128 sums[4]) {
+    __m512i hi[4], lo[4];
+    size_t j = 0;
+
+    for (int r = 0; r < 4; r++) {
+        hi[r] = lo[r] = _mm512_setzero_si512();
+    }
+    for (; j + 16 <= n; j += 16) {
+        __m512i vx = _mm512_loadu_si512((const void *)(x + j));
+        __m512i vx_odd = _mm512_srli_epi64(vx, 32);
+        for (int r = 0; r < 4; r++) {
+            __m512i va = _mm512_loadu_si512((const void *)(a + r * stride + j));
+            split_add_avx512(_mm512_mul_epi32(va, vx), &hi[r], &lo[r]);
+            split_add_avx512(_mm512_mul_epi32(_mm512_srli_epi64(va, 32), vx_odd), &hi[r], &lo[r]);
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        sums[r] += split_value((uint64_t)_mm512_reduce_add_epi64(hi[r]),
+                               (uint64_t)_mm512_reduce_add_epi64(lo[r]), j)
+                   + dot_scalar(a + r * stride + j, x + j, n - j);
+    }
+}
+
+SDK_TARGET_AVX512 static int axpy_avx512(int alpha, const int *x, int64_t *y, size_t n) {
+    const __m512i va = _mm512_set1_epi32(alpha);
+    __m512i wrapped = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m512i p = _mm512_mul_epi32(_mm512_cvtepi32_epi64(
+                        _mm256_loadu_si256((const __m256i *)(const void *)(x + i))), va);
+        __m512i vy = _mm512_loadu_si512((const void *)(y + i));
+        __m512i r = _mm512_add_epi64(vy, p);
+        wrapped = _mm512_or_si512(wrapped, _mm512_and_si512(_mm512_xor_si512(r, vy),
+                                                            _mm512_xor_si512(r, p)));
+        _mm512_storeu_si512((void *)(y + i), r);
+    }
+    return (_mm512_cmplt_epi64_mask(wrapped, _mm512_setzero_si512()) != 0)
+           | axpy_scalar(alpha, x + i, y + i, n - i);
+}
+
+/* c[4 x 16] += a[4 x kc] * b[kc x 16] */
+SDK_TARGET_AVX512 static void micro_avx512(const int *a, size_t lda, const int *b, size_t ldb,
+                                           int64_t *c, size_t ldc, size_t kc) {
+    __m512i c0[4], c1[4];
+
+    for (int r = 0; r < 4; r++) {
+        c0[r] = _mm512_loadu_si512((const void *)(c + r * ldc));
+        c1[r] = _mm512_loadu_si512((const void *)(c + r * ldc + 8));
+    }
+    for (size_t p = 0; p < kc; p++) {
+        const int *bp = b + p * ldb;
+        __m512i b0 = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i *)(const void *)bp));
+        __m512i b1 = _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i *)(const void *)(bp + 8)));
+        for (int r = 0; r < 4; r++) {
+            __m512i av = _mm512_set1_epi32(a[r * lda + p]);
+            c0[r] = _mm512_add_epi64(c0[r], _mm512_mul_epi32(av, b0));
+            c1[r] = _mm512_add_epi64(c1[r], _mm512_mul_epi32(av, b1));
+        }
+    }
+    for (int r = 0; r < 4; r++) {
+        _mm512_storeu_si512((void *)(c + r * ldc), c0[r]);
+        _mm512_storeu_si512((void *)(c + r * ldc + 8), c1[r]);
+    }
+}
+
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * Kernel tables, indexed by calc_isa_t
+ *
+ * SSE2 has no signed 32x32->64-bit multiply (_mm_mul_epi32 is SSE4.1), so
+ * that level uses the scalar kernels.
+ *===========================================================================*/
+
+typedef void (*micro_kernel)(const int *a, size_t lda, const int *b, size_t ldb,
+                             int64_t *c, size_t ldc, size_t kc);
+
+typedef struct {
+    dot_kernel dot;
+    rows4_kernel rows4;
+    axpy_kernel axpy;
+    micro_kernel micro;         /* NULL: GEMM uses gemm_scalar only */
+    size_t micro_cols;          /* Columns of c per micro-kernel call */
+} linalg_kernels;
+
+#if SDK_SIMD_X86
+static const linalg_kernels kernel_table[] = {
+    { dot_scalar, rows4_scalar, axpy_scalar, NULL, 0 },
+    { dot_scalar, rows4_scalar, axpy_scalar, NULL, 0 },
+    { dot_avx2, rows4_avx2, axpy_avx2, micro_avx2, 8 },
+    { dot_avx512, rows4_avx512, axpy_avx512, micro_avx512, 16 },
+};
+#else
+static const linalg_kernels kernel_table[] = {
+    { dot_scalar, rows4_scalar, axpy_scalar, NULL, 0 },
+};
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * GEMM drivers
+ *===========================================================================*/
+
+/* c[rows x cols] += a[rows x kc] * b[kc x cols]: 4-row micro tiles, scalar edges */
+static void gemm_block(const linalg_kernels *kernels, const int *a, size_t lda,
+                       const int *b, size_t ldb, int64_t *c, size_t ldc,
+                       size_t rows, size_t kc, size_t cols) {
+    size_t i = 0;
+
+    if (kernels->micro != NULL) {
+        const size_t width = kernels->micro_cols;
+        for (; i + 4 <= rows; i += 4) {
+            size_t j = 0;
+            for (; j + width <= cols; j += width) {
+                kernels->micro(a + i * lda, lda, b + j, ldb, c + i * ldc + j, ldc, kc);
+            }
+            gemm_scalar(a + i * lda, lda, b + j, ldb, c + i * ldc + j, ldc, 4, kc, cols - j);
+        }
+    }
+    gemm_scalar(a + i * lda, lda, b, ldb, c + i * ldc, ldc, rows - i, kc, cols);
+}
+
+/* 64-bit accumulation, exact when no partial sum can overflow */
+static void gemm_blocked(const int *a, const int *b, int64_t *c, size_t m, size_t k, size_t n) {
+    const linalg_kernels *kernels = &kernel_table[calc_batch_isa()];
+
+    memset(c, 0, m * n * sizeof(*c));
+    for (size_t jc = 0; jc < n; jc += GEMM_NC) {
+        size_t nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+        for (size_t pc = 0; pc < k; pc += GEMM_KC) {
+            size_t kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+            gemm_block(kernels, a + pc, k, b + pc * n + jc, n, c + jc, n, m, kc, nc);
+        }
+    }
+}
+
+/* 128-bit accumulation, GEMM_EXACT_COLS columns of one row at a time */
+static calc_status_t gemm_exact(const int *a, const int *b, int64_t *c,
+                                size_t m, size_t k, size_t n) {
+    __int128 acc[GEMM_EXACT_COLS];
+    int overflow = 0;
+
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j0 = 0; j0 < n; j0 += GEMM_EXACT_COLS) {
+            size_t width = n - j0 < GEMM_EXACT_COLS ? n - j0 : GEMM_EXACT_COLS;
+            memset(acc, 0, sizeof(acc));
+            for (size_t p = 0; p < k; p++) {
+                const int64_t av = a[i * k + p];
+                const int *bp = b + p * n + j0;
+                for (size_t j = 0; j < width; j++) {
+                    acc[j] += av * bp[j];
+                }
+            }
+            for (size_t j = 0; j < width; j++) {
+                overflow |= store_exact(acc[j], &c[i * n + j0 + j]);
+            }
+        }
+    }
+    return overflow ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+/* Largest magnitude in an int array (2^31 for INT_MIN) */
+static uint32_t max_magnitude(const int *a, size_t n) {
+    uint32_t max = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint32_t v = a[i] < 0 ? 0u - (uint32_t)a[i] : (uint32_t)a[i];
+        max = v > max ? v : max;
+    }
+    return max;
+}
+
+/*============================================================================
+ * Public functions
+ *===========================================================================*/
+
+calc_status_t calc_dot(const int *a, const int *b, size_t n, int64_t *result) {
+    dot_kernel dot = kernel_table[calc_batch_isa()].dot;
+    __int128 sum = 0;
+
+    for (size_t i = 0; i < n; i += SPLIT_BLOCK) {
+        sum += dot(a + i, b + i, n - i < SPLIT_BLOCK ? n - i : SPLIT_BLOCK);
+    }
+    return store_exact(sum, result) ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t calc_axpy(int alpha, const int *x, int64_t *y, size_t n) {
+    return kernel_table[calc_batch_isa()].axpy(alpha, x, y, n) ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t calc_gemv(const int *a, const int *x, int64_t *y, size_t rows, size_t cols) {
+    const linalg_kernels *kernels = &kernel_table[calc_batch_isa()];
+    int overflow = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= rows; i += 4) {
+        __int128 sums[4] = { 0, 0, 0, 0 };
+        for (size_t j = 0; j < cols; j += SPLIT_BLOCK) {
+            kernels->rows4(a + i * cols + j, cols, x + j,
+                           cols - j < SPLIT_BLOCK ? cols - j : SPLIT_BLOCK, sums);
+        }
+        for (int r = 0; r < 4; r++) {
+            overflow |= store_exact(sums[r], &y[i + r]);
+        }
+    }
+    for (; i < rows; i++) {
+        overflow |= calc_dot(a + i * cols, x, cols, &y[i]) != CALC_OK;
+    }
+    return overflow ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t calc_gemm(const int *a, const int *b, int64_t *c, size_t m, size_t k, size_t n) {
+    if (m == 0 || n == 0) {
+        return CALC_OK;
+    }
+    // |partial sum| <= k * max|a| * max|b|: 64 bits are enough below 2^63
+    unsigned __int128 bound = (unsigned __int128)k * max_magnitude(a, m * k) * max_magnitude(b, k * n);
+    if (bound > INT64_MAX) {
+        return gemm_exact(a, b, c, m, k, n);
+    }
+    gemm_blocked(a, b, c, m, k, n);
+    return CALC_OK;
+}
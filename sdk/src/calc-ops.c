@@ -0,0 +1,201 @@
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "calc-ops.h"
+#include "calc.h"
+#include "calc-batch.h"
+
+/*============================================================================
+ * Scalar backend
+ *
+ * Every element goes through the exported calc_* symbols (the parentheses
+ * keep CALC_INLINE from inlining them), so the linker --wrap mocks used by
+ * the unit tests see each call.
+ *===========================================================================*/
+
+#define DEFINE_SCALAR_BATCH(op)                                             \
+    static void scalar_##op##_batch(const int *a, const int *b, int *out,   \
+                                    size_t n) {                             \
+        for (size_t i = 0; i < n; i++) {                                    \
+            out[i] = (calc_##op)(a[i], b[i]);                               \
+        }                                                                   \
+    }
+
+DEFINE_SCALAR_BATCH(add)
+DEFINE_SCALAR_BATCH(subtract)
+DEFINE_SCALAR_BATCH(multiply)
+DEFINE_SCALAR_BATCH(divide)
+
+const sdk_calc_ops calc_ops_scalar = {
+    SDK_CALC_OPS_ABI, "scalar",
+    calc_add, calc_subtract, calc_multiply, calc_divide,
+    scalar_add_batch, scalar_subtract_batch, scalar_multiply_batch, scalar_divide_batch,
+};
+
+/*============================================================================
+ * Checked backend
+ *
+ * Same results as the scalar backend; the first failure on each thread is
+ * kept until calc_ops_take_status reads it.
+ *===========================================================================*/
+
+static __thread calc_status_t checked_status = CALC_OK;
+
+static inline void checked_record(calc_status_t status) {
+    if (status != CALC_OK && checked_status == CALC_OK) {
+        checked_status = status;
+    }
+}
+
+calc_status_t calc_ops_take_status(void) {
+    calc_status_t status = checked_status;
+    checked_status = CALC_OK;
+    return status;
+}
+
+#define DEFINE_CHECKED(op)                                                  \
+    static int checked_##op(int a, int b) {                                 \
+        int result;                                                         \
+        checked_record(calc_##op##_checked(a, b, &result));                 \
+        return result;                                                      \
+    }                                                                       \
+    static void checked_##op##_batch(const int *a, const int *b, int *out,  \
+                                     size_t n) {                            \
+        if (calc_##op##_checked_batch(a, b, out, NULL, n) != 0) {           \
+            checked_record(CALC_ERR_OVERFLOW);                              \
+        }                                                                   \
+    }
+
+DEFINE_CHECKED(add)
+DEFINE_CHECKED(subtract)
+DEFINE_CHECKED(multiply)
+
+static int checked_divide(int a, int b) {
+    int result;
+    checked_record(calc_divide_checked(a, b, &result));
+    return result;
+}
+
+static void checked_divide_batch(const int *a, const int *b, int *out, size_t n) {
+    // The batch count does not say which error it was, and out may alias
+    // the inputs: find the first failure before dividing
+    for (size_t i = 0; i < n; i++) {
+        if (b[i] == 0 || (a[i] == INT_MIN && b[i] == -1)) {
+            checked_record(b[i] == 0 ? CALC_ERR_DIV_BY_ZERO : CALC_ERR_OVERFLOW);
+            break;
+        }
+    }
+    calc_divide_checked_batch(a, b, out, NULL, n);
+}
+
+const sdk_calc_ops calc_ops_checked = {
+    SDK_CALC_OPS_ABI, "checked",
+    checked_add, checked_subtract, checked_multiply, checked_divide,
+    checked_add_batch, checked_subtract_batch, checked_multiply_batch, checked_divide_batch,
+};
+
+/*============================================================================
+ * SIMD backend
+ *
+ * Scalar entries are local copies of the inline calc_* bodies (no call
+ * into calc.c); batch entries use the runtime-dispatched SIMD kernels.
+ *===========================================================================*/
+
+const sdk_calc_ops calc_ops_simd = {
+    SDK_CALC_OPS_ABI, "simd",
+    calc_add_inline, calc_subtract_inline, calc_multiply_inline, calc_divide_inline,
+    calc_add_batch, calc_subtract_batch, calc_multiply_batch, calc_divide_batch,
+};
+
+/*============================================================================
+ * Active backend
+ *===========================================================================*/
+
+static const sdk_calc_ops *const builtin_ops[] = {
+    &calc_ops_scalar, &calc_ops_checked, &calc_ops_simd,
+};
+
+static const sdk_calc_ops *active_ops = NULL;
+
+static int ops_valid(const sdk_calc_ops *ops) {
+    return ops->abi == SDK_CALC_OPS_ABI
+        && ops->add != NULL && ops->subtract != NULL
+        && ops->multiply != NULL && ops->divide != NULL
+        && ops->add_batch != NULL && ops->subtract_batch != NULL
+        && ops->multiply_batch != NULL && ops->divide_batch != NULL;
+}
+
+/* Backend named by spec: a built-in name, or a path if it has a '/' */
+static const sdk_calc_ops* ops_resolve(const char *spec) {
+    return strchr(spec, '/') != NULL ? calc_ops_load(spec) : calc_ops_find(spec);
+}
+
+const sdk_calc_ops* calc_ops_get(void) {
+    const sdk_calc_ops *ops = __atomic_load_n(&active_ops, __ATOMIC_ACQUIRE);
+
+    if (__builtin_expect(ops == NULL, 0)) {
+        // First use: honour SDK_CALC_BACKEND, unless another thread won.
+        // Concurrent first calls may both resolve it; only one installs it.
+        const char *spec = getenv(SDK_CALC_OPS_ENV);
+        const sdk_calc_ops *resolved = spec != NULL ? ops_resolve(spec) : NULL;
+        const sdk_calc_ops *expected = NULL;
+        if (resolved == NULL || !ops_valid(resolved)) {
+            resolved = &calc_ops_scalar;
+        }
+        __atomic_compare_exchange_n(&active_ops, &expected, resolved, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        ops = __atomic_load_n(&active_ops, __ATOMIC_ACQUIRE);
+    }
+    return ops;
+}
+
+int calc_ops_set(const sdk_calc_ops *ops) {
+    if (ops == NULL) {
+        ops = &calc_ops_scalar;
+    }
+    if (!ops_valid(ops)) {
+        return -1;
+    }
+    __atomic_store_n(&active_ops, ops, __ATOMIC_RELEASE);
+    return 0;
+}
+
+const sdk_calc_ops* calc_ops_find(const char *name) {
+    for (size_t i = 0; i < sizeof(builtin_ops) / sizeof(builtin_ops[0]); i++) {
+        if (strcmp(builtin_ops[i]->name, name) == 0) {
+            return builtin_ops[i];
+        }
+    }
+    return NULL;
+}
+
+int calc_ops_select(const char *spec) {
+    const sdk_calc_ops *ops;
+
+    if (spec == NULL) {
+        return -1;
+    }
+    ops = ops_resolve(spec);
+    return ops != NULL ? calc_ops_set(ops) : -1;
+}
+
+/*============================================================================
+ * Shared object backends
+ *===========================================================================*/
+
+const sdk_calc_ops* calc_ops_load(const char *path) {
+    void *handle;
+    const sdk_calc_ops *ops;
+
+    if (path == NULL || (handle = dlopen(path, RTLD_NOW | RTLD_LOCAL)) == NULL) {
+        return NULL;
+    }
+    ops = (const sdk_calc_ops *)dlsym(handle, SDK_CALC_OPS_SYMBOL);
+    if (ops == NULL || !ops_valid(ops)) {
+        dlclose(handle);
+        return NULL;
+    }
+    // Never closed: callers may still hold pointers into the library
+    return ops;
+}
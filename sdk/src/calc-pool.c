@@ -0,0 +1,330 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "calc-pool.h"
+
+#define DEQUE_INITIAL 64        /* Tasks per deque before it grows (power of 2) */
+#define RANGES_PER_THREAD 8     /* Automatic grain: ranges per thread */
+
+/*============================================================================
+ * Jobs and tasks
+ *
+ * A job is one calc_pool_parallel_for call; it lives on the caller's stack
+ * until `remaining` drops to 0. A task is a range of a job still to run.
+ *===========================================================================*/
+
+typedef struct {
+    calc_pool_fn fn;
+    void *ctx;
+    size_t grain;
+    size_t remaining;           /* Indexes not processed yet (atomic) */
+} pool_job;
+
+typedef struct {
+    pool_job *job;
+    size_t begin;
+    size_t end;
+} pool_task;
+
+/*
+ * Deque of tasks in a ring. The owner pushes and pops at the back, thieves
+ * take from the front. Tasks are coarse (a grain of elements each), so a
+ * short mutex-protected section costs nothing measurable. `len` is also
+ * read without the lock to skip empty deques.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pool_task *tasks;
+    size_t cap;
+    size_t head;
+    size_t len;
+} task_deque;
+
+/*
+ * Slot 0 is shared by every thread outside the pool; worker i owns slot i.
+ * Workers sleep on `wake` when no deque has work.
+ */
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    unsigned threads;           /* Configured count, 0 until first read (atomic) */
+    int running;                /* Workers and deques set up (atomic) */
+    int stopping;
+    unsigned slots;             /* Deques in use, = threads while running */
+    unsigned sleepers;          /* Workers waiting on wake (atomic) */
+    pthread_t workers[CALC_POOL_MAX_THREADS];
+    int started[CALC_POOL_MAX_THREADS];
+    task_deque deques[CALC_POOL_MAX_THREADS];
+} pool = { .lock = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER };
+
+static __thread unsigned current_slot;     // 0 outside the pool
+
+/*============================================================================
+ * Deques
+ *===========================================================================*/
+
+static int deque_push(task_deque *d, pool_task task) {
+    pthread_mutex_lock(&d->lock);
+    if (d->len == d->cap) {
+        size_t cap = d->cap ? 2 * d->cap : DEQUE_INITIAL;
+        pool_task *tasks = malloc(cap * sizeof(*tasks));
+        if (tasks == NULL) {
+            pthread_mutex_unlock(&d->lock);
+            return -1;
+        }
+        for (size_t i = 0; i < d->len; i++) {
+            tasks[i] = d->tasks[(d->head + i) & (d->cap - 1)];
+        }
+        free(d->tasks);
+        d->tasks = tasks;
+        d->cap = cap;
+        d->head = 0;
+    }
+    d->tasks[(d->head + d->len) & (d->cap - 1)] = task;
+    __atomic_store_n(&d->len, d->len + 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&d->lock);
+    return 0;
+}
+
+static int deque_pop_back(task_deque *d, pool_task *task) {
+    int found = 0;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->len > 0) {
+        *task = d->tasks[(d->head + d->len - 1) & (d->cap - 1)];
+        __atomic_store_n(&d->len, d->len - 1, __ATOMIC_SEQ_CST);
+        found = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return found;
+}
+
+static int deque_steal_front(task_deque *d, pool_task *task) {
+    int found = 0;
+
+    pthread_mutex_lock(&d->lock);
+    if (d->len > 0) {
+        *task = d->tasks[d->head];
+        d->head = (d->head + 1) & (d->cap - 1);
+        __atomic_store_n(&d->len, d->len - 1, __ATOMIC_SEQ_CST);
+        found = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return found;
+}
+
+static int any_work(void) {
+    for (unsigned s = 0; s < pool.slots; s++) {
+        if (__atomic_load_n(&pool.deques[s].len, __ATOMIC_SEQ_CST) > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Newest task of our own deque, else the oldest of another one */
+static int find_task(unsigned slot, pool_task *task) {
+    if (deque_pop_back(&pool.deques[slot], task)) {
+        return 1;
+    }
+    for (unsigned k = 1; k < pool.slots; k++) {
+        task_deque *victim = &pool.deques[(slot + k) % pool.slots];
+        if (__atomic_load_n(&victim->len, __ATOMIC_RELAXED) > 0 &&
+            deque_steal_front(victim, task)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * Execution
+ *===========================================================================*/
+
+static void notify_sleepers(void) {
+    // Pairs with the sleepers increment in worker_main (both seq_cst)
+    if (__atomic_load_n(&pool.sleepers, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool.lock);
+        pthread_cond_signal(&pool.wake);
+        pthread_mutex_unlock(&pool.lock);
+    }
+}
+
+/* Split off upper halves for thieves down to the grain, then run the rest */
+static void run_task(unsigned slot, pool_task task) {
+    pool_job *job = task.job;
+    size_t done;
+
+    while (task.end - task.begin > job->grain) {
+        size_t mid = task.begin + (task.end - task.begin) / 2;
+        pool_task upper = { job, mid, task.end };
+        if (deque_push(&pool.deques[slot], upper) != 0) {
+            break;
+        }
+        notify_sleepers();
+        task.end = mid;
+    }
+    // Normally one call; several if a push ran out of memory
+    for (size_t b = task.begin; b < task.end; b += job->grain) {
+        size_t e = task.end - b > job->grain ? b + job->grain : task.end;
+        job->fn(job->ctx, b, e);
+    }
+    done = task.end - task.begin;
+    // Last access to the job: the owner may return once it reaches 0
+    __atomic_sub_fetch(&job->remaining, done, __ATOMIC_RELEASE);
+}
+
+static void* worker_main(void *arg) {
+    unsigned slot = (unsigned)(uintptr_t)arg;
+    pool_task task;
+
+    current_slot = slot;
+    for (;;) {
+        int stop;
+        if (find_task(slot, &task)) {
+            run_task(slot, task);
+            continue;
+        }
+        pthread_mutex_lock(&pool.lock);
+        __atomic_add_fetch(&pool.sleepers, 1, __ATOMIC_SEQ_CST);
+        while (!pool.stopping && !any_work()) {
+            pthread_cond_wait(&pool.wake, &pool.lock);
+        }
+        __atomic_sub_fetch(&pool.sleepers, 1, __ATOMIC_SEQ_CST);
+        stop = pool.stopping;
+        pthread_mutex_unlock(&pool.lock);
+        if (stop) {
+            return NULL;
+        }
+    }
+}
+
+/*============================================================================
+ * Pool lifetime
+ *===========================================================================*/
+
+static void start_workers(void) {
+    unsigned threads = calc_pool_threads();
+
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.running) {
+        pool.slots = threads;
+        for (unsigned s = 0; s < threads; s++) {
+            task_deque *d = &pool.deques[s];
+            pthread_mutex_init(&d->lock, NULL);
+            d->tasks = NULL;
+            d->cap = d->head = d->len = 0;
+        }
+        // A worker that cannot start leaves its share to the others
+        for (unsigned s = 1; s < threads; s++) {
+            pool.started[s] = pthread_create(&pool.workers[s], NULL, worker_main,
+                                             (void *)(uintptr_t)s) == 0;
+        }
+        __atomic_store_n(&pool.running, 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&pool.lock);
+}
+
+static void stop_workers(void) {
+    pthread_mutex_lock(&pool.lock);
+    if (!pool.running) {
+        pthread_mutex_unlock(&pool.lock);
+        return;
+    }
+    pool.stopping = 1;
+    pthread_cond_broadcast(&pool.wake);
+    pthread_mutex_unlock(&pool.lock);
+
+    for (unsigned s = 1; s < pool.slots; s++) {
+        if (pool.started[s]) {
+            pthread_join(pool.workers[s], NULL);
+            pool.started[s] = 0;
+        }
+    }
+    for (unsigned s = 0; s < pool.slots; s++) {
+        free(pool.deques[s].tasks);
+        pthread_mutex_destroy(&pool.deques[s].lock);
+    }
+    pool.slots = 0;
+    pool.stopping = 0;
+    __atomic_store_n(&pool.running, 0, __ATOMIC_RELEASE);
+}
+
+static unsigned clamp_threads(long threads) {
+    if (threads <= 0) {
+        threads = sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (threads < 1) {
+        return 1;
+    }
+    return threads > CALC_POOL_MAX_THREADS ? CALC_POOL_MAX_THREADS : (unsigned)threads;
+}
+
+/*============================================================================
+ * Public functions
+ *===========================================================================*/
+
+void calc_pool_set_threads(unsigned threads) {
+    stop_workers();
+    __atomic_store_n(&pool.threads, clamp_threads((long)threads), __ATOMIC_RELEASE);
+}
+
+unsigned calc_pool_threads(void) {
+    unsigned threads = __atomic_load_n(&pool.threads, __ATOMIC_ACQUIRE);
+
+    if (__builtin_expect(threads == 0, 0)) {
+        // First use: honour SDK_CALC_THREADS, unless another thread won
+        const char *env = getenv(CALC_POOL_ENV);
+        unsigned expected = 0;
+        threads = env != NULL && *env != '\0' ? clamp_threads(strtol(env, NULL, 10)) : 1;
+        __atomic_compare_exchange_n(&pool.threads, &expected, threads, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        threads = __atomic_load_n(&pool.threads, __ATOMIC_ACQUIRE);
+    }
+    return threads;
+}
+
+void calc_pool_parallel_for(size_t begin, size_t end, size_t grain,
+                            calc_pool_fn fn, void *ctx) {
+    unsigned threads = calc_pool_threads();
+    size_t n = end > begin ? end - begin : 0;
+    unsigned slot = current_slot;
+    pool_job job;
+    pool_task task;
+
+    if (n == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = n / ((size_t)threads * RANGES_PER_THREAD);
+        grain = grain ? grain : 1;
+    }
+    if (threads == 1 || n <= grain) {
+        for (size_t b = begin; b < end; b += grain) {
+            fn(ctx, b, end - b > grain ? b + grain : end);
+        }
+        return;
+    }
+    if (!__atomic_load_n(&pool.running, __ATOMIC_ACQUIRE)) {
+        start_workers();
+    }
+
+    job.fn = fn;
+    job.ctx = ctx;
+    job.grain = grain;
+    job.remaining = n;
+    task.job = &job;
+    task.begin = begin;
+    task.end = end;
+    run_task(slot, task);
+    // Help with any task (ours or not) until every range of the job is done
+    while (__atomic_load_n(&job.remaining, __ATOMIC_ACQUIRE) != 0) {
+        if (find_task(slot, &task)) {
+            run_task(slot, task);
+        } else {
+            sched_yield();
+        }
+    }
+}
@@ -0,0 +1,261 @@
+#include <string.h>
+#include "calc-reduce.h"
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "simd.h"
+
+/*============================================================================
+ * Partial results
+ *
+ * Every kernel reduces one range of the input into a reduce_part; the
+ * parts of all ranges (and threads) are then combined in order.
+ *===========================================================================*/
+
+typedef struct {
+    int64_t value;      /* Sum, or product wrapped around to 64 bits */
+    int overflow;       /* Product: some partial product overflowed */
+    int zero;           /* Product: the range contains a 0 */
+} reduce_part;
+
+typedef void (*reduce_kernel)(const int *a, size_t n, reduce_part *part);
+
+/*============================================================================
+ * Sum kernels
+ *
+ * Four independent accumulators (scalar variables or vectors of int64
+ * lanes) keep the additions out of one long dependency chain.
+ *===========================================================================*/
+
+static void sum_scalar(const int *a, size_t n, reduce_part *part) {
+    int64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        s0 += a[i];
+        s1 += a[i + 1];
+        s2 += a[i + 2];
+        s3 += a[i + 3];
+    }
+    for (; i < n; i++) {
+        s0 += a[i];
+    }
+    part->value = (s0 + s1) + (s2 + s3);
+}
+
+#if SDK_SIMD_X86
+
+SDK_TARGET_SSE2 static inline __m128i widen_lo_sse2(__m128i v) {
+    return _mm_unpacklo_epi32(v, _mm_srai_epi32(v, 31));
+}
+
+SDK_TARGET_SSE2 static inline __m128i widen_hi_sse2(__m128i v) {
+    return _mm_unpackhi_epi32(v, _mm_srai_epi32(v, 31));
+}
+
+SDK_TARGET_SSE2 static void sum_sse2(const int *a, size_t n, reduce_part *part) {
+    __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128();
+    __m128i s2 = _mm_setzero_si128(), s3 = _mm_setzero_si128();
+    int64_t lanes[2];
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *)(const void *)(a + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(const void *)(a + i + 4));
+        s0 = _mm_add_epi64(s0, widen_lo_sse2(v0));
+        s1 = _mm_add_epi64(s1, widen_hi_sse2(v0));
+        s2 = _mm_add_epi64(s2, widen_lo_sse2(v1));
+        s3 = _mm_add_epi64(s3, widen_hi_sse2(v1));
+    }
+    s0 = _mm_add_epi64(_mm_add_epi64(s0, s1), _mm_add_epi64(s2, s3));
+    _mm_storeu_si128((__m128i *)(void *)lanes, s0);
+
+    sum_scalar(a + i, n - i, part);
+    part->value += lanes[0] + lanes[1];
+}
+
+SDK_TARGET_AVX2 static inline __m256i load_widen_avx2(const int *p) {
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(const void *)p));
+}
+
+SDK_TARGET_AVX2 static void sum_avx2(const int *a, size_t n, reduce_part *part) {
+    __m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256();
+    __m256i s2 = _mm256_setzero_si256(), s3 = _mm256_setzero_si256();
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        s0 = _mm256_add_epi64(s0, load_widen_avx2(a + i));
+        s1 = _mm256_add_epi64(s1, load_widen_avx2(a + i + 4));
+        s2 = _mm256_add_epi64(s2, load_widen_avx2(a + i + 8));
+        s3 = _mm256_add_epi64(s3, load_widen_avx2(a + i + 12));
+    }
+    s0 = _mm256_add_epi64(_mm256_add_epi64(s0, s1), _mm256_add_epi64(s2, s3));
+    // Horizontal reduction: fold 256 -> 128 -> 64 bits
+    __m128i h = _mm_add_epi64(_mm256_castsi256_si128(s0), _mm256_extracti128_si256(s0, 1));
+    h = _mm_add_epi64(h, _mm_unpackhi_epi64(h, h));
+
+    sum_scalar(a + i, n - i, part);
+    part->value += _mm_cvtsi128_si64(h);
+}
+
+SDK_TARGET_AVX512 static inline __m512i load_widen_avx512(const int *p) {
+    return _mm512_cvtepi32_epi64(_mm256_loadu_si256((const __m256i *)(const void *)p));
+}
+
+SDK_TARGET_AVX512 static void sum_avx512(const int *a, size_t n, reduce_part *part) {
+    __m512i s0 = _mm512_setzero_si512(), s1 = _mm512_setzero_si512();
+    __m512i s2 = _mm512_setzero_si512(), s3 = _mm512_setzero_si512();
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        s0 = _mm512_add_epi64(s0, load_widen_avx512(a + i));
+        s1 = _mm512_add_epi64(s1, load_widen_avx512(a + i + 8));
+        s2 = _mm512_add_epi64(s2, load_widen_avx512(a + i + 16));
+        s3 = _mm512_add_epi64(s3, load_widen_avx512(a + i + 24));
+    }
+    s0 = _mm512_add_epi64(_mm512_add_epi64(s0, s1), _mm512_add_epi64(s2, s3));
+
+    sum_scalar(a + i, n - i, part);
+    part->value += _mm512_reduce_add_epi64(s0);
+}
+
+static const reduce_kernel sum_kernels[] = {
+    sum_scalar, sum_sse2, sum_avx2, sum_avx512,
+};
+#else
+static const reduce_kernel sum_kernels[] = { sum_scalar };
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * Product kernel
+ *
+ * There is no SIMD 64-bit multiply with overflow detection, so the product
+ * uses four scalar accumulators. Once the range is known to contain a 0
+ * the rest of it does not matter.
+ *===========================================================================*/
+
+static inline int64_t mul_wrap(int64_t a, int64_t b, int *overflow) {
+    int64_t r;
+    if (__builtin_mul_overflow(a, b, &r)) {
+        *overflow = 1;
+        r = (int64_t)((uint64_t)a * (uint64_t)b);
+    }
+    return r;
+}
+
+static void product_scalar(const int *a, size_t n, reduce_part *part) {
+    int64_t p0 = 1, p1 = 1, p2 = 1, p3 = 1;
+    int overflow = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        if (a[i] == 0 || a[i + 1] == 0 || a[i + 2] == 0 || a[i + 3] == 0) {
+            part->zero = 1;
+            return;
+        }
+        p0 = mul_wrap(p0, a[i], &overflow);
+        p1 = mul_wrap(p1, a[i + 1], &overflow);
+        p2 = mul_wrap(p2, a[i + 2], &overflow);
+        p3 = mul_wrap(p3, a[i + 3], &overflow);
+    }
+    for (; i < n; i++) {
+        if (a[i] == 0) {
+            part->zero = 1;
+            return;
+        }
+        p0 = mul_wrap(p0, a[i], &overflow);
+    }
+    part->value = mul_wrap(mul_wrap(p0, p1, &overflow), mul_wrap(p2, p3, &overflow), &overflow);
+    part->overflow = overflow;
+}
+
+/*============================================================================
+ * Multi-threaded split
+ *
+ * Large inputs are cut into one range per calc-pool thread, each of at
+ * least CALC_REDUCE_MIN_PER_THREAD elements, and the ranges are reduced
+ * on the pool. The range boundaries depend only on n and the thread count.
+ *===========================================================================*/
+
+void calc_reduce_set_threads(unsigned threads) {
+    calc_pool_set_threads(threads ? threads : 1);
+}
+
+unsigned calc_reduce_threads(void) {
+    return calc_pool_threads();
+}
+
+typedef struct {
+    reduce_kernel kernel;
+    const int *a;
+    size_t n;
+    size_t count;                               /* Number of ranges */
+    reduce_part parts[CALC_POOL_MAX_THREADS];   /* One per range */
+} reduce_job;
+
+static void reduce_range(void *ctx, size_t begin, size_t end) {
+    reduce_job *job = ctx;
+
+    for (size_t t = begin; t < end; t++) {
+        size_t first = job->n / job->count * t;
+        size_t last = t + 1 == job->count ? job->n : job->n / job->count * (t + 1);
+        job->kernel(job->a + first, last - first, &job->parts[t]);
+    }
+}
+
+/* Reduce a[0..n) into job->parts[0..job->count) */
+static void reduce_ranges(reduce_kernel kernel, const int *a, size_t n, reduce_job *job) {
+    size_t count = n / CALC_REDUCE_MIN_PER_THREAD;
+    size_t limit = calc_pool_threads();
+
+    if (count > limit) {
+        count = limit;
+    }
+    if (count == 0) {
+        count = 1;
+    }
+    job->kernel = kernel;
+    job->a = a;
+    job->n = n;
+    job->count = count;
+    memset(job->parts, 0, count * sizeof(job->parts[0]));
+
+    if (count == 1) {
+        reduce_range(job, 0, 1);
+    } else {
+        calc_pool_parallel_for(0, count, 1, reduce_range, job);
+    }
+}
+
+/*============================================================================
+ * Public functions
+ *===========================================================================*/
+
+int64_t calc_sum(const int *a, size_t n) {
+    reduce_job job;
+    int64_t sum = 0;
+
+    reduce_ranges(sum_kernels[calc_batch_isa()], a, n, &job);
+    for (size_t t = 0; t < job.count; t++) {
+        sum += job.parts[t].value;
+    }
+    return sum;
+}
+
+calc_status_t calc_product(const int *a, size_t n, int64_t *result) {
+    reduce_job job;
+    int64_t product = 1;
+    int overflow = 0;
+
+    reduce_ranges(product_scalar, a, n, &job);
+    for (size_t t = 0; t < job.count; t++) {
+        if (job.parts[t].zero) {
+            // A zero factor makes the exact product 0, whatever overflowed
+            *result = 0;
+            return CALC_OK;
+        }
+        overflow |= job.parts[t].overflow;
+        product = mul_wrap(product, job.parts[t].value, &overflow);
+    }
+    *result = product;
+    return overflow ? CALC_ERR_OVERFLOW : CALC_OK;
+}
@@ -0,0 +1,422 @@
+#include <string.h>
+#include "calc-select.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+#include "simd.h"
+
+/*============================================================================
+ * Comparisons
+ *
+ * Every comparison is one of two base tests, a == b or a > b, with the
+ * operands possibly swapped and the result possibly inverted:
+ * LT(a, b) = GT(b, a), LE = !GT, GE = !LT, NE = !EQ. SIMD has both base
+ * tests, so one kernel per instruction set covers all six.
+ *===========================================================================*/
+
+typedef struct {
+    unsigned char eq;           /* Base test a == b, else a > b */
+    unsigned char swap;
+    unsigned char invert;
+} cmp_form;
+
+static const cmp_form cmp_forms[] = {
+    [CALC_CMP_EQ] = { 1, 0, 0 },
+    [CALC_CMP_NE] = { 1, 0, 1 },
+    [CALC_CMP_LT] = { 0, 1, 0 },
+    [CALC_CMP_LE] = { 0, 0, 1 },
+    [CALC_CMP_GT] = { 0, 0, 0 },
+    [CALC_CMP_GE] = { 0, 1, 1 },
+};
+
+/* b is NULL to compare with value. Groups of 8 rows fill one bitmap byte. */
+typedef size_t (*compare_kernel)(const int *a, const int *b, int value, cmp_form form,
+                                 unsigned char *bits, size_t n);
+
+static size_t compare_scalar(const int *a, const int *b, int value, cmp_form form,
+                             unsigned char *bits, size_t n) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i += 8) {
+        size_t len = (n - i < 8) ? n - i : 8;
+        unsigned byte = 0;
+        for (size_t j = 0; j < len; j++) {
+            int x = a[i + j];
+            int y = b != NULL ? b[i + j] : value;
+            if (form.swap) {
+                int t = x;
+                x = y;
+                y = t;
+            }
+            unsigned r = form.eq ? x == y : x > y;
+            byte |= (r ^ form.invert) << j;
+        }
+        count += (size_t)__builtin_popcount(byte);
+        bits[i / 8] = (unsigned char)byte;
+    }
+    return count;
+}
+
+#if SDK_SIMD_X86
+
+/*
+ * Generate a comparison kernel: `step` compares `width` rows (a multiple
+ * of 8) and returns their bits; the tail goes to the scalar kernel.
+ */
+#define SIMD_COMPARE_KERNEL(name, target, width, step)                       \
+    target static size_t name(const int *a, const int *b, int value, cmp_form form, \
+                              unsigned char *bits, size_t n) {               \
+        size_t count = 0;                                                    \
+        size_t i = 0;                                                        \
+        for (; i + (width) <= n; i += (width)) {                             \
+            unsigned m = step(a + i, b != NULL ? b + i : NULL, value, form); \
+            count += (size_t)__builtin_popcount(m);                          \
+            for (size_t k = 0; k < (width) / 8; k++) {                       \
+                bits[i / 8 + k] = (unsigned char)(m >> (8 * k));             \
+            }                                                                \
+        }                                                                    \
+        return count + compare_scalar(a + i, b != NULL ? b + i : NULL, value, form, \
+                                      bits + i / 8, n - i);                  \
+    }
+
+SDK_TARGET_SSE2 static inline unsigned compare_step_sse2(const int *a, const int *b,
+                                                         int value, cmp_form form) {
+    unsigned bits = 0;
+    for (int k = 0; k < 2; k++) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(const void *)(a + 4 * k));
+        __m128i y = b != NULL ? _mm_loadu_si128((const __m128i *)(const void *)(b + 4 * k))
+                              : _mm_set1_epi32(value);
+        if (form.swap) {
+            __m128i t = x;
+            x = y;
+            y = t;
+        }
+        __m128i m = form.eq ? _mm_cmpeq_epi32(x, y) : _mm_cmpgt_epi32(x, y);
+        bits |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(m)) << (4 * k);
+    }
+    return form.invert ? bits ^ 0xffu : bits;
+}
+
+SDK_TARGET_AVX2 static inline unsigned compare_step_avx2(const int *a, const int *b,
+                                                         int value, cmp_form form) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(const void *)a);
+    __m256i y = b != NULL ? _mm256_loadu_si256((const __m256i *)(const void *)b)
+                          : _mm256_set1_epi32(value);
+    if (form.swap) {
+        __m256i t = x;
+        x = y;
+        y = t;
+    }
+    __m256i m = form.eq ? _mm256_cmpeq_epi32(x, y) : _mm256_cmpgt_epi32(x, y);
+    unsigned bits = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(m));
+    return form.invert ? bits ^ 0xffu : bits;
+}
+
+SDK_TARGET_AVX512 static inline unsigned compare_step_avx512(const int *a, const int *b,
+                                                             int value, cmp_form form) {
+    __m512i x = _mm512_loadu_si512((const void *)a);
+    __m512i y = b != NULL ? _mm512_loadu_si512((const void *)b) : _mm512_set1_epi32(value);
+    if (form.swap) {
+        __m512i t = x;
+        x = y;
+        y = t;
+    }
+    unsigned bits = form.eq ? _mm512_cmpeq_epi32_mask(x, y) : _mm512_cmpgt_epi32_mask(x, y);
+    return form.invert ? bits ^ 0xffffu : bits;
+}
+
+SIMD_COMPARE_KERNEL(compare_sse2, SDK_TARGET_SSE2, 8, compare_step_sse2)
+SIMD_COMPARE_KERNEL(compare_avx2, SDK_TARGET_AVX2, 8, compare_step_avx2)
+SIMD_COMPARE_KERNEL(compare_avx512, SDK_TARGET_AVX512, 16, compare_step_avx512)
+
+static const compare_kernel compare_kernels[] = {
+    compare_scalar, compare_sse2, compare_avx2, compare_avx512,
+};
+#else
+static const compare_kernel compare_kernels[] = { compare_scalar };
+#endif
+
+static size_t compare(calc_cmp_t cmp, const int *a, const int *b, int value,
+                      unsigned char *bits, size_t n) {
+    if ((unsigned)cmp > CALC_CMP_GE) {
+        memset(bits, 0, CALC_BITMAP_BYTES(n));
+        return 0;
+    }
+    return compare_kernels[calc_batch_isa()](a, b, value, cmp_forms[cmp], bits, n);
+}
+
+size_t calc_compare_batch(calc_cmp_t cmp, const int *a, const int *b,
+                          unsigned char *bits, size_t n) {
+    return compare(cmp, a, b, 0, bits, n);
+}
+
+size_t calc_compare_value_batch(calc_cmp_t cmp, const int *a, int value,
+                                unsigned char *bits, size_t n) {
+    return compare(cmp, a, NULL, value, bits, n);
+}
+
+/*============================================================================
+ * Bitmaps
+ *===========================================================================*/
+
+/* Clear the unused bits of the last byte, then count the set bits */
+static size_t bitmap_finish(unsigned char *bits, size_t n) {
+    size_t count = 0;
+    size_t j = 0;
+
+    if (n % 8 != 0) {
+        bits[n / 8] &= (unsigned char)((1u << (n % 8)) - 1);
+    }
+    for (; j + 8 <= CALC_BITMAP_BYTES(n); j += 8) {
+        uint64_t word;
+        memcpy(&word, bits + j, sizeof(word));
+        count += (size_t)__builtin_popcountll(word);
+    }
+    for (; j < CALC_BITMAP_BYTES(n); j++) {
+        count += (size_t)__builtin_popcount(bits[j]);
+    }
+    return count;
+}
+
+size_t calc_bitmap_and(const unsigned char *x, const unsigned char *y,
+                       unsigned char *out, size_t n) {
+    for (size_t j = 0; j < CALC_BITMAP_BYTES(n); j++) {
+        out[j] = x[j] & y[j];
+    }
+    return bitmap_finish(out, n);
+}
+
+size_t calc_bitmap_or(const unsigned char *x, const unsigned char *y,
+                      unsigned char *out, size_t n) {
+    for (size_t j = 0; j < CALC_BITMAP_BYTES(n); j++) {
+        out[j] = x[j] | y[j];
+    }
+    return bitmap_finish(out, n);
+}
+
+size_t calc_bitmap_to_selection(const unsigned char *bits, size_t n, uint32_t *sel) {
+    size_t count = 0;
+    size_t i = 0;
+
+    // One 64-bit word at a time; the loop runs once per set bit
+    for (; i + 64 <= n; i += 64) {
+        uint64_t word;
+        memcpy(&word, bits + i / 8, sizeof(word));
+        while (word != 0) {
+            sel[count++] = (uint32_t)(i + (size_t)__builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+    for (; i < n; i++) {
+        if ((bits[i / 8] >> (i % 8)) & 1) {
+            sel[count++] = (uint32_t)i;
+        }
+    }
+    return count;
+}
+
+/*============================================================================
+ * Row operations
+ *
+ * Unsigned arithmetic so overflow wraps, as in calc-batch.c. The row
+ * macros read the a, b, c and d columns of the kernel they expand in.
+ *===========================================================================*/
+
+static inline int divide_row(int a, int b) {
+    if (b == 0) {
+        return 0;
+    }
+    if (b == -1) {
+        return (int)(0u - (unsigned)a);     // INT_MIN / -1 wraps to INT_MIN
+    }
+    return a / b;
+}
+
+#define ADD_ROW(i)      (int)((unsigned)a[i] + (unsigned)b[i])
+#define SUBTRACT_ROW(i) (int)((unsigned)a[i] - (unsigned)b[i])
+#define MULTIPLY_ROW(i) (int)((unsigned)a[i] * (unsigned)b[i])
+#define DIVIDE_ROW(i)   divide_row(a[i], b[i])
+#define EXPRESSION_ROW(i) \
+    (int)(((unsigned)a[i] + (unsigned)b[i]) * ((unsigned)c[i] - (unsigned)d[i]))
+
+/*============================================================================
+ * Selection vectors
+ *===========================================================================*/
+
+#define SEL_FUNCTION(name, row)                                              \
+    void name(const int *a, const int *b, int *out, const uint32_t *sel, size_t count) { \
+        for (size_t k = 0; k < count; k++) {                                 \
+            size_t i = sel[k];                                               \
+            out[i] = row(i);                                                 \
+        }                                                                    \
+    }
+
+SEL_FUNCTION(calc_add_batch_sel, ADD_ROW)
+SEL_FUNCTION(calc_subtract_batch_sel, SUBTRACT_ROW)
+SEL_FUNCTION(calc_multiply_batch_sel, MULTIPLY_ROW)
+SEL_FUNCTION(calc_divide_batch_sel, DIVIDE_ROW)
+
+void multi_calc_expression_batch_sel(const int *a, const int *b, const int *c,
+                                     const int *d, int *out,
+                                     const uint32_t *sel, size_t count) {
+    for (size_t k = 0; k < count; k++) {
+        size_t i = sel[k];
+        out[i] = EXPRESSION_ROW(i);
+    }
+}
+
+/*============================================================================
+ * Bitmap kernels
+ *
+ * Rows [begin, n) with begin a multiple of 8; binary operations ignore c
+ * and d. SIMD kernels hand their tail to the scalar kernel.
+ *===========================================================================*/
+
+typedef void (*bitmap_kernel)(const int *a, const int *b, const int *c, const int *d,
+                              int *out, const unsigned char *bits, size_t begin, size_t n);
+
+#define BITMAP_SCALAR_KERNEL(name, row)                                      \
+    static void name(const int *a, const int *b, const int *c, const int *d, \
+                     int *out, const unsigned char *bits, size_t begin, size_t n) { \
+        (void)c;                                                             \
+        (void)d;                                                             \
+        for (size_t i = begin; i < n; i += 8) {                              \
+            unsigned byte = bits[i / 8];                                     \
+            if (n - i < 8) {                                                 \
+                byte &= (1u << (n - i)) - 1;                                 \
+            }                                                                \
+            if (byte == 0xff) {                                              \
+                for (size_t j = i; j < i + 8; j++) {                         \
+                    out[j] = row(j);                                         \
+                }                                                            \
+                continue;                                                    \
+            }                                                                \
+            while (byte != 0) {                                              \
+                size_t j = i + (size_t)__builtin_ctz(byte);                  \
+                out[j] = row(j);                                             \
+                byte &= byte - 1;                                            \
+            }                                                                \
+        }                                                                    \
+    }
+
+BITMAP_SCALAR_KERNEL(add_bitmap_scalar, ADD_ROW)
+BITMAP_SCALAR_KERNEL(subtract_bitmap_scalar, SUBTRACT_ROW)
+BITMAP_SCALAR_KERNEL(multiply_bitmap_scalar, MULTIPLY_ROW)
+BITMAP_SCALAR_KERNEL(divide_bitmap_scalar, DIVIDE_ROW)
+BITMAP_SCALAR_KERNEL(expression_bitmap_scalar, EXPRESSION_ROW)
+
+#if SDK_SIMD_X86
+
+/*
+ * AVX2 stores 8 rows under a lane mask built from one bitmap byte;
+ * AVX-512 stores 16 rows under a mask register taken from two bytes.
+ * There is no SSE2 equivalent (maskmovdqu bypasses the caches), so SSE2
+ * uses the scalar kernels.
+ */
+#define LOAD256(p, i) _mm256_loadu_si256((const __m256i *)(const void *)((p) + (i)))
+#define LOAD512(p, i) _mm512_loadu_si512((const void *)((p) + (i)))
+
+#define ADD_AVX2(i)      _mm256_add_epi32(LOAD256(a, i), LOAD256(b, i))
+#define SUBTRACT_AVX2(i) _mm256_sub_epi32(LOAD256(a, i), LOAD256(b, i))
+#define MULTIPLY_AVX2(i) _mm256_mullo_epi32(LOAD256(a, i), LOAD256(b, i))
+#define EXPRESSION_AVX2(i)                                                   \
+    _mm256_mullo_epi32(_mm256_add_epi32(LOAD256(a, i), LOAD256(b, i)),       \
+                       _mm256_sub_epi32(LOAD256(c, i), LOAD256(d, i)))
+
+#define ADD_AVX512(i)      _mm512_add_epi32(LOAD512(a, i), LOAD512(b, i))
+#define SUBTRACT_AVX512(i) _mm512_sub_epi32(LOAD512(a, i), LOAD512(b, i))
+#define MULTIPLY_AVX512(i) _mm512_mullo_epi32(LOAD512(a, i), LOAD512(b, i))
+#define EXPRESSION_AVX512(i)                                                 \
+    _mm512_mullo_epi32(_mm512_add_epi32(LOAD512(a, i), LOAD512(b, i)),       \
+                       _mm512_sub_epi32(LOAD512(c, i), LOAD512(d, i)))
+
+#define BITMAP_AVX2_KERNEL(name, vrow, tail)                                 \
+    SDK_TARGET_AVX2 static void name(const int *a, const int *b, const int *c, const int *d, \
+                                     int *out, const unsigned char *bits,    \
+                                     size_t begin, size_t n) {               \
+        const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128); \
+        size_t i = begin;                                                    \
+        for (; i + 8 <= n; i += 8) {                                         \
+            unsigned byte = bits[i / 8];                                     \
+            if (byte == 0) {                                                 \
+                continue;                                                    \
+            }                                                                \
+            __m256i r = vrow(i);                                             \
+            if (byte == 0xff) {                                              \
+                _mm256_storeu_si256((__m256i *)(void *)(out + i), r);        \
+                continue;                                                    \
+            }                                                                \
+            __m256i lanes = _mm256_and_si256(_mm256_set1_epi32((int)byte), lane_bits); \
+            _mm256_maskstore_epi32(out + i, _mm256_cmpeq_epi32(lanes, lane_bits), r); \
+        }                                                                    \
+        tail(a, b, c, d, out, bits, i, n);                                   \
+    }
+
+#define BITMAP_AVX512_KERNEL(name, vrow, tail)                               \
+    SDK_TARGET_AVX512 static void name(const int *a, const int *b, const int *c, const int *d, \
+                                       int *out, const unsigned char *bits,  \
+                                       size_t begin, size_t n) {             \
+        size_t i = begin;                                                    \
+        for (; i + 16 <= n; i += 16) {                                       \
+            unsigned m = bits[i / 8] | (unsigned)bits[i / 8 + 1] << 8;       \
+            if (m != 0) {                                                    \
+                _mm512_mask_storeu_epi32(out + i, (__mmask16)m, vrow(i));    \
+            }                                                                \
+        }                                                                    \
+        tail(a, b, c, d, out, bits, i, n);                                   \
+    }
+
+BITMAP_AVX2_KERNEL(add_bitmap_avx2, ADD_AVX2, add_bitmap_scalar)
+BITMAP_AVX2_KERNEL(subtract_bitmap_avx2, SUBTRACT_AVX2, subtract_bitmap_scalar)
+BITMAP_AVX2_KERNEL(multiply_bitmap_avx2, MULTIPLY_AVX2, multiply_bitmap_scalar)
+BITMAP_AVX2_KERNEL(expression_bitmap_avx2, EXPRESSION_AVX2, expression_bitmap_scalar)
+
+BITMAP_AVX512_KERNEL(add_bitmap_avx512, ADD_AVX512, add_bitmap_scalar)
+BITMAP_AVX512_KERNEL(subtract_bitmap_avx512, SUBTRACT_AVX512, subtract_bitmap_scalar)
+BITMAP_AVX512_KERNEL(multiply_bitmap_avx512, MULTIPLY_AVX512, multiply_bitmap_scalar)
+BITMAP_AVX512_KERNEL(expression_bitmap_avx512, EXPRESSION_AVX512, expression_bitmap_scalar)
+
+static const bitmap_kernel add_bitmap_kernels[] = {
+    add_bitmap_scalar, add_bitmap_scalar, add_bitmap_avx2, add_bitmap_avx512,
+};
+static const bitmap_kernel subtract_bitmap_kernels[] = {
+    subtract_bitmap_scalar, subtract_bitmap_scalar, subtract_bitmap_avx2, subtract_bitmap_avx512,
+};
+static const bitmap_kernel multiply_bitmap_kernels[] = {
+    multiply_bitmap_scalar, multiply_bitmap_scalar, multiply_bitmap_avx2, multiply_bitmap_avx512,
+};
+static const bitmap_kernel expression_bitmap_kernels[] = {
+    expression_bitmap_scalar, expression_bitmap_scalar, expression_bitmap_avx2,
+    expression_bitmap_avx512,
+};
+#else
+static const bitmap_kernel add_bitmap_kernels[] = { add_bitmap_scalar };
+static const bitmap_kernel subtract_bitmap_kernels[] = { subtract_bitmap_scalar };
+static const bitmap_kernel multiply_bitmap_kernels[] = { multiply_bitmap_scalar };
+static const bitmap_kernel expression_bitmap_kernels[] = { expression_bitmap_scalar };
+#endif
+
+void calc_add_batch_bitmap(const int *a, const int *b, int *out,
+                           const unsigned char *bits, size_t n) {
+    add_bitmap_kernels[calc_batch_isa()](a, b, NULL, NULL, out, bits, 0, n);
+}
+
+void calc_subtract_batch_bitmap(const int *a, const int *b, int *out,
+                                const unsigned char *bits, size_t n) {
+    subtract_bitmap_kernels[calc_batch_isa()](a, b, NULL, NULL, out, bits, 0, n);
+}
+
+void calc_multiply_batch_bitmap(const int *a, const int *b, int *out,
+                                const unsigned char *bits, size_t n) {
+    multiply_bitmap_kernels[calc_batch_isa()](a, b, NULL, NULL, out, bits, 0, n);
+}
+
+void calc_divide_batch_bitmap(const int *a, const int *b, int *out,
+                              const unsigned char *bits, size_t n) {
+    divide_bitmap_scalar(a, b, NULL, NULL, out, bits, 0, n);
+}
+
+void multi_calc_expression_batch_bitmap(const int *a, const int *b, const int *c,
+                                        const int *d, int *out,
+                                        const unsigned char *bits, size_t n) {
+    expression_bitmap_kernels[calc_batch_isa()](a, b, c, d, out, bits, 0, n);
+}
@@ -0,0 +1,394 @@
+#include <limits.h>
+#include "calc-wide.h"
+#include "calc-batch.h"
+#include "simd.h"
+
+/*
+ * Everything in this file is generated from three definitions:
+ *
+ *   DEFINE_ELEMENT_OPS   scalar add/subtract/multiply/divide for one element
+ *                        type under both policies (wrap, sat)
+ *   DEFINE_VECTOR_OPS    the same operations on SIMD vectors, written once
+ *                        against a small per-instruction-set helper layer
+ *   DEFINE_VARIANT       public scalar functions, kernels and dispatch for
+ *                        one (element type, policy) pair
+ *
+ * so a policy behaves the same at every width and on every instruction set.
+ */
+
+/*============================================================================
+ * Element operations
+ *===========================================================================*/
+
+#define DEFINE_ELEMENT_OPS(es, T, U, MIN, MAX)                                \
+    static inline T wrap_add_##es(T a, T b) {                                 \
+        return (T)((U)a + (U)b);                                              \
+    }                                                                         \
+    static inline T wrap_subtract_##es(T a, T b) {                            \
+        return (T)((U)a - (U)b);                                              \
+    }                                                                         \
+    static inline T wrap_multiply_##es(T a, T b) {                            \
+        return (T)((U)a * (U)b);                                              \
+    }                                                                         \
+    static inline T wrap_divide_##es(T a, T b) {                              \
+        if (b == 0) {                                                         \
+            return 0;                                                         \
+        }                                                                     \
+        /* MIN / -1 would trap, negate with wrap-around instead */            \
+        return b == -1 ? (T)(0 - (U)a) : a / b;                               \
+    }                                                                         \
+    static inline T sat_add_##es(T a, T b) {                                  \
+        T r;                                                                  \
+        return __builtin_add_overflow(a, b, &r) ? (a < 0 ? MIN : MAX) : r;    \
+    }                                                                         \
+    static inline T sat_subtract_##es(T a, T b) {                             \
+        T r;                                                                  \
+        return __builtin_sub_overflow(a, b, &r) ? (a < 0 ? MIN : MAX) : r;    \
+    }                                                                         \
+    static inline T sat_multiply_##es(T a, T b) {                             \
+        T r;                                                                  \
+        if (__builtin_mul_overflow(a, b, &r)) {                               \
+            return (a < 0) != (b < 0) ? MIN : MAX;                            \
+        }                                                                     \
+        return r;                                                             \
+    }                                                                         \
+    static inline T sat_divide_##es(T a, T b) {                               \
+        if (b == 0) {                                                         \
+            return 0;                                                         \
+        }                                                                     \
+        if (b == -1) {                                                        \
+            return a == MIN ? MAX : -a;                                       \
+        }                                                                     \
+        return a / b;                                                         \
+    }
+
+DEFINE_ELEMENT_OPS(i32, int, unsigned int, INT_MIN, INT_MAX)
+DEFINE_ELEMENT_OPS(i64, int64_t, uint64_t, INT64_MIN, INT64_MAX)
+
+/*============================================================================
+ * Scalar kernels
+ *===========================================================================*/
+
+typedef void (*kernel_i32)(const int *a, const int *b, int *out, size_t n);
+typedef void (*kernel_i64)(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+
+#define DEFINE_SCALAR_KERNEL(pol, op, es, T)                                  \
+    static void pol##_##op##_##es##_scalar(const T *a, const T *b, T *out,    \
+                                           size_t n) {                        \
+        for (size_t i = 0; i < n; i++) {                                      \
+            out[i] = pol##_##op##_##es(a[i], b[i]);                           \
+        }                                                                     \
+    }
+
+#if SDK_SIMD_X86
+
+/*============================================================================
+ * Per-instruction-set helper layer
+ *
+ * Each instruction set provides <isa>_vec and the same set of helpers;
+ * sign_iNN() broadcasts the sign bit of every lane, max_iNN() is a vector
+ * of INT_MAX / INT64_MAX.
+ *===========================================================================*/
+
+typedef __m128i sse2_vec;
+
+SDK_TARGET_SSE2 static inline sse2_vec sse2_load(const void *p) { return _mm_loadu_si128((const __m128i *)p); }
+SDK_TARGET_SSE2 static inline void sse2_store(void *p, sse2_vec v) { _mm_storeu_si128((__m128i *)p, v); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_and(sse2_vec a, sse2_vec b) { return _mm_and_si128(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_andnot(sse2_vec a, sse2_vec b) { return _mm_andnot_si128(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_or(sse2_vec a, sse2_vec b) { return _mm_or_si128(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_xor(sse2_vec a, sse2_vec b) { return _mm_xor_si128(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_add_i32(sse2_vec a, sse2_vec b) { return _mm_add_epi32(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_add_i64(sse2_vec a, sse2_vec b) { return _mm_add_epi64(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_sub_i32(sse2_vec a, sse2_vec b) { return _mm_sub_epi32(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_sub_i64(sse2_vec a, sse2_vec b) { return _mm_sub_epi64(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_sign_i32(sse2_vec a) { return _mm_srai_epi32(a, 31); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_sign_i64(sse2_vec a) {
+    // No 64-bit arithmetic shift: copy the sign of each high half
+    return _mm_shuffle_epi32(_mm_srai_epi32(a, 31), _MM_SHUFFLE(3, 3, 1, 1));
+}
+SDK_TARGET_SSE2 static inline sse2_vec sse2_max_i32(void) { return _mm_set1_epi32(INT_MAX); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_max_i64(void) { return _mm_set1_epi64x(INT64_MAX); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_zero(void) { return _mm_setzero_si128(); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_mul_u32(sse2_vec a, sse2_vec b) { return _mm_mul_epu32(a, b); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_hi32_u64(sse2_vec a) { return _mm_srli_epi64(a, 32); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_shl32_u64(sse2_vec a) { return _mm_slli_epi64(a, 32); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_lo32_u64(sse2_vec a) { return _mm_and_si128(a, _mm_set1_epi64x(0xFFFFFFFF)); }
+SDK_TARGET_SSE2 static inline sse2_vec sse2_msb_u64(sse2_vec a) { return _mm_srli_epi64(a, 63); }
+
+typedef __m256i avx2_vec;
+
+SDK_TARGET_AVX2 static inline avx2_vec avx2_load(const void *p) { return _mm256_loadu_si256((const __m256i *)p); }
+SDK_TARGET_AVX2 static inline void avx2_store(void *p, avx2_vec v) { _mm256_storeu_si256((__m256i *)p, v); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_and(avx2_vec a, avx2_vec b) { return _mm256_and_si256(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_andnot(avx2_vec a, avx2_vec b) { return _mm256_andnot_si256(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_or(avx2_vec a, avx2_vec b) { return _mm256_or_si256(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_xor(avx2_vec a, avx2_vec b) { return _mm256_xor_si256(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_add_i32(avx2_vec a, avx2_vec b) { return _mm256_add_epi32(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_add_i64(avx2_vec a, avx2_vec b) { return _mm256_add_epi64(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_sub_i32(avx2_vec a, avx2_vec b) { return _mm256_sub_epi32(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_sub_i64(avx2_vec a, avx2_vec b) { return _mm256_sub_epi64(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_sign_i32(avx2_vec a) { return _mm256_srai_epi32(a, 31); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_sign_i64(avx2_vec a) {
+    return _mm256_shuffle_epi32(_mm256_srai_epi32(a, 31), _MM_SHUFFLE(3, 3, 1, 1));
+}
+SDK_TARGET_AVX2 static inline avx2_vec avx2_max_i32(void) { return _mm256_set1_epi32(INT_MAX); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_max_i64(void) { return _mm256_set1_epi64x(INT64_MAX); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_zero(void) { return _mm256_setzero_si256(); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_mul_u32(avx2_vec a, avx2_vec b) { return _mm256_mul_epu32(a, b); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_hi32_u64(avx2_vec a) { return _mm256_srli_epi64(a, 32); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_shl32_u64(avx2_vec a) { return _mm256_slli_epi64(a, 32); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_lo32_u64(avx2_vec a) { return _mm256_and_si256(a, _mm256_set1_epi64x(0xFFFFFFFF)); }
+SDK_TARGET_AVX2 static inline avx2_vec avx2_msb_u64(avx2_vec a) { return _mm256_srli_epi64(a, 63); }
+
+typedef __m512i avx512_vec;
+
+SDK_TARGET_AVX512 static inline avx512_vec avx512_load(const void *p) { return _mm512_loadu_si512(p); }
+SDK_TARGET_AVX512 static inline void avx512_store(void *p, avx512_vec v) { _mm512_storeu_si512(p, v); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_and(avx512_vec a, avx512_vec b) { return _mm512_and_si512(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_andnot(avx512_vec a, avx512_vec b) { return _mm512_andnot_si512(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_or(avx512_vec a, avx512_vec b) { return _mm512_or_si512(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_xor(avx512_vec a, avx512_vec b) { return _mm512_xor_si512(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_add_i32(avx512_vec a, avx512_vec b) { return _mm512_add_epi32(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_add_i64(avx512_vec a, avx512_vec b) { return _mm512_add_epi64(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_sub_i32(avx512_vec a, avx512_vec b) { return _mm512_sub_epi32(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_sub_i64(avx512_vec a, avx512_vec b) { return _mm512_sub_epi64(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_sign_i32(avx512_vec a) { return _mm512_srai_epi32(a, 31); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_sign_i64(avx512_vec a) { return _mm512_srai_epi64(a, 63); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_max_i32(void) { return _mm512_set1_epi32(INT_MAX); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_max_i64(void) { return _mm512_set1_epi64(INT64_MAX); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_zero(void) { return _mm512_setzero_si512(); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_mul_u32(avx512_vec a, avx512_vec b) { return _mm512_mul_epu32(a, b); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_hi32_u64(avx512_vec a) { return _mm512_srli_epi64(a, 32); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_shl32_u64(avx512_vec a) { return _mm512_slli_epi64(a, 32); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_lo32_u64(avx512_vec a) { return _mm512_and_si512(a, _mm512_set1_epi64(0xFFFFFFFF)); }
+SDK_TARGET_AVX512 static inline avx512_vec avx512_msb_u64(avx512_vec a) { return _mm512_srli_epi64(a, 63); }
+
+/*============================================================================
+ * Vector operations
+ *
+ * Signed overflow of r = a + b happens when a and b have the same sign and
+ * r has the other one; for r = a - b when a and b differ in sign and r
+ * differs from a. Overflowing lanes are replaced by MAX for non-negative a
+ * and MIN (= ~MAX) for negative a.
+ *===========================================================================*/
+
+#define DEFINE_VECTOR_OPS(isa, target, es)                                    \
+    target static inline isa##_vec isa##_wrap_add_##es(isa##_vec a,          \
+                                                       isa##_vec b) {         \
+        return isa##_add_##es(a, b);                                          \
+    }                                                                         \
+    target static inline isa##_vec isa##_wrap_subtract_##es(isa##_vec a,     \
+                                                            isa##_vec b) {    \
+        return isa##_sub_##es(a, b);                                          \
+    }                                                                         \
+    target static inline isa##_vec isa##_saturate_##es(isa##_vec a,          \
+                                                       isa##_vec r,           \
+                                                       isa##_vec ovf) {       \
+        isa##_vec sat = isa##_xor(isa##_sign_##es(a), isa##_max_##es());      \
+        ovf = isa##_sign_##es(ovf);                                           \
+        return isa##_or(isa##_and(ovf, sat), isa##_andnot(ovf, r));           \
+    }                                                                         \
+    target static inline isa##_vec isa##_sat_add_##es(isa##_vec a,           \
+                                                      isa##_vec b) {          \
+        isa##_vec r = isa##_add_##es(a, b);                                   \
+        isa##_vec ovf = isa##_and(isa##_xor(a, r), isa##_xor(b, r));          \
+        return isa##_saturate_##es(a, r, ovf);                                \
+    }                                                                         \
+    target static inline isa##_vec isa##_sat_subtract_##es(isa##_vec a,      \
+                                                           isa##_vec b) {     \
+        isa##_vec r = isa##_sub_##es(a, b);                                   \
+        isa##_vec ovf = isa##_and(isa##_xor(a, b), isa##_xor(a, r));          \
+        return isa##_saturate_##es(a, r, ovf);                                \
+    }
+
+/*
+ * 64-bit low multiply from 32x32->64 unsigned multiplies:
+ * a * b = lo(a) * lo(b) + ((hi(a) * lo(b) + lo(a) * hi(b)) << 32) mod 2^64
+ */
+#define DEFINE_VECTOR_MUL_I64(isa, target)                                    \
+    target static inline isa##_vec isa##_wrap_multiply_i64(isa##_vec a,      \
+                                                           isa##_vec b) {     \
+        isa##_vec cross = isa##_add_i64(                                      \
+            isa##_mul_u32(isa##_hi32_u64(a), b),                              \
+            isa##_mul_u32(a, isa##_hi32_u64(b)));                             \
+        return isa##_add_i64(isa##_mul_u32(a, b), isa##_shl32_u64(cross));   \
+    }
+
+/*
+ * Generate a SIMD kernel: full vectors go through the vector operation,
+ * the tail is handed to the scalar kernel.
+ */
+#define DEFINE_SIMD_KERNEL(isa, target, pol, op, es, T)                       \
+    target static void pol##_##op##_##es##_##isa(const T *a, const T *b,      \
+                                                 T *out, size_t n) {          \
+        const size_t width = sizeof(isa##_vec) / sizeof(T);                   \
+        size_t i = 0;                                                         \
+        for (; i + width <= n; i += width) {                                  \
+            isa##_vec va = isa##_load(a + i);                                 \
+            isa##_vec vb = isa##_load(b + i);                                 \
+            isa##_store(out + i, isa##_##pol##_##op##_##es(va, vb));          \
+        }                                                                     \
+        pol##_##op##_##es##_scalar(a + i, b + i, out + i, n - i);             \
+    }
+
+#define DEFINE_ISA(isa, target)                                               \
+    DEFINE_VECTOR_OPS(isa, target, i32)                                       \
+    DEFINE_VECTOR_OPS(isa, target, i64)                                       \
+    DEFINE_VECTOR_MUL_I64(isa, target)
+
+DEFINE_ISA(sse2, SDK_TARGET_SSE2)
+DEFINE_ISA(avx2, SDK_TARGET_AVX2)
+DEFINE_ISA(avx512, SDK_TARGET_AVX512)
+
+/* Kernels with a SIMD version: scalar plus one per instruction set */
+#define DEFINE_SIMD_KERNELS(pol, op, es, T)                                   \
+    DEFINE_SCALAR_KERNEL(pol, op, es, T)                                      \
+    DEFINE_SIMD_KERNEL(sse2, SDK_TARGET_SSE2, pol, op, es, T)                 \
+    DEFINE_SIMD_KERNEL(avx2, SDK_TARGET_AVX2, pol, op, es, T)                 \
+    DEFINE_SIMD_KERNEL(avx512, SDK_TARGET_AVX512, pol, op, es, T)             \
+    static const kernel_##es pol##_##op##_##es##_kernels[] = {                \
+        pol##_##op##_##es##_scalar, pol##_##op##_##es##_sse2,                 \
+        pol##_##op##_##es##_avx2, pol##_##op##_##es##_avx512,                 \
+    };
+
+#else
+
+#define DEFINE_SIMD_KERNELS(pol, op, es, T)                                   \
+    DEFINE_SCALAR_KERNEL(pol, op, es, T)                                      \
+    static const kernel_##es pol##_##op##_##es##_kernels[] = {                \
+        pol##_##op##_##es##_scalar,                                           \
+    };
+
+#endif /* SDK_SIMD_X86 */
+
+/* Kernels without a SIMD version (division, saturating multiply) */
+#define DEFINE_SCALAR_KERNELS(pol, op, es, T)                                 \
+    DEFINE_SCALAR_KERNEL(pol, op, es, T)                                      \
+    static const kernel_##es pol##_##op##_##es##_kernels[] = {                \
+        pol##_##op##_##es##_scalar,                                           \
+    };
+
+/*============================================================================
+ * Public functions
+ *===========================================================================*/
+
+#define DEFINE_FUNCTIONS(name, pol, op, es, T)                                \
+    T calc_##op##name(T a, T b) {                                             \
+        return pol##_##op##_##es(a, b);                                       \
+    }                                                                         \
+    void calc_##op##name##_batch(const T *a, const T *b, T *out, size_t n) {  \
+        const size_t count = sizeof(pol##_##op##_##es##_kernels) /            \
+                             sizeof(pol##_##op##_##es##_kernels[0]);          \
+        size_t isa = (size_t)calc_batch_isa();                                \
+        pol##_##op##_##es##_kernels[isa < count ? isa : 0](a, b, out, n);     \
+    }
+
+/* One variant: public name suffix, policy, element type */
+#define DEFINE_VARIANT(name, pol, es, T, mul_kernels)                         \
+    DEFINE_SIMD_KERNELS(pol, add, es, T)                                      \
+    DEFINE_SIMD_KERNELS(pol, subtract, es, T)                                 \
+    mul_kernels(pol, multiply, es, T)                                         \
+    DEFINE_SCALAR_KERNELS(pol, divide, es, T)                                 \
+    DEFINE_FUNCTIONS(name, pol, add, es, T)                                   \
+    DEFINE_FUNCTIONS(name, pol, subtract, es, T)                              \
+    DEFINE_FUNCTIONS(name, pol, multiply, es, T)                              \
+    DEFINE_FUNCTIONS(name, pol, divide, es, T)
+
+DEFINE_VARIANT(_i64, wrap, i64, int64_t, DEFINE_SIMD_KERNELS)
+DEFINE_VARIANT(_sat, sat, i32, int, DEFINE_SCALAR_KERNELS)
+DEFINE_VARIANT(_sat_i64, sat, i64, int64_t, DEFINE_SCALAR_KERNELS)
+
+/*============================================================================
+ * 128-bit sum
+ *
+ * Each int64 is split into its unsigned high and low 32-bit halves, which
+ * are summed in separate 64-bit lanes, and its sign bit is counted:
+ *   sum = sum(hi) * 2^32 + sum(lo) - count(negative) * 2^64
+ * A 64-bit lane holds at least 2^32 such halves before it can overflow, so
+ * the partial sums are folded into the 128-bit total every SUM_BLOCK
+ * elements.
+ *===========================================================================*/
+
+typedef unsigned __int128 u128;
+
+#define SUM_BLOCK ((size_t)1 << 31)
+
+typedef struct {
+    uint64_t hi;        /* Sum of the high halves */
+    uint64_t lo;        /* Sum of the low halves */
+    uint64_t neg;       /* Number of negative elements */
+} sum_parts;
+
+typedef void (*sum_kernel)(const int64_t *a, size_t n, sum_parts *parts);
+
+static void sum_scalar(const int64_t *a, size_t n, sum_parts *parts) {
+    for (size_t i = 0; i < n; i++) {
+        uint64_t v = (uint64_t)a[i];
+        parts->hi += v >> 32;
+        parts->lo += v & 0xFFFFFFFFu;
+        parts->neg += v >> 63;
+    }
+}
+
+#if SDK_SIMD_X86
+
+#define DEFINE_SUM_KERNEL(isa, target)                                        \
+    target static void sum_##isa(const int64_t *a, size_t n,                  \
+                                 sum_parts *parts) {                          \
+        const size_t width = sizeof(isa##_vec) / sizeof(int64_t);             \
+        isa##_vec hi = isa##_zero();                                          \
+        isa##_vec lo = isa##_zero();                                          \
+        isa##_vec neg = isa##_zero();                                         \
+        uint64_t lanes[3][sizeof(isa##_vec) / sizeof(uint64_t)];              \
+        size_t i = 0;                                                         \
+        for (; i + width <= n; i += width) {                                  \
+            isa##_vec v = isa##_load(a + i);                                  \
+            hi = isa##_add_i64(hi, isa##_hi32_u64(v));                        \
+            lo = isa##_add_i64(lo, isa##_lo32_u64(v));                        \
+            neg = isa##_add_i64(neg, isa##_msb_u64(v));                       \
+        }                                                                     \
+        isa##_store(lanes[0], hi);                                            \
+        isa##_store(lanes[1], lo);                                            \
+        isa##_store(lanes[2], neg);                                           \
+        for (size_t j = 0; j < width; j++) {                                  \
+            parts->hi += lanes[0][j];                                         \
+            parts->lo += lanes[1][j];                                         \
+            parts->neg += lanes[2][j];                                        \
+        }                                                                     \
+        sum_scalar(a + i, n - i, parts);                                      \
+    }
+
+DEFINE_SUM_KERNEL(sse2, SDK_TARGET_SSE2)
+DEFINE_SUM_KERNEL(avx2, SDK_TARGET_AVX2)
+DEFINE_SUM_KERNEL(avx512, SDK_TARGET_AVX512)
+
+static const sum_kernel sum_kernels[] = {
+    sum_scalar, sum_sse2, sum_avx2, sum_avx512,
+};
+#else
+static const sum_kernel sum_kernels[] = { sum_scalar };
+#endif /* SDK_SIMD_X86 */
+
+calc_i128_t calc_sum_i64(const int64_t *a, size_t n) {
+    sum_kernel kernel = sum_kernels[calc_batch_isa()];
+    u128 total = 0;
+    calc_i128_t result;
+
+    for (size_t i = 0; i < n; i += SUM_BLOCK) {
+        sum_parts parts = { 0, 0, 0 };
+        kernel(a + i, n - i < SUM_BLOCK ? n - i : SUM_BLOCK, &parts);
+        // Arithmetic modulo 2^128 gives the exact signed total
+        total += ((u128)parts.hi << 32) + parts.lo - ((u128)parts.neg << 64);
+    }
+
+    result.hi = (int64_t)(uint64_t)(total >> 64);
+    result.lo = (uint64_t)total;
+    return result;
+}
+
+calc_status_t calc_i128_to_i64(calc_i128_t v, int64_t *result) {
+    *result = (int64_t)v.lo;
+    // Fits if the high half is the sign extension of the low half
+    return v.hi == (*result < 0 ? -1 : 0) ? CALC_OK : CALC_ERR_OVERFLOW;
+}
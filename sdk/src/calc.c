@@ -1,21 +1,19 @@
+/* Always build the exported functions, even if CALC_INLINE is set */
+#define CALC_IMPLEMENTATION
 #include "calc.h"
 
 int calc_add(int a, int b) {
-    return a + b;
+    return calc_add_inline(a, b);
 }
 
 int calc_subtract(int a, int b) {
-    return a - b;
+    return calc_subtract_inline(a, b);
 }
 
 int calc_multiply(int a, int b) {
-    return a * b;
+    return calc_multiply_inline(a, b);
 }
 
 int calc_divide(int a, int b) {
-    // Handle division by zero
-    if (b == 0) {
-        return 0;
-    }
-    return a / b;
+    return calc_divide_inline(a, b);
 }
\ No newline at end of file
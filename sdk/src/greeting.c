@@ -1,15 +1,30 @@
 #include <stdio.h>
-#include <string.h>
 #include "greeting.h"
 
+/* Shared by the _r functions: "<word>, <name or stranger>!" into buf */
+static size_t greet_r(const char* word, const char* name, char* buf, size_t size) {
+    int len;
+
+    if (name == NULL || name[0] == '\0') {
+        name = "stranger";
+    }
+    len = snprintf(buf, size, "%s, %s!", word, name);
+
+    return len < 0 ? 0 : (size_t)len;
+}
+
+size_t say_hello_r(const char* name, char* buf, size_t size) {
+    return greet_r("Hello", name, buf, size);
+}
+
+size_t say_goodbye_r(const char* name, char* buf, size_t size) {
+    return greet_r("Goodbye", name, buf, size);
+}
+
 const char* say_hello(const char* name) {
     static char buffer[256];
 
-    if (name == NULL || strlen(name) == 0) {
-        snprintf(buffer, sizeof(buffer), "Hello, stranger!");
-    } else {
-        snprintf(buffer, sizeof(buffer), "Hello, %s!", name);
-    }
+    say_hello_r(name, buffer, sizeof(buffer));
 
     return buffer;
 }
@@ -17,11 +32,7 @@ const char* say_hello(const char* name) {
 const char* say_goodbye(const char* name) {
     static char buffer[256];
 
-    if (name == NULL || strlen(name) == 0) {
-        snprintf(buffer, sizeof(buffer), "Goodbye, stranger!");
-    } else {
-        snprintf(buffer, sizeof(buffer), "Goodbye, %s!", name);
-    }
+    say_goodbye_r(name, buffer, sizeof(buffer));
 
     return buffer;
 }
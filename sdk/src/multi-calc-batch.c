@@ -0,0 +1,191 @@
+#include "multi-calc-batch.h"
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "simd.h"
+
+/*============================================================================
+ * Scalar kernels
+ *
+ * Unsigned arithmetic so overflow wraps, as in calc-batch.c.
+ *===========================================================================*/
+
+static inline int expression_one(int a, int b, int c, int d) {
+    return (int)(((unsigned)a + (unsigned)b) * ((unsigned)c - (unsigned)d));
+}
+
+static void expression_scalar(const int *a, const int *b, const int *c,
+                              const int *d, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = expression_one(a[i], b[i], c[i], d[i]);
+    }
+}
+
+static void expression_aos_scalar(const multi_calc_tuple_t *t, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = expression_one(t[i].a, t[i].b, t[i].c, t[i].d);
+    }
+}
+
+#if SDK_SIMD_X86
+
+// The AoS kernels read tuples as a flat int array
+_Static_assert(sizeof(multi_calc_tuple_t) == 4 * sizeof(int), "multi_calc_tuple_t has padding");
+
+/*
+ * Generate a struct-of-arrays kernel: one vector of each column in, one
+ * vector of results out.
+ */
+#define SIMD_SOA_KERNEL(name, target, vec, width, load, store, add, sub, mul) \
+    target static void name(const int *a, const int *b, const int *c,        \
+                            const int *d, int *out, size_t n) {              \
+        size_t i = 0;                                                        \
+        for (; i + (width) <= n; i += (width)) {                             \
+            vec sum = add(load((const void *)(a + i)), load((const void *)(b + i))); \
+            vec diff = sub(load((const void *)(c + i)), load((const void *)(d + i))); \
+            store((void *)(out + i), mul(sum, diff));                        \
+        }                                                                    \
+        expression_scalar(a + i, b + i, c + i, d + i, out + i, n - i);       \
+    }
+
+/*
+ * Generate an array-of-structs kernel. Four contiguous vectors hold
+ * `width` tuples; a 4x4 transpose inside every 128-bit lane turns them
+ * into a, b, c and d columns. With L lanes, element k of lane j then
+ * belongs to tuple k * L + j, so `fixup` permutes the results back into
+ * tuple order once, instead of permuting each column.
+ */
+#define SIMD_AOS_KERNEL(name, target, vec, width, load, store, lo32, hi32,   \
+                        lo64, hi64, add, sub, mul, fixup)                    \
+    target static void name(const multi_calc_tuple_t *t, int *out, size_t n) { \
+        size_t i = 0;                                                        \
+        for (; i + (width) <= n; i += (width)) {                             \
+            const int *p = &t[i].a;                                          \
+            vec r0 = load((const void *)p);                                  \
+            vec r1 = load((const void *)(p + (width)));                      \
+            vec r2 = load((const void *)(p + 2 * (width)));                  \
+            vec r3 = load((const void *)(p + 3 * (width)));                  \
+            vec ab01 = lo32(r0, r1), ab23 = lo32(r2, r3);                    \
+            vec cd01 = hi32(r0, r1), cd23 = hi32(r2, r3);                    \
+            vec sum = add(lo64(ab01, ab23), hi64(ab01, ab23));               \
+            vec diff = sub(lo64(cd01, cd23), hi64(cd01, cd23));              \
+            store((void *)(out + i), fixup(mul(sum, diff)));                 \
+        }                                                                    \
+        expression_aos_scalar(t + i, out + i, n - i);                        \
+    }
+
+/*============================================================================
+ * SSE2 kernels (4 x int32)
+ *===========================================================================*/
+
+#define KEEP_ORDER(v) (v)
+
+SIMD_SOA_KERNEL(expression_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                _mm_loadu_si128, _mm_storeu_si128, _mm_add_epi32, _mm_sub_epi32, mullo_sse2)
+SIMD_AOS_KERNEL(expression_aos_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                _mm_loadu_si128, _mm_storeu_si128,
+                _mm_unpacklo_epi32, _mm_unpackhi_epi32, _mm_unpacklo_epi64, _mm_unpackhi_epi64,
+                _mm_add_epi32, _mm_sub_epi32, mullo_sse2, KEEP_ORDER)
+
+/*============================================================================
+ * AVX2 kernels (8 x int32)
+ *===========================================================================*/
+
+#define FIXUP_AVX2(v) _mm256_permutevar8x32_epi32((v), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7))
+
+SIMD_SOA_KERNEL(expression_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                _mm256_loadu_si256, _mm256_storeu_si256,
+                _mm256_add_epi32, _mm256_sub_epi32, _mm256_mullo_epi32)
+SIMD_AOS_KERNEL(expression_aos_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                _mm256_loadu_si256, _mm256_storeu_si256,
+                _mm256_unpacklo_epi32, _mm256_unpackhi_epi32,
+                _mm256_unpacklo_epi64, _mm256_unpackhi_epi64,
+                _mm256_add_epi32, _mm256_sub_epi32, _mm256_mullo_epi32, FIXUP_AVX2)
+
+/*============================================================================
+ * AVX-512 kernels (16 x int32)
+ *===========================================================================*/
+
+#define FIXUP_AVX512(v) _mm512_permutexvar_epi32(                            \
+    _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15), (v))
+
+SIMD_SOA_KERNEL(expression_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                _mm512_loadu_si512, _mm512_storeu_si512,
+                _mm512_add_epi32, _mm512_sub_epi32, _mm512_mullo_epi32)
+SIMD_AOS_KERNEL(expression_aos_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                _mm512_loadu_si512, _mm512_storeu_si512,
+                _mm512_unpacklo_epi32, _mm512_unpackhi_epi32,
+                _mm512_unpacklo_epi64, _mm512_unpackhi_epi64,
+                _mm512_add_epi32, _mm512_sub_epi32, _mm512_mullo_epi32, FIXUP_AVX512)
+
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * Dispatch tables, indexed by calc_isa_t
+ *===========================================================================*/
+
+typedef void (*soa_kernel)(const int *a, const int *b, const int *c,
+                           const int *d, int *out, size_t n);
+typedef void (*aos_kernel)(const multi_calc_tuple_t *t, int *out, size_t n);
+
+#if SDK_SIMD_X86
+static const soa_kernel expression_kernels[] = {
+    expression_scalar, expression_sse2, expression_avx2, expression_avx512,
+};
+static const aos_kernel expression_aos_kernels[] = {
+    expression_aos_scalar, expression_aos_sse2, expression_aos_avx2, expression_aos_avx512,
+};
+#else
+static const soa_kernel expression_kernels[] = { expression_scalar };
+static const aos_kernel expression_aos_kernels[] = { expression_aos_scalar };
+#endif
+
+/*============================================================================
+ * Multi-threaded split (calc-pool)
+ *===========================================================================*/
+
+typedef struct {
+    soa_kernel kernel;
+    const int *a;
+    const int *b;
+    const int *c;
+    const int *d;
+    int *out;
+} soa_job;
+
+static void soa_range(void *ctx, size_t begin, size_t end) {
+    const soa_job *job = ctx;
+    job->kernel(job->a + begin, job->b + begin, job->c + begin, job->d + begin,
+                job->out + begin, end - begin);
+}
+
+typedef struct {
+    aos_kernel kernel;
+    const multi_calc_tuple_t *tuples;
+    int *out;
+} aos_job;
+
+static void aos_range(void *ctx, size_t begin, size_t end) {
+    const aos_job *job = ctx;
+    job->kernel(job->tuples + begin, job->out + begin, end - begin);
+}
+
+void multi_calc_expression_batch(const int *a, const int *b, const int *c,
+                                 const int *d, int *out, size_t n) {
+    soa_job job = { expression_kernels[calc_batch_isa()], a, b, c, d, out };
+
+    if (n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        job.kernel(a, b, c, d, out, n);
+        return;
+    }
+    calc_pool_parallel_for(0, n, CALC_POOL_BATCH_GRAIN, soa_range, &job);
+}
+
+void multi_calc_expression_batch_aos(const multi_calc_tuple_t *tuples, int *out, size_t n) {
+    aos_job job = { expression_aos_kernels[calc_batch_isa()], tuples, out };
+
+    if (n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        job.kernel(tuples, out, n);
+        return;
+    }
+    calc_pool_parallel_for(0, n, CALC_POOL_BATCH_GRAIN, aos_range, &job);
+}
@@ -0,0 +1,430 @@
+#include <stdint.h>
+#include <string.h>
+#include "multi-calc-poly.h"
+#include "calc.h"
+#include "calc-ops.h"
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "simd.h"
+
+/*============================================================================
+ * Scalar functions
+ *
+ * The plain versions call the calc_ops backend like multi_calc_expression
+ * (the default scalar backend directly, so --wrap mocks see calc_*).
+ *===========================================================================*/
+
+int calc_pow(int base, unsigned exponent) {
+    const sdk_calc_ops *ops = calc_ops_get();
+    int result = 1;
+
+    if (ops != &calc_ops_scalar) {
+        for (; exponent != 0; exponent >>= 1) {
+            result = exponent & 1 ? ops->multiply(result, base) : result;
+            base = exponent > 1 ? ops->multiply(base, base) : base;
+        }
+        return result;
+    }
+    for (; exponent != 0; exponent >>= 1) {
+        result = exponent & 1 ? calc_multiply(result, base) : result;
+        base = exponent > 1 ? calc_multiply(base, base) : base;
+    }
+    return result;
+}
+
+int multi_calc_poly(const int *coeffs, size_t count, int x) {
+    const sdk_calc_ops *ops = calc_ops_get();
+
+    if (count == 0) {
+        return 0;
+    }
+    // Horner: (...(c[n-1] * x + c[n-2]) * x + ...) * x + c[0]
+    int result = coeffs[count - 1];
+    if (ops != &calc_ops_scalar) {
+        for (size_t k = count - 1; k-- > 0;) {
+            result = ops->add(ops->multiply(result, x), coeffs[k]);
+        }
+        return result;
+    }
+    for (size_t k = count - 1; k-- > 0;) {
+        result = calc_add(calc_multiply(result, x), coeffs[k]);
+    }
+    return result;
+}
+
+/*
+ * Squaring is skipped after the last exponent bit, so a squaring only
+ * happens when its result is a factor of the power: with |base| >= 2 an
+ * overflowing square means an overflowing power, so the flag is exact.
+ */
+calc_status_t calc_pow_checked(int base, unsigned exponent, int *result) {
+    int r = 1;
+    int overflow = 0;
+
+    for (; exponent != 0; exponent >>= 1) {
+        if (exponent & 1) {
+            overflow |= __builtin_mul_overflow(r, base, &r);
+        }
+        if (exponent > 1) {
+            overflow |= __builtin_mul_overflow(base, base, &base);
+        }
+    }
+    *result = r;
+    return overflow ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+calc_status_t multi_calc_poly_checked(const int *coeffs, size_t count, int x, int *result) {
+    int r = count ? coeffs[count - 1] : 0;
+    int overflow = 0;
+
+    for (size_t k = count ? count - 1 : 0; k-- > 0;) {
+        overflow |= __builtin_mul_overflow(r, x, &r);
+        overflow |= __builtin_add_overflow(r, coeffs[k], &r);
+    }
+    *result = r;
+    return overflow ? CALC_ERR_OVERFLOW : CALC_OK;
+}
+
+/*============================================================================
+ * Scalar batch kernels
+ *
+ * Unsigned arithmetic so overflow wraps, as in calc-batch.c. Kernels get
+ * count >= 1; checked kernels work in groups of 8 elements (one bitmap
+ * byte), and SIMD kernels hand their tail over at a multiple of 8.
+ *===========================================================================*/
+
+static void pow_scalar(const int *base, unsigned exponent, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned b = (unsigned)base[i], r = 1;
+        for (unsigned e = exponent; e != 0; e >>= 1) {
+            r = e & 1 ? r * b : r;
+            b = e > 1 ? b * b : b;
+        }
+        out[i] = (int)r;
+    }
+}
+
+static void poly_scalar(const int *coeffs, size_t count, const int *x, int *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned xi = (unsigned)x[i], r = (unsigned)coeffs[count - 1];
+        for (size_t k = count - 1; k-- > 0;) {
+            r = r * xi + (unsigned)coeffs[k];
+        }
+        out[i] = (int)r;
+    }
+}
+
+/* Store bits for elements i.. (width a multiple of 8) and count them */
+static inline size_t put_bits(unsigned char *flags, size_t i, uint32_t bits, size_t width) {
+    if (flags != NULL) {
+        for (size_t k = 0; k < width / 8; k++) {
+            flags[i / 8 + k] = (unsigned char)(bits >> (8 * k));
+        }
+    }
+    return (size_t)__builtin_popcount(bits);
+}
+
+static size_t pow_checked_scalar(const int *base, unsigned exponent, int *out,
+                                 unsigned char *flags, size_t n) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; i += 8) {
+        size_t len = (n - i < 8) ? n - i : 8;
+        unsigned bits = 0;
+        for (size_t j = 0; j < len; j++) {
+            bits |= (unsigned)(calc_pow_checked(base[i + j], exponent, &out[i + j]) != CALC_OK) << j;
+        }
+        count += put_bits(flags, i, bits, 8);
+    }
+    return count;
+}
+
+static size_t poly_checked_scalar(const int *coeffs, size_t count, const int *x, int *out,
+                                  unsigned char *flags, size_t n) {
+    size_t overflows = 0;
+    for (size_t i = 0; i < n; i += 8) {
+        size_t len = (n - i < 8) ? n - i : 8;
+        unsigned bits = 0;
+        for (size_t j = 0; j < len; j++) {
+            bits |= (unsigned)(multi_calc_poly_checked(coeffs, count, x[i + j], &out[i + j])
+                               != CALC_OK) << j;
+        }
+        overflows += put_bits(flags, i, bits, 8);
+    }
+    return overflows;
+}
+
+#if SDK_SIMD_X86
+
+/*============================================================================
+ * SIMD kernels
+ *
+ * Every exponent bit or coefficient is a dependent multiply (and add), so
+ * two vectors are processed per step to overlap their latencies. The
+ * checked kernels use the overflow-reporting helpers of simd.h.
+ *===========================================================================*/
+
+#define SIMD_POW_KERNEL(name, target, vec, width, load, store, set1, mul)   \
+    target static void name(const int *base, unsigned exponent, int *out, size_t n) { \
+        size_t i = 0;                                                        \
+        for (; i + 2 * (width) <= n; i += 2 * (width)) {                     \
+            vec b0 = load((const void *)(base + i));                         \
+            vec b1 = load((const void *)(base + i + (width)));               \
+            vec r0 = set1(1), r1 = set1(1);                                  \
+            for (unsigned e = exponent; e != 0; e >>= 1) {                   \
+                if (e & 1) {                                                 \
+                    r0 = mul(r0, b0);                                        \
+                    r1 = mul(r1, b1);                                        \
+                }                                                            \
+                if (e > 1) {                                                 \
+                    b0 = mul(b0, b0);                                        \
+                    b1 = mul(b1, b1);                                        \
+                }                                                            \
+            }                                                                \
+            store((void *)(out + i), r0);                                    \
+            store((void *)(out + i + (width)), r1);                          \
+        }                                                                    \
+        pow_scalar(base + i, exponent, out + i, n - i);                      \
+    }
+
+#define SIMD_POLY_KERNEL(name, target, vec, width, load, store, set1, add, mul) \
+    target static void name(const int *coeffs, size_t count, const int *x,   \
+                            int *out, size_t n) {                            \
+        size_t i = 0;                                                        \
+        for (; i + 2 * (width) <= n; i += 2 * (width)) {                     \
+            vec x0 = load((const void *)(x + i));                            \
+            vec x1 = load((const void *)(x + i + (width)));                  \
+            vec r0 = set1(coeffs[count - 1]), r1 = r0;                       \
+            for (size_t k = count - 1; k-- > 0;) {                           \
+                vec c = set1(coeffs[k]);                                     \
+                r0 = add(mul(r0, x0), c);                                    \
+                r1 = add(mul(r1, x1), c);                                    \
+            }                                                                \
+            store((void *)(out + i), r0);                                    \
+            store((void *)(out + i + (width)), r1);                          \
+        }                                                                    \
+        poly_scalar(coeffs, count, x + i, out + i, n - i);                   \
+    }
+
+#define SIMD_POW_CHECKED_KERNEL(name, target, vec, width, load, store, set1, mulw) \
+    target static size_t name(const int *base, unsigned exponent, int *out,  \
+                              unsigned char *flags, size_t n) {              \
+        size_t count = 0;                                                    \
+        size_t i = 0;                                                        \
+        for (; i + 2 * (width) <= n; i += 2 * (width)) {                     \
+            vec b0 = load((const void *)(base + i));                         \
+            vec b1 = load((const void *)(base + i + (width)));               \
+            vec r0 = set1(1), r1 = set1(1);                                  \
+            unsigned o0 = 0, o1 = 0, ovf;                                    \
+            for (unsigned e = exponent; e != 0; e >>= 1) {                   \
+                if (e & 1) {                                                 \
+                    r0 = mulw(r0, b0, &ovf);                                 \
+                    o0 |= ovf;                                               \
+                    r1 = mulw(r1, b1, &ovf);                                 \
+                    o1 |= ovf;                                               \
+                }                                                            \
+                if (e > 1) {                                                 \
+                    b0 = mulw(b0, b0, &ovf);                                 \
+                    o0 |= ovf;                                               \
+                    b1 = mulw(b1, b1, &ovf);                                 \
+                    o1 |= ovf;                                               \
+                }                                                            \
+            }                                                                \
+            store((void *)(out + i), r0);                                    \
+            store((void *)(out + i + (width)), r1);                          \
+            count += put_bits(flags, i, o0 | o1 << (width), 2 * (width));    \
+        }                                                                    \
+        return count + pow_checked_scalar(base + i, exponent, out + i,       \
+                                          flags != NULL ? flags + i / 8 : NULL, n - i); \
+    }
+
+#define SIMD_POLY_CHECKED_KERNEL(name, target, vec, width, load, store, set1, addw, mulw) \
+    target static size_t name(const int *coeffs, size_t count, const int *x, \
+                              int *out, unsigned char *flags, size_t n) {    \
+        size_t overflows = 0;                                                \
+        size_t i = 0;                                                        \
+        for (; i + 2 * (width) <= n; i += 2 * (width)) {                     \
+            vec x0 = load((const void *)(x + i));                            \
+            vec x1 = load((const void *)(x + i + (width)));                  \
+            vec r0 = set1(coeffs[count - 1]), r1 = r0;                       \
+            unsigned o0 = 0, o1 = 0, ovf;                                    \
+            for (size_t k = count - 1; k-- > 0;) {                           \
+                vec c = set1(coeffs[k]);                                     \
+                r0 = mulw(r0, x0, &ovf);                                     \
+                o0 |= ovf;                                                   \
+                r0 = addw(r0, c, &ovf);                                      \
+                o0 |= ovf;                                                   \
+                r1 = mulw(r1, x1, &ovf);                                     \
+                o1 |= ovf;                                                   \
+                r1 = addw(r1, c, &ovf);                                      \
+                o1 |= ovf;                                                   \
+            }                                                                \
+            store((void *)(out + i), r0);                                    \
+            store((void *)(out + i + (width)), r1);                          \
+            overflows += put_bits(flags, i, o0 | o1 << (width), 2 * (width)); \
+        }                                                                    \
+        return overflows + poly_checked_scalar(coeffs, count, x + i, out + i, \
+                                               flags != NULL ? flags + i / 8 : NULL, n - i); \
+    }
+
+/* SSE2 (4 x int32): plain kernels only, it has no signed 32x32->64 multiply */
+SIMD_POW_KERNEL(pow_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                _mm_loadu_si128, _mm_storeu_si128, _mm_set1_epi32, mullo_sse2)
+SIMD_POLY_KERNEL(poly_sse2, SDK_TARGET_SSE2, __m128i, 4,
+                 _mm_loadu_si128, _mm_storeu_si128, _mm_set1_epi32, _mm_add_epi32, mullo_sse2)
+
+/* AVX2 (8 x int32) */
+SIMD_POW_KERNEL(pow_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                _mm256_loadu_si256, _mm256_storeu_si256, _mm256_set1_epi32, _mm256_mullo_epi32)
+SIMD_POLY_KERNEL(poly_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                 _mm256_loadu_si256, _mm256_storeu_si256, _mm256_set1_epi32,
+                 _mm256_add_epi32, _mm256_mullo_epi32)
+SIMD_POW_CHECKED_KERNEL(pow_checked_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                        _mm256_loadu_si256, _mm256_storeu_si256, _mm256_set1_epi32,
+                        mullo_wrap_avx2)
+SIMD_POLY_CHECKED_KERNEL(poly_checked_avx2, SDK_TARGET_AVX2, __m256i, 8,
+                         _mm256_loadu_si256, _mm256_storeu_si256, _mm256_set1_epi32,
+                         add_wrap_avx2, mullo_wrap_avx2)
+
+/* AVX-512 (16 x int32) */
+SIMD_POW_KERNEL(pow_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32, _mm512_mullo_epi32)
+SIMD_POLY_KERNEL(poly_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                 _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32,
+                 _mm512_add_epi32, _mm512_mullo_epi32)
+SIMD_POW_CHECKED_KERNEL(pow_checked_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                        _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32,
+                        mullo_wrap_avx512)
+SIMD_POLY_CHECKED_KERNEL(poly_checked_avx512, SDK_TARGET_AVX512, __m512i, 16,
+                         _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32,
+                         add_wrap_avx512, mullo_wrap_avx512)
+
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * Dispatch tables, indexed by calc_isa_t
+ *===========================================================================*/
+
+typedef void (*pow_kernel)(const int *base, unsigned exponent, int *out, size_t n);
+typedef void (*poly_kernel)(const int *coeffs, size_t count, const int *x, int *out, size_t n);
+typedef size_t (*pow_checked_kernel)(const int *base, unsigned exponent, int *out,
+                                     unsigned char *flags, size_t n);
+typedef size_t (*poly_checked_kernel)(const int *coeffs, size_t count, const int *x,
+                                      int *out, unsigned char *flags, size_t n);
+
+#if SDK_SIMD_X86
+static const pow_kernel pow_kernels[] = { pow_scalar, pow_sse2, pow_avx2, pow_avx512 };
+static const poly_kernel poly_kernels[] = { poly_scalar, poly_sse2, poly_avx2, poly_avx512 };
+static const pow_checked_kernel pow_checked_kernels[] = {
+    pow_checked_scalar, pow_checked_scalar, pow_checked_avx2, pow_checked_avx512,
+};
+static const poly_checked_kernel poly_checked_kernels[] = {
+    poly_checked_scalar, poly_checked_scalar, poly_checked_avx2, poly_checked_avx512,
+};
+#else
+static const pow_kernel pow_kernels[] = { pow_scalar };
+static const poly_kernel poly_kernels[] = { poly_scalar };
+static const pow_checked_kernel pow_checked_kernels[] = { pow_checked_scalar };
+static const poly_checked_kernel poly_checked_kernels[] = { poly_checked_scalar };
+#endif /* SDK_SIMD_X86 */
+
+/*============================================================================
+ * Multi-threaded split (calc-pool)
+ *
+ * Ranges are counted in bitmap bytes (8 elements) so the checked kernels
+ * of different threads never write the same flag byte.
+ *===========================================================================*/
+
+typedef struct {
+    pow_kernel pow;                     /* Exactly one kernel is set */
+    poly_kernel poly;
+    pow_checked_kernel pow_checked;
+    poly_checked_kernel poly_checked;
+    const int *input;                   /* Bases or points */
+    unsigned exponent;
+    const int *coeffs;
+    size_t count;
+    int *out;
+    unsigned char *flags;
+    size_t n;
+    size_t overflows;
+} power_job;
+
+static void power_range(void *ctx, size_t begin, size_t end) {
+    power_job *job = ctx;
+    size_t first = begin * 8;
+    size_t last = end * 8 < job->n ? end * 8 : job->n;
+    const int *in = job->input + first;
+    int *out = job->out + first;
+    unsigned char *flags = job->flags != NULL ? job->flags + begin : NULL;
+    size_t overflows = 0;
+
+    if (job->pow != NULL) {
+        job->pow(in, job->exponent, out, last - first);
+    } else if (job->poly != NULL) {
+        job->poly(job->coeffs, job->count, in, out, last - first);
+    } else if (job->pow_checked != NULL) {
+        overflows = job->pow_checked(in, job->exponent, out, flags, last - first);
+    } else {
+        overflows = job->poly_checked(job->coeffs, job->count, in, out, flags, last - first);
+    }
+    if (overflows != 0) {
+        __atomic_add_fetch(&job->overflows, overflows, __ATOMIC_RELAXED);
+    }
+}
+
+static size_t run_power(power_job *job) {
+    if (job->n < 2 * CALC_POOL_BATCH_GRAIN || calc_pool_threads() == 1) {
+        power_range(job, 0, (job->n + 7) / 8);
+    } else {
+        calc_pool_parallel_for(0, (job->n + 7) / 8, CALC_POOL_BATCH_GRAIN / 8, power_range, job);
+    }
+    return job->overflows;
+}
+
+/* A polynomial without coefficients is 0 everywhere */
+static void zero_poly(int *out, unsigned char *flags, size_t n) {
+    memset(out, 0, n * sizeof(*out));
+    if (flags != NULL) {
+        memset(flags, 0, CALC_BITMAP_BYTES(n));
+    }
+}
+
+/*============================================================================
+ * Public batch functions
+ *===========================================================================*/
+
+void calc_pow_batch(const int *base, unsigned exponent, int *out, size_t n) {
+    power_job job = { .pow = pow_kernels[calc_batch_isa()], .input = base,
+                      .exponent = exponent, .out = out, .n = n };
+    run_power(&job);
+}
+
+void multi_calc_poly_batch(const int *coeffs, size_t count, const int *x, int *out, size_t n) {
+    power_job job = { .poly = poly_kernels[calc_batch_isa()], .input = x,
+                      .coeffs = coeffs, .count = count, .out = out, .n = n };
+
+    if (count == 0) {
+        zero_poly(out, NULL, n);
+        return;
+    }
+    run_power(&job);
+}
+
+size_t calc_pow_checked_batch(const int *base, unsigned exponent, int *out,
+                              unsigned char *flags, size_t n) {
+    power_job job = { .pow_checked = pow_checked_kernels[calc_batch_isa()], .input = base,
+                      .exponent = exponent, .out = out, .flags = flags, .n = n };
+    return run_power(&job);
+}
+
+size_t multi_calc_poly_checked_batch(const int *coeffs, size_t count, const int *x,
+                                     int *out, unsigned char *flags, size_t n) {
+    power_job job = { .poly_checked = poly_checked_kernels[calc_batch_isa()], .input = x,
+                      .coeffs = coeffs, .count = count, .out = out, .flags = flags, .n = n };
+
+    if (count == 0) {
+        zero_poly(out, flags, n);
+        return 0;
+    }
+    return run_power(&job);
+}
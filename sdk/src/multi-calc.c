@@ -1,7 +1,20 @@
 #include "multi-calc.h"
 #include "calc.h"
+#include "calc-ops.h"
+#include "calc-reduce.h"
+
+/*
+ * The default scalar backend is called directly rather than through its
+ * table: the compare is always predicted, the calls stay direct (and are
+ * inlined with CALC_INLINE), and --wrap mocks still see calc_*.
+ */
 
 int multi_calc_expression(int a, int b, int c, int d) {
+    const sdk_calc_ops *ops = calc_ops_get();
+
+    if (ops != &calc_ops_scalar) {
+        return ops->multiply(ops->add(a, b), ops->subtract(c, d));
+    }
     // Calculate (a + b) * (c - d)
     int sum = calc_add(a, b);           // a + b
     int diff = calc_subtract(c, d);     // c - d
@@ -10,9 +23,23 @@ int multi_calc_expression(int a, int b, int c, int d) {
 }
 
 int multi_calc_average(int a, int b, int c) {
+    const sdk_calc_ops *ops = calc_ops_get();
+
+    if (ops != &calc_ops_scalar) {
+        return ops->divide(ops->add(ops->add(a, b), c), 3);
+    }
     // Calculate (a + b + c) / 3
     int sum1 = calc_add(a, b);          // a + b
     int sum2 = calc_add(sum1, c);       // (a + b) + c
     int result = calc_divide(sum2, 3);  // (a + b + c) / 3
     return result;
+}
+
+int multi_calc_average_n(const int *values, size_t n) {
+    // Generalizes multi_calc_average: sum(values) / n
+    if (n == 0) {
+        return 0;
+    }
+    int64_t sum = calc_sum(values, n);
+    return (int)(sum / (int64_t)n);     // Between min and max, fits in int
 }
\ No newline at end of file
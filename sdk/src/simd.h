@@ -0,0 +1,83 @@
+#ifndef __SDK_SIMD_H__
+#define __SDK_SIMD_H__
+
+/*
+ * Internal helpers for the SIMD batch kernels (not installed).
+ *
+ * Kernels for each instruction set live in the same translation unit and
+ * are compiled with per-function target attributes, so the SDK itself is
+ * still built for the baseline CPU. Callers pick a kernel at run time with
+ * calc_batch_isa().
+ */
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SDK_SIMD_X86 1
+#include <immintrin.h>
+#define SDK_TARGET_SSE2   __attribute__((target("sse2")))
+#define SDK_TARGET_AVX2   __attribute__((target("avx2")))
+#define SDK_TARGET_AVX512 __attribute__((target("avx512f")))
+
+SDK_TARGET_SSE2 static inline __m128i mullo_sse2(__m128i a, __m128i b) {
+    // SSE2 has no 32-bit low multiply: multiply even and odd lanes separately
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+/*
+ * Overflow-reporting vector arithmetic: each returns the wrapped result
+ * and sets bit j of *overflow if element j overflowed.
+ *
+ * Signed overflow of r = a + b happened iff a and b have the same sign and
+ * r has a different one: sign bit of (a ^ r) & (b ^ r).
+ *
+ * A 64-bit product p fits in int32 iff its high half equals the sign of its
+ * low half. srai_epi32(p, 31) followed by a 32-bit shift left within the
+ * 64-bit lane moves the low-half sign next to the high half, so a 32-bit
+ * compare leaves the answer in the odd (high) element of each lane.
+ */
+SDK_TARGET_AVX2 static inline __m256i add_wrap_avx2(__m256i a, __m256i b, unsigned *overflow) {
+    __m256i r = _mm256_add_epi32(a, b);
+    *overflow = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_and_si256(_mm256_xor_si256(a, r), _mm256_xor_si256(b, r))));
+    return r;
+}
+
+SDK_TARGET_AVX2 static inline __m256i mul_fits_avx2(__m256i p) {
+    return _mm256_cmpeq_epi32(p, _mm256_slli_epi64(_mm256_srai_epi32(p, 31), 32));
+}
+
+SDK_TARGET_AVX2 static inline __m256i mullo_wrap_avx2(__m256i a, __m256i b, unsigned *overflow) {
+    __m256i even = _mm256_mul_epi32(a, b);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    unsigned ok_even = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(mul_fits_avx2(even)));
+    unsigned ok_odd = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(mul_fits_avx2(odd)));
+    // Element 2k's answer sits at bit 2k+1 of ok_even, element 2k+1's at bit 2k+1 of ok_odd
+    *overflow = ~(((ok_even >> 1) & 0x55u) | (ok_odd & 0xAAu)) & 0xFFu;
+    return _mm256_mullo_epi32(a, b);
+}
+
+SDK_TARGET_AVX512 static inline __m512i add_wrap_avx512(__m512i a, __m512i b, unsigned *overflow) {
+    __m512i r = _mm512_add_epi32(a, b);
+    *overflow = _mm512_cmplt_epi32_mask(
+        _mm512_and_si512(_mm512_xor_si512(a, r), _mm512_xor_si512(b, r)),
+        _mm512_setzero_si512());
+    return r;
+}
+
+SDK_TARGET_AVX512 static inline __m512i mullo_wrap_avx512(__m512i a, __m512i b, unsigned *overflow) {
+    __m512i even = _mm512_mul_epi32(a, b);
+    __m512i odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+    // Same trick as mullo_wrap_avx2, with the answer landing in mask registers
+    unsigned ok_even = _mm512_cmpeq_epi32_mask(
+        even, _mm512_slli_epi64(_mm512_srai_epi32(even, 31), 32));
+    unsigned ok_odd = _mm512_cmpeq_epi32_mask(
+        odd, _mm512_slli_epi64(_mm512_srai_epi32(odd, 31), 32));
+    *overflow = ~(((ok_even >> 1) & 0x5555u) | (ok_odd & 0xAAAAu)) & 0xFFFFu;
+    return _mm512_mullo_epi32(a, b);
+}
+#else
+#define SDK_SIMD_X86 0
+#endif
+
+#endif /* __SDK_SIMD_H__ */
@@ -20,7 +20,7 @@ CATCH2_REPORT_DIR := $(BUILD_DIR)/ut-catch2-report
 
 # C++ compiler flags
 CATCH2_CXXFLAGS := $(CXXFLAGS) -std=c++17 -I$(SDK_INSTALL_INC_DIR) -I$(CATCH2_INC_DIR)
-CATCH2_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CATCH2_LIB_DIR) -lsdk -lCatch2Main -lCatch2
+CATCH2_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CATCH2_LIB_DIR) -lsdk -pthread -ldl -lCatch2Main -lCatch2
 
 # Mock test specific LDFLAGS (--wrap options for mocking calc functions)
 CATCH2_MOCK_LDFLAGS := $(CATCH2_LDFLAGS) \
@@ -30,7 +30,7 @@ CATCH2_COV_SDK_LIB := $(CATCH2_COV_OUTPUT_DIR)/libsdk_cov.a
 
 # UT specific flags for coverage build
 CATCH2_COV_UT_CXXFLAGS := $(CATCH2_COV_CXXFLAGS) -Isdk/include -I$(CATCH2_INC_DIR)
-CATCH2_COV_UT_LDFLAGS := $(CATCH2_COV_LDFLAGS) -L$(CATCH2_COV_OUTPUT_DIR) -L$(CATCH2_LIB_DIR) -lsdk_cov -lCatch2Main -lCatch2
+CATCH2_COV_UT_LDFLAGS := $(CATCH2_COV_LDFLAGS) -L$(CATCH2_COV_OUTPUT_DIR) -L$(CATCH2_LIB_DIR) -lsdk_cov -pthread -ldl -lCatch2Main -lCatch2
 
 # Mock test specific LDFLAGS for coverage
 CATCH2_COV_MOCK_LDFLAGS := $(CATCH2_COV_UT_LDFLAGS) \
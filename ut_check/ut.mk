@@ -37,7 +37,7 @@ CHECK_REPORT_DIR := $(BUILD_DIR)/ut-check-report
 
 # UT specific flags
 CHECK_CFLAGS := $(CFLAGS) -I$(SDK_INSTALL_INC_DIR) -I$(CHECK_INC_DIR)
-CHECK_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CHECK_LIB_DIR) -lsdk -lcheck -pthread -lm -lrt
+CHECK_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CHECK_LIB_DIR) -lsdk -lcheck -pthread -ldl -lm -lrt
 
 # Mock test specific LDFLAGS (--wrap options for mocking calc functions)
 CHECK_MOCK_LDFLAGS := $(CHECK_LDFLAGS) \
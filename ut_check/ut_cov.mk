@@ -14,7 +14,7 @@ CHECK_COV_TEST_FEATURES := $(DIST_DIR)/check_cov_test_features
 
 # Coverage flags
 CHECK_COV_CFLAGS := $(CFLAGS) --coverage -I$(SDK_INC_DIR) -I$(CHECK_INC_DIR)
-CHECK_COV_LDFLAGS := -L$(CHECK_LIB_DIR) -lcheck -pthread -lm -lrt --coverage
+CHECK_COV_LDFLAGS := -L$(CHECK_LIB_DIR) -lcheck -pthread -ldl -lm -lrt --coverage
 
 # Coverage mock LDFLAGS
 CHECK_COV_MOCK_LDFLAGS := $(CHECK_COV_LDFLAGS) \
@@ -0,0 +1,50 @@
+/**
+ * @file calc_ops_plugin.c
+ * @brief Example calc backend loaded with calc_ops_load
+ *
+ * Built as a shared object that only needs calc-ops.h: it exports a
+ * saturating backend as SDK_CALC_OPS_SYMBOL.
+ */
+
+#include <limits.h>
+#include <stdint.h>
+#include "calc-ops.h"
+
+static int saturate(int64_t v) {
+    return v > INT_MAX ? INT_MAX : (v < INT_MIN ? INT_MIN : (int)v);
+}
+
+static int sat_add(int a, int b) {
+    return saturate((int64_t)a + b);
+}
+
+static int sat_subtract(int a, int b) {
+    return saturate((int64_t)a - b);
+}
+
+static int sat_multiply(int a, int b) {
+    return saturate((int64_t)a * b);
+}
+
+static int sat_divide(int a, int b) {
+    return b == 0 ? 0 : saturate((int64_t)a / b);
+}
+
+#define DEFINE_BATCH(op)                                                    \
+    static void sat_##op##_batch(const int *a, const int *b, int *out,      \
+                                 size_t n) {                                \
+        for (size_t i = 0; i < n; i++) {                                    \
+            out[i] = sat_##op(a[i], b[i]);                                  \
+        }                                                                   \
+    }
+
+DEFINE_BATCH(add)
+DEFINE_BATCH(subtract)
+DEFINE_BATCH(multiply)
+DEFINE_BATCH(divide)
+
+const sdk_calc_ops sdk_calc_backend = {
+    SDK_CALC_OPS_ABI, "plugin-saturate",
+    sat_add, sat_subtract, sat_multiply, sat_divide,
+    sat_add_batch, sat_subtract_batch, sat_multiply_batch, sat_divide_batch,
+};
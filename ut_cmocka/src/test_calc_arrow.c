@@ -0,0 +1,336 @@
+/**
+ * @file test_calc_arrow.c
+ * @brief Unit tests for batch calc on Arrow C Data Interface columns
+ *
+ * Input columns are built by hand around plain arrays, the way a producer
+ * exports them, and results are compared with the calc_*_batch and
+ * calc_*_checked functions.
+ *
+ * Demonstrates cmocka features:
+ * - assert_memory_equal on result buffers
+ * - assert_null / assert_non_null on the optional validity buffer
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-arrow.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+#include "multi-calc-batch.h"
+#include "test_data.h"
+
+#define LEN 203                 /* Not a multiple of 8 */
+#define OFFSET 5                /* Not a multiple of 8 either */
+
+/* An exported column over caller-owned buffers */
+typedef struct {
+    struct ArrowArray array;
+    const void *buffers[2];
+} test_column;
+
+static void release_test_column(struct ArrowArray *array) {
+    array->release = NULL;
+}
+
+static void column_init(test_column *col, const int *data, const unsigned char *validity,
+                        int64_t length, int64_t offset, int64_t null_count) {
+    memset(col, 0, sizeof(*col));
+    col->buffers[0] = validity;
+    col->buffers[1] = data;
+    col->array.length = length;
+    col->array.null_count = null_count;
+    col->array.offset = offset;
+    col->array.n_buffers = 2;
+    col->array.buffers = col->buffers;
+    col->array.release = release_test_column;
+}
+
+static int bit(const unsigned char *bits, size_t i) {
+    return (bits[i / 8] >> (i % 8)) & 1;
+}
+
+/* Edge values, and random values of every magnitude */
+static void fill(int *buf, size_t n, uint32_t seed) {
+    static const int edges[] = { INT_MAX, INT_MIN, -1, 0, 1 };
+    for (size_t i = 0; i < n; i++) {
+        uint32_t range = (uint32_t)INT_MAX >> (test_data_next(&seed) % 31);
+        buf[i] = test_data_int_or_edge(&seed, range, edges, sizeof(edges) / sizeof(edges[0]), 3);
+    }
+}
+
+/* Validity of the result row i: both inputs valid and, if asked, no error */
+static void check_validity(const struct ArrowArray *out, const unsigned char *expected_valid) {
+    const unsigned char *validity = out->buffers[0];
+    size_t nulls = 0;
+
+    for (size_t i = 0; i < (size_t)out->length; i++) {
+        nulls += !expected_valid[i];
+    }
+    assert_int_equal(out->null_count, nulls);
+    if (nulls == 0) {
+        assert_null(validity);
+        return;
+    }
+    assert_non_null(validity);
+    for (size_t i = 0; i < (size_t)out->length; i++) {
+        assert_int_equal(bit(validity, i), expected_valid[i]);
+    }
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_values_match_batch(void **state) {
+    (void)state;
+    int a[LEN], b[LEN], expected[LEN];
+    test_column ca, cb;
+    struct ArrowArray out;
+    static const struct {
+        calc_arrow_op_t op;
+        void (*batch)(const int *, const int *, int *, size_t);
+    } ops[] = {
+        { CALC_ARROW_ADD, calc_add_batch },
+        { CALC_ARROW_SUBTRACT, calc_subtract_batch },
+        { CALC_ARROW_MULTIPLY, calc_multiply_batch },
+        { CALC_ARROW_DIVIDE, calc_divide_batch },
+    };
+
+    fill(a, LEN, 1u);
+    fill(b, LEN, 2u);
+    column_init(&ca, a, NULL, LEN, 0, 0);
+    column_init(&cb, b, NULL, LEN, 0, 0);
+
+    for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); k++) {
+        ops[k].batch(a, b, expected, LEN);
+        assert_int_equal(calc_arrow_batch(ops[k].op, &ca.array, &cb.array, 0, &out), 0);
+        assert_int_equal(out.length, LEN);
+        assert_int_equal(out.offset, 0);
+        assert_int_equal(out.n_buffers, 2);
+        assert_int_equal(out.null_count, 0);
+        assert_null(out.buffers[0]);
+        assert_int_equal((uintptr_t)out.buffers[1] % 64, 0);
+        assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+        out.release(&out);
+        assert_null(out.release);
+    }
+}
+
+static void test_validity_propagates(void **state) {
+    (void)state;
+    int a[LEN], b[LEN + OFFSET], expected[LEN];
+    unsigned char valid_a[CALC_BITMAP_BYTES(LEN)];
+    unsigned char valid_b[CALC_BITMAP_BYTES(LEN + OFFSET)];
+    unsigned char expected_valid[LEN];
+    test_column ca, cb;
+    struct ArrowArray out;
+
+    fill(a, LEN, 3u);
+    fill(b, LEN + OFFSET, 4u);
+    for (size_t j = 0; j < sizeof(valid_a); j++) {
+        valid_a[j] = (unsigned char)(0xb7u ^ j);
+    }
+    for (size_t j = 0; j < sizeof(valid_b); j++) {
+        valid_b[j] = (unsigned char)(0x6du + 13 * j);
+    }
+    for (size_t i = 0; i < LEN; i++) {
+        expected_valid[i] = (unsigned char)(bit(valid_a, i) & bit(valid_b, i + OFFSET));
+    }
+    // b starts OFFSET rows into its buffers, so its bitmap is read unaligned
+    column_init(&ca, a, valid_a, LEN, 0, -1);
+    column_init(&cb, b, valid_b, LEN, OFFSET, -1);
+
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, &out), 0);
+    calc_add_batch(a, b + OFFSET, expected, LEN);
+    assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+    check_validity(&out, expected_valid);
+    out.release(&out);
+
+    // A null count of 0 means the bitmap can be ignored
+    column_init(&cb, b, valid_b, LEN, OFFSET, 0);
+    for (size_t i = 0; i < LEN; i++) {
+        expected_valid[i] = (unsigned char)bit(valid_a, i);
+    }
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, &out), 0);
+    check_validity(&out, expected_valid);
+    out.release(&out);
+}
+
+static void test_errors_become_nulls(void **state) {
+    (void)state;
+    int a[LEN], b[LEN], expected[LEN];
+    unsigned char flags[CALC_BITMAP_BYTES(LEN)];
+    unsigned char valid_b[CALC_BITMAP_BYTES(LEN)];
+    unsigned char expected_valid[LEN];
+    test_column ca, cb;
+    struct ArrowArray out;
+
+    fill(a, LEN, 5u);
+    fill(b, LEN, 6u);
+    memset(valid_b, 0xff, sizeof(valid_b));
+    valid_b[2] = 0x0f;
+    column_init(&ca, a, NULL, LEN, 0, 0);
+    column_init(&cb, b, valid_b, LEN, 0, 4);
+
+    // Division by zero and INT_MIN / -1
+    size_t errors = calc_divide_checked_batch(a, b, expected, flags, LEN);
+    assert_true(errors > 0);
+    for (size_t i = 0; i < LEN; i++) {
+        expected_valid[i] = (unsigned char)(!bit(flags, i) && bit(valid_b, i));
+    }
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_DIVIDE, &ca.array, &cb.array,
+                                      CALC_ARROW_NULL_ON_ERROR, &out), 0);
+    assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+    check_validity(&out, expected_valid);
+    out.release(&out);
+
+    // Overflow, without input nulls
+    column_init(&cb, b, NULL, LEN, 0, 0);
+    errors = calc_multiply_checked_batch(a, b, expected, flags, LEN);
+    assert_true(errors > 0);
+    for (size_t i = 0; i < LEN; i++) {
+        expected_valid[i] = (unsigned char)!bit(flags, i);
+    }
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_MULTIPLY, &ca.array, &cb.array,
+                                      CALC_ARROW_NULL_ON_ERROR, &out), 0);
+    assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+    check_validity(&out, expected_valid);
+    out.release(&out);
+
+    // Without the option, the same rows keep their wrapped values
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_MULTIPLY, &ca.array, &cb.array, 0, &out), 0);
+    assert_int_equal(out.null_count, 0);
+    assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+    out.release(&out);
+}
+
+static void test_expression(void **state) {
+    (void)state;
+    int a[LEN], b[LEN], c[LEN], d[LEN + OFFSET], expected[LEN];
+    unsigned char valid_d[CALC_BITMAP_BYTES(LEN + OFFSET)];
+    unsigned char expected_valid[LEN];
+    test_column ca, cb, cc, cd;
+    struct ArrowArray out;
+
+    fill(a, LEN, 7u);
+    fill(b, LEN, 8u);
+    fill(c, LEN, 9u);
+    fill(d, LEN + OFFSET, 10u);
+    for (size_t j = 0; j < sizeof(valid_d); j++) {
+        valid_d[j] = (unsigned char)~(1u << (j % 8));
+    }
+    column_init(&ca, a, NULL, LEN, 0, 0);
+    column_init(&cb, b, NULL, LEN, 0, 0);
+    column_init(&cc, c, NULL, LEN, 0, 0);
+    column_init(&cd, d, valid_d, LEN, OFFSET, -1);
+
+    multi_calc_expression_batch(a, b, c, d + OFFSET, expected, LEN);
+    assert_int_equal(calc_arrow_expression_batch(&ca.array, &cb.array, &cc.array, &cd.array,
+                                                 0, &out), 0);
+    assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+    for (size_t i = 0; i < LEN; i++) {
+        expected_valid[i] = (unsigned char)bit(valid_d, i + OFFSET);
+    }
+    check_validity(&out, expected_valid);
+    out.release(&out);
+
+    assert_int_equal(calc_arrow_expression_batch(&ca.array, &cb.array, &cc.array, &cd.array,
+                                                 CALC_ARROW_NULL_ON_ERROR, &out), 0);
+    assert_memory_equal(out.buffers[1], expected, sizeof(expected));
+    for (size_t i = 0; i < LEN; i++) {
+        int sum, diff, product;
+        int error = calc_add_checked(a[i], b[i], &sum) != CALC_OK;
+        error |= calc_subtract_checked(c[i], d[i + OFFSET], &diff) != CALC_OK;
+        error |= calc_multiply_checked(sum, diff, &product) != CALC_OK;
+        expected_valid[i] = (unsigned char)(!error && bit(valid_d, i + OFFSET));
+    }
+    check_validity(&out, expected_valid);
+    out.release(&out);
+}
+
+static void test_schema(void **state) {
+    (void)state;
+    struct ArrowSchema schema;
+
+    assert_int_equal(calc_arrow_export_schema("total", &schema), 0);
+    assert_string_equal(schema.format, "i");
+    assert_string_equal(schema.name, "total");
+    assert_int_equal(schema.flags, ARROW_FLAG_NULLABLE);
+    assert_int_equal(calc_arrow_check_schema(&schema), 0);
+
+    schema.format = "l";    // int64
+    assert_int_equal(calc_arrow_check_schema(&schema), -1);
+    schema.release(&schema);
+    assert_null(schema.release);
+    assert_int_equal(calc_arrow_check_schema(&schema), -1);
+    assert_int_equal(calc_arrow_check_schema(NULL), -1);
+
+    assert_int_equal(calc_arrow_export_schema(NULL, &schema), 0);
+    assert_null(schema.name);
+    schema.release(&schema);
+}
+
+static void test_invalid_inputs(void **state) {
+    (void)state;
+    int a[8] = { 0 }, b[8] = { 0 };
+    test_column ca, cb;
+    struct ArrowArray out;
+
+    memset(&out, 0x5a, sizeof(out));
+    column_init(&ca, a, NULL, 8, 0, 0);
+    column_init(&cb, b, NULL, 7, 0, 0);
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, &out), -1);
+
+    column_init(&cb, b, NULL, 8, 0, 0);
+    cb.array.release = NULL;    // Already released
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, &out), -1);
+
+    column_init(&cb, b, NULL, 8, 0, 0);
+    cb.array.n_buffers = 3;     // Not a primitive column
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, &out), -1);
+
+    column_init(&cb, NULL, NULL, 8, 0, 0);
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, &out), -1);
+
+    column_init(&cb, b, NULL, 8, 0, 0);
+    assert_int_equal(calc_arrow_batch((calc_arrow_op_t)99, &ca.array, &cb.array, 0, &out), -1);
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, NULL, &cb.array, 0, &out), -1);
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_ADD, &ca.array, &cb.array, 0, NULL), -1);
+    assert_int_equal(calc_arrow_expression_batch(&ca.array, &cb.array, &ca.array, NULL, 0, &out), -1);
+    assert_int_equal(out.length, 0x5a5a5a5a5a5a5a5a);   // Untouched
+
+    // Empty columns are fine
+    column_init(&ca, NULL, NULL, 0, 0, 0);
+    column_init(&cb, NULL, NULL, 0, 0, 0);
+    assert_int_equal(calc_arrow_batch(CALC_ARROW_DIVIDE, &ca.array, &cb.array,
+                                      CALC_ARROW_NULL_ON_ERROR, &out), 0);
+    assert_int_equal(out.length, 0);
+    assert_int_equal(out.null_count, 0);
+    out.release(&out);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_values_match_batch),
+        cmocka_unit_test(test_validity_propagates),
+        cmocka_unit_test(test_errors_become_nulls),
+        cmocka_unit_test(test_expression),
+        cmocka_unit_test(test_schema),
+        cmocka_unit_test(test_invalid_inputs),
+    };
+
+    printf("\n========== CALC ARROW MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc arrow tests", tests, NULL, NULL);
+}
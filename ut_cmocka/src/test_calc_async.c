@@ -0,0 +1,266 @@
+/**
+ * @file test_calc_async.c
+ * @brief Unit tests for the calc-async job executor
+ *
+ * Jobs must give the same results as the synchronous calls, completion
+ * must be observable through poll, wait and callbacks, and a full queue
+ * must block or refuse submissions instead of growing.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share one executor through state
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cmocka.h>
+
+#include "calc-async.h"
+#include "calc-batch.h"
+#include "greeting.h"
+#include "multi-calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 1000
+#define PRODUCERS 4
+#define JOBS_PER_PRODUCER 2000
+
+static int setup_executor(void **state) {
+    *state = calc_async_create(2, 16);
+    return *state == NULL ? -1 : 0;
+}
+
+static int teardown_executor(void **state) {
+    calc_async_destroy(*state);
+    return 0;
+}
+
+/* Custom job that holds its worker until the test opens the gate */
+struct gate {
+    int open;                   /* Atomic */
+    int entered;                /* Atomic */
+};
+
+static void gate_job(void *arg) {
+    struct gate *g = arg;
+
+    __atomic_store_n(&g->entered, 1, __ATOMIC_RELEASE);
+    while (!__atomic_load_n(&g->open, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+}
+
+static void count_job(void *arg) {
+    __atomic_add_fetch((unsigned *)arg, 1, __ATOMIC_RELAXED);
+}
+
+static void count_callback(calc_job_t *job, void *arg) {
+    (void)job;
+    __atomic_add_fetch((unsigned *)arg, 1, __ATOMIC_RELAXED);
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_batch_jobs_match_sync(void **state) {
+    calc_async_t *async = *state;
+    static const calc_job_kind_t kinds[] = {
+        CALC_JOB_ADD, CALC_JOB_SUBTRACT, CALC_JOB_MULTIPLY, CALC_JOB_DIVIDE, CALC_JOB_EXPRESSION,
+    };
+    static int cols[4][TEST_LEN];
+    static int async_out[5][TEST_LEN];
+    int sync_out[TEST_LEN];
+    calc_job_t *jobs[5];
+    uint32_t seed = 7u;
+
+    for (size_t k = 0; k < 4; k++) {
+        test_data_fill(cols[k], TEST_LEN, &seed, k == 1 ? 32 : 0);     // Some zero divisors
+    }
+    for (size_t j = 0; j < 5; j++) {
+        calc_job_desc_t desc = {
+            .kind = kinds[j], .a = cols[0], .b = cols[1], .c = cols[2], .d = cols[3],
+            .out = async_out[j], .n = TEST_LEN,
+        };
+        jobs[j] = calc_async_submit(async, &desc);
+        assert_non_null(jobs[j]);
+    }
+    for (size_t j = 0; j < 5; j++) {
+        calc_job_wait(jobs[j]);
+        assert_int_equal(calc_job_poll(jobs[j]), CALC_JOB_DONE);
+        calc_job_release(jobs[j]);
+    }
+
+    calc_add_batch(cols[0], cols[1], sync_out, TEST_LEN);
+    assert_memory_equal(async_out[0], sync_out, sizeof(sync_out));
+    calc_subtract_batch(cols[0], cols[1], sync_out, TEST_LEN);
+    assert_memory_equal(async_out[1], sync_out, sizeof(sync_out));
+    calc_multiply_batch(cols[0], cols[1], sync_out, TEST_LEN);
+    assert_memory_equal(async_out[2], sync_out, sizeof(sync_out));
+    calc_divide_batch(cols[0], cols[1], sync_out, TEST_LEN);
+    assert_memory_equal(async_out[3], sync_out, sizeof(sync_out));
+    multi_calc_expression_batch(cols[0], cols[1], cols[2], cols[3], sync_out, TEST_LEN);
+    assert_memory_equal(async_out[4], sync_out, sizeof(sync_out));
+}
+
+static void test_greeting_jobs(void **state) {
+    calc_async_t *async = *state;
+    static const char *const names[] = { "Alice", "", NULL, "Bob" };
+    char hello[4][CALC_JOB_TEXT_LEN];
+    char goodbye[4][8];
+    calc_job_desc_t desc = {
+        .kind = CALC_JOB_HELLO, .n = 4, .names = names, .text = hello[0],
+    };
+    calc_job_t *hello_job = calc_async_submit(async, &desc);
+    calc_job_t *goodbye_job;
+
+    desc.kind = CALC_JOB_GOODBYE;
+    desc.text = goodbye[0];
+    desc.text_size = sizeof(goodbye[0]);
+    goodbye_job = calc_async_submit(async, &desc);
+    assert_non_null(hello_job);
+    assert_non_null(goodbye_job);
+    calc_job_wait(hello_job);
+    calc_job_wait(goodbye_job);
+
+    assert_string_equal(hello[0], "Hello, Alice!");
+    assert_string_equal(hello[1], "Hello, stranger!");
+    assert_string_equal(hello[2], "Hello, stranger!");
+    assert_string_equal(hello[3], "Hello, Bob!");
+    assert_string_equal(goodbye[0], "Goodbye");     // Truncated to text_size
+    assert_string_equal(goodbye[3], "Goodbye");
+    calc_job_release(hello_job);
+    calc_job_release(goodbye_job);
+}
+
+static void test_poll_wait_and_callback(void **state) {
+    calc_async_t *async = *state;
+    struct gate g = { 0, 0 };
+    unsigned calls = 0;
+    calc_job_desc_t desc = { .kind = CALC_JOB_CUSTOM, .fn = gate_job, .arg = &g };
+    calc_job_t *job = calc_async_submit(async, &desc);
+
+    assert_non_null(job);
+    while (!__atomic_load_n(&g.entered, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    assert_int_equal(calc_job_poll(job), CALC_JOB_RUNNING);
+    assert_int_equal(calc_job_then(job, count_callback, &calls), 0);
+    assert_int_equal(calc_job_then(job, count_callback, &calls), -1);
+    assert_int_equal(__atomic_load_n(&calls, __ATOMIC_RELAXED), 0);
+
+    __atomic_store_n(&g.open, 1, __ATOMIC_RELEASE);
+    calc_job_wait(job);
+    assert_int_equal(calc_job_poll(job), CALC_JOB_DONE);
+    // The callback runs after the state changes: wait for it too
+    while (__atomic_load_n(&calls, __ATOMIC_ACQUIRE) == 0) {
+        sched_yield();
+    }
+    assert_int_equal(__atomic_load_n(&calls, __ATOMIC_ACQUIRE), 1);
+    calc_job_release(job);
+
+    // A callback attached to a finished job runs at once
+    job = calc_async_submit(async, &desc);
+    assert_non_null(job);
+    calc_job_wait(job);
+    assert_int_equal(calc_job_then(job, count_callback, &calls), 0);
+    assert_int_equal(__atomic_load_n(&calls, __ATOMIC_ACQUIRE), 2);
+    calc_job_release(job);
+}
+
+static void test_backpressure(void **state) {
+    (void)state;
+    calc_async_t *async = calc_async_create(1, 2);
+    struct gate g = { 0, 0 };
+    unsigned count = 0;
+    calc_job_desc_t blocker = { .kind = CALC_JOB_CUSTOM, .fn = gate_job, .arg = &g };
+    calc_job_desc_t counter = { .kind = CALC_JOB_CUSTOM, .fn = count_job, .arg = &count };
+    calc_job_t *jobs[3];
+
+    assert_non_null(async);
+    jobs[0] = calc_async_submit(async, &blocker);
+    assert_non_null(jobs[0]);
+    while (!__atomic_load_n(&g.entered, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    // The worker is busy: two queued jobs fill the queue
+    jobs[1] = calc_async_try_submit(async, &counter);
+    jobs[2] = calc_async_try_submit(async, &counter);
+    assert_non_null(jobs[1]);
+    assert_non_null(jobs[2]);
+    assert_null(calc_async_try_submit(async, &counter));
+    assert_int_equal(calc_job_poll(jobs[1]), CALC_JOB_QUEUED);
+
+    __atomic_store_n(&g.open, 1, __ATOMIC_RELEASE);
+    for (size_t j = 0; j < 3; j++) {
+        calc_job_wait(jobs[j]);
+        calc_job_release(jobs[j]);
+    }
+    assert_int_equal(__atomic_load_n(&count, __ATOMIC_ACQUIRE), 2);
+    calc_async_destroy(async);
+}
+
+static void* producer(void *arg) {
+    calc_async_t *async = ((void **)arg)[0];
+    calc_job_desc_t desc = { .kind = CALC_JOB_CUSTOM, .fn = count_job, .arg = ((void **)arg)[1] };
+
+    for (int i = 0; i < JOBS_PER_PRODUCER; i++) {
+        // Released at once: the job still runs
+        calc_job_release(calc_async_submit(async, &desc));
+    }
+    return NULL;
+}
+
+static void test_concurrent_producers_and_drain(void **state) {
+    (void)state;
+    calc_async_t *async = calc_async_create(3, 8);
+    unsigned count = 0;
+    void *args[2] = { async, &count };
+    pthread_t producers[PRODUCERS];
+
+    assert_non_null(async);
+    for (size_t p = 0; p < PRODUCERS; p++) {
+        assert_int_equal(pthread_create(&producers[p], NULL, producer, args), 0);
+    }
+    for (size_t p = 0; p < PRODUCERS; p++) {
+        pthread_join(producers[p], NULL);
+    }
+    // Destroy runs every queued job first
+    calc_async_destroy(async);
+    assert_int_equal(__atomic_load_n(&count, __ATOMIC_ACQUIRE), PRODUCERS * JOBS_PER_PRODUCER);
+}
+
+static void test_invalid_arguments(void **state) {
+    calc_async_t *async = *state;
+    calc_job_desc_t desc = { .kind = (calc_job_kind_t)99 };
+
+    assert_null(calc_async_submit(async, &desc));
+    assert_null(calc_async_try_submit(async, &desc));
+    calc_job_release(NULL);
+    calc_async_destroy(NULL);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_batch_jobs_match_sync),
+        cmocka_unit_test(test_greeting_jobs),
+        cmocka_unit_test(test_poll_wait_and_callback),
+        cmocka_unit_test(test_backpressure),
+        cmocka_unit_test(test_concurrent_producers_and_drain),
+        cmocka_unit_test(test_invalid_arguments),
+    };
+
+    printf("\n========== CALC ASYNC MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc async tests", tests,
+                                       setup_executor, teardown_executor);
+}
@@ -0,0 +1,290 @@
+/**
+ * @file test_calc_batch.c
+ * @brief Unit tests for calc batch (array) module
+ *
+ * Every kernel supported by the running CPU is checked against the scalar
+ * calc_* functions, element by element.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers (cmocka_run_group_tests_name)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+
+#define TEST_LEN 1037   /* Not a multiple of any vector width: exercises tails */
+
+struct batch_buffers {
+    int a[TEST_LEN];
+    int b[TEST_LEN];
+    int out[TEST_LEN];
+};
+
+/*============================================================================
+ * Helpers
+ *===========================================================================*/
+
+static uint32_t rng_state = 12345u;
+
+static int next_random(void) {
+    // xorshift32, deterministic across runs
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return (int)rng_state;
+}
+
+static void fill_inputs(struct batch_buffers *buf) {
+    static const int edges[] = { 0, 1, -1, 2, -2, 3, INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1 };
+    const size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        if (i < n_edges * n_edges) {
+            buf->a[i] = edges[i / n_edges];
+            buf->b[i] = edges[i % n_edges];
+        } else {
+            // Mix large random values with small ones and zero divisors
+            buf->a[i] = next_random();
+            buf->b[i] = (i % 7 == 0) ? 0 : ((i % 3 == 0) ? next_random() % 100 : next_random());
+        }
+    }
+}
+
+/* Reference for divide: calc_divide traps on INT_MIN / -1, batch wraps */
+static int reference_divide(int a, int b) {
+    if (a == INT_MIN && b == -1) {
+        return INT_MIN;
+    }
+    return calc_divide(a, b);
+}
+
+static int group_setup(void **state) {
+    struct batch_buffers *buf = malloc(sizeof(*buf));
+    if (buf == NULL) {
+        return -1;
+    }
+    fill_inputs(buf);
+    *state = buf;
+    return 0;
+}
+
+static int group_teardown(void **state) {
+    free(*state);
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+    return 0;
+}
+
+/*============================================================================
+ * Batch results match calc_* for every supported instruction set
+ *===========================================================================*/
+
+static void test_add_batch_matches_calc_add(void **state) {
+    struct batch_buffers *buf = (struct batch_buffers *)*state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        calc_add_batch(buf->a, buf->b, buf->out, TEST_LEN);
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            // Compare in unsigned arithmetic: INT_MAX + 1 must wrap
+            assert_int_equal(buf->out[i], (int)((unsigned)buf->a[i] + (unsigned)buf->b[i]));
+        }
+        assert_int_equal(buf->out[12], calc_add(buf->a[12], buf->b[12]));
+    }
+}
+
+static void test_subtract_batch_matches_calc_subtract(void **state) {
+    struct batch_buffers *buf = (struct batch_buffers *)*state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        calc_subtract_batch(buf->a, buf->b, buf->out, TEST_LEN);
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(buf->out[i], (int)((unsigned)buf->a[i] - (unsigned)buf->b[i]));
+        }
+        assert_int_equal(buf->out[12], calc_subtract(buf->a[12], buf->b[12]));
+    }
+}
+
+static void test_multiply_batch_matches_calc_multiply(void **state) {
+    struct batch_buffers *buf = (struct batch_buffers *)*state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        calc_multiply_batch(buf->a, buf->b, buf->out, TEST_LEN);
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(buf->out[i], (int)((unsigned)buf->a[i] * (unsigned)buf->b[i]));
+        }
+        assert_int_equal(buf->out[35], calc_multiply(buf->a[35], buf->b[35]));
+    }
+}
+
+static void test_divide_batch_matches_calc_divide(void **state) {
+    struct batch_buffers *buf = (struct batch_buffers *)*state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        calc_divide_batch(buf->a, buf->b, buf->out, TEST_LEN);
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(buf->out[i], reference_divide(buf->a[i], buf->b[i]));
+        }
+    }
+}
+
+static void test_divide_masked_matches_calc_divide(void **state) {
+    struct batch_buffers *buf = (struct batch_buffers *)*state;
+    unsigned char flags[CALC_BITMAP_BYTES(TEST_LEN)];
+    unsigned char expected_flags[CALC_BITMAP_BYTES(TEST_LEN)];
+    size_t expected_count = 0;
+
+    memset(expected_flags, 0, sizeof(expected_flags));
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        if (buf->b[i] == 0) {
+            expected_flags[i / 8] |= (unsigned char)(1u << (i % 8));
+            expected_count++;
+        }
+    }
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        memset(flags, 0xAA, sizeof(flags));
+        assert_int_equal(calc_divide_batch_masked(buf->a, buf->b, buf->out, flags, TEST_LEN),
+                         expected_count);
+        assert_memory_equal(flags, expected_flags, sizeof(flags));
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(buf->out[i], reference_divide(buf->a[i], buf->b[i]));
+        }
+
+        // Without a bitmap only the count is returned
+        assert_int_equal(calc_divide_batch_masked(buf->a, buf->b, buf->out, NULL, TEST_LEN),
+                         expected_count);
+    }
+}
+
+/*============================================================================
+ * Edge cases: empty input, tails, in-place operation
+ *===========================================================================*/
+
+static void test_batch_zero_length(void **state) {
+    (void)state;
+    int out[1] = { 42 };
+
+    calc_add_batch(NULL, NULL, out, 0);
+    calc_divide_batch(NULL, NULL, out, 0);
+    assert_int_equal(out[0], 42);
+}
+
+static void test_batch_short_tails(void **state) {
+    (void)state;
+    const int a[5] = { 10, 20, 30, 40, 50 };
+    const int b[5] = { 2, 0, 3, -4, 5 };
+    int out[5];
+
+    for (size_t n = 1; n <= 5; n++) {
+        calc_divide_batch(a, b, out, n);
+        for (size_t i = 0; i < n; i++) {
+            assert_int_equal(out[i], calc_divide(a[i], b[i]));
+        }
+    }
+}
+
+static void test_batch_in_place(void **state) {
+    (void)state;
+    int a[20];
+    int b[20];
+
+    for (int i = 0; i < 20; i++) {
+        a[i] = i;
+        b[i] = 2;
+    }
+    calc_multiply_batch(a, b, a, 20);   // a *= b
+    calc_add_batch(a, a, a, 20);        // a += a
+    for (int i = 0; i < 20; i++) {
+        assert_int_equal(a[i], i * 4);
+    }
+}
+
+/*============================================================================
+ * Instruction set selection
+ *===========================================================================*/
+
+static void test_isa_scalar_always_supported(void **state) {
+    (void)state;
+    assert_int_equal(calc_batch_set_isa(CALC_ISA_SCALAR), 0);
+    assert_int_equal(calc_batch_isa(), CALC_ISA_SCALAR);
+}
+
+static void test_isa_rejects_invalid_level(void **state) {
+    (void)state;
+    calc_isa_t before = calc_batch_isa();
+
+    assert_int_equal(calc_batch_set_isa((calc_isa_t)-1), -1);
+    assert_int_equal(calc_batch_set_isa((calc_isa_t)99), -1);
+    assert_int_equal(calc_batch_isa(), before);
+}
+
+static void test_isa_names(void **state) {
+    (void)state;
+    assert_string_equal(calc_isa_name(CALC_ISA_SCALAR), "scalar");
+    assert_string_equal(calc_isa_name(CALC_ISA_SSE2), "sse2");
+    assert_string_equal(calc_isa_name(CALC_ISA_AVX2), "avx2");
+    assert_string_equal(calc_isa_name(CALC_ISA_AVX512), "avx512");
+    assert_string_equal(calc_isa_name((calc_isa_t)99), "unknown");
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest match_tests[] = {
+        cmocka_unit_test(test_add_batch_matches_calc_add),
+        cmocka_unit_test(test_subtract_batch_matches_calc_subtract),
+        cmocka_unit_test(test_multiply_batch_matches_calc_multiply),
+        cmocka_unit_test(test_divide_batch_matches_calc_divide),
+        cmocka_unit_test(test_divide_masked_matches_calc_divide),
+    };
+
+    const struct CMUnitTest edge_tests[] = {
+        cmocka_unit_test(test_batch_zero_length),
+        cmocka_unit_test(test_batch_short_tails),
+        cmocka_unit_test(test_batch_in_place),
+    };
+
+    const struct CMUnitTest isa_tests[] = {
+        cmocka_unit_test(test_isa_scalar_always_supported),
+        cmocka_unit_test(test_isa_rejects_invalid_level),
+        cmocka_unit_test(test_isa_names),
+    };
+
+    int result = 0;
+
+    printf("\n========== CALC BATCH MODULE UNIT TESTS ==========\n\n");
+    printf("Detected instruction set: %s\n\n", calc_isa_name(calc_batch_isa()));
+
+    result += cmocka_run_group_tests_name("batch vs calc_* tests", match_tests, group_setup, group_teardown);
+    result += cmocka_run_group_tests_name("batch edge case tests", edge_tests, NULL, NULL);
+    result += cmocka_run_group_tests_name("instruction set tests", isa_tests, NULL, NULL);
+
+    return result;
+}
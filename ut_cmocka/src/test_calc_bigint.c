@@ -0,0 +1,330 @@
+/**
+ * @file test_calc_bigint.c
+ * @brief Unit tests for the arbitrary-precision integer module
+ *
+ * Small operands are checked against __int128 arithmetic, large ones
+ * against known decimal values and identities (a * b / b == a,
+ * a == q * b + r), with Karatsuba on and off.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test numbers through state
+ * - assert_string_equal() on decimal conversions
+ * - Worker threads that exit without releasing their scratch arena
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <cmocka.h>
+
+#include "calc-bigint.h"
+#include "test_data.h"
+
+#define MAX_LIMBS 300           /* Large enough for several Karatsuba levels */
+
+struct bigint_state {
+    calc_bigint_t a, b, c, d, q, r;
+    char text[8192];
+};
+
+static int setup_numbers(void **state) {
+    struct bigint_state *s = test_calloc(1, sizeof(*s));
+    *state = s;
+    return 0;
+}
+
+static int teardown_numbers(void **state) {
+    struct bigint_state *s = *state;
+
+    calc_bigint_free(&s->a);
+    calc_bigint_free(&s->b);
+    calc_bigint_free(&s->c);
+    calc_bigint_free(&s->d);
+    calc_bigint_free(&s->q);
+    calc_bigint_free(&s->r);
+    test_free(s);
+    calc_bigint_set_karatsuba_threshold(CALC_BIGINT_KARATSUBA_THRESHOLD);
+    calc_bigint_release_scratch();
+    return 0;
+}
+
+/* Pseudo-random number of `limbs` limbs, some of them 0 or all ones */
+static void make_number(calc_bigint_t *x, size_t limbs, uint64_t seed, int negative) {
+    calc_bigint_t shift = CALC_BIGINT_INIT, half = CALC_BIGINT_INIT;
+
+    // Leading limb 1, then x = x * 2^32 + half, two halves per limb
+    assert_int_equal(calc_bigint_set_i64(x, 1), 0);
+    assert_int_equal(calc_bigint_set_i64(&shift, INT64_C(1) << 32), 0);
+    for (size_t i = 0; i < limbs; i++) {
+        uint64_t v = test_data_next64(&seed);
+        v = (v >> 60) == 0 ? 0 : (v >> 60) == 1 ? UINT64_MAX : v;
+        for (int k = 1; k >= 0; k--) {
+            assert_int_equal(calc_bigint_multiply(x, &shift, x), 0);
+            assert_int_equal(calc_bigint_set_i64(&half, (int64_t)(uint32_t)(v >> (32 * k))), 0);
+            assert_int_equal(calc_bigint_add(x, &half, x), 0);
+        }
+    }
+    assert_int_equal(x->size, limbs + 1);
+    x->negative = negative != 0;
+    calc_bigint_free(&shift);
+    calc_bigint_free(&half);
+}
+
+static __int128 to_i128(const calc_bigint_t *x) {
+    unsigned __int128 m = 0;
+
+    assert_true(x->size <= 2);
+    for (size_t i = x->size; i-- > 0;) {
+        m = m << 64 | x->limbs[i];
+    }
+    return x->negative ? -(__int128)m : (__int128)m;
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_conversions(void **state) {
+    struct bigint_state *s = *state;
+    int64_t v;
+
+    assert_int_equal(calc_bigint_set_i64(&s->a, INT64_MIN), 0);
+    assert_int_equal(calc_bigint_to_i64(&s->a, &v), CALC_OK);
+    assert_true(v == INT64_MIN);
+    calc_bigint_to_str(&s->a, s->text, sizeof(s->text));
+    assert_string_equal(s->text, "-9223372036854775808");
+
+    // 2^64 does not fit; its low 64 bits are 0
+    assert_int_equal(calc_bigint_set_str(&s->a, "+18446744073709551616"), 0);
+    assert_int_equal(calc_bigint_to_i64(&s->a, &v), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_bigint_set_str(&s->a, "9223372036854775808"), 0);
+    assert_int_equal(calc_bigint_to_i64(&s->a, &v), CALC_ERR_OVERFLOW);
+
+    assert_int_equal(calc_bigint_set_str(&s->a, "-000"), 0);
+    assert_int_equal(s->a.size, 0);
+    assert_int_equal(s->a.negative, 0);
+    assert_int_equal(calc_bigint_to_str(&s->a, s->text, sizeof(s->text)), 1);
+    assert_string_equal(s->text, "0");
+
+    // Malformed strings leave the number unchanged
+    assert_int_equal(calc_bigint_set_i64(&s->a, 42), 0);
+    assert_int_equal(calc_bigint_set_str(&s->a, ""), -1);
+    assert_int_equal(calc_bigint_set_str(&s->a, "-"), -1);
+    assert_int_equal(calc_bigint_set_str(&s->a, "12a"), -1);
+    assert_int_equal(calc_bigint_to_i64(&s->a, &v), CALC_OK);
+    assert_int_equal(v, 42);
+
+    // Truncated output still reports the full length
+    assert_int_equal(calc_bigint_set_str(&s->a, "-1234567890123456789012345"), 0);
+    assert_int_equal(calc_bigint_to_str(&s->a, s->text, 6), 26);
+    assert_string_equal(s->text, "-1234");
+    assert_int_equal(calc_bigint_to_str(&s->a, NULL, 0), 26);
+    calc_bigint_to_str(&s->a, s->text, sizeof(s->text));
+    assert_string_equal(s->text, "-1234567890123456789012345");
+}
+
+static void test_small_against_int128(void **state) {
+    struct bigint_state *s = *state;
+    static const int64_t values[] = {
+        0, 1, -1, 7, -7, 1000000007, INT64_MAX, INT64_MIN, INT64_MIN + 1, 1ll << 32,
+    };
+    const size_t count = sizeof(values) / sizeof(values[0]);
+
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < count; j++) {
+            __int128 x = values[i], y = values[j];
+            calc_bigint_set_i64(&s->a, values[i]);
+            calc_bigint_set_i64(&s->b, values[j]);
+
+            assert_int_equal(calc_bigint_add(&s->a, &s->b, &s->c), 0);
+            assert_true(to_i128(&s->c) == x + y);
+            assert_int_equal(calc_bigint_subtract(&s->a, &s->b, &s->c), 0);
+            assert_true(to_i128(&s->c) == x - y);
+            assert_int_equal(calc_bigint_multiply(&s->a, &s->b, &s->c), 0);
+            assert_true(to_i128(&s->c) == x * y);
+            assert_int_equal(calc_bigint_divide(&s->a, &s->b, &s->q, &s->r), 0);
+            // Truncated toward zero, 0 and 0 for a zero divisor like calc_divide
+            assert_true(to_i128(&s->q) == (y ? x / y : 0));
+            assert_true(to_i128(&s->r) == (y ? x % y : 0));
+            assert_int_equal(calc_bigint_compare(&s->a, &s->b), (x > y) - (x < y));
+        }
+    }
+}
+
+static void test_known_values(void **state) {
+    struct bigint_state *s = *state;
+
+    // 30!
+    calc_bigint_set_i64(&s->a, 1);
+    for (int k = 2; k <= 30; k++) {
+        calc_bigint_set_i64(&s->b, k);
+        assert_int_equal(calc_bigint_multiply(&s->a, &s->b, &s->a), 0);
+    }
+    calc_bigint_to_str(&s->a, s->text, sizeof(s->text));
+    assert_string_equal(s->text, "265252859812191058636308480000000");
+
+    // (10^40 + 1)^2 - 1 = 10^80 + 2 * 10^40
+    assert_int_equal(calc_bigint_set_str(&s->a, "10000000000000000000000000000000000000001"), 0);
+    assert_int_equal(calc_bigint_multiply(&s->a, &s->a, &s->b), 0);
+    calc_bigint_set_i64(&s->c, 1);
+    assert_int_equal(calc_bigint_subtract(&s->b, &s->c, &s->b), 0);
+    calc_bigint_to_str(&s->b, s->text, sizeof(s->text));
+    assert_string_equal(s->text, "1000000000000000000000000000000000000000"
+                                 "20000000000000000000000000000000000000000");
+
+    // Division by a multi-limb divisor: (10^80 + 2 * 10^40) / (10^40 + 2) = 10^40, rest 0
+    assert_int_equal(calc_bigint_set_str(&s->c, "10000000000000000000000000000000000000002"), 0);
+    assert_int_equal(calc_bigint_divide(&s->b, &s->c, &s->q, &s->r), 0);
+    calc_bigint_to_str(&s->q, s->text, sizeof(s->text));
+    assert_string_equal(s->text, "10000000000000000000000000000000000000000");
+    assert_int_equal(s->r.size, 0);
+}
+
+static void test_karatsuba_matches_schoolbook(void **state) {
+    struct bigint_state *s = *state;
+    static const size_t sizes[][2] = {
+        { 4, 4 }, { 39, 41 }, { 64, 64 }, { 127, 128 }, { 300, 300 }, { 300, 45 }, { 250, 97 },
+    };
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        make_number(&s->a, sizes[k][0], 11u + k, k & 1);
+        make_number(&s->b, sizes[k][1], 97u + k, k & 2);
+
+        calc_bigint_set_karatsuba_threshold(SIZE_MAX);
+        assert_int_equal(calc_bigint_multiply(&s->a, &s->b, &s->c), 0);
+        calc_bigint_set_karatsuba_threshold(4);
+        assert_int_equal(calc_bigint_multiply(&s->a, &s->b, &s->d), 0);
+        assert_int_equal(calc_bigint_compare(&s->c, &s->d), 0);
+        calc_bigint_set_karatsuba_threshold(CALC_BIGINT_KARATSUBA_THRESHOLD);
+        assert_int_equal(calc_bigint_multiply(&s->b, &s->a, &s->d), 0);
+        assert_int_equal(calc_bigint_compare(&s->c, &s->d), 0);
+
+        // (a * b) / b == a exactly
+        assert_int_equal(calc_bigint_divide(&s->c, &s->b, &s->q, &s->r), 0);
+        assert_int_equal(calc_bigint_compare(&s->q, &s->a), 0);
+        assert_int_equal(s->r.size, 0);
+    }
+}
+
+static void test_division_identity(void **state) {
+    struct bigint_state *s = *state;
+    static const size_t sizes[][2] = {
+        { 1, 1 }, { 2, 2 }, { 5, 1 }, { 9, 2 }, { 40, 3 }, { 100, 99 }, { 200, 64 }, { 3, 7 },
+    };
+
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++) {
+        make_number(&s->a, sizes[k][0], 5u + k, k & 1);
+        make_number(&s->b, sizes[k][1], 3u + k, k & 2);
+
+        assert_int_equal(calc_bigint_divide(&s->a, &s->b, &s->q, &s->r), 0);
+        // |r| < |b|, r has the sign of a (or is 0), a == q * b + r
+        assert_int_equal(calc_bigint_copy(&s->c, &s->r), 0);
+        assert_int_equal(calc_bigint_copy(&s->d, &s->b), 0);
+        s->c.negative = s->d.negative = 0;
+        assert_true(calc_bigint_compare(&s->c, &s->d) < 0);
+        assert_true(s->r.size == 0 || s->r.negative == s->a.negative);
+        assert_int_equal(calc_bigint_multiply(&s->q, &s->b, &s->c), 0);
+        assert_int_equal(calc_bigint_add(&s->c, &s->r, &s->c), 0);
+        assert_int_equal(calc_bigint_compare(&s->c, &s->a), 0);
+    }
+
+    // Results aliasing the operands
+    make_number(&s->a, 20, 1u, 0);
+    make_number(&s->b, 7, 2u, 1);
+    assert_int_equal(calc_bigint_divide(&s->a, &s->b, &s->q, NULL), 0);
+    assert_int_equal(calc_bigint_divide(&s->a, &s->b, &s->a, &s->b), 0);
+    assert_int_equal(calc_bigint_compare(&s->a, &s->q), 0);
+}
+
+/* out = op(x, y) with out aliasing x (first) or y (second), then compare */
+static void check_aliased(struct bigint_state *s, int (*op)(const calc_bigint_t *,
+                          const calc_bigint_t *, calc_bigint_t *),
+                          const char *x, const char *y, int out_is_x, const char *expected) {
+    assert_int_equal(calc_bigint_set_str(&s->a, x), 0);
+    assert_int_equal(calc_bigint_set_str(&s->b, y), 0);
+    if (out_is_x) {
+        assert_int_equal(op(&s->a, &s->b, &s->a), 0);
+        calc_bigint_to_str(&s->a, s->text, sizeof(s->text));
+    } else {
+        assert_int_equal(op(&s->a, &s->b, &s->b), 0);
+        calc_bigint_to_str(&s->b, s->text, sizeof(s->text));
+    }
+    assert_string_equal(s->text, expected);
+}
+
+static void test_aliased_borrow_through_zero_limbs(void **state) {
+    struct bigint_state *s = *state;
+    // |2^128| - 5 borrows through two zero limbs, into the aliased operand
+    for (int out_is_x = 0; out_is_x <= 1; out_is_x++) {
+        check_aliased(s, calc_bigint_subtract, "-340282366920938463463374607431768211456",
+                      "-5", out_is_x, "-340282366920938463463374607431768211451");
+        check_aliased(s, calc_bigint_subtract, "-5",
+                      "-340282366920938463463374607431768211456", out_is_x,
+                      "340282366920938463463374607431768211451");
+        check_aliased(s, calc_bigint_add, "-340282366920938463463374607431768211456",
+                      "5", out_is_x, "-340282366920938463463374607431768211451");
+        check_aliased(s, calc_bigint_add, "5",
+                      "340282366920938463463374607431768211456", out_is_x,
+                      "340282366920938463463374607431768211461");
+        check_aliased(s, calc_bigint_add, "-5",
+                      "340282366920938463463374607431768211456", out_is_x,
+                      "340282366920938463463374607431768211451");
+        check_aliased(s, calc_bigint_subtract,
+                      "6277101735386680763835789423207666416102355444464034512896", "1",
+                      out_is_x, "6277101735386680763835789423207666416102355444464034512895");
+    }
+}
+
+/* 10^60 squared twice in a fresh thread, which then exits */
+static void* square_in_thread(void *arg) {
+    char *text = arg;
+    calc_bigint_t x = CALC_BIGINT_INIT;
+
+    calc_bigint_set_str(&x, "1000000000000000000000000000000000000000000000000000000000000");
+    calc_bigint_multiply(&x, &x, &x);
+    calc_bigint_multiply(&x, &x, &x);
+    calc_bigint_to_str(&x, text, 256);
+    calc_bigint_free(&x);
+    return NULL;     // No calc_bigint_release_scratch: freed at thread exit
+}
+
+static void test_scratch_of_exiting_threads(void **state) {
+    (void)state;
+    char text[4][256];
+    pthread_t threads[4];
+
+    for (int t = 0; t < 4; t++) {
+        assert_int_equal(pthread_create(&threads[t], NULL, square_in_thread, text[t]), 0);
+    }
+    for (int t = 0; t < 4; t++) {
+        pthread_join(threads[t], NULL);
+        assert_int_equal(strlen(text[t]), 241);     // 10^240
+        assert_int_equal(text[t][0], '1');
+        assert_int_equal(strspn(text[t] + 1, "0"), 240);
+    }
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_conversions),
+        cmocka_unit_test(test_small_against_int128),
+        cmocka_unit_test(test_known_values),
+        cmocka_unit_test(test_karatsuba_matches_schoolbook),
+        cmocka_unit_test(test_division_identity),
+        cmocka_unit_test(test_aliased_borrow_through_zero_limbs),
+        cmocka_unit_test(test_scratch_of_exiting_threads),
+    };
+
+    printf("\n========== CALC BIGINT MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc bigint tests", tests,
+                                       setup_numbers, teardown_numbers);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file test_calc_checked.c
+ * @brief Unit tests for calc checked (overflow detecting) module
+ *
+ * Demonstrates cmocka features:
+ * - assert_int_equal on enum status codes
+ * - assert_memory_equal to compare bitmaps
+ * - Parameterized tests with cmocka_unit_test_prestate
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-checked.h"
+#include "calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 203    /* Leaves a partial bitmap byte at the end */
+
+/*============================================================================
+ * Scalar checked functions
+ *===========================================================================*/
+
+static void test_add_checked(void **state) {
+    (void)state;
+    int r;
+
+    assert_int_equal(calc_add_checked(2, 3, &r), CALC_OK);
+    assert_int_equal(r, 5);
+    assert_int_equal(calc_add_checked(INT_MAX - 1, 1, &r), CALC_OK);
+    assert_int_equal(r, INT_MAX);
+    assert_int_equal(calc_add_checked(INT_MAX, 1, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(r, INT_MIN);
+    assert_int_equal(calc_add_checked(INT_MIN, -1, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(r, INT_MAX);
+}
+
+static void test_subtract_checked(void **state) {
+    (void)state;
+    int r;
+
+    assert_int_equal(calc_subtract_checked(5, 3, &r), CALC_OK);
+    assert_int_equal(r, 2);
+    assert_int_equal(calc_subtract_checked(-1, INT_MAX, &r), CALC_OK);
+    assert_int_equal(r, INT_MIN);
+    assert_int_equal(calc_subtract_checked(INT_MIN, 1, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_subtract_checked(0, INT_MIN, &r), CALC_ERR_OVERFLOW);
+}
+
+static void test_multiply_checked(void **state) {
+    (void)state;
+    int r;
+
+    assert_int_equal(calc_multiply_checked(-3, 4, &r), CALC_OK);
+    assert_int_equal(r, -12);
+    assert_int_equal(calc_multiply_checked(46341, 46340, &r), CALC_OK);
+    assert_int_equal(calc_multiply_checked(46341, 46341, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_multiply_checked(INT_MIN, -1, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_multiply_checked(INT_MIN, 1, &r), CALC_OK);
+    assert_int_equal(r, INT_MIN);
+}
+
+static void test_divide_checked(void **state) {
+    (void)state;
+    int r = 42;
+
+    assert_int_equal(calc_divide_checked(10, 3, &r), CALC_OK);
+    assert_int_equal(r, 3);
+    assert_int_equal(calc_divide_checked(10, 0, &r), CALC_ERR_DIV_BY_ZERO);
+    assert_int_equal(r, 0);
+    assert_int_equal(calc_divide_checked(INT_MIN, -1, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(r, INT_MIN);
+}
+
+/*============================================================================
+ * Batch variants: results and bitmaps match the scalar functions
+ *===========================================================================*/
+
+typedef calc_status_t (*checked_fn)(int a, int b, int *result);
+typedef size_t (*checked_batch_fn)(const int *a, const int *b, int *out,
+                                   unsigned char *flags, size_t n);
+
+struct checked_case {
+    const char *name;
+    checked_fn scalar;
+    checked_batch_fn batch;
+};
+
+static void fill_inputs(int *a, int *b, size_t n) {
+    static const int edges[] = { 0, 1, -1, 46341, -46341, INT_MAX, INT_MIN, INT_MAX / 2 + 1 };
+    uint32_t seed = 99u;
+
+    test_data_fill_pairs(a, b, n, &seed, edges, sizeof(edges) / sizeof(edges[0]));
+}
+
+static void test_checked_batch_matches_scalar(void **state) {
+    const struct checked_case *tc = (const struct checked_case *)*state;
+    int a[TEST_LEN];
+    int b[TEST_LEN];
+    int out[TEST_LEN];
+    unsigned char flags[CALC_BITMAP_BYTES(TEST_LEN)];
+    unsigned char expected_flags[CALC_BITMAP_BYTES(TEST_LEN)];
+
+    fill_inputs(a, b, TEST_LEN);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        size_t expected_count = 0;
+        memset(expected_flags, 0, sizeof(expected_flags));
+        memset(flags, 0xAA, sizeof(flags));
+
+        size_t count = tc->batch(a, b, out, flags, TEST_LEN);
+
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            int r;
+            if (tc->scalar(a[i], b[i], &r) != CALC_OK) {
+                expected_flags[i / 8] |= (unsigned char)(1u << (i % 8));
+                expected_count++;
+            }
+            assert_int_equal(out[i], r);
+        }
+        assert_int_equal(count, expected_count);
+        assert_memory_equal(flags, expected_flags, sizeof(flags));
+
+        // Without a bitmap only the count is returned
+        assert_int_equal(tc->batch(a, b, out, NULL, TEST_LEN), expected_count);
+    }
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+}
+
+static struct checked_case checked_cases[] = {
+    { "add", calc_add_checked, calc_add_checked_batch },
+    { "subtract", calc_subtract_checked, calc_subtract_checked_batch },
+    { "multiply", calc_multiply_checked, calc_multiply_checked_batch },
+    { "divide", calc_divide_checked, calc_divide_checked_batch },
+};
+
+static void test_checked_batch_no_overflow(void **state) {
+    (void)state;
+    const int a[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    const int b[10] = { 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+    int out[10];
+    unsigned char flags[CALC_BITMAP_BYTES(10)] = { 0xFF, 0xFF };
+
+    assert_int_equal(calc_add_checked_batch(a, b, out, flags, 10), 0);
+    assert_int_equal(flags[0], 0);
+    assert_int_equal(flags[1], 0);
+    for (int i = 0; i < 10; i++) {
+        assert_int_equal(out[i], 11);
+    }
+}
+
+static void test_checked_batch_bitmap_layout(void **state) {
+    (void)state;
+    int a[9] = { 0, INT_MAX, 0, 0, 0, 0, 0, 0, INT_MAX };
+    int b[9] = { 0, 1, 0, 0, 0, 0, 0, 0, 1 };
+    unsigned char flags[CALC_BITMAP_BYTES(9)];
+
+    // In place, overflow at elements 1 and 8: LSB-first bit order
+    assert_int_equal(calc_add_checked_batch(a, b, a, flags, 9), 2);
+    assert_int_equal(flags[0], 0x02);
+    assert_int_equal(flags[1], 0x01);
+    assert_int_equal(a[1], INT_MIN);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest scalar_tests[] = {
+        cmocka_unit_test(test_add_checked),
+        cmocka_unit_test(test_subtract_checked),
+        cmocka_unit_test(test_multiply_checked),
+        cmocka_unit_test(test_divide_checked),
+    };
+
+    // Parameterized tests using prestate
+    const struct CMUnitTest batch_tests[] = {
+        cmocka_unit_test_prestate(test_checked_batch_matches_scalar, &checked_cases[0]),
+        cmocka_unit_test_prestate(test_checked_batch_matches_scalar, &checked_cases[1]),
+        cmocka_unit_test_prestate(test_checked_batch_matches_scalar, &checked_cases[2]),
+        cmocka_unit_test_prestate(test_checked_batch_matches_scalar, &checked_cases[3]),
+        cmocka_unit_test(test_checked_batch_no_overflow),
+        cmocka_unit_test(test_checked_batch_bitmap_layout),
+    };
+
+    int result = 0;
+
+    printf("\n========== CALC CHECKED MODULE UNIT TESTS ==========\n\n");
+
+    result += cmocka_run_group_tests_name("checked scalar tests", scalar_tests, NULL, NULL);
+    result += cmocka_run_group_tests_name("checked batch tests", batch_tests, NULL, NULL);
+
+    return result;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_calc_divider.c
+ * @brief Unit tests for calc divider (invariant divisor) module
+ *
+ * Quotients from the precomputed divider must match calc_divide exactly,
+ * for every divisor class and every batch kernel.
+ *
+ * Demonstrates cmocka features:
+ * - Loops of assertions with a failure message (assert_int_equal + print_message)
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-divider.h"
+
+#define N_DIVIDENDS 512
+
+static int dividends[N_DIVIDENDS];
+
+/*============================================================================
+ * Helpers
+ *===========================================================================*/
+
+static void fill_dividends(void) {
+    static const int edges[] = {
+        0, 1, -1, 2, -2, 3, -3, 6, -6, 7, -7, 100, -100,
+        INT_MAX, INT_MIN, INT_MAX - 1, INT_MIN + 1, INT_MAX / 2, INT_MIN / 2,
+    };
+    const size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+    uint32_t seed = 7u;
+
+    for (size_t i = 0; i < N_DIVIDENDS; i++) {
+        if (i < n_edges) {
+            dividends[i] = edges[i];
+        } else {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            // Half full-range values, half small ones
+            dividends[i] = (i % 2) ? (int)seed : (int)(seed % 2001) - 1000;
+        }
+    }
+}
+
+/* calc_divide traps on INT_MIN / -1, the divider wraps */
+static int reference_divide(int a, int b) {
+    if (a == INT_MIN && b == -1) {
+        return INT_MIN;
+    }
+    return calc_divide(a, b);
+}
+
+static void check_divisor(int divisor) {
+    calc_divider_t d;
+    int out[N_DIVIDENDS];
+
+    calc_divider_init(&d, divisor);
+    assert_int_equal(d.divisor, divisor);
+
+    for (size_t i = 0; i < N_DIVIDENDS; i++) {
+        int expected = reference_divide(dividends[i], divisor);
+        int actual = calc_divider_divide(&d, dividends[i]);
+        if (actual != expected) {
+            print_message("%d / %d: expected %d, got %d\n", dividends[i], divisor, expected, actual);
+        }
+        assert_int_equal(actual, expected);
+    }
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        calc_divider_divide_batch(&d, dividends, out, N_DIVIDENDS);
+        for (size_t i = 0; i < N_DIVIDENDS; i++) {
+            assert_int_equal(out[i], reference_divide(dividends[i], divisor));
+        }
+    }
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+}
+
+static int group_setup(void **state) {
+    (void)state;
+    fill_dividends();
+    return 0;
+}
+
+/*============================================================================
+ * Divisor classes
+ *===========================================================================*/
+
+static void test_divider_by_zero(void **state) {
+    (void)state;
+    check_divisor(0);
+}
+
+static void test_divider_by_one(void **state) {
+    (void)state;
+    check_divisor(1);
+    check_divisor(-1);
+}
+
+static void test_divider_small_divisors(void **state) {
+    (void)state;
+    for (int divisor = -300; divisor <= 300; divisor++) {
+        check_divisor(divisor);
+    }
+}
+
+static void test_divider_powers_of_two(void **state) {
+    (void)state;
+    for (int k = 1; k < 31; k++) {
+        check_divisor(1 << k);
+        check_divisor(-(1 << k));
+    }
+    check_divisor(INT_MIN);
+}
+
+static void test_divider_large_divisors(void **state) {
+    (void)state;
+    static const int divisors[] = {
+        INT_MAX, INT_MAX - 1, INT_MIN + 1, 1000000007, -1000000007,
+        641, 6700417, 0x40000001, -0x40000001, 3 * 7 * 11 * 13 * 17 * 19,
+    };
+
+    for (size_t i = 0; i < sizeof(divisors) / sizeof(divisors[0]); i++) {
+        check_divisor(divisors[i]);
+    }
+}
+
+/*============================================================================
+ * Batch edge cases
+ *===========================================================================*/
+
+static void test_divider_batch_in_place(void **state) {
+    (void)state;
+    calc_divider_t d;
+    int a[19];
+
+    for (int i = 0; i < 19; i++) {
+        a[i] = i * 3;
+    }
+    calc_divider_init(&d, 3);
+    calc_divider_divide_batch(&d, a, a, 19);
+    for (int i = 0; i < 19; i++) {
+        assert_int_equal(a[i], i);
+    }
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest divider_tests[] = {
+        cmocka_unit_test(test_divider_by_zero),
+        cmocka_unit_test(test_divider_by_one),
+        cmocka_unit_test(test_divider_small_divisors),
+        cmocka_unit_test(test_divider_powers_of_two),
+        cmocka_unit_test(test_divider_large_divisors),
+        cmocka_unit_test(test_divider_batch_in_place),
+    };
+
+    printf("\n========== CALC DIVIDER MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("divider tests", divider_tests, group_setup, NULL);
+}
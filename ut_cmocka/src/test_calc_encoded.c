@@ -0,0 +1,317 @@
+/**
+ * @file test_calc_encoded.c
+ * @brief Unit tests for batch calc on run-length and dictionary encoded columns
+ *
+ * Every result is checked against calc_*_batch on the decoded columns, for
+ * each mix of plain, run-length and dictionary encoded operands and for
+ * plain and run-length encoded outputs.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers through state
+ * - assert_memory_equal() to compare result columns
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-encoded.h"
+#include "calc-batch.h"
+#include "multi-calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 700            /* Spans several internal chunks */
+#define DICT_SIZE 5
+
+/* One operand, available in every encoding */
+struct operand {
+    int rows[TEST_LEN];
+    int run_values[TEST_LEN];
+    uint32_t run_ends[TEST_LEN];
+    size_t runs;
+    int dict[DICT_SIZE];
+};
+
+struct encoded_buffers {
+    struct operand ops[4];
+    uint32_t indices[TEST_LEN];     /* Shared by every dictionary operand */
+    int expected[TEST_LEN];
+    int out[TEST_LEN];
+    int run_values[TEST_LEN];
+    uint32_t run_ends[TEST_LEN];
+};
+
+static int setup_buffers(void **state) {
+    static const int edges[] = { 0, 1, -1, INT_MAX, INT_MIN };
+    struct encoded_buffers *buf = test_malloc(sizeof(*buf));
+    uint32_t seed = 2024u;
+
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        uint32_t v = test_data_next(&seed);
+        // Runs of about 32 rows
+        buf->indices[i] = i == 0 || (v >> 24) < 8 ? (v >> 8) % DICT_SIZE : buf->indices[i - 1];
+    }
+    for (int k = 0; k < 4; k++) {
+        struct operand *op = &buf->ops[k];
+        calc_rle_buffer_t rle = { op->run_values, op->run_ends, TEST_LEN, 0 };
+        for (int e = 0; e < DICT_SIZE; e++) {
+            op->dict[e] = e < 2 ? edges[(k + e) % 5] : (k + 1) * (e - 3);
+        }
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            op->rows[i] = op->dict[(buf->indices[i] + (uint32_t)k * (i / 150)) % DICT_SIZE];
+        }
+        assert_int_equal(calc_rle_encode(op->rows, TEST_LEN, &rle), 0);
+        op->runs = rle.runs;
+    }
+    *state = buf;
+    return 0;
+}
+
+static int teardown_buffers(void **state) {
+    test_free(*state);
+    return 0;
+}
+
+/*
+ * Operand k as a column; a DICT column only matches rows for k == 0, other
+ * operands shift their entries every 150 rows
+ */
+static calc_column_t column_of(const struct encoded_buffers *buf, int k,
+                               calc_encoding_t encoding) {
+    const struct operand *op = &buf->ops[k];
+    calc_column_t col = { encoding, TEST_LEN, op->rows, 0, NULL, NULL };
+
+    if (encoding == CALC_COLUMN_RLE) {
+        col.values = op->run_values;
+        col.count = op->runs;
+        col.run_ends = op->run_ends;
+    } else if (encoding == CALC_COLUMN_DICT) {
+        col.values = op->dict;
+        col.count = DICT_SIZE;
+        col.indices = buf->indices;
+    }
+    return col;
+}
+
+/* Rows of a column, through the decoder */
+static void decode(const calc_column_t *col, int *rows) {
+    assert_int_equal(calc_column_decode(col, rows), 0);
+}
+
+/* Expand runs into expected-sized rows, checking they are well formed */
+static void expand_runs(const int *values, const uint32_t *run_ends, size_t runs, int *rows) {
+    uint32_t begin = 0;
+
+    for (size_t r = 0; r < runs; r++) {
+        assert_true(run_ends[r] > begin);
+        if (r > 0) {
+            // Equal neighbours are coalesced
+            assert_int_not_equal(values[r], values[r - 1]);
+        }
+        for (uint32_t i = begin; i < run_ends[r]; i++) {
+            rows[i] = values[r];
+        }
+        begin = run_ends[r];
+    }
+    assert_int_equal(begin, TEST_LEN);
+}
+
+static void (*const batch_ops[])(const int *, const int *, int *, size_t) = {
+    calc_add_batch, calc_subtract_batch, calc_multiply_batch, calc_divide_batch,
+};
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_encode_and_decode(void **state) {
+    struct encoded_buffers *buf = *state;
+    calc_column_t col;
+
+    for (int e = CALC_COLUMN_PLAIN; e <= CALC_COLUMN_RLE; e++) {
+        col = column_of(buf, 1, (calc_encoding_t)e);
+        decode(&col, buf->out);
+        assert_memory_equal(buf->out, buf->ops[1].rows, sizeof(buf->out));
+    }
+    col = column_of(buf, 0, CALC_COLUMN_DICT);
+    decode(&col, buf->out);
+    assert_memory_equal(buf->out, buf->ops[0].rows, sizeof(buf->out));
+
+    // A run per row at worst, none for no rows
+    calc_rle_buffer_t rle = { buf->run_values, buf->run_ends, buf->ops[1].runs - 1, 0 };
+    assert_int_equal(calc_rle_encode(buf->ops[1].rows, TEST_LEN, &rle), -1);
+    rle.capacity = 0;
+    assert_int_equal(calc_rle_encode(buf->ops[1].rows, 0, &rle), 0);
+    assert_int_equal(rle.runs, 0);
+}
+
+static void test_every_encoding_mix(void **state) {
+    struct encoded_buffers *buf = *state;
+    int a[TEST_LEN];
+    int b[TEST_LEN];
+
+    for (int ea = CALC_COLUMN_PLAIN; ea <= CALC_COLUMN_DICT; ea++) {
+        for (int eb = CALC_COLUMN_PLAIN; eb <= CALC_COLUMN_DICT; eb++) {
+            calc_column_t ca = column_of(buf, 0, (calc_encoding_t)ea);
+            calc_column_t cb = column_of(buf, 1, (calc_encoding_t)eb);
+            decode(&ca, a);
+            decode(&cb, b);
+            for (int op = CALC_ENCODED_ADD; op <= CALC_ENCODED_DIVIDE; op++) {
+                calc_rle_buffer_t rle = { buf->run_values, buf->run_ends, TEST_LEN, 0 };
+                batch_ops[op](a, b, buf->expected, TEST_LEN);
+
+                memset(buf->out, 0, sizeof(buf->out));
+                assert_int_equal(calc_encoded_batch((calc_encoded_op_t)op, &ca, &cb, buf->out), 0);
+                assert_memory_equal(buf->out, buf->expected, sizeof(buf->out));
+
+                assert_int_equal(calc_encoded_batch_rle((calc_encoded_op_t)op, &ca, &cb, &rle), 0);
+                expand_runs(rle.values, rle.run_ends, rle.runs, buf->out);
+                assert_memory_equal(buf->out, buf->expected, sizeof(buf->out));
+            }
+        }
+    }
+}
+
+static void test_run_output_capacity(void **state) {
+    struct encoded_buffers *buf = *state;
+    calc_column_t ca = column_of(buf, 2, CALC_COLUMN_RLE);
+    calc_column_t cb = column_of(buf, 3, CALC_COLUMN_RLE);
+    calc_rle_buffer_t rle = { buf->run_values, buf->run_ends, ca.count + cb.count, 0 };
+
+    // The documented bound holds, and results are coalesced below it
+    assert_int_equal(calc_encoded_batch_rle(CALC_ENCODED_ADD, &ca, &cb, &rle), 0);
+    assert_true(rle.runs < ca.count + cb.count);
+    rle.capacity = rle.runs - 1;
+    assert_int_equal(calc_encoded_batch_rle(CALC_ENCODED_ADD, &ca, &cb, &rle), -1);
+
+    // x - x is one run of zeros
+    rle.capacity = 1;
+    assert_int_equal(calc_encoded_batch_rle(CALC_ENCODED_SUBTRACT, &ca, &ca, &rle), 0);
+    assert_int_equal(rle.runs, 1);
+    assert_int_equal(rle.values[0], 0);
+    assert_int_equal(rle.run_ends[0], TEST_LEN);
+}
+
+static void test_dictionary_entries(void **state) {
+    struct encoded_buffers *buf = *state;
+    calc_column_t ca = column_of(buf, 0, CALC_COLUMN_DICT);
+    calc_column_t cb = column_of(buf, 1, CALC_COLUMN_DICT);
+    int constant_value = -7;
+    uint32_t constant_end = TEST_LEN;
+    calc_column_t constant = { CALC_COLUMN_RLE, TEST_LEN, &constant_value, 1, &constant_end, NULL };
+    int dict[DICT_SIZE];
+    uint32_t other_indices[TEST_LEN];
+    int expected[DICT_SIZE];
+
+    // Shared indices: entry by entry
+    for (int op = CALC_ENCODED_ADD; op <= CALC_ENCODED_DIVIDE; op++) {
+        batch_ops[op](buf->ops[0].dict, buf->ops[1].dict, expected, DICT_SIZE);
+        assert_int_equal(calc_encoded_batch_dict((calc_encoded_op_t)op, &ca, &cb, dict), 0);
+        assert_memory_equal(dict, expected, sizeof(dict));
+    }
+
+    // Dictionary and constant, either side; rows through the dictionary too
+    for (int e = 0; e < DICT_SIZE; e++) {
+        expected[e] = constant_value - buf->ops[0].dict[e];
+    }
+    assert_int_equal(calc_encoded_batch_dict(CALC_ENCODED_SUBTRACT, &constant, &ca, dict), 0);
+    assert_memory_equal(dict, expected, sizeof(dict));
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_SUBTRACT, &constant, &ca, buf->out), 0);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(buf->out[i], expected[buf->indices[i]]);
+    }
+
+    // Other shapes are refused, even equal indices in another array
+    calc_column_t plain = column_of(buf, 1, CALC_COLUMN_PLAIN);
+    calc_column_t runs = column_of(buf, 1, CALC_COLUMN_RLE);
+    memcpy(other_indices, buf->indices, sizeof(other_indices));
+    cb.indices = other_indices;
+    assert_int_equal(calc_encoded_batch_dict(CALC_ENCODED_ADD, &ca, &plain, dict), -1);
+    assert_int_equal(calc_encoded_batch_dict(CALC_ENCODED_ADD, &ca, &runs, dict), -1);
+    assert_int_equal(calc_encoded_batch_dict(CALC_ENCODED_ADD, &ca, &cb, dict), -1);
+}
+
+static void test_malformed_columns(void **state) {
+    struct encoded_buffers *buf = *state;
+    calc_column_t ca = column_of(buf, 0, CALC_COLUMN_RLE);
+    calc_column_t cb = column_of(buf, 1, CALC_COLUMN_PLAIN);
+    calc_rle_buffer_t rle = { buf->run_values, buf->run_ends, TEST_LEN, 0 };
+    uint32_t ends[3] = { 10, 10, TEST_LEN };
+    int values[3] = { 1, 2, 3 };
+
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        buf->out[i] = 0x5eed;
+    }
+    // Run ends not ascending, then not ending at the length
+    ca.values = values;
+    ca.run_ends = ends;
+    ca.count = 3;
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_ADD, &ca, &cb, buf->out), -1);
+    ends[1] = 20;
+    ends[2] = TEST_LEN - 1;
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_ADD, &ca, &cb, buf->out), -1);
+    assert_int_equal(calc_encoded_batch_rle(CALC_ENCODED_ADD, &ca, &cb, &rle), -1);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(buf->out[i], 0x5eed);
+    }
+    ends[2] = TEST_LEN;
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_ADD, &ca, &cb, buf->out), 0);
+
+    // Unknown encoding or op, different lengths
+    ca.encoding = (calc_encoding_t)42;
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_ADD, &ca, &cb, buf->out), -1);
+    ca = column_of(buf, 0, CALC_COLUMN_PLAIN);
+    assert_int_equal(calc_encoded_batch((calc_encoded_op_t)42, &ca, &cb, buf->out), -1);
+    cb.length--;
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_ADD, &ca, &cb, buf->out), -1);
+    assert_int_equal(calc_encoded_batch(CALC_ENCODED_ADD, NULL, &cb, buf->out), -1);
+}
+
+static void test_expression(void **state) {
+    struct encoded_buffers *buf = *state;
+    int rows[4][TEST_LEN];
+    calc_column_t cols[4];
+
+    // Each operand takes a different encoding in turn
+    for (int shift = 0; shift < 3; shift++) {
+        calc_rle_buffer_t rle = { buf->run_values, buf->run_ends, TEST_LEN, 0 };
+        for (int k = 0; k < 4; k++) {
+            cols[k] = column_of(buf, k, (calc_encoding_t)((k + shift) % 3));
+            decode(&cols[k], rows[k]);
+        }
+        multi_calc_expression_batch(rows[0], rows[1], rows[2], rows[3], buf->expected, TEST_LEN);
+
+        assert_int_equal(multi_calc_expression_encoded(&cols[0], &cols[1], &cols[2], &cols[3],
+                                                       buf->out), 0);
+        assert_memory_equal(buf->out, buf->expected, sizeof(buf->out));
+        assert_int_equal(multi_calc_expression_encoded_rle(&cols[0], &cols[1], &cols[2],
+                                                           &cols[3], &rle), 0);
+        expand_runs(rle.values, rle.run_ends, rle.runs, buf->out);
+        assert_memory_equal(buf->out, buf->expected, sizeof(buf->out));
+    }
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_encode_and_decode),
+        cmocka_unit_test(test_every_encoding_mix),
+        cmocka_unit_test(test_run_output_capacity),
+        cmocka_unit_test(test_dictionary_entries),
+        cmocka_unit_test(test_malformed_columns),
+        cmocka_unit_test(test_expression),
+    };
+
+    printf("\n========== CALC ENCODED MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc encoded tests", tests,
+                                       setup_buffers, teardown_buffers);
+}
@@ -0,0 +1,289 @@
+/**
+ * @file test_calc_expr.c
+ * @brief Unit tests for the calc-expr expression engine
+ *
+ * The formulas of multi_calc_expression and multi_calc_average must give
+ * the same wrapped results as the functions, on every instruction set and
+ * over several evaluation blocks.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test columns through state
+ * - assert_null / assert_non_null for compile failures
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-expr.h"
+#include "calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 1301   /* Over two evaluation blocks, plus a ragged tail */
+
+static const char *const abcd[] = { "a", "b", "c", "d" };
+
+struct expr_columns {
+    int col[4][TEST_LEN];
+    int out[TEST_LEN];
+};
+
+static int setup_columns(void **state) {
+    static const int edges[] = { 0, 1, -1, 3, INT_MAX, INT_MIN };
+    struct expr_columns *buf = test_malloc(sizeof(*buf));
+    uint32_t seed = 4242u;
+
+    for (int k = 0; k < 4; k++) {
+        // Mostly random values, some edge values to force overflow
+        test_data_fill_edges(buf->col[k], TEST_LEN, &seed, 0,
+                             edges, sizeof(edges) / sizeof(edges[0]), 1);
+    }
+    *state = buf;
+    return 0;
+}
+
+static int teardown_columns(void **state) {
+    test_free(*state);
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+    return 0;
+}
+
+static const int *const *columns_of(const struct expr_columns *buf) {
+    static const int *cols[4];
+    for (int k = 0; k < 4; k++) {
+        cols[k] = buf->col[k];
+    }
+    return cols;
+}
+
+/*
+ * References in wrapping unsigned arithmetic: the random columns overflow,
+ * and calling the signed calc_* functions on them would be undefined
+ */
+static int ref_expression(int a, int b, int c, int d) {
+                          return (int)(((unsigned)a + (unsigned)b) * ((unsigned)c - (unsigned)d));
+}
+
+static int ref_average(int a, int b, int c) {
+    return (int)((unsigned)a + (unsigned)b + (unsigned)c) / 3;
+}
+
+static calc_expr_t *compile_ok(const char *source) {
+    calc_expr_t *expr = calc_expr_compile(source, abcd, 4, NULL);
+    assert_non_null(expr);
+    return expr;
+}
+
+static int eval_const(const char *source) {
+    calc_expr_t *expr = compile_ok(source);
+    int result = calc_expr_eval(expr, NULL);
+    calc_expr_free(expr);
+    return result;
+}
+
+static size_t compile_error(const char *source) {
+    size_t pos = (size_t)-1;
+    assert_null(calc_expr_compile(source, abcd, 4, &pos));
+    return pos;
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_expression_formula_matches(void **state) {
+    struct expr_columns *buf = *state;
+    calc_expr_t *expr = compile_ok("(a + b) * (c - d)");
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t n = 0; n <= TEST_LEN; n += n < 40 ? 1 : 97) {
+            assert_int_equal(calc_expr_eval_batch(expr, columns_of(buf), buf->out, n), 0);
+            for (size_t i = 0; i < n; i++) {
+                assert_int_equal(buf->out[i],
+                                 ref_expression(buf->col[0][i], buf->col[1][i],
+                                                buf->col[2][i], buf->col[3][i]));
+            }
+        }
+    }
+    calc_expr_free(expr);
+}
+
+static void test_average_formula_matches(void **state) {
+    struct expr_columns *buf = *state;
+    calc_expr_t *expr = compile_ok("(a + b + c) / 3");
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        assert_int_equal(calc_expr_eval_batch(expr, columns_of(buf), buf->out, TEST_LEN), 0);
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(buf->out[i],
+                             ref_average(buf->col[0][i], buf->col[1][i], buf->col[2][i]));
+        }
+    }
+    calc_expr_free(expr);
+}
+
+static void test_single_row_matches_batch(void **state) {
+    struct expr_columns *buf = *state;
+    calc_expr_t *expr = compile_ok("-a * (b - -c) / (d + 7) - 2 * (a / b)");
+
+    assert_int_equal(calc_expr_eval_batch(expr, columns_of(buf), buf->out, TEST_LEN), 0);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        int row[4] = { buf->col[0][i], buf->col[1][i], buf->col[2][i], buf->col[3][i] };
+        assert_int_equal(calc_expr_eval(expr, row), buf->out[i]);
+    }
+    calc_expr_free(expr);
+}
+
+static void test_precedence_and_unary(void **state) {
+    (void)state;
+    assert_int_equal(eval_const("2 + 3 * 4"), 14);
+    assert_int_equal(eval_const("(2 + 3) * 4"), 20);
+    assert_int_equal(eval_const("20 - 6 - 4"), 10);
+    assert_int_equal(eval_const("100 / 10 / 5"), 2);
+    assert_int_equal(eval_const("-7 / 2"), -3);
+    assert_int_equal(eval_const("--5"), 5);
+    assert_int_equal(eval_const("2 * -3"), -6);
+}
+
+/* Constants and variables in either order, at a = 1, b = 5, c = -2, d = 7 */
+static const struct {
+    const char *source;
+    int expected;
+} mixed_cases[] = {
+    { "10 - b * 3", -5 },
+    { "10 * (b + 1)", 60 },
+    { "10 - -b", 15 },
+    { "1 - (2 - b)", 4 },
+    { "(3 - a) * (b + 4) - 100 / d", 4 },
+    { "2 * c + 8 * (a - 6 * b)", -236 },
+};
+
+static void test_constants_and_variables_mixed(void **state) {
+    (void)state;
+    enum { ROWS = 19 };
+    static const int values[4] = { 1, 5, -2, 7 };
+    int col[4][ROWS];
+    int out[ROWS];
+    const int *cols[4];
+
+    for (int k = 0; k < 4; k++) {
+        for (size_t i = 0; i < ROWS; i++) {
+            col[k][i] = values[k];
+        }
+        cols[k] = col[k];
+    }
+    for (size_t t = 0; t < sizeof(mixed_cases) / sizeof(mixed_cases[0]); t++) {
+        calc_expr_t *expr = compile_ok(mixed_cases[t].source);
+
+        assert_int_equal(calc_expr_eval(expr, values), mixed_cases[t].expected);
+        for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+            if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+                continue;
+            }
+            assert_int_equal(calc_expr_eval_batch(expr, cols, out, ROWS), 0);
+            for (size_t i = 0; i < ROWS; i++) {
+                assert_int_equal(out[i], mixed_cases[t].expected);
+            }
+        }
+        calc_expr_free(expr);
+    }
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+}
+
+static void test_division_and_overflow(void **state) {
+    (void)state;
+    assert_int_equal(eval_const("7 / 0"), 0);
+    assert_int_equal(eval_const("2147483647 + 1"), INT_MIN);
+    assert_int_equal(eval_const("(-2147483647 - 1) / -1"), INT_MIN);
+    assert_int_equal(eval_const("65536 * 65536"), 0);
+}
+
+static void test_lone_operand(void **state) {
+    struct expr_columns *buf = *state;
+    calc_expr_t *var = compile_ok(" ( c ) ");
+    calc_expr_t *num = compile_ok("6 * 7");
+    int row[4] = { 1, 2, 3, 4 };
+
+    assert_int_equal(calc_expr_eval_batch(var, columns_of(buf), buf->out, TEST_LEN), 0);
+    assert_memory_equal(buf->out, buf->col[2], sizeof(buf->out));
+    assert_int_equal(calc_expr_eval(var, row), 3);
+
+    assert_int_equal(calc_expr_eval_batch(num, columns_of(buf), buf->out, TEST_LEN), 0);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(buf->out[i], 42);
+    }
+    calc_expr_free(var);
+    calc_expr_free(num);
+}
+
+static void test_output_aliases_column(void **state) {
+    struct expr_columns *buf = *state;
+    calc_expr_t *expr = compile_ok("(a + b) * (c - d)");
+    static int copy[TEST_LEN];
+    const int *cols[4] = { buf->col[0], buf->col[1], copy, buf->col[3] };
+
+    memcpy(copy, buf->col[2], sizeof(copy));
+    // Results overwrite the c column in place
+    assert_int_equal(calc_expr_eval_batch(expr, cols, copy, TEST_LEN), 0);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(copy[i],
+                         ref_expression(buf->col[0][i], buf->col[1][i],
+                                        buf->col[2][i], buf->col[3][i]));
+    }
+    calc_expr_free(expr);
+}
+
+static void test_compile_errors(void **state) {
+    char deep[600];
+    (void)state;
+
+    assert_int_equal(compile_error("a + e"), 4);
+    assert_int_equal(compile_error("a + b c"), 6);
+    assert_int_equal(compile_error("1 + 2147483648"), 4);
+    assert_int_equal(compile_error("(a + b"), 6);
+    assert_int_equal(compile_error("a * )"), 4);
+    assert_int_equal(compile_error(""), 0);
+    assert_int_equal(compile_error("ab"), 0);
+
+    memset(deep, '(', sizeof(deep) - 2);
+    deep[sizeof(deep) - 2] = 'a';
+    deep[sizeof(deep) - 1] = '\0';
+    assert_int_equal(compile_error(deep), 256);
+
+    assert_null(calc_expr_compile("a", abcd, CALC_EXPR_MAX_VARS + 1, NULL));
+    calc_expr_free(NULL);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_expression_formula_matches),
+        cmocka_unit_test(test_average_formula_matches),
+        cmocka_unit_test(test_single_row_matches_batch),
+        cmocka_unit_test(test_precedence_and_unary),
+        cmocka_unit_test(test_constants_and_variables_mixed),
+        cmocka_unit_test(test_division_and_overflow),
+        cmocka_unit_test(test_lone_operand),
+        cmocka_unit_test(test_output_aliases_column),
+        cmocka_unit_test(test_compile_errors),
+    };
+
+    printf("\n========== CALC EXPR MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc expr tests", tests,
+                                       setup_columns, teardown_columns);
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_calc_group.c
+ * @brief Unit tests for the hash group-by aggregator
+ *
+ * Aggregates are checked against a reference computed by sorting the rows
+ * by key, in the single-table and the partitioned mode, with one and with
+ * several calc-pool threads.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers through state
+ * - Per-test teardown restoring the calc-pool thread count
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-group.h"
+#include "calc-pool.h"
+#include "multi-calc.h"
+#include "test_data.h"
+
+#define TEST_ROWS (3 * CALC_GROUP_PARTITION_MIN)   /* Takes the partitioned path */
+
+struct group_buffers {
+    int keys[TEST_ROWS];
+    int values[TEST_ROWS];
+    int sorted_keys[TEST_ROWS];
+    int sorted_values[TEST_ROWS];
+    calc_group_result_t results[TEST_ROWS];
+};
+
+static int setup_buffers(void **state) {
+    *state = test_malloc(sizeof(struct group_buffers));
+    return 0;
+}
+
+static int teardown_buffers(void **state) {
+    test_free(*state);
+    return 0;
+}
+
+static int reset_threads(void **state) {
+    (void)state;
+    calc_pool_set_threads(1);
+    return 0;
+}
+
+/* Keys among `distinct` values spread over the whole int range */
+static void make_rows(struct group_buffers *buf, size_t n, uint32_t distinct, uint32_t seed) {
+    static const int edges[] = { 0, 1, -1, INT_MAX, INT_MIN };
+    const size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+
+    for (size_t i = 0; i < n; i++) {
+        buf->keys[i] = (int)((test_data_next(&seed) >> 8) % distinct * 2654435761u);
+        buf->values[i] = test_data_int_or_edge(&seed, 1000, edges, n_edges, 2);
+    }
+}
+
+static int compare_pairs(const void *x, const void *y) {
+    const int *a = x, *b = y;
+    return (a[0] > b[0]) - (a[0] < b[0]);
+}
+
+static int compare_results(const void *x, const void *y) {
+    const calc_group_result_t *a = x, *b = y;
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+/*
+ * Every group of the first n rows must be found with the aggregates of
+ * its sorted run of values; returns the number of groups
+ */
+static size_t check_groups(struct group_buffers *buf, const calc_group_t *group, size_t n) {
+    int (*pairs)[2] = malloc(n * sizeof(*pairs));
+    size_t groups = 0;
+
+    assert_non_null(pairs);
+    for (size_t i = 0; i < n; i++) {
+        pairs[i][0] = buf->keys[i];
+        pairs[i][1] = buf->values[i];
+    }
+    qsort(pairs, n, sizeof(*pairs), compare_pairs);
+    for (size_t i = 0; i < n; i++) {
+        buf->sorted_keys[i] = pairs[i][0];
+        buf->sorted_values[i] = pairs[i][1];
+    }
+    free(pairs);
+
+    for (size_t begin = 0, end; begin < n; begin = end, groups++) {
+        calc_group_result_t r;
+        int64_t sum = 0;
+        int lo = INT_MAX, hi = INT_MIN;
+
+        for (end = begin; end < n && buf->sorted_keys[end] == buf->sorted_keys[begin]; end++) {
+            sum += buf->sorted_values[end];
+            lo = buf->sorted_values[end] < lo ? buf->sorted_values[end] : lo;
+            hi = buf->sorted_values[end] > hi ? buf->sorted_values[end] : hi;
+        }
+        assert_int_equal(calc_group_find(group, buf->sorted_keys[begin], &r), 0);
+        assert_int_equal(r.key, buf->sorted_keys[begin]);
+        assert_int_equal(r.count, end - begin);
+        assert_int_equal(r.sum, sum);
+        assert_int_equal(r.min, lo);
+        assert_int_equal(r.max, hi);
+        // Same average as sorting and calling multi_calc_average_n per group
+        assert_int_equal(r.average, multi_calc_average_n(buf->sorted_values + begin, end - begin));
+    }
+    assert_int_equal(calc_group_size(group), groups);
+    return groups;
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_small_groups(void **state) {
+    struct group_buffers *buf = *state;
+    static const int keys[] = { 7, -7, 7, INT_MIN, 7, INT_MAX, -7 };
+    static const int values[] = { 1, -3, 2, INT_MIN, -4, INT_MAX, 0 };
+    calc_group_t *group = calc_group_create(0, 0);
+    calc_group_result_t r;
+
+    assert_non_null(group);
+    assert_int_equal(calc_group_find(group, 7, &r), -1);
+    assert_int_equal(calc_group_add_batch(group, keys, values, 7), 0);
+    assert_int_equal(calc_group_size(group), 4);
+
+    assert_int_equal(calc_group_find(group, 7, &r), 0);
+    assert_int_equal(r.count, 3);
+    assert_int_equal(r.sum, -1);
+    assert_int_equal(r.min, -4);
+    assert_int_equal(r.max, 2);
+    assert_int_equal(r.average, 0);     // -1 / 3 truncates toward zero
+    assert_int_equal(calc_group_find(group, -7, &r), 0);
+    assert_int_equal(r.average, -1);    // -3 / 2
+    assert_int_equal(calc_group_find(group, INT_MIN, &r), 0);
+    assert_int_equal(r.average, INT_MIN);
+    assert_int_equal(calc_group_find(group, 8, &r), -1);
+
+    assert_int_equal(calc_group_results(group, buf->results), 4);
+    calc_group_clear(group);
+    assert_int_equal(calc_group_size(group), 0);
+    assert_int_equal(calc_group_find(group, 7, &r), -1);
+    calc_group_destroy(group);
+    calc_group_destroy(NULL);
+
+    assert_null(calc_group_create(0, CALC_GROUP_MAX_PARTITIONS + 1));
+}
+
+static void test_growth_and_batches(void **state) {
+    struct group_buffers *buf = *state;
+    calc_group_t *group = calc_group_create(1, 0);
+
+    // Tables grow far past the expected size; batches accumulate
+    make_rows(buf, 20000, 5000, 1u);
+    assert_int_equal(calc_group_add_batch(group, buf->keys, buf->values, 7000), 0);
+    assert_int_equal(calc_group_add_batch(group, buf->keys + 7000, buf->values + 7000, 13000), 0);
+    size_t groups = check_groups(buf, group, 20000);
+    assert_true(groups > 4000);
+
+    // Every key once from calc_group_results
+    assert_int_equal(calc_group_results(group, buf->results), groups);
+    qsort(buf->results, groups, sizeof(buf->results[0]), compare_results);
+    for (size_t i = 1; i < groups; i++) {
+        assert_true(buf->results[i - 1].key < buf->results[i].key);
+    }
+    calc_group_destroy(group);
+}
+
+static void test_partitioned(void **state) {
+    struct group_buffers *buf = *state;
+    static const uint32_t cardinalities[] = { 3, 1000, TEST_ROWS };
+    static const unsigned threads[] = { 1, 4 };
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        calc_pool_set_threads(threads[t]);
+        for (size_t c = 0; c < sizeof(cardinalities) / sizeof(cardinalities[0]); c++) {
+            calc_group_t *group = calc_group_create(cardinalities[c], 7);
+            assert_non_null(group);
+            make_rows(buf, TEST_ROWS, cardinalities[c], 2u + (uint32_t)c);
+            // A partitioned batch followed by a short one on the row path
+            assert_int_equal(calc_group_add_batch(group, buf->keys, buf->values,
+                                                  TEST_ROWS - 100), 0);
+            assert_int_equal(calc_group_add_batch(group, buf->keys + TEST_ROWS - 100,
+                                                  buf->values + TEST_ROWS - 100, 100), 0);
+            check_groups(buf, group, TEST_ROWS);
+            calc_group_destroy(group);
+        }
+    }
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_small_groups),
+        cmocka_unit_test(test_growth_and_batches),
+        cmocka_unit_test_teardown(test_partitioned, reset_threads),
+    };
+
+    printf("\n========== CALC GROUP MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc group tests", tests,
+                                       setup_buffers, teardown_buffers);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_calc_inline.c
+ * @brief Unit tests for the calc inline fast path
+ *
+ * This file is built with CALC_INLINE and linked with --wrap=calc_*:
+ * - Inlined calls give the same results as the exported functions
+ * - Inlined calls never reach the __wrap_xxx functions
+ * - (calc_xxx)(...) and code built without CALC_INLINE (libsdk for unit
+ *   tests) still call the exported functions, so mocking keeps working
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#define CALC_INLINE
+#include "calc.h"
+#include "multi-calc.h"
+
+/*============================================================================
+ * Wrapped functions: count the calls that reach the linker symbols
+ *===========================================================================*/
+
+extern int __real_calc_add(int a, int b);
+extern int __real_calc_subtract(int a, int b);
+extern int __real_calc_multiply(int a, int b);
+extern int __real_calc_divide(int a, int b);
+
+static int wrapped_calls;
+
+int __wrap_calc_add(int a, int b) {
+    wrapped_calls++;
+    return __real_calc_add(a, b);
+}
+
+int __wrap_calc_subtract(int a, int b) {
+    wrapped_calls++;
+    return __real_calc_subtract(a, b);
+}
+
+int __wrap_calc_multiply(int a, int b) {
+    wrapped_calls++;
+    return __real_calc_multiply(a, b);
+}
+
+int __wrap_calc_divide(int a, int b) {
+    wrapped_calls++;
+    return __real_calc_divide(a, b);
+}
+
+static int reset_calls(void **state) {
+    (void)state;
+    wrapped_calls = 0;
+    return 0;
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_inline_matches_exported(void **state) {
+    (void)state;
+    static const int values[] = { 0, 1, -1, 7, -7, 46340, INT_MAX, INT_MIN + 1 };
+    const size_t n = sizeof(values) / sizeof(values[0]);
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            int a = values[i];
+            int b = values[j];
+            // Skip the combinations that overflow (undefined in both versions)
+            if (!((b > 0 && a > INT_MAX - b) || (b < 0 && a < INT_MIN - b))) {
+                assert_int_equal(calc_add(a, b), __real_calc_add(a, b));
+            }
+            if (!((b < 0 && a > INT_MAX + b) || (b > 0 && a < INT_MIN + b))) {
+                assert_int_equal(calc_subtract(a, b), __real_calc_subtract(a, b));
+            }
+            assert_int_equal(calc_divide(a, b), __real_calc_divide(a, b));
+        }
+    }
+    assert_int_equal(calc_multiply(46340, -46340), __real_calc_multiply(46340, -46340));
+    assert_int_equal(calc_divide(5, 0), 0);
+}
+
+static void test_inline_bypasses_wrap(void **state) {
+    (void)state;
+
+    assert_int_equal(calc_add(2, 3), 5);
+    assert_int_equal(calc_subtract(2, 3), -1);
+    assert_int_equal(calc_multiply(2, 3), 6);
+    assert_int_equal(calc_divide(7, 2), 3);
+    assert_int_equal(wrapped_calls, 0);
+}
+
+static void test_parenthesized_call_uses_symbol(void **state) {
+    (void)state;
+    int (*fn)(int, int) = calc_add;
+
+    // No function-like macro expansion: these are real calls
+    assert_int_equal((calc_add)(2, 3), 5);
+    assert_int_equal((calc_divide)(7, 0), 0);
+    assert_int_equal(fn(4, 5), 9);
+    assert_int_equal(wrapped_calls, 3);
+}
+
+static void test_library_calls_stay_wrapped(void **state) {
+    (void)state;
+
+    // libsdk is built without CALC_INLINE for the unit tests
+    assert_int_equal(multi_calc_expression(1, 2, 5, 3), 6);
+    assert_int_equal(wrapped_calls, 3);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_inline_matches_exported, reset_calls),
+        cmocka_unit_test_setup(test_inline_bypasses_wrap, reset_calls),
+        cmocka_unit_test_setup(test_parenthesized_call_uses_symbol, reset_calls),
+        cmocka_unit_test_setup(test_library_calls_stay_wrapped, reset_calls),
+    };
+
+    printf("\n========== CALC INLINE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc inline tests", tests, NULL, NULL);
+}
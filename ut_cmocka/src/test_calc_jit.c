@@ -0,0 +1,278 @@
+/**
+ * @file test_calc_jit.c
+ * @brief Unit tests for the calc-jit native expression compiler
+ *
+ * Generated code must agree with the calc-expr interpreter on every row,
+ * including division by zero and INT_MIN / -1, and must fall back to the
+ * interpreter when native code cannot be used.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test columns through state
+ * - skip() when the CPU has no AVX2
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-jit.h"
+#include "calc-expr.h"
+#include "calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 1003   /* Not a multiple of 8: exercises the scalar tail */
+
+static const char *const abcd[] = { "a", "b", "c", "d" };
+
+static const char *const formulas[] = {
+    "(a + b) * (c - d)",
+    "(a + b + c) / 3",
+    "a / b",
+    "-a * (b - -c) / (d + 7) - 2 * (a / b)",
+    "(a - 5) / (b / (c + 1)) / -d",
+};
+
+struct jit_columns {
+    int col[4][TEST_LEN];
+    int out[TEST_LEN];
+    int expected[TEST_LEN];
+};
+
+static void fill_columns(struct jit_columns *buf) {
+    static const int edges[] = { 0, 1, -1, 3, INT_MAX, INT_MIN };
+    uint32_t seed = 9001u;
+
+    for (int k = 0; k < 4; k++) {
+        // Many edge values: zero divisors and INT_MIN / -1 in every block
+        test_data_fill_edges(buf->col[k], TEST_LEN, &seed, 0,
+                             edges, sizeof(edges) / sizeof(edges[0]), 6);
+    }
+}
+
+static int setup_columns(void **state) {
+    struct jit_columns *buf = test_malloc(sizeof(*buf));
+
+    fill_columns(buf);
+    *state = buf;
+    return 0;
+}
+
+static int teardown_columns(void **state) {
+    test_free(*state);
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+    return 0;
+}
+
+/* Selects the best vector instruction set before each test */
+static int reset_isa(void **state) {
+    (void)state;
+    if (calc_batch_set_isa(CALC_ISA_AVX512) != 0) {
+        calc_batch_set_isa(CALC_ISA_AVX2);
+    }
+    return 0;
+}
+
+static const int *const *columns_of(const struct jit_columns *buf) {
+    static const int *cols[4];
+    for (int k = 0; k < 4; k++) {
+        cols[k] = buf->col[k];
+    }
+    return cols;
+}
+
+/*
+ * multi_calc_expression in wrapping unsigned arithmetic: the random columns
+ * overflow, and calling the signed calc_* functions on them would be
+ * undefined
+ */
+static int ref_expression(int a, int b, int c, int d) {
+                          return (int)(((unsigned)a + (unsigned)b) * ((unsigned)c - (unsigned)d));
+}
+
+/* Compile with both engines and compare the first n rows */
+static void check_formula(struct jit_columns *buf, const char *source, size_t n,
+                          int expect_native) {
+    calc_jit_t *jit = calc_jit_compile(source, abcd, 4, NULL);
+    calc_expr_t *expr = calc_expr_compile(source, abcd, 4, NULL);
+
+    assert_non_null(jit);
+    assert_non_null(expr);
+    if (expect_native >= 0) {
+        assert_int_equal(calc_jit_is_native(jit), expect_native);
+    }
+    assert_int_equal(calc_expr_eval_batch(expr, columns_of(buf), buf->expected, n), 0);
+    assert_int_equal(calc_jit_eval_batch(jit, columns_of(buf), buf->out, n), 0);
+    assert_memory_equal(buf->out, buf->expected, n * sizeof(int));
+    calc_jit_free(jit);
+    calc_expr_free(expr);
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_native_matches_interpreter(void **state) {
+    struct jit_columns *buf = *state;
+
+    if (calc_batch_isa() < CALC_ISA_AVX2) {
+        skip();
+    }
+    for (size_t f = 0; f < sizeof(formulas) / sizeof(formulas[0]); f++) {
+        for (size_t n = 0; n <= 20; n++) {
+            check_formula(buf, formulas[f], n, 1);
+        }
+        check_formula(buf, formulas[f], TEST_LEN, 1);
+    }
+}
+
+static void test_matches_multi_calc(void **state) {
+    struct jit_columns *buf = *state;
+    calc_jit_t *jit = calc_jit_compile("(a + b) * (c - d)", abcd, 4, NULL);
+
+    assert_non_null(jit);
+    assert_int_equal(calc_jit_eval_batch(jit, columns_of(buf), buf->out, TEST_LEN), 0);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(buf->out[i],
+                         ref_expression(buf->col[0][i], buf->col[1][i],
+                                        buf->col[2][i], buf->col[3][i]));
+    }
+    calc_jit_free(jit);
+}
+
+static void test_division_edges(void **state) {
+    struct jit_columns *buf = *state;
+    static const int a[8] = { INT_MIN, INT_MIN, 7, -7, INT_MAX, 0, -1, 5 };
+    static const int b[8] = { -1, 1, 0, 2, -1, 0, INT_MIN, -2 };
+    static const int expected[8] = { INT_MIN, INT_MIN, 0, -3, -INT_MAX, 0, 0, -2 };
+    const int *cols[2] = { a, b };
+    calc_jit_t *jit = calc_jit_compile("a / b", abcd, 2, NULL);
+
+    (void)buf;
+    assert_non_null(jit);
+    assert_int_equal(calc_jit_eval_batch(jit, cols, buf->out, 8), 0);
+    assert_memory_equal(buf->out, expected, sizeof(expected));
+    calc_jit_free(jit);
+}
+
+/* Constants and variables in either order, at a = 1, b = 5, c = -2, d = 7 */
+static void test_constants_and_variables_mixed(void **state) {
+    struct jit_columns *buf = *state;
+    static const struct {
+        const char *source;
+        int expected;
+    } cases[] = {
+        { "10 - b * 3", -5 },
+        { "10 * (b + 1)", 60 },
+        { "10 - -b", 15 },
+        { "1 - (2 - b)", 4 },
+        { "(3 - a) * (b + 4) - 100 / d", 4 },
+        { "2 * c + 8 * (a - 6 * b)", -236 },
+    };
+    static const int values[4] = { 1, 5, -2, 7 };
+    const calc_isa_t isas[2] = { calc_batch_isa(), CALC_ISA_SSE2 };   // Native, fallback
+
+    for (int k = 0; k < 4; k++) {
+        for (size_t i = 0; i < 19; i++) {
+            buf->col[k][i] = values[k];
+        }
+    }
+    for (size_t t = 0; t < sizeof(cases) / sizeof(cases[0]); t++) {
+        for (int v = 0; v < 2; v++) {
+            calc_jit_t *jit;
+
+            calc_batch_set_isa(isas[v]);
+            jit = calc_jit_compile(cases[t].source, abcd, 4, NULL);
+            assert_non_null(jit);
+            // 19 rows: full vectors plus the scalar tail
+            assert_int_equal(calc_jit_eval_batch(jit, columns_of(buf), buf->out, 19), 0);
+            for (size_t i = 0; i < 19; i++) {
+                assert_int_equal(buf->out[i], cases[t].expected);
+            }
+            calc_jit_free(jit);
+        }
+    }
+    fill_columns(buf);
+}
+
+static void test_falls_back_without_avx2(void **state) {
+    struct jit_columns *buf = *state;
+
+    calc_batch_set_isa(CALC_ISA_SSE2);
+    check_formula(buf, formulas[3], TEST_LEN, 0);
+}
+
+static void test_falls_back_for_deep_expressions(void **state) {
+    struct jit_columns *buf = *state;
+    char source[256] = "";
+
+    // (b - c) * ((b - c) * (... a)): each level holds a register, 12 in all
+    for (int level = 0; level < 12; level++) {
+        strcat(source, "(b - c) * (");
+    }
+    strcat(source, "a");
+    for (int level = 0; level < 12; level++) {
+        strcat(source, ")");
+    }
+    check_formula(buf, source, TEST_LEN, 0);
+}
+
+static void test_lone_operand_and_aliasing(void **state) {
+    struct jit_columns *buf = *state;
+    calc_jit_t *jit = calc_jit_compile("d", abcd, 4, NULL);
+    static int copy[TEST_LEN];
+    const int *cols[4];
+
+    assert_non_null(jit);
+    assert_int_equal(calc_jit_eval_batch(jit, columns_of(buf), buf->out, TEST_LEN), 0);
+    assert_memory_equal(buf->out, buf->col[3], sizeof(buf->out));
+    calc_jit_free(jit);
+
+    // Results overwrite the a column in place
+    jit = calc_jit_compile("(a + b) * (c - d)", abcd, 4, NULL);
+    memcpy(copy, buf->col[0], sizeof(copy));
+    memcpy(cols, columns_of(buf), sizeof(cols));
+    cols[0] = copy;
+    assert_int_equal(calc_jit_eval_batch(jit, cols, copy, TEST_LEN), 0);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(copy[i],
+                         ref_expression(buf->col[0][i], buf->col[1][i],
+                                        buf->col[2][i], buf->col[3][i]));
+    }
+    calc_jit_free(jit);
+}
+
+static void test_compile_errors(void **state) {
+    size_t pos = 0;
+    (void)state;
+
+    assert_null(calc_jit_compile("a + x", abcd, 4, &pos));
+    assert_int_equal(pos, 4);
+    calc_jit_free(NULL);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_native_matches_interpreter, reset_isa),
+        cmocka_unit_test_setup(test_matches_multi_calc, reset_isa),
+        cmocka_unit_test_setup(test_division_edges, reset_isa),
+        cmocka_unit_test_setup(test_constants_and_variables_mixed, reset_isa),
+        cmocka_unit_test_setup(test_falls_back_without_avx2, reset_isa),
+        cmocka_unit_test_setup(test_falls_back_for_deep_expressions, reset_isa),
+        cmocka_unit_test_setup(test_lone_operand_and_aliasing, reset_isa),
+        cmocka_unit_test(test_compile_errors),
+    };
+
+    printf("\n========== CALC JIT MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc jit tests", tests,
+                                       setup_columns, teardown_columns);
+}
@@ -0,0 +1,223 @@
+/**
+ * @file test_calc_linalg.c
+ * @brief Unit tests for the integer vector and matrix kernels
+ *
+ * Every kernel is checked against a 128-bit reference on random data, for
+ * every instruction set the CPU supports, including sums whose partial
+ * values leave the int64_t range and results that do not fit.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers through state
+ * - Running the same checks for every instruction set
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-linalg.h"
+#include "calc-batch.h"
+#include "test_data.h"
+
+#define MAX_DIM 300             /* Largest matrix side used below */
+
+struct linalg_buffers {
+    int a[MAX_DIM * MAX_DIM];
+    int b[MAX_DIM * MAX_DIM];
+    int64_t c[MAX_DIM * MAX_DIM];
+    int64_t y[MAX_DIM];
+};
+
+static int setup_buffers(void **state) {
+    *state = test_malloc(sizeof(struct linalg_buffers));
+    return 0;
+}
+
+static int teardown_buffers(void **state) {
+    test_free(*state);
+    return 0;
+}
+
+/* Exact dot product of a row with a column of stride ints */
+static __int128 reference_dot(const int *a, const int *b, size_t stride, size_t n) {
+    __int128 sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += (int64_t)a[i] * b[i * stride];
+    }
+    return sum;
+}
+
+static int fits_i64(__int128 v) {
+    return v >= INT64_MIN && v <= INT64_MAX;
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_dot(void **state) {
+    struct linalg_buffers *buf = *state;
+    calc_isa_t detected = calc_batch_isa();
+    static const size_t lengths[] = { 0, 1, 7, 16, 203, 1000 };
+    int64_t r;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            size_t n = lengths[l];
+            uint32_t seed = 1u + (uint32_t)n;
+            test_data_fill(buf->a, n, &seed, 0);
+            test_data_fill(buf->b, n, &seed, 0);
+            __int128 expected = reference_dot(buf->a, buf->b, 1, n);
+            calc_status_t status = calc_dot(buf->a, buf->b, n, &r);
+            assert_int_equal(status, fits_i64(expected) ? CALC_OK : CALC_ERR_OVERFLOW);
+            assert_true(r == (int64_t)(uint64_t)(unsigned __int128)expected);
+        }
+
+        // Partial sums reach 100 * 2^62 but the result fits
+        for (size_t i = 0; i < 200; i++) {
+            buf->a[i] = INT_MIN;
+            buf->b[i] = i < 100 ? INT_MIN : INT_MAX;
+        }
+        assert_int_equal(calc_dot(buf->a, buf->b, 200, &r), CALC_OK);
+        assert_true(r == INT64_C(100) << 31);
+
+        // 3 * 2^62 does not fit: low 64 bits
+        assert_int_equal(calc_dot(buf->a, buf->a, 3, &r), CALC_ERR_OVERFLOW);
+        assert_true((uint64_t)r == UINT64_C(3) << 62);
+    }
+    calc_batch_set_isa(detected);
+}
+
+static void test_axpy(void **state) {
+    struct linalg_buffers *buf = *state;
+    calc_isa_t detected = calc_batch_isa();
+    const size_t n = 203;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        uint32_t seed = 3u;
+        test_data_fill(buf->a, n, &seed, 0);
+        for (size_t i = 0; i < n; i++) {
+            buf->c[i] = (int64_t)i * 1000003 - 99999;
+        }
+        assert_int_equal(calc_axpy(-7, buf->a, buf->c, n), CALC_OK);
+        for (size_t i = 0; i < n; i++) {
+            assert_true(buf->c[i] == (int64_t)i * 1000003 - 99999 - (int64_t)7 * buf->a[i]);
+        }
+
+        // One wrapped element, in the vector part and in the tail
+        static const size_t positions[] = { 5, 202 };
+        for (size_t p = 0; p < 2; p++) {
+            memset(buf->c, 0, n * sizeof(buf->c[0]));
+            for (size_t i = 0; i < n; i++) {
+                buf->a[i] = -1;
+            }
+            buf->c[positions[p]] = INT64_MIN + 1;
+            buf->a[positions[p]] = 1;
+            assert_int_equal(calc_axpy(INT_MIN, buf->a, buf->c, n), CALC_ERR_OVERFLOW);
+            assert_true((uint64_t)buf->c[positions[p]] == (uint64_t)INT64_MIN + 1 + (uint64_t)INT_MIN);
+            assert_true(buf->c[0 == positions[p] ? 1 : 0] == -(int64_t)INT_MIN);
+        }
+    }
+    calc_batch_set_isa(detected);
+}
+
+static void test_gemv(void **state) {
+    struct linalg_buffers *buf = *state;
+    calc_isa_t detected = calc_batch_isa();
+    static const size_t shapes[][2] = { { 1, 1 }, { 4, 16 }, { 7, 37 }, { 13, 300 }, { 0, 5 } };
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+            size_t rows = shapes[s][0], cols = shapes[s][1];
+            uint32_t seed = 5u + (uint32_t)s;
+            int overflow = 0;
+
+            test_data_fill(buf->a, rows * cols, &seed, 1u << 24);
+            test_data_fill(buf->b, cols, &seed, 1u << 24);
+            // Only row 0 of the 13-row case overflows
+            if (rows == 13) {
+                for (size_t j = 0; j < cols; j++) {
+                    buf->a[j] = buf->b[j] = INT_MIN;
+                }
+            }
+            calc_status_t status = calc_gemv(buf->a, buf->b, buf->y, rows, cols);
+            for (size_t i = 0; i < rows; i++) {
+                __int128 expected = reference_dot(buf->a + i * cols, buf->b, 1, cols);
+                overflow |= !fits_i64(expected);
+                assert_true(buf->y[i] == (int64_t)(uint64_t)(unsigned __int128)expected);
+            }
+            assert_int_equal(status, overflow ? CALC_ERR_OVERFLOW : CALC_OK);
+            assert_int_equal(overflow, rows == 13);
+        }
+    }
+    calc_batch_set_isa(detected);
+}
+
+static void test_gemm(void **state) {
+    struct linalg_buffers *buf = *state;
+    calc_isa_t detected = calc_batch_isa();
+    static const size_t shapes[][3] = {
+        { 1, 1, 1 }, { 4, 3, 8 }, { 5, 300, 37 }, { 9, 130, 270 }, { 17, 129, 16 }, { 3, 0, 4 },
+    };
+    // Small values take the 64-bit blocked path, full-range ones the 128-bit loop
+    static const uint32_t ranges[] = { 1000, 0 };
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+            for (size_t v = 0; v < 2; v++) {
+                size_t m = shapes[s][0], k = shapes[s][1], n = shapes[s][2];
+                uint32_t seed = 7u + (uint32_t)s;
+                int overflow = 0;
+
+                test_data_fill(buf->a, m * k, &seed, ranges[v]);
+                test_data_fill(buf->b, k * n, &seed, ranges[v]);
+                calc_status_t status = calc_gemm(buf->a, buf->b, buf->c, m, k, n);
+                for (size_t i = 0; i < m; i++) {
+                    for (size_t j = 0; j < n; j++) {
+                        __int128 expected = reference_dot(buf->a + i * k, buf->b + j, n, k);
+                        overflow |= !fits_i64(expected);
+                        assert_true(buf->c[i * n + j] ==
+                                    (int64_t)(uint64_t)(unsigned __int128)expected);
+                    }
+                }
+                assert_int_equal(status, overflow ? CALC_ERR_OVERFLOW : CALC_OK);
+            }
+        }
+    }
+    calc_batch_set_isa(detected);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_dot),
+        cmocka_unit_test(test_axpy),
+        cmocka_unit_test(test_gemv),
+        cmocka_unit_test(test_gemm),
+    };
+
+    printf("\n========== CALC LINALG MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc linalg tests", tests,
+                                       setup_buffers, teardown_buffers);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file test_calc_ops.c
+ * @brief Unit tests for the runtime-selectable calc backends
+ *
+ * Demonstrates cmocka features:
+ * - Running the same checks against several implementations
+ * - Group teardown restoring global state (the active backend)
+ * - Loading a backend from a shared object built next to the test
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-ops.h"
+#include "calc.h"
+#include "multi-calc.h"
+
+#define TEST_LEN 37
+
+static const sdk_calc_ops* builtins[] = {
+    &calc_ops_scalar, &calc_ops_checked, &calc_ops_simd,
+};
+
+/*============================================================================
+ * Selection
+ *===========================================================================*/
+
+/**
+ * Must run first: the environment is only read on the first calc_ops_get
+ */
+static void test_env_selects_backend(void **state) {
+    (void)state;
+    setenv(SDK_CALC_OPS_ENV, "simd", 1);
+    assert_ptr_equal(calc_ops_get(), &calc_ops_simd);
+    unsetenv(SDK_CALC_OPS_ENV);
+}
+
+static void test_find_and_set(void **state) {
+    (void)state;
+    assert_ptr_equal(calc_ops_find("scalar"), &calc_ops_scalar);
+    assert_ptr_equal(calc_ops_find("checked"), &calc_ops_checked);
+    assert_ptr_equal(calc_ops_find("simd"), &calc_ops_simd);
+    assert_null(calc_ops_find("avx9000"));
+
+    assert_int_equal(calc_ops_select("checked"), 0);
+    assert_ptr_equal(calc_ops_get(), &calc_ops_checked);
+    assert_int_equal(calc_ops_select("avx9000"), -1);
+    assert_ptr_equal(calc_ops_get(), &calc_ops_checked);
+
+    // NULL restores the default
+    assert_int_equal(calc_ops_set(NULL), 0);
+    assert_ptr_equal(calc_ops_get(), &calc_ops_scalar);
+}
+
+static void test_set_rejects_invalid(void **state) {
+    (void)state;
+    sdk_calc_ops ops = calc_ops_scalar;
+
+    ops.abi = SDK_CALC_OPS_ABI + 1;
+    assert_int_equal(calc_ops_set(&ops), -1);
+    ops.abi = SDK_CALC_OPS_ABI;
+    ops.divide_batch = NULL;
+    assert_int_equal(calc_ops_set(&ops), -1);
+    assert_ptr_equal(calc_ops_get(), &calc_ops_scalar);
+}
+
+/*============================================================================
+ * Built-in backends
+ *===========================================================================*/
+
+static void test_builtins_agree(void **state) {
+    (void)state;
+    int a[TEST_LEN], b[TEST_LEN], out[TEST_LEN];
+
+    for (int i = 0; i < TEST_LEN; i++) {
+        a[i] = (i - 18) * 12345;
+        b[i] = (i % 7) - 3 ? (i % 7) - 3 : 5;
+    }
+
+    for (size_t k = 0; k < sizeof(builtins) / sizeof(builtins[0]); k++) {
+        const sdk_calc_ops *ops = builtins[k];
+
+        assert_int_equal(ops->abi, SDK_CALC_OPS_ABI);
+        assert_int_equal(ops->add(7, 5), 12);
+        assert_int_equal(ops->subtract(7, 5), 2);
+        assert_int_equal(ops->multiply(7, -5), -35);
+        assert_int_equal(ops->divide(-7, 2), -3);
+
+        ops->add_batch(a, b, out, TEST_LEN);
+        for (int i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(out[i], calc_add(a[i], b[i]));
+        }
+        ops->subtract_batch(a, b, out, TEST_LEN);
+        for (int i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(out[i], calc_subtract(a[i], b[i]));
+        }
+        ops->multiply_batch(a, b, out, TEST_LEN);
+        for (int i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(out[i], calc_multiply(a[i], b[i]));
+        }
+        ops->divide_batch(a, b, out, TEST_LEN);
+        for (int i = 0; i < TEST_LEN; i++) {
+            assert_int_equal(out[i], calc_divide(a[i], b[i]));
+        }
+    }
+}
+
+static void test_multi_calc_uses_backend(void **state) {
+    (void)state;
+
+    for (size_t k = 0; k < sizeof(builtins) / sizeof(builtins[0]); k++) {
+        assert_int_equal(calc_ops_set(builtins[k]), 0);
+        assert_int_equal(multi_calc_expression(2, 3, 10, 4), 30);
+        assert_int_equal(multi_calc_average(10, 20, 30), 20);
+    }
+}
+
+static void test_checked_status(void **state) {
+    (void)state;
+    const sdk_calc_ops *ops = &calc_ops_checked;
+    int a[3] = { 1, INT_MIN, 8 };
+    int b[3] = { 2, -1, 0 };
+    int out[3];
+
+    assert_int_equal(calc_ops_take_status(), CALC_OK);
+    ops->add(1, 2);
+    assert_int_equal(calc_ops_take_status(), CALC_OK);
+
+    // The first failure is kept until it is taken
+    ops->add(INT_MAX, 1);
+    ops->divide(1, 0);
+    assert_int_equal(calc_ops_take_status(), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_ops_take_status(), CALC_OK);
+
+    assert_int_equal(ops->divide(1, 0), 0);
+    assert_int_equal(calc_ops_take_status(), CALC_ERR_DIV_BY_ZERO);
+
+    ops->divide_batch(a, b, out, 3);
+    assert_int_equal(calc_ops_take_status(), CALC_ERR_OVERFLOW);
+    ops->divide_batch(a + 2, b + 2, out, 1);
+    assert_int_equal(calc_ops_take_status(), CALC_ERR_DIV_BY_ZERO);
+    ops->multiply_batch(a, b, out, 3);
+    assert_int_equal(calc_ops_take_status(), CALC_ERR_OVERFLOW);
+    ops->subtract_batch(a, a, out, 3);
+    assert_int_equal(calc_ops_take_status(), CALC_OK);
+
+    // Through multi_calc
+    assert_int_equal(calc_ops_set(ops), 0);
+    multi_calc_expression(INT_MAX, 1, 0, 0);
+    assert_int_equal(calc_ops_take_status(), CALC_ERR_OVERFLOW);
+}
+
+/*============================================================================
+ * Shared object backends
+ *===========================================================================*/
+
+static void test_load_plugin(void **state) {
+    (void)state;
+    const sdk_calc_ops *ops = calc_ops_load(CALC_OPS_PLUGIN);
+    int a[2] = { INT_MAX, 5 };
+    int b[2] = { 1, 6 };
+    int out[2];
+
+    assert_non_null(ops);
+    assert_string_equal(ops->name, "plugin-saturate");
+    assert_int_equal(ops->add(INT_MAX, 1), INT_MAX);
+    ops->add_batch(a, b, out, 2);
+    assert_int_equal(out[0], INT_MAX);
+    assert_int_equal(out[1], 11);
+
+    // Loading again returns the same table
+    assert_ptr_equal(calc_ops_load(CALC_OPS_PLUGIN), ops);
+
+    assert_int_equal(calc_ops_select(CALC_OPS_PLUGIN), 0);
+    assert_ptr_equal(calc_ops_get(), ops);
+    assert_int_equal(multi_calc_expression(INT_MAX, 1, 3, 1), INT_MAX);
+    assert_int_equal(multi_calc_average(INT_MAX, INT_MAX, INT_MAX), INT_MAX / 3);
+}
+
+static void test_load_failures(void **state) {
+    (void)state;
+    assert_null(calc_ops_load(NULL));
+    assert_null(calc_ops_load("./no-such-backend.so"));
+    assert_int_equal(calc_ops_select("./no-such-backend.so"), -1);
+    assert_ptr_equal(calc_ops_get(), &calc_ops_scalar);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+static int reset_backend(void **state) {
+    (void)state;
+    calc_ops_take_status();
+    return calc_ops_set(NULL);
+}
+
+int main(void) {
+    const struct CMUnitTest select_tests[] = {
+        cmocka_unit_test(test_env_selects_backend),
+        cmocka_unit_test_teardown(test_find_and_set, reset_backend),
+        cmocka_unit_test_teardown(test_set_rejects_invalid, reset_backend),
+    };
+
+    const struct CMUnitTest builtin_tests[] = {
+        cmocka_unit_test(test_builtins_agree),
+        cmocka_unit_test_teardown(test_multi_calc_uses_backend, reset_backend),
+        cmocka_unit_test_teardown(test_checked_status, reset_backend),
+    };
+
+    const struct CMUnitTest plugin_tests[] = {
+        cmocka_unit_test_teardown(test_load_plugin, reset_backend),
+        cmocka_unit_test(test_load_failures),
+    };
+
+    int result = 0;
+
+    printf("\n========== CALC OPS MODULE UNIT TESTS ==========\n\n");
+
+    result += cmocka_run_group_tests_name("select tests", select_tests, NULL, reset_backend);
+    result += cmocka_run_group_tests_name("builtin tests", builtin_tests, NULL, reset_backend);
+    result += cmocka_run_group_tests_name("plugin tests", plugin_tests, NULL, reset_backend);
+
+    return result;
+}
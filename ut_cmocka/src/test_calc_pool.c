@@ -0,0 +1,252 @@
+/**
+ * @file test_calc_pool.c
+ * @brief Unit tests for the calc-pool work-stealing thread pool
+ *
+ * parallel_for must call its function on disjoint ranges that cover the
+ * whole index range exactly once, for any thread count, grain, nesting or
+ * number of concurrent callers. The SDK batch functions must give the same
+ * results on the pool as on one thread.
+ *
+ * Demonstrates cmocka features:
+ * - Per-test setup/teardown to restore the thread count
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <cmocka.h>
+
+#include "calc-pool.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+#include "calc-expr.h"
+#include "calc-jit.h"
+#include "multi-calc-batch.h"
+#include "test_data.h"
+
+#define BIG_LEN (5 * CALC_POOL_BATCH_GRAIN + 13)   /* Above the split threshold */
+
+static int setup_threads(void **state) {
+    (void)state;
+    calc_pool_set_threads(4);
+    return 0;
+}
+
+static int teardown_threads(void **state) {
+    (void)state;
+    calc_pool_set_threads(1);
+    return 0;
+}
+
+/*============================================================================
+ * Range bookkeeping
+ *===========================================================================*/
+
+struct coverage {
+    unsigned *hits;             /* Calls that covered each index (atomic) */
+    size_t grain;
+    int too_long;               /* A range longer than the grain (atomic) */
+};
+
+static void count_range(void *ctx, size_t begin, size_t end) {
+    struct coverage *cov = ctx;
+
+    if (end - begin > cov->grain) {
+        __atomic_store_n(&cov->too_long, 1, __ATOMIC_RELAXED);
+    }
+    for (size_t i = begin; i < end; i++) {
+        __atomic_add_fetch(&cov->hits[i], 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void check_coverage(size_t begin, size_t end, size_t grain) {
+    struct coverage cov = { test_calloc(end + 1, sizeof(unsigned)), grain, 0 };
+
+    calc_pool_parallel_for(begin, end, grain, count_range, &cov);
+    for (size_t i = 0; i <= end; i++) {
+        assert_int_equal(cov.hits[i], i >= begin && i < end ? 1 : 0);
+    }
+    if (grain != 0) {
+        assert_int_equal(cov.too_long, 0);
+    }
+    test_free(cov.hits);
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_thread_count(void **state) {
+    (void)state;
+    calc_pool_set_threads(3);
+    assert_int_equal(calc_pool_threads(), 3);
+    calc_pool_set_threads(CALC_POOL_MAX_THREADS + 10);
+    assert_int_equal(calc_pool_threads(), CALC_POOL_MAX_THREADS);
+    calc_pool_set_threads(0);
+    assert_true(calc_pool_threads() >= 1);
+    calc_pool_set_threads(1);
+    assert_int_equal(calc_pool_threads(), 1);
+}
+
+static void test_covers_every_index_once(void **state) {
+    (void)state;
+    static const unsigned threads[] = { 1, 2, 4, 7 };
+    static const size_t grains[] = { 0, 1, 3, 64, 1000 };
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        calc_pool_set_threads(threads[t]);
+        for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+            check_coverage(0, 0, grains[g]);
+            check_coverage(0, 1, grains[g]);
+            check_coverage(5, 17, grains[g]);
+            check_coverage(0, 10007, grains[g]);
+            check_coverage(123, 50000, grains[g]);
+        }
+    }
+}
+
+struct nested {
+    unsigned *hits;
+    size_t inner;
+    int too_long;               /* Atomic: asserts stay on the test thread */
+};
+
+static void nested_range(void *ctx, size_t begin, size_t end) {
+    struct nested *outer = ctx;
+
+    for (size_t i = begin; i < end; i++) {
+        struct coverage cov = { outer->hits + i * outer->inner, 7, 0 };
+        calc_pool_parallel_for(0, outer->inner, cov.grain, count_range, &cov);
+        if (cov.too_long) {
+            __atomic_store_n(&outer->too_long, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void test_nested_parallel_for(void **state) {
+    (void)state;
+    struct nested outer = { test_calloc(40 * 300, sizeof(unsigned)), 300, 0 };
+
+    calc_pool_parallel_for(0, 40, 1, nested_range, &outer);
+    assert_int_equal(outer.too_long, 0);
+    for (size_t i = 0; i < 40 * 300; i++) {
+        assert_int_equal(outer.hits[i], 1);
+    }
+    test_free(outer.hits);
+}
+
+static void* external_caller(void *arg) {
+    unsigned *hits = arg;
+    struct coverage cov = { hits, 16, 0 };
+
+    for (int round = 0; round < 20; round++) {
+        calc_pool_parallel_for(0, 4096, cov.grain, count_range, &cov);
+    }
+    return NULL;
+}
+
+static void test_concurrent_callers(void **state) {
+    (void)state;
+    pthread_t callers[3];
+    unsigned *hits = test_calloc(3 * 4096, sizeof(unsigned));
+
+    for (size_t k = 0; k < 3; k++) {
+        assert_int_equal(pthread_create(&callers[k], NULL, external_caller, hits + k * 4096), 0);
+    }
+    for (size_t k = 0; k < 3; k++) {
+        pthread_join(callers[k], NULL);
+    }
+    for (size_t i = 0; i < 3 * 4096; i++) {
+        assert_int_equal(hits[i], 20);
+    }
+    test_free(hits);
+}
+
+static void test_batch_functions_match_serial(void **state) {
+    (void)state;
+    static const char *const abcd[] = { "a", "b", "c", "d" };
+    int *cols[4];
+    int *pooled = test_malloc(BIG_LEN * sizeof(int));
+    int *serial = test_malloc(BIG_LEN * sizeof(int));
+    unsigned char *pooled_flags = test_malloc(CALC_BITMAP_BYTES(BIG_LEN));
+    unsigned char *serial_flags = test_malloc(CALC_BITMAP_BYTES(BIG_LEN));
+    calc_expr_t *expr = calc_expr_compile("(a + b) * (c - d) / (b - 3)", abcd, 4, NULL);
+    calc_jit_t *jit = calc_jit_compile("(a + b) * (c - d) / (b - 3)", abcd, 4, NULL);
+    uint32_t seed = 99u;
+    size_t zeros;
+
+    assert_non_null(expr);
+    assert_non_null(jit);
+    for (size_t k = 0; k < 4; k++) {
+        cols[k] = test_malloc(BIG_LEN * sizeof(int));
+        // Small values in b so that some divisors are zero
+        test_data_fill(cols[k], BIG_LEN, &seed, k == 1 ? 8 : 0);
+    }
+
+    calc_pool_set_threads(1);
+    calc_add_batch(cols[0], cols[1], serial, BIG_LEN);
+    calc_pool_set_threads(4);
+    calc_add_batch(cols[0], cols[1], pooled, BIG_LEN);
+    assert_memory_equal(pooled, serial, BIG_LEN * sizeof(int));
+
+    calc_pool_set_threads(1);
+    zeros = calc_divide_batch_masked(cols[0], cols[1], serial, serial_flags, BIG_LEN);
+    calc_pool_set_threads(4);
+    assert_int_equal(calc_divide_batch_masked(cols[0], cols[1], pooled, pooled_flags, BIG_LEN),
+                     zeros);
+    assert_true(zeros > 0);
+    assert_memory_equal(pooled, serial, BIG_LEN * sizeof(int));
+    assert_memory_equal(pooled_flags, serial_flags, CALC_BITMAP_BYTES(BIG_LEN));
+
+    calc_pool_set_threads(1);
+    multi_calc_expression_batch(cols[0], cols[1], cols[2], cols[3], serial, BIG_LEN);
+    calc_pool_set_threads(4);
+    multi_calc_expression_batch(cols[0], cols[1], cols[2], cols[3], pooled, BIG_LEN);
+    assert_memory_equal(pooled, serial, BIG_LEN * sizeof(int));
+
+    calc_pool_set_threads(1);
+    assert_int_equal(calc_expr_eval_batch(expr, (const int *const *)cols, serial, BIG_LEN), 0);
+    calc_pool_set_threads(4);
+    assert_int_equal(calc_expr_eval_batch(expr, (const int *const *)cols, pooled, BIG_LEN), 0);
+    assert_memory_equal(pooled, serial, BIG_LEN * sizeof(int));
+
+    memset(pooled, 0, BIG_LEN * sizeof(int));
+    assert_int_equal(calc_jit_eval_batch(jit, (const int *const *)cols, pooled, BIG_LEN), 0);
+    assert_memory_equal(pooled, serial, BIG_LEN * sizeof(int));
+
+    calc_expr_free(expr);
+    calc_jit_free(jit);
+    for (size_t k = 0; k < 4; k++) {
+        test_free(cols[k]);
+    }
+    test_free(pooled);
+    test_free(serial);
+    test_free(pooled_flags);
+    test_free(serial_flags);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_thread_count, setup_threads, teardown_threads),
+        cmocka_unit_test_setup_teardown(test_covers_every_index_once,
+                                        setup_threads, teardown_threads),
+        cmocka_unit_test_setup_teardown(test_nested_parallel_for,
+                                        setup_threads, teardown_threads),
+        cmocka_unit_test_setup_teardown(test_concurrent_callers,
+                                        setup_threads, teardown_threads),
+        cmocka_unit_test_setup_teardown(test_batch_functions_match_serial,
+                                        setup_threads, teardown_threads),
+    };
+
+    printf("\n========== CALC POOL MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc pool tests", tests, NULL, NULL);
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_calc_reduce.c
+ * @brief Unit tests for calc reduction (sum / product) module
+ *
+ * Demonstrates cmocka features:
+ * - test_malloc / test_free for leak-checked large buffers
+ * - Group setup and teardown functions
+ * - Running the same checks for every instruction set
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-reduce.h"
+#include "calc-batch.h"
+#include "calc-pool.h"
+#include "test_data.h"
+
+#define TEST_LEN 203
+#define LARGE_LEN (4 * CALC_REDUCE_MIN_PER_THREAD + 13)
+
+static int64_t reference_sum(const int *a, size_t n) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i];
+    }
+    return sum;
+}
+
+/*============================================================================
+ * calc_sum
+ *===========================================================================*/
+
+static void test_sum_small(void **state) {
+    (void)state;
+    const int values[] = { 1, 2, 3, 4, 5 };
+
+    assert_int_equal(calc_sum(values, 5), 15);
+    assert_int_equal(calc_sum(values, 0), 0);
+    assert_int_equal(calc_sum(NULL, 0), 0);
+}
+
+static void test_sum_all_isas(void **state) {
+    (void)state;
+    int a[TEST_LEN];
+    uint32_t seed = 3u;
+
+    test_data_fill(a, TEST_LEN, &seed, 0);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        // Every length up to TEST_LEN exercises all tail sizes
+        for (size_t n = 0; n <= TEST_LEN; n++) {
+            assert_int_equal(calc_sum(a, n), reference_sum(a, n));
+        }
+    }
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+}
+
+static void test_sum_no_overflow(void **state) {
+    (void)state;
+    int max[100];
+    int min[100];
+
+    for (int i = 0; i < 100; i++) {
+        max[i] = INT_MAX;
+        min[i] = INT_MIN;
+    }
+    assert_int_equal(calc_sum(max, 100), (int64_t)INT_MAX * 100);
+    assert_int_equal(calc_sum(min, 100), (int64_t)INT_MIN * 100);
+}
+
+static void test_sum_threads(void **state) {
+    (void)state;
+    int *a = test_malloc(LARGE_LEN * sizeof(int));
+    int64_t expected;
+    uint32_t seed = 5u;
+
+    test_data_fill(a, LARGE_LEN, &seed, 0);
+    expected = reference_sum(a, LARGE_LEN);
+
+    for (unsigned threads = 1; threads <= 8; threads *= 2) {
+        calc_pool_set_threads(threads);
+        assert_int_equal(calc_sum(a, LARGE_LEN), expected);
+    }
+
+    // The deprecated setting forwards to the pool
+    calc_reduce_set_threads(3);
+    assert_int_equal(calc_pool_threads(), 3);
+    assert_int_equal(calc_reduce_threads(), 3);
+    assert_int_equal(calc_sum(a, LARGE_LEN), expected);
+    calc_reduce_set_threads(0);
+    assert_int_equal(calc_pool_threads(), 1);
+    test_free(a);
+}
+
+/*============================================================================
+ * calc_product
+ *===========================================================================*/
+
+static void test_product_small(void **state) {
+    (void)state;
+    const int values[] = { 2, -3, 4, 5, -6, 7 };
+    int64_t r = 0;
+
+    assert_int_equal(calc_product(values, 6, &r), CALC_OK);
+    assert_int_equal(r, 5040);
+    assert_int_equal(calc_product(values, 0, &r), CALC_OK);
+    assert_int_equal(r, 1);
+}
+
+static void test_product_overflow(void **state) {
+    (void)state;
+    const int values[] = { INT_MAX, INT_MAX, 2, 3, 5 };
+    int64_t r;
+
+    // INT_MAX^2 * 2 still fits, * 3 does not
+    assert_int_equal(calc_product(values, 3, &r), CALC_OK);
+    assert_int_equal(r, (int64_t)INT_MAX * INT_MAX * 2);
+    assert_int_equal(calc_product(values, 4, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_product(values, 5, &r), CALC_ERR_OVERFLOW);
+}
+
+static void test_product_zero(void **state) {
+    (void)state;
+    int values[11] = { INT_MAX, INT_MAX, INT_MAX, INT_MAX, INT_MAX, INT_MAX,
+                       INT_MAX, INT_MAX, INT_MAX, INT_MAX, 0 };
+    int64_t r = 42;
+
+    // The partial product overflows, but the exact product is 0
+    assert_int_equal(calc_product(values, 11, &r), CALC_OK);
+    assert_int_equal(r, 0);
+}
+
+static void test_product_threads(void **state) {
+    (void)state;
+    int *a = test_malloc(LARGE_LEN * sizeof(int));
+    int64_t r;
+
+    // Mostly 1 and -1 so the product stays small: (-1)^count * 2^2
+    for (size_t i = 0; i < LARGE_LEN; i++) {
+        a[i] = (i % 3 == 0) ? -1 : 1;
+    }
+    a[10] = 2;
+    a[LARGE_LEN - 1] = 2;
+    int negatives = 0;
+    for (size_t i = 0; i < LARGE_LEN; i++) {
+        negatives += a[i] < 0;
+    }
+
+    for (unsigned threads = 1; threads <= 4; threads++) {
+        calc_pool_set_threads(threads);
+        assert_int_equal(calc_product(a, LARGE_LEN, &r), CALC_OK);
+        assert_int_equal(r, negatives % 2 ? -4 : 4);
+    }
+
+    // A zero in the last range wins over an overflow in the first one
+    a[0] = INT_MAX;
+    a[1] = INT_MAX;
+    a[2] = INT_MAX;
+    assert_int_equal(calc_product(a, LARGE_LEN, &r), CALC_ERR_OVERFLOW);
+    a[LARGE_LEN - 2] = 0;
+    assert_int_equal(calc_product(a, LARGE_LEN, &r), CALC_OK);
+    assert_int_equal(r, 0);
+    test_free(a);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+static int reset_threads(void **state) {
+    (void)state;
+    calc_pool_set_threads(1);
+    return 0;
+}
+
+int main(void) {
+    const struct CMUnitTest sum_tests[] = {
+        cmocka_unit_test(test_sum_small),
+        cmocka_unit_test(test_sum_all_isas),
+        cmocka_unit_test(test_sum_no_overflow),
+        cmocka_unit_test_teardown(test_sum_threads, reset_threads),
+    };
+
+    const struct CMUnitTest product_tests[] = {
+        cmocka_unit_test(test_product_small),
+        cmocka_unit_test(test_product_overflow),
+        cmocka_unit_test(test_product_zero),
+        cmocka_unit_test_teardown(test_product_threads, reset_threads),
+    };
+
+    int result = 0;
+
+    printf("\n========== CALC REDUCE MODULE UNIT TESTS ==========\n\n");
+
+    result += cmocka_run_group_tests_name("sum tests", sum_tests, reset_threads, NULL);
+    result += cmocka_run_group_tests_name("product tests", product_tests, reset_threads, NULL);
+
+    return result;
+}
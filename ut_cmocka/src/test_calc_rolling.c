@@ -0,0 +1,179 @@
+/**
+ * @file test_calc_rolling.c
+ * @brief Unit tests for the calc-rolling window statistics
+ *
+ * Every statistic is checked against a brute-force rescan of the window
+ * after each push, for several window sizes.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share a sample stream through state
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-rolling.h"
+#include "multi-calc.h"
+#include "test_data.h"
+
+#define STREAM_LEN 2000
+
+static int setup_stream(void **state) {
+    static const int edges[] = { 0, 1, -1, INT_MAX, INT_MIN };
+    int *stream = test_malloc(STREAM_LEN * sizeof(*stream));
+    const size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+    uint32_t seed = 31337u;
+
+    for (size_t i = 0; i < STREAM_LEN; i++) {
+        // Runs of equal values and edge values stress the min/max queues
+        if ((test_data_next(&seed) >> 28) == 0 && i > 0) {
+            stream[i] = stream[i - 1];
+        } else {
+            stream[i] = test_data_int_or_edge(&seed, 0, edges, n_edges, 1);
+        }
+    }
+    *state = stream;
+    return 0;
+}
+
+static int teardown_stream(void **state) {
+    test_free(*state);
+    return 0;
+}
+
+/* Rescan the last `count` samples ending at stream[end - 1] */
+static void check_window(const calc_rolling_t *r, const int *stream, size_t end, size_t count) {
+    int64_t sum = 0;
+    int lo = INT_MAX;
+    int hi = INT_MIN;
+    __int128 sum_sq = 0;
+
+    for (size_t i = end - count; i < end; i++) {
+        sum += stream[i];
+        sum_sq += (__int128)((int64_t)stream[i] * stream[i]);
+        lo = stream[i] < lo ? stream[i] : lo;
+        hi = stream[i] > hi ? stream[i] : hi;
+    }
+    assert_int_equal(calc_rolling_count(r), count);
+    assert_true(calc_rolling_sum(r) == sum);
+    assert_int_equal(calc_rolling_mean(r), (int)(sum / (int64_t)count));
+    assert_int_equal(calc_rolling_min(r), lo);
+    assert_int_equal(calc_rolling_max(r), hi);
+    assert_true(calc_rolling_variance(r) ==
+                (int64_t)(((__int128)count * sum_sq - (__int128)sum * sum) /
+                          ((__int128)count * (__int128)count)));
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_matches_rescan(void **state) {
+    const int *stream = *state;
+    static const size_t windows[] = { 1, 2, 3, 7, 64, 1000 };
+
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        calc_rolling_t *r = calc_rolling_create(windows[w]);
+        assert_non_null(r);
+        for (size_t i = 0; i < STREAM_LEN; i++) {
+            calc_rolling_push(r, stream[i]);
+            check_window(r, stream, i + 1, i + 1 < windows[w] ? i + 1 : windows[w]);
+        }
+        calc_rolling_destroy(r);
+    }
+}
+
+static void test_window_of_three_matches_average(void **state) {
+    (void)state;
+    int samples[500];
+    int means[500];
+    uint32_t seed = 5u;
+    calc_rolling_t *r = calc_rolling_create(3);
+
+    // Values below INT_MAX / 3 so that multi_calc_average does not wrap
+    test_data_fill(samples, 500, &seed, 700000000u);
+    assert_non_null(r);
+    calc_rolling_push_batch(r, samples, 500, means);
+    for (size_t i = 2; i < 500; i++) {
+        assert_int_equal(means[i], multi_calc_average(samples[i - 2], samples[i - 1], samples[i]));
+    }
+    calc_rolling_destroy(r);
+}
+
+static void test_mean_truncates_toward_zero(void **state) {
+    (void)state;
+    calc_rolling_t *r = calc_rolling_create(2);
+
+    assert_non_null(r);
+    assert_int_equal(calc_rolling_mean(r), 0);
+    assert_int_equal(calc_rolling_min(r), 0);
+    assert_int_equal(calc_rolling_max(r), 0);
+    assert_int_equal(calc_rolling_variance(r), 0);
+
+    calc_rolling_push(r, -3);
+    calc_rolling_push(r, -4);
+    assert_int_equal(calc_rolling_mean(r), -3);     // -7 / 2
+    calc_rolling_push(r, INT_MAX);
+    calc_rolling_push(r, INT_MAX);
+    assert_int_equal(calc_rolling_mean(r), INT_MAX);   // No overflow
+    assert_int_equal(calc_rolling_variance(r), 0);
+    calc_rolling_destroy(r);
+}
+
+static void test_batch_and_reset(void **state) {
+    const int *stream = *state;
+    static int means[STREAM_LEN];
+    calc_rolling_t *batch = calc_rolling_create(16);
+    calc_rolling_t *single = calc_rolling_create(16);
+
+    assert_non_null(batch);
+    assert_non_null(single);
+    calc_rolling_push_batch(batch, stream, STREAM_LEN, means);
+    for (size_t i = 0; i < STREAM_LEN; i++) {
+        calc_rolling_push(single, stream[i]);
+        assert_int_equal(means[i], calc_rolling_mean(single));
+    }
+    assert_int_equal(calc_rolling_min(batch), calc_rolling_min(single));
+    assert_int_equal(calc_rolling_max(batch), calc_rolling_max(single));
+
+    calc_rolling_reset(batch);
+    assert_int_equal(calc_rolling_count(batch), 0);
+    calc_rolling_push_batch(batch, stream, 5, NULL);
+    check_window(batch, stream, 5, 5);
+
+    calc_rolling_destroy(batch);
+    calc_rolling_destroy(single);
+}
+
+static void test_invalid_window(void **state) {
+    (void)state;
+    assert_null(calc_rolling_create(0));
+#if SIZE_MAX > UINT32_MAX
+    assert_null(calc_rolling_create((size_t)UINT32_MAX + 1));
+#endif
+    calc_rolling_destroy(NULL);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_matches_rescan),
+        cmocka_unit_test(test_window_of_three_matches_average),
+        cmocka_unit_test(test_mean_truncates_toward_zero),
+        cmocka_unit_test(test_batch_and_reset),
+        cmocka_unit_test(test_invalid_window),
+    };
+
+    printf("\n========== CALC ROLLING MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc rolling tests", tests,
+                                       setup_stream, teardown_stream);
+}
@@ -0,0 +1,287 @@
+/**
+ * @file test_calc_select.c
+ * @brief Unit tests for the comparison kernels and selected batch functions
+ *
+ * Comparison bitmaps are checked against plain C comparisons for every
+ * kernel supported by the running CPU. Selected batch functions must match
+ * calc_*_batch on the selected rows and leave every other row untouched.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers through state
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-select.h"
+#include "calc-batch.h"
+#include "calc-checked.h"
+#include "multi-calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 301            /* Not a multiple of any vector width: exercises tails */
+#define UNTOUCHED 0x5eed        /* Rows not selected keep this value */
+
+struct select_buffers {
+    int a[TEST_LEN];
+    int b[TEST_LEN];
+    int c[TEST_LEN];
+    int d[TEST_LEN];
+    int expected[TEST_LEN];
+    int out[TEST_LEN];
+    unsigned char bits[CALC_BITMAP_BYTES(TEST_LEN)];
+    uint32_t sel[TEST_LEN];
+};
+
+static int setup_buffers(void **state) {
+    static const int edges[] = { 0, 1, -1, INT_MAX, INT_MIN };
+    struct select_buffers *buf = test_malloc(sizeof(*buf));
+    uint32_t seed = 2024u;
+
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        int v[4];
+        for (int k = 0; k < 4; k++) {
+            // Small values make equal pairs common
+            v[k] = test_data_int_or_edge(&seed, 3, edges, sizeof(edges) / sizeof(edges[0]), 2);
+        }
+        buf->a[i] = v[0];
+        buf->b[i] = v[1];
+        buf->c[i] = v[2];
+        buf->d[i] = v[3];
+    }
+    *state = buf;
+    return 0;
+}
+
+static int teardown_buffers(void **state) {
+    test_free(*state);
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+    return 0;
+}
+
+static int compare_one(calc_cmp_t cmp, int x, int y) {
+    switch (cmp) {
+    case CALC_CMP_EQ: return x == y;
+    case CALC_CMP_NE: return x != y;
+    case CALC_CMP_LT: return x < y;
+    case CALC_CMP_LE: return x <= y;
+    case CALC_CMP_GT: return x > y;
+    case CALC_CMP_GE: return x >= y;
+    }
+    return 0;
+}
+
+static int bit(const unsigned char *bits, size_t i) {
+    return (bits[i / 8] >> (i % 8)) & 1;
+}
+
+/* Mixes empty, full and partial bitmap bytes */
+static void make_selection(unsigned char *bits, size_t n) {
+    for (size_t j = 0; j < CALC_BITMAP_BYTES(n); j++) {
+        bits[j] = (unsigned char)(j % 4 == 0 ? 0x00 : j % 4 == 1 ? 0xff : 0x93 ^ j);
+    }
+}
+
+/* out must hold expected on selected rows and UNTOUCHED elsewhere */
+static void check_selected(const struct select_buffers *buf, const unsigned char *bits, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        assert_int_equal(buf->out[i], bit(bits, i) ? buf->expected[i] : UNTOUCHED);
+    }
+}
+
+static void reset_out(struct select_buffers *buf) {
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        buf->out[i] = UNTOUCHED;
+    }
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_compare_all_isas(void **state) {
+    struct select_buffers *buf = *state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (int cmp = CALC_CMP_EQ; cmp <= CALC_CMP_GE; cmp++) {
+            // Short lengths cover every tail size of every vector width
+            for (size_t n = 0; n <= TEST_LEN; n += (n < 40 ? 1 : 261)) {
+                size_t expected = 0;
+                memset(buf->bits, 0xff, sizeof(buf->bits));
+                size_t count = calc_compare_batch((calc_cmp_t)cmp, buf->a, buf->b, buf->bits, n);
+                for (size_t i = 0; i < n; i++) {
+                    int r = compare_one((calc_cmp_t)cmp, buf->a[i], buf->b[i]);
+                    assert_int_equal(bit(buf->bits, i), r);
+                    expected += (size_t)r;
+                }
+                assert_int_equal(count, expected);
+                if (n % 8 != 0) {
+                    assert_int_equal(buf->bits[n / 8] >> (n % 8), 0);
+                }
+            }
+            for (int v = -2; v <= 2; v++) {
+                size_t expected = 0;
+                size_t count = calc_compare_value_batch((calc_cmp_t)cmp, buf->a, v,
+                                                        buf->bits, TEST_LEN);
+                for (size_t i = 0; i < TEST_LEN; i++) {
+                    int r = compare_one((calc_cmp_t)cmp, buf->a[i], v);
+                    assert_int_equal(bit(buf->bits, i), r);
+                    expected += (size_t)r;
+                }
+                assert_int_equal(count, expected);
+            }
+        }
+    }
+}
+
+static void test_unknown_comparison(void **state) {
+    struct select_buffers *buf = *state;
+
+    memset(buf->bits, 0xff, sizeof(buf->bits));
+    assert_int_equal(calc_compare_batch((calc_cmp_t)42, buf->a, buf->b, buf->bits, TEST_LEN), 0);
+    for (size_t j = 0; j < sizeof(buf->bits); j++) {
+        assert_int_equal(buf->bits[j], 0);
+    }
+}
+
+static void test_bitmaps_and_selection_vectors(void **state) {
+    struct select_buffers *buf = *state;
+    unsigned char positive[CALC_BITMAP_BYTES(TEST_LEN)];
+    unsigned char both[CALC_BITMAP_BYTES(TEST_LEN)];
+    size_t count_and = 0, count_or = 0;
+
+    calc_compare_value_batch(CALC_CMP_GT, buf->a, 0, positive, TEST_LEN);
+    calc_compare_value_batch(CALC_CMP_GT, buf->b, 0, buf->bits, TEST_LEN);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        count_and += buf->a[i] > 0 && buf->b[i] > 0;
+        count_or += buf->a[i] > 0 || buf->b[i] > 0;
+    }
+    assert_int_equal(calc_bitmap_and(positive, buf->bits, both, TEST_LEN), count_and);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(bit(both, i), buf->a[i] > 0 && buf->b[i] > 0);
+    }
+    assert_int_equal(calc_bitmap_or(positive, buf->bits, both, TEST_LEN), count_or);
+
+    // Indices come out ascending, one per set bit
+    size_t count = calc_bitmap_to_selection(both, TEST_LEN, buf->sel);
+    assert_int_equal(count, count_or);
+    size_t k = 0;
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        if (bit(both, i)) {
+            assert_int_equal(buf->sel[k++], i);
+        }
+    }
+    memset(both, 0, sizeof(both));
+    assert_int_equal(calc_bitmap_to_selection(both, TEST_LEN, buf->sel), 0);
+}
+
+static void test_selection_vectors(void **state) {
+    struct select_buffers *buf = *state;
+    static const struct {
+        void (*batch)(const int *, const int *, int *, size_t);
+        void (*sel)(const int *, const int *, int *, const uint32_t *, size_t);
+    } ops[] = {
+        { calc_add_batch, calc_add_batch_sel },
+        { calc_subtract_batch, calc_subtract_batch_sel },
+        { calc_multiply_batch, calc_multiply_batch_sel },
+        { calc_divide_batch, calc_divide_batch_sel },
+    };
+
+    make_selection(buf->bits, TEST_LEN);
+    size_t count = calc_bitmap_to_selection(buf->bits, TEST_LEN, buf->sel);
+
+    for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); k++) {
+        ops[k].batch(buf->a, buf->b, buf->expected, TEST_LEN);
+        reset_out(buf);
+        ops[k].sel(buf->a, buf->b, buf->out, buf->sel, count);
+        check_selected(buf, buf->bits, TEST_LEN);
+    }
+
+    multi_calc_expression_batch(buf->a, buf->b, buf->c, buf->d, buf->expected, TEST_LEN);
+    reset_out(buf);
+    multi_calc_expression_batch_sel(buf->a, buf->b, buf->c, buf->d, buf->out, buf->sel, count);
+    check_selected(buf, buf->bits, TEST_LEN);
+}
+
+static void test_bitmaps_all_isas(void **state) {
+    struct select_buffers *buf = *state;
+    static const struct {
+        void (*batch)(const int *, const int *, int *, size_t);
+        void (*bitmap)(const int *, const int *, int *, const unsigned char *, size_t);
+    } ops[] = {
+        { calc_add_batch, calc_add_batch_bitmap },
+        { calc_subtract_batch, calc_subtract_batch_bitmap },
+        { calc_multiply_batch, calc_multiply_batch_bitmap },
+        { calc_divide_batch, calc_divide_batch_bitmap },
+    };
+
+    make_selection(buf->bits, TEST_LEN);
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); k++) {
+            ops[k].batch(buf->a, buf->b, buf->expected, TEST_LEN);
+            for (size_t n = 0; n <= TEST_LEN; n += (n < 40 ? 1 : 261)) {
+                reset_out(buf);
+                ops[k].bitmap(buf->a, buf->b, buf->out, buf->bits, n);
+                check_selected(buf, buf->bits, n);
+                // Rows past n are never written, even with their bit set
+                for (size_t i = n; i < TEST_LEN; i++) {
+                    assert_int_equal(buf->out[i], UNTOUCHED);
+                }
+            }
+        }
+        multi_calc_expression_batch(buf->a, buf->b, buf->c, buf->d, buf->expected, TEST_LEN);
+        reset_out(buf);
+        multi_calc_expression_batch_bitmap(buf->a, buf->b, buf->c, buf->d, buf->out,
+                                           buf->bits, TEST_LEN);
+        check_selected(buf, buf->bits, TEST_LEN);
+    }
+}
+
+static void test_filter_then_expression(void **state) {
+    struct select_buffers *buf = *state;
+    int sum[TEST_LEN];
+
+    // Rows where a + b > 1 get (a + b) * (c - d), computed in place over c
+    calc_add_batch(buf->a, buf->b, sum, TEST_LEN);
+    size_t count = calc_compare_value_batch(CALC_CMP_GT, sum, 1, buf->bits, TEST_LEN);
+    assert_true(count > 0 && count < TEST_LEN);
+    multi_calc_expression_batch(buf->a, buf->b, buf->c, buf->d, buf->expected, TEST_LEN);
+    memcpy(buf->out, buf->c, sizeof(buf->out));
+    multi_calc_expression_batch_bitmap(buf->a, buf->b, buf->out, buf->d, buf->out,
+                                       buf->bits, TEST_LEN);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(buf->out[i], sum[i] > 1 ? buf->expected[i] : buf->c[i]);
+    }
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_compare_all_isas),
+        cmocka_unit_test(test_unknown_comparison),
+        cmocka_unit_test(test_bitmaps_and_selection_vectors),
+        cmocka_unit_test(test_selection_vectors),
+        cmocka_unit_test(test_bitmaps_all_isas),
+        cmocka_unit_test(test_filter_then_expression),
+    };
+
+    printf("\n========== CALC SELECT MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("calc select tests", tests,
+                                       setup_buffers, teardown_buffers);
+}
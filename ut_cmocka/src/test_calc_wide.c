@@ -0,0 +1,265 @@
+/**
+ * @file test_calc_wide.c
+ * @brief Unit tests for calc 64-bit, saturating and 128-bit sum functions
+ *
+ * Demonstrates cmocka features:
+ * - assert_int_equal on 64-bit values (LargestIntegralType)
+ * - Parameterized tests with cmocka_unit_test_prestate
+ * - Reference results computed in 128-bit arithmetic
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "calc-wide.h"
+#include "calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 203    /* Not a multiple of any vector width */
+
+typedef __int128 i128;
+
+/*============================================================================
+ * Reference implementations
+ *===========================================================================*/
+
+enum { OP_ADD, OP_SUBTRACT, OP_MULTIPLY, OP_DIVIDE };
+
+/* Exact result, or 0 for a zero divisor */
+static i128 reference_exact(int op, i128 a, i128 b) {
+    switch (op) {
+    case OP_ADD:
+        return a + b;
+    case OP_SUBTRACT:
+        return a - b;
+    case OP_MULTIPLY:
+        return a * b;
+    default:
+        return b == 0 ? 0 : a / b;
+    }
+}
+
+static i128 clamp(i128 v, i128 min, i128 max) {
+    return v < min ? min : (v > max ? max : v);
+}
+
+static int64_t wrap64(i128 v) {
+    return (int64_t)(uint64_t)(unsigned __int128)v;
+}
+
+static i128 from_i128(calc_i128_t v) {
+    return (i128)(((unsigned __int128)(uint64_t)v.hi << 64) | v.lo);
+}
+
+/*============================================================================
+ * Scalar functions
+ *===========================================================================*/
+
+static void test_i64_scalar(void **state) {
+    (void)state;
+
+    assert_int_equal(calc_add_i64(INT64_C(5000000000), 3), INT64_C(5000000003));
+    assert_int_equal(calc_subtract_i64(INT64_MIN, 1), INT64_MAX);
+    assert_int_equal(calc_multiply_i64(INT64_C(3000000000), 3), INT64_C(9000000000));
+    assert_int_equal(calc_multiply_i64(INT64_MAX, 2), -2);
+    assert_int_equal(calc_divide_i64(INT64_C(9000000000), 3), INT64_C(3000000000));
+    assert_int_equal(calc_divide_i64(7, 0), 0);
+    assert_int_equal(calc_divide_i64(INT64_MIN, -1), INT64_MIN);
+}
+
+static void test_sat_scalar(void **state) {
+    (void)state;
+
+    assert_int_equal(calc_add_sat(2, 3), 5);
+    assert_int_equal(calc_add_sat(INT_MAX, 1), INT_MAX);
+    assert_int_equal(calc_add_sat(INT_MIN, -1), INT_MIN);
+    assert_int_equal(calc_subtract_sat(INT_MIN, 1), INT_MIN);
+    assert_int_equal(calc_subtract_sat(0, INT_MIN), INT_MAX);
+    assert_int_equal(calc_multiply_sat(65536, 65536), INT_MAX);
+    assert_int_equal(calc_multiply_sat(-65536, 65536), INT_MIN);
+    assert_int_equal(calc_multiply_sat(-7, 6), -42);
+    assert_int_equal(calc_divide_sat(INT_MIN, -1), INT_MAX);
+    assert_int_equal(calc_divide_sat(INT_MIN, 0), 0);
+}
+
+static void test_sat_i64_scalar(void **state) {
+    (void)state;
+
+    assert_int_equal(calc_add_sat_i64(INT64_MAX, 1), INT64_MAX);
+    assert_int_equal(calc_subtract_sat_i64(INT64_MIN, INT64_MAX), INT64_MIN);
+    assert_int_equal(calc_multiply_sat_i64(INT64_MIN, -1), INT64_MAX);
+    assert_int_equal(calc_multiply_sat_i64(INT64_C(3037000500), -INT64_C(3037000500)), INT64_MIN);
+    assert_int_equal(calc_divide_sat_i64(INT64_MIN, -1), INT64_MAX);
+    assert_int_equal(calc_divide_sat_i64(-9, 2), -4);
+}
+
+/*============================================================================
+ * Batch variants: every instruction set matches the reference
+ *===========================================================================*/
+
+typedef void (*batch_i32_fn)(const int *a, const int *b, int *out, size_t n);
+typedef void (*batch_i64_fn)(const int64_t *a, const int64_t *b, int64_t *out, size_t n);
+
+struct wide_case {
+    const char *name;
+    int op;
+    batch_i32_fn sat;           /* calc_*_sat_batch */
+    batch_i64_fn wrap64;        /* calc_*_i64_batch */
+    batch_i64_fn sat64;         /* calc_*_sat_i64_batch */
+};
+
+static void fill_i32(int *a, int *b, size_t n) {
+    static const int edges[] = { 0, 1, -1, 46341, -46341, 65536, INT_MAX, INT_MIN };
+    uint32_t seed = 7u;
+
+    test_data_fill_pairs(a, b, n, &seed, edges, sizeof(edges) / sizeof(edges[0]));
+}
+
+static void fill_i64(int64_t *a, int64_t *b, size_t n) {
+    static const int64_t edges[] = {
+        0, 1, -1, INT64_C(3037000500), -INT64_C(3037000500),
+        INT64_C(1) << 32, INT64_MAX, INT64_MIN,
+    };
+    const size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+    uint64_t seed = 11u;
+
+    for (size_t i = 0; i < n; i++) {
+        if (i < n_edges * n_edges) {
+            a[i] = edges[i / n_edges];
+            b[i] = edges[i % n_edges];
+        } else {
+            a[i] = (int64_t)test_data_next64(&seed);
+            b[i] = (i % 2) ? (int64_t)(seed >> 32) - INT64_C(2147483648) : (int64_t)(seed * 31u);
+        }
+    }
+}
+
+static void test_wide_batch(void **state) {
+    const struct wide_case *tc = (const struct wide_case *)*state;
+    int a32[TEST_LEN];
+    int b32[TEST_LEN];
+    int out32[TEST_LEN];
+    int64_t a64[TEST_LEN];
+    int64_t b64[TEST_LEN];
+    int64_t wrap_out[TEST_LEN];
+    int64_t sat_out[TEST_LEN];
+
+    fill_i32(a32, b32, TEST_LEN);
+    fill_i64(a64, b64, TEST_LEN);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        tc->sat(a32, b32, out32, TEST_LEN);
+        tc->wrap64(a64, b64, wrap_out, TEST_LEN);
+        tc->sat64(a64, b64, sat_out, TEST_LEN);
+
+        for (size_t i = 0; i < TEST_LEN; i++) {
+            i128 r32 = reference_exact(tc->op, a32[i], b32[i]);
+            i128 r64 = reference_exact(tc->op, a64[i], b64[i]);
+            assert_int_equal(out32[i], (int)clamp(r32, INT_MIN, INT_MAX));
+            assert_int_equal(wrap_out[i], wrap64(r64));
+            assert_int_equal(sat_out[i], (int64_t)clamp(r64, INT64_MIN, INT64_MAX));
+        }
+    }
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+}
+
+static struct wide_case wide_cases[] = {
+    { "add", OP_ADD, calc_add_sat_batch, calc_add_i64_batch, calc_add_sat_i64_batch },
+    { "subtract", OP_SUBTRACT, calc_subtract_sat_batch, calc_subtract_i64_batch,
+      calc_subtract_sat_i64_batch },
+    { "multiply", OP_MULTIPLY, calc_multiply_sat_batch, calc_multiply_i64_batch,
+      calc_multiply_sat_i64_batch },
+    { "divide", OP_DIVIDE, calc_divide_sat_batch, calc_divide_i64_batch,
+      calc_divide_sat_i64_batch },
+};
+
+/*============================================================================
+ * 128-bit sum
+ *===========================================================================*/
+
+static void test_sum_i64(void **state) {
+    (void)state;
+    int64_t a[TEST_LEN];
+    int64_t b[TEST_LEN];
+
+    fill_i64(a, b, TEST_LEN);
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t n = 0; n <= TEST_LEN; n += 29) {
+            i128 expected = 0;
+            for (size_t i = 0; i < n; i++) {
+                expected += a[i];
+            }
+            assert_true(from_i128(calc_sum_i64(a, n)) == expected);
+        }
+    }
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+}
+
+static void test_sum_i64_overflow(void **state) {
+    (void)state;
+    int64_t max[4] = { INT64_MAX, INT64_MAX, INT64_MAX, INT64_MAX };
+    int64_t min[4] = { INT64_MIN, INT64_MIN, INT64_MIN, INT64_MIN };
+    int64_t mixed[3] = { INT64_MAX, 1, -2 };
+    int64_t r;
+
+    calc_i128_t sum = calc_sum_i64(max, 4);
+    assert_int_equal(sum.hi, 1);
+    assert_int_equal(sum.lo, UINT64_MAX - 3);
+    assert_int_equal(calc_i128_to_i64(sum, &r), CALC_ERR_OVERFLOW);
+
+    sum = calc_sum_i64(min, 4);
+    assert_int_equal(sum.hi, -2);
+    assert_int_equal(sum.lo, 0);
+
+    // The intermediate INT64_MAX + 1 does not fit, the total does
+    sum = calc_sum_i64(mixed, 3);
+    assert_int_equal(calc_i128_to_i64(sum, &r), CALC_OK);
+    assert_int_equal(r, INT64_MAX - 1);
+
+    sum = calc_sum_i64(min, 1);
+    assert_int_equal(calc_i128_to_i64(sum, &r), CALC_OK);
+    assert_int_equal(r, INT64_MIN);
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest scalar_tests[] = {
+        cmocka_unit_test(test_i64_scalar),
+        cmocka_unit_test(test_sat_scalar),
+        cmocka_unit_test(test_sat_i64_scalar),
+    };
+
+    // Parameterized tests using prestate
+    const struct CMUnitTest batch_tests[] = {
+        cmocka_unit_test_prestate(test_wide_batch, &wide_cases[0]),
+        cmocka_unit_test_prestate(test_wide_batch, &wide_cases[1]),
+        cmocka_unit_test_prestate(test_wide_batch, &wide_cases[2]),
+        cmocka_unit_test_prestate(test_wide_batch, &wide_cases[3]),
+        cmocka_unit_test(test_sum_i64),
+        cmocka_unit_test(test_sum_i64_overflow),
+    };
+
+    int result = 0;
+
+    printf("\n========== CALC WIDE MODULE UNIT TESTS ==========\n\n");
+
+    result += cmocka_run_group_tests_name("wide scalar tests", scalar_tests, NULL, NULL);
+    result += cmocka_run_group_tests_name("wide batch tests", batch_tests, NULL, NULL);
+
+    return result;
+}
@@ -0,0 +1,124 @@
+#ifndef __TEST_DATA_H__
+#define __TEST_DATA_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Seeded test data shared by the unit tests
+ *
+ * Every generator advances the same LCG through a seed passed by pointer,
+ * so a test gets the same data on every run and consecutive calls continue
+ * one sequence.
+ */
+
+/**
+ * Advance the generator
+ * @param seed Generator state
+ * @return The new state
+ */
+static inline uint32_t test_data_next(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed;
+}
+
+/**
+ * Advance the 64-bit generator, for 64-bit and multi-limb data
+ * @param seed Generator state
+ * @return The new state
+ */
+static inline uint64_t test_data_next64(uint64_t *seed) {
+    *seed = *seed * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+    return *seed;
+}
+
+/* Value of a generator state in [-range, range], or any int if range is 0 */
+static inline int test_data_scale(uint32_t v, uint32_t range) {
+    if (range == 0) {
+        return (int)v;
+    }
+    // Scale the high bits (the low bits of an LCG are not random); the
+    // subtraction is done in 64 bits: the scaled value may pass INT_MAX
+    return (int)((int64_t)(((uint64_t)v * (2u * (uint64_t)range + 1)) >> 32) - (int64_t)range);
+}
+
+/**
+ * Random int
+ * @param seed Generator state
+ * @param range Bound of the values, 0 for the whole int range
+ * @return Value in [-range, range] (range at most INT_MAX)
+ */
+static inline int test_data_int(uint32_t *seed, uint32_t range) {
+    return test_data_scale(test_data_next(seed), range);
+}
+
+/**
+ * Random int, or now and then one of the edge values
+ * @param seed Generator state
+ * @param range Bound of the random values, 0 for the whole int range
+ * @param edges Edge values
+ * @param n_edges Number of edge values
+ * @param rate About how many values in 16 are edge values
+ * @return Value in [-range, range] or from edges
+ */
+static inline int test_data_int_or_edge(uint32_t *seed, uint32_t range,
+                                        const int *edges, size_t n_edges, unsigned rate) {
+    uint32_t v = test_data_next(seed);
+
+    return (v >> 28) < rate ? edges[(v >> 8) % n_edges] : test_data_scale(v, range);
+}
+
+/**
+ * Fill an array with random ints
+ * @param a Array to fill
+ * @param n Number of elements
+ * @param seed Generator state
+ * @param range Bound of the values, 0 for the whole int range
+ */
+static inline void test_data_fill(int *a, size_t n, uint32_t *seed, uint32_t range) {
+    for (size_t i = 0; i < n; i++) {
+        a[i] = test_data_int(seed, range);
+    }
+}
+
+/**
+ * Fill an array with test_data_int_or_edge values
+ * @param a Array to fill
+ * @param n Number of elements
+ * @param seed Generator state
+ * @param range Bound of the random values, 0 for the whole int range
+ * @param edges Edge values
+ * @param n_edges Number of edge values
+ * @param rate About how many values in 16 are edge values
+ */
+static inline void test_data_fill_edges(int *a, size_t n, uint32_t *seed, uint32_t range,
+                                        const int *edges, size_t n_edges, unsigned rate) {
+    for (size_t i = 0; i < n; i++) {
+        a[i] = test_data_int_or_edge(seed, range, edges, n_edges, rate);
+    }
+}
+
+/**
+ * Fill two operand arrays: every pair of edge values first, then random pairs
+ * @param a First operands
+ * @param b Second operands: alternately small ([-32768, 32768]) and full range
+ * @param n Number of elements
+ * @param seed Generator state
+ * @param edges Edge values
+ * @param n_edges Number of edge values
+ * @note The edge pairs take the first n_edges * n_edges rows (fewer if n is smaller)
+ */
+static inline void test_data_fill_pairs(int *a, int *b, size_t n, uint32_t *seed,
+                                        const int *edges, size_t n_edges) {
+    for (size_t i = 0; i < n; i++) {
+        if (i < n_edges * n_edges) {
+            a[i] = edges[i / n_edges];
+            b[i] = edges[i % n_edges];
+        } else {
+            a[i] = test_data_int(seed, 0);
+            b[i] = test_data_int(seed, (i % 2) ? 32768u : 0);
+        }
+    }
+}
+
+#endif /* __TEST_DATA_H__ */
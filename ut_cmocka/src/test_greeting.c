@@ -8,6 +8,7 @@
  * - String assertions (assert_string_equal)
  * - Pointer assertions (assert_non_null, assert_null)
  * - Memory allocation in tests
+ * - Concurrent calls from several threads (reentrant variants)
  */
 
 #include <stdarg.h>
@@ -17,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 #include <cmocka.h>
 
 #include "greeting.h"
@@ -209,6 +211,77 @@ static void test_greeting_return_not_null(void **state) {
     assert_non_null(say_goodbye(NULL));
 }
 
+/*============================================================================
+ * Reentrant Variants - say_hello_r / say_goodbye_r
+ *===========================================================================*/
+
+static void test_say_hello_r(void **state) {
+    (void)state;
+    char buf[64];
+
+    assert_int_equal(say_hello_r("Alice", buf, sizeof(buf)), strlen("Hello, Alice!"));
+    assert_string_equal(buf, "Hello, Alice!");
+    assert_int_equal(say_hello_r("", buf, sizeof(buf)), strlen("Hello, stranger!"));
+    assert_string_equal(buf, "Hello, stranger!");
+    assert_int_equal(say_goodbye_r(NULL, buf, sizeof(buf)), strlen("Goodbye, stranger!"));
+    assert_string_equal(buf, "Goodbye, stranger!");
+
+    // Same text as the legacy functions
+    say_goodbye_r("O'Brien", buf, sizeof(buf));
+    assert_string_equal(buf, say_goodbye("O'Brien"));
+}
+
+static void test_say_hello_r_truncation(void **state) {
+    (void)state;
+    char buf[8];
+
+    // Returns the full length, writes what fits
+    assert_int_equal(say_hello_r("Alice", buf, sizeof(buf)), 13);
+    assert_string_equal(buf, "Hello, ");
+    assert_int_equal(say_goodbye_r("Bob", buf, 1), 13);
+    assert_string_equal(buf, "");
+
+    // Size query without a buffer
+    assert_int_equal(say_hello_r("Alice", NULL, 0), 13);
+}
+
+#define GREET_THREADS 4
+#define GREET_ROUNDS 2000
+
+struct greet_worker {
+    char name[16];
+    int mismatches;
+};
+
+static void* greet_worker_run(void *arg) {
+    struct greet_worker *w = arg;
+    char expected[32];
+    char buf[32];
+
+    snprintf(expected, sizeof(expected), "Hello, %s!", w->name);
+    for (int i = 0; i < GREET_ROUNDS; i++) {
+        say_hello_r(w->name, buf, sizeof(buf));
+        w->mismatches += strcmp(buf, expected) != 0;
+    }
+    return NULL;
+}
+
+static void test_say_hello_r_threads(void **state) {
+    (void)state;
+    struct greet_worker workers[GREET_THREADS];
+    pthread_t threads[GREET_THREADS];
+
+    for (int t = 0; t < GREET_THREADS; t++) {
+        snprintf(workers[t].name, sizeof(workers[t].name), "Thread%d", t);
+        workers[t].mismatches = 0;
+        assert_int_equal(pthread_create(&threads[t], NULL, greet_worker_run, &workers[t]), 0);
+    }
+    for (int t = 0; t < GREET_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+        assert_int_equal(workers[t].mismatches, 0);
+    }
+}
+
 /*============================================================================
  * Main - Run all tests
  *===========================================================================*/
@@ -241,6 +314,13 @@ int main(void) {
         cmocka_unit_test(test_greeting_return_not_null),
     };
 
+    // Reentrant variants
+    const struct CMUnitTest reentrant_tests[] = {
+        cmocka_unit_test(test_say_hello_r),
+        cmocka_unit_test(test_say_hello_r_truncation),
+        cmocka_unit_test(test_say_hello_r_threads),
+    };
+
     int result = 0;
 
     printf("\n========== GREETING MODULE UNIT TESTS ==========\n\n");
@@ -255,5 +335,8 @@ int main(void) {
     // Run edge case tests
     result += cmocka_run_group_tests_name("edge case tests", edge_case_tests, NULL, NULL);
 
+    // Run reentrant variant tests
+    result += cmocka_run_group_tests_name("reentrant tests", reentrant_tests, NULL, NULL);
+
     return result;
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include <setjmp.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <cmocka.h>
 
 #include "multi-calc.h"
@@ -395,6 +396,48 @@ static void test_compare_mock_vs_real(void **state) {
     printf("    Mock result: %d, Real result: %d\n", mock_result, real_result);
 }
 
+/*============================================================================
+ * Test Cases for multi_calc_average_n
+ *
+ * The array version sums with calc_sum, not calc_add, so no mock values
+ * are queued: a call into a mocked calc_* would fail the test
+ *===========================================================================*/
+
+/**
+ * Test same results as multi_calc_average for three values
+ */
+static void test_average_n_matches_average(void **state) {
+    (void)state;
+    enable_all_mocks();
+
+    const int values[] = { 10, 20, 30 };
+    assert_int_equal(multi_calc_average_n(values, 3), 20);
+
+    const int negative[] = { -5, -5, -6 };
+    assert_int_equal(multi_calc_average_n(negative, 3), -5);   // -16 / 3
+}
+
+/**
+ * Test sum that does not fit in an int
+ */
+static void test_average_n_no_overflow(void **state) {
+    (void)state;
+    enable_all_mocks();
+
+    const int values[] = { INT_MAX, INT_MAX, INT_MAX, INT_MAX - 4 };
+    assert_int_equal(multi_calc_average_n(values, 4), INT_MAX - 1);
+}
+
+/**
+ * Test empty array
+ */
+static void test_average_n_empty(void **state) {
+    (void)state;
+    enable_all_mocks();
+
+    assert_int_equal(multi_calc_average_n(NULL, 0), 0);
+}
+
 /*============================================================================
  * Main - Run all tests
  *===========================================================================*/
@@ -423,6 +466,12 @@ int main(void) {
         cmocka_unit_test(test_compare_mock_vs_real),
     };
 
+    const struct CMUnitTest average_n_tests[] = {
+        cmocka_unit_test(test_average_n_matches_average),
+        cmocka_unit_test(test_average_n_no_overflow),
+        cmocka_unit_test(test_average_n_empty),
+    };
+
     int result = 0;
 
     printf("\n========== MULTI-CALC MODULE MOCK TESTS ==========\n\n");
@@ -430,6 +479,7 @@ int main(void) {
     result += cmocka_run_group_tests_name("expression mock tests", expression_tests, NULL, NULL);
     result += cmocka_run_group_tests_name("average mock tests", average_tests, NULL, NULL);
     result += cmocka_run_group_tests_name("hybrid tests (real + mock)", hybrid_tests, NULL, NULL);
+    result += cmocka_run_group_tests_name("average_n tests", average_n_tests, NULL, NULL);
 
     return result;
 }
\ No newline at end of file
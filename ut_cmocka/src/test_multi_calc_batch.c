@@ -0,0 +1,144 @@
+/**
+ * @file test_multi_calc_batch.c
+ * @brief Unit tests for the fused multi_calc_expression batch kernels
+ *
+ * Every kernel supported by the running CPU is checked against
+ * multi_calc_expression's wrapped results, for both the column and the
+ * tuple layout.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers through state
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "multi-calc-batch.h"
+#include "calc-batch.h"
+#include "test_data.h"
+
+#define TEST_LEN 301    /* Not a multiple of any vector width: exercises tails */
+
+struct expression_buffers {
+    int a[TEST_LEN];
+    int b[TEST_LEN];
+    int c[TEST_LEN];
+    int d[TEST_LEN];
+    multi_calc_tuple_t tuples[TEST_LEN];
+    int out[TEST_LEN];
+};
+
+static int setup_buffers(void **state) {
+    static const int edges[] = { 0, 1, -1, 46341, INT_MAX, INT_MIN };
+    struct expression_buffers *buf = test_malloc(sizeof(*buf));
+    const size_t n_edges = sizeof(edges) / sizeof(edges[0]);
+    uint32_t seed = 777u;
+
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        int v[4];
+        for (int k = 0; k < 4; k++) {
+            // Mostly random values, some edge values to force overflow
+            v[k] = test_data_int_or_edge(&seed, 0, edges, n_edges, 1);
+        }
+        buf->a[i] = buf->tuples[i].a = v[0];
+        buf->b[i] = buf->tuples[i].b = v[1];
+        buf->c[i] = buf->tuples[i].c = v[2];
+        buf->d[i] = buf->tuples[i].d = v[3];
+    }
+    *state = buf;
+    return 0;
+}
+
+static int teardown_buffers(void **state) {
+    test_free(*state);
+    calc_batch_set_isa(CALC_ISA_SCALAR);
+    return 0;
+}
+
+/*
+ * multi_calc_expression in wrapping unsigned arithmetic: the inputs
+ * overflow, and calling the signed calc_* functions on them would be
+ * undefined
+ */
+static int ref_expression(int a, int b, int c, int d) {
+    return (int)(((unsigned)a + (unsigned)b) * ((unsigned)c - (unsigned)d));
+}
+
+static void check_out(const struct expression_buffers *buf, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        assert_int_equal(buf->out[i], ref_expression(buf->a[i], buf->b[i], buf->c[i], buf->d[i]));
+    }
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_columns_all_isas(void **state) {
+    struct expression_buffers *buf = *state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        // Short lengths cover every tail size of every vector width
+        for (size_t n = 0; n <= 40; n++) {
+            multi_calc_expression_batch(buf->a, buf->b, buf->c, buf->d, buf->out, n);
+            check_out(buf, n);
+        }
+        multi_calc_expression_batch(buf->a, buf->b, buf->c, buf->d, buf->out, TEST_LEN);
+        check_out(buf, TEST_LEN);
+    }
+}
+
+static void test_tuples_all_isas(void **state) {
+    struct expression_buffers *buf = *state;
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t n = 0; n <= 40; n++) {
+            multi_calc_expression_batch_aos(buf->tuples, buf->out, n);
+            check_out(buf, n);
+        }
+        multi_calc_expression_batch_aos(buf->tuples, buf->out, TEST_LEN);
+        check_out(buf, TEST_LEN);
+    }
+}
+
+static void test_output_aliases_input(void **state) {
+    struct expression_buffers *buf = *state;
+    int copy[TEST_LEN];
+
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        copy[i] = buf->c[i];
+    }
+    // Results overwrite the c column in place
+    multi_calc_expression_batch(buf->a, buf->b, copy, buf->d, copy, TEST_LEN);
+    for (size_t i = 0; i < TEST_LEN; i++) {
+        assert_int_equal(copy[i], ref_expression(buf->a[i], buf->b[i], buf->c[i], buf->d[i]));
+    }
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_columns_all_isas),
+        cmocka_unit_test(test_tuples_all_isas),
+        cmocka_unit_test(test_output_aliases_input),
+    };
+
+    printf("\n========== MULTI CALC BATCH MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("multi calc batch tests", tests,
+                                       setup_buffers, teardown_buffers);
+}
@@ -0,0 +1,236 @@
+/**
+ * @file test_multi_calc_poly.c
+ * @brief Unit tests for integer powers and polynomial evaluation
+ *
+ * Batch results and overflow flags are checked element by element against
+ * the scalar functions, for every instruction set the CPU supports and
+ * with the calc-pool split.
+ *
+ * Demonstrates cmocka features:
+ * - Group setup/teardown to share test buffers through state
+ * - Per-test teardown restoring global settings
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <cmocka.h>
+
+#include "multi-calc-poly.h"
+#include "calc-batch.h"
+#include "calc-ops.h"
+#include "calc-pool.h"
+#include "test_data.h"
+
+#define TEST_LEN 203
+#define LARGE_LEN (3 * CALC_POOL_BATCH_GRAIN + 5)   /* Takes the calc-pool split */
+
+struct poly_buffers {
+    int x[LARGE_LEN];
+    int out[LARGE_LEN];
+    unsigned char flags[CALC_BITMAP_BYTES(LARGE_LEN)];
+};
+
+static int setup_buffers(void **state) {
+    *state = test_malloc(sizeof(struct poly_buffers));
+    return 0;
+}
+
+static int teardown_buffers(void **state) {
+    test_free(*state);
+    return 0;
+}
+
+static int reset_settings(void **state) {
+    (void)state;
+    calc_pool_set_threads(1);
+    calc_ops_set(NULL);
+    return 0;
+}
+
+/* Random ints in [-range, range] with some edge values mixed in */
+static void fill(int *a, size_t n, uint32_t seed, uint32_t range) {
+    static const int edges[] = { 0, 1, -1, INT_MAX, INT_MIN };
+
+    test_data_fill_edges(a, n, &seed, range, edges, sizeof(edges) / sizeof(edges[0]), 1);
+}
+
+/*
+ * References in wrapping unsigned arithmetic, by plain repeated
+ * multiplication and summing terms: the inputs overflow, and calling the
+ * plain functions (signed calc_multiply / calc_add) on them would be
+ * undefined
+ */
+static int ref_pow(int base, unsigned exponent) {
+    unsigned r = 1;
+
+    for (unsigned e = 0; e < exponent; e++) {
+        r *= (unsigned)base;
+    }
+    return (int)r;
+}
+
+static int ref_poly(const int *coeffs, size_t count, int x) {
+    unsigned r = 0, power = 1;
+
+    for (size_t k = 0; k < count; k++) {
+        r += (unsigned)coeffs[k] * power;
+        power *= (unsigned)x;
+    }
+    return (int)r;
+}
+
+/* Batch output and flags must match the scalar checked function */
+static void check_pow(struct poly_buffers *buf, unsigned exponent, size_t n, size_t overflows) {
+    size_t expected = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int r;
+        int flagged = calc_pow_checked(buf->x[i], exponent, &r) != CALC_OK;
+        expected += (size_t)flagged;
+        assert_int_equal(buf->out[i], r);
+        assert_int_equal((buf->flags[i / 8] >> (i % 8)) & 1, flagged);
+    }
+    assert_int_equal(overflows, expected);
+}
+
+static void check_poly(struct poly_buffers *buf, const int *coeffs, size_t count,
+                       size_t n, size_t overflows) {
+    size_t expected = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        int r;
+        int flagged = multi_calc_poly_checked(coeffs, count, buf->x[i], &r) != CALC_OK;
+        expected += (size_t)flagged;
+        assert_int_equal(buf->out[i], r);
+        assert_int_equal((buf->flags[i / 8] >> (i % 8)) & 1, flagged);
+    }
+    assert_int_equal(overflows, expected);
+}
+
+/*============================================================================
+ * Test cases
+ *===========================================================================*/
+
+static void test_pow_scalar(void **state) {
+    (void)state;
+    int r;
+
+    assert_int_equal(calc_pow(2, 10), 1024);
+    assert_int_equal(calc_pow(-3, 5), -243);
+    assert_int_equal(calc_pow(7, 0), 1);
+    assert_int_equal(calc_pow(0, 0), 1);
+    assert_int_equal(calc_pow(0, 9), 0);
+    assert_int_equal(calc_pow(-1, 4000000001u), -1);
+
+    // (-2)^31 fits, 2^31 wraps to the same bits
+    assert_int_equal(calc_pow_checked(-2, 31, &r), CALC_OK);
+    assert_int_equal(r, INT_MIN);
+    assert_int_equal(calc_pow_checked(2, 31, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(r, INT_MIN);
+
+    // 3^20 = 3486784401: low 32 bits
+    assert_int_equal(calc_pow_checked(3, 20, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(r, (int)3486784401u);
+    assert_int_equal(calc_pow_checked(3, 19, &r), CALC_OK);
+    assert_int_equal(r, 1162261467);
+    assert_int_equal(calc_pow_checked(46341, 2, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(calc_pow_checked(46340, 2, &r), CALC_OK);
+}
+
+static void test_poly_scalar(void **state) {
+    (void)state;
+    static const int coeffs[] = { 1, -2, 3 };
+    static const int sums[] = { INT_MIN, INT_MAX, 1 };
+    int r;
+
+    assert_int_equal(multi_calc_poly(coeffs, 3, 2), 9);         // 1 - 4 + 12
+    assert_int_equal(multi_calc_poly(coeffs, 3, -1), 6);
+    assert_int_equal(multi_calc_poly(coeffs, 1, 100), 1);
+    assert_int_equal(multi_calc_poly(coeffs, 0, 100), 0);
+    assert_int_equal(multi_calc_poly_checked(coeffs, 0, 5, &r), CALC_OK);
+    assert_int_equal(r, 0);
+
+    // Same result through another backend
+    assert_int_equal(calc_ops_set(&calc_ops_simd), 0);
+    assert_int_equal(multi_calc_poly(coeffs, 3, 2), 9);
+    assert_int_equal(calc_pow(-3, 5), -243);
+    calc_ops_set(NULL);
+
+    // At x = 1 the Horner step 1 + INT_MAX overflows although the sum is 0
+    assert_int_equal(multi_calc_poly_checked(sums, 3, 1, &r), CALC_ERR_OVERFLOW);
+    assert_int_equal(r, 0);
+    assert_int_equal(multi_calc_poly_checked(sums, 2, 1, &r), CALC_OK);
+    assert_int_equal(r, -1);
+}
+
+static void test_batches_all_isas(void **state) {
+    struct poly_buffers *buf = *state;
+    calc_isa_t detected = calc_batch_isa();
+    static const unsigned exponents[] = { 0, 1, 2, 3, 7, 13, 31, 64 };
+    static const int coeffs[] = { 5, -3, 0, 7, 1, -1, 2, -9, 4 };
+
+    for (int isa = CALC_ISA_SCALAR; isa <= CALC_ISA_AVX512; isa++) {
+        if (calc_batch_set_isa((calc_isa_t)isa) != 0) {
+            continue;
+        }
+        for (size_t e = 0; e < sizeof(exponents) / sizeof(exponents[0]); e++) {
+            fill(buf->x, TEST_LEN, 1u + (uint32_t)e, 20);
+            check_pow(buf, exponents[e],
+                      TEST_LEN, calc_pow_checked_batch(buf->x, exponents[e], buf->out,
+                                                       buf->flags, TEST_LEN));
+            memset(buf->out, 0, sizeof(int) * TEST_LEN);
+            calc_pow_batch(buf->x, exponents[e], buf->out, TEST_LEN);
+            for (size_t i = 0; i < TEST_LEN; i++) {
+                assert_int_equal(buf->out[i], ref_pow(buf->x[i], exponents[e]));
+            }
+        }
+        for (size_t count = 0; count <= sizeof(coeffs) / sizeof(coeffs[0]); count++) {
+            fill(buf->x, TEST_LEN, 7u + (uint32_t)count, 30);
+            check_poly(buf, coeffs, count, TEST_LEN,
+                       multi_calc_poly_checked_batch(coeffs, count, buf->x, buf->out,
+                                                     buf->flags, TEST_LEN));
+            // In place, without flags
+            multi_calc_poly_batch(coeffs, count, buf->x, buf->x, TEST_LEN);
+            fill(buf->out, TEST_LEN, 7u + (uint32_t)count, 30);
+            for (size_t i = 0; i < TEST_LEN; i++) {
+                assert_int_equal(buf->x[i], ref_poly(coeffs, count, buf->out[i]));
+            }
+        }
+    }
+    calc_batch_set_isa(detected);
+}
+
+static void test_batches_threads(void **state) {
+    struct poly_buffers *buf = *state;
+    static const int coeffs[] = { 3, 0, -2, 1, 5 };
+
+    calc_pool_set_threads(4);
+    fill(buf->x, LARGE_LEN, 11u, 200);
+    check_pow(buf, 5, LARGE_LEN,
+              calc_pow_checked_batch(buf->x, 5, buf->out, buf->flags, LARGE_LEN));
+    check_poly(buf, coeffs, 5, LARGE_LEN,
+               multi_calc_poly_checked_batch(coeffs, 5, buf->x, buf->out, buf->flags, LARGE_LEN));
+}
+
+/*============================================================================
+ * Main - Run all tests
+ *===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_pow_scalar),
+        cmocka_unit_test_teardown(test_poly_scalar, reset_settings),
+        cmocka_unit_test(test_batches_all_isas),
+        cmocka_unit_test_teardown(test_batches_threads, reset_settings),
+    };
+
+    printf("\n========== MULTI CALC POLY MODULE UNIT TESTS ==========\n\n");
+
+    return cmocka_run_group_tests_name("multi calc poly tests", tests,
+                                       setup_buffers, teardown_buffers);
+}
@@ -14,13 +14,36 @@ CMOCKA_OBJS := $(patsubst $(CMOCKA_SRC_DIR)/%.c, $(UT_OUTPUT_DIR)/%.o, $(CMOCKA_
 CMOCKA_TEST_CALC := $(DIST_DIR)/cmocka_test_calc
 CMOCKA_TEST_GREETING := $(DIST_DIR)/cmocka_test_greeting
 CMOCKA_TEST_MULTI_CALC := $(DIST_DIR)/cmocka_test_multi_calc
+CMOCKA_TEST_CALC_BATCH := $(DIST_DIR)/cmocka_test_calc_batch
+CMOCKA_TEST_CALC_CHECKED := $(DIST_DIR)/cmocka_test_calc_checked
+CMOCKA_TEST_CALC_DIVIDER := $(DIST_DIR)/cmocka_test_calc_divider
+CMOCKA_TEST_CALC_INLINE := $(DIST_DIR)/cmocka_test_calc_inline
+CMOCKA_TEST_CALC_WIDE := $(DIST_DIR)/cmocka_test_calc_wide
+CMOCKA_TEST_CALC_REDUCE := $(DIST_DIR)/cmocka_test_calc_reduce
+CMOCKA_TEST_CALC_OPS := $(DIST_DIR)/cmocka_test_calc_ops
+CMOCKA_TEST_MULTI_CALC_BATCH := $(DIST_DIR)/cmocka_test_multi_calc_batch
+CMOCKA_TEST_CALC_EXPR := $(DIST_DIR)/cmocka_test_calc_expr
+CMOCKA_TEST_CALC_JIT := $(DIST_DIR)/cmocka_test_calc_jit
+CMOCKA_TEST_CALC_ROLLING := $(DIST_DIR)/cmocka_test_calc_rolling
+CMOCKA_TEST_CALC_POOL := $(DIST_DIR)/cmocka_test_calc_pool
+CMOCKA_TEST_CALC_ASYNC := $(DIST_DIR)/cmocka_test_calc_async
+CMOCKA_TEST_CALC_ARROW := $(DIST_DIR)/cmocka_test_calc_arrow
+CMOCKA_TEST_CALC_SELECT := $(DIST_DIR)/cmocka_test_calc_select
+CMOCKA_TEST_CALC_ENCODED := $(DIST_DIR)/cmocka_test_calc_encoded
+CMOCKA_TEST_CALC_GROUP := $(DIST_DIR)/cmocka_test_calc_group
+CMOCKA_TEST_CALC_BIGINT := $(DIST_DIR)/cmocka_test_calc_bigint
+CMOCKA_TEST_CALC_LINALG := $(DIST_DIR)/cmocka_test_calc_linalg
+CMOCKA_TEST_MULTI_CALC_POLY := $(DIST_DIR)/cmocka_test_multi_calc_poly
+
+# Backend shared object loaded by cmocka_test_calc_ops
+CMOCKA_CALC_OPS_PLUGIN := $(DIST_DIR)/libcmocka_calc_ops_plugin.so
 
 # UT report directory
 CMOCKA_REPORT_DIR := $(BUILD_DIR)/ut-cmocka-report
 
 # UT specific flags (use installed SDK from build directory)
 CMOCKA_CFLAGS := $(CFLAGS) -I$(SDK_INSTALL_INC_DIR) -I$(CMOCKA_INC_DIR)
-CMOCKA_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CMOCKA_LIB_DIR) -lsdk -lcmocka -Wl,-rpath,$(CMOCKA_LIB_DIR)
+CMOCKA_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CMOCKA_LIB_DIR) -lsdk -pthread -ldl -lcmocka -Wl,-rpath,$(CMOCKA_LIB_DIR)
 
 # Mock test specific LDFLAGS (--wrap options for mocking calc functions)
 CMOCKA_MOCK_LDFLAGS := $(CMOCKA_LDFLAGS) \
@@ -54,6 +77,66 @@ ut_cmocka_run: ut_cmocka_build
 	@echo ""
 	@echo "--- Running cmocka_test_multi_calc (Mock Tests) ---"
 	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_MULTI_CALC)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_batch ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_BATCH)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_checked ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_CHECKED)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_divider ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_DIVIDER)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_inline (with wrap) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_INLINE)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_wide ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_WIDE)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_reduce ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_REDUCE)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_ops (loads a backend .so) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_OPS)
+	@echo ""
+	@echo "--- Running cmocka_test_multi_calc_batch ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_MULTI_CALC_BATCH)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_expr ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_EXPR)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_jit ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_JIT)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_rolling ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_ROLLING)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_pool ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_POOL)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_async ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_ASYNC)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_arrow ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_ARROW)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_select ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_SELECT)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_encoded ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_ENCODED)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_group ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_GROUP)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_bigint ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_BIGINT)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_linalg ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_CALC_LINALG)
+	@echo ""
+	@echo "--- Running cmocka_test_multi_calc_poly ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_TEST_MULTI_CALC_POLY)
 
 # Generate XML reports and HTML report
 .PHONY: ut_cmocka_report
@@ -75,6 +158,86 @@ ut_cmocka_report: ut_cmocka_build
 		CMOCKA_MESSAGE_OUTPUT=XML \
 		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_multi_calc_%g.xml \
 		$(CMOCKA_TEST_MULTI_CALC) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_batch_%g.xml \
+		$(CMOCKA_TEST_CALC_BATCH) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_checked_%g.xml \
+		$(CMOCKA_TEST_CALC_CHECKED) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_divider_%g.xml \
+		$(CMOCKA_TEST_CALC_DIVIDER) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_inline_%g.xml \
+		$(CMOCKA_TEST_CALC_INLINE) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_wide_%g.xml \
+		$(CMOCKA_TEST_CALC_WIDE) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_reduce_%g.xml \
+		$(CMOCKA_TEST_CALC_REDUCE) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_ops_%g.xml \
+		$(CMOCKA_TEST_CALC_OPS) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_multi_calc_batch_%g.xml \
+		$(CMOCKA_TEST_MULTI_CALC_BATCH) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_expr_%g.xml \
+		$(CMOCKA_TEST_CALC_EXPR) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_jit_%g.xml \
+		$(CMOCKA_TEST_CALC_JIT) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_rolling_%g.xml \
+		$(CMOCKA_TEST_CALC_ROLLING) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_pool_%g.xml \
+		$(CMOCKA_TEST_CALC_POOL) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_async_%g.xml \
+		$(CMOCKA_TEST_CALC_ASYNC) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_arrow_%g.xml \
+		$(CMOCKA_TEST_CALC_ARROW) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_select_%g.xml \
+		$(CMOCKA_TEST_CALC_SELECT) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_encoded_%g.xml \
+		$(CMOCKA_TEST_CALC_ENCODED) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_group_%g.xml \
+		$(CMOCKA_TEST_CALC_GROUP) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_bigint_%g.xml \
+		$(CMOCKA_TEST_CALC_BIGINT) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_calc_linalg_%g.xml \
+		$(CMOCKA_TEST_CALC_LINALG) || true
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH \
+		CMOCKA_MESSAGE_OUTPUT=XML \
+		CMOCKA_XML_FILE=$(CMOCKA_REPORT_DIR)/test_multi_calc_poly_%g.xml \
+		$(CMOCKA_TEST_MULTI_CALC_POLY) || true
 	@echo "Generating HTML report..."
 	@cd $(CMOCKA_REPORT_DIR) && junit2html --merge merged.xml *.xml && junit2html merged.xml report.html
 	@echo ""
@@ -84,11 +247,31 @@ ut_cmocka_report: ut_cmocka_build
 
 # Build unit tests only (without running)
 .PHONY: ut_cmocka_build
-ut_cmocka_build: sdk_install $(CMOCKA_TEST_CALC) $(CMOCKA_TEST_GREETING) $(CMOCKA_TEST_MULTI_CALC)
+ut_cmocka_build: sdk_install $(CMOCKA_TEST_CALC) $(CMOCKA_TEST_GREETING) $(CMOCKA_TEST_MULTI_CALC) $(CMOCKA_TEST_CALC_BATCH) $(CMOCKA_TEST_CALC_CHECKED) $(CMOCKA_TEST_CALC_DIVIDER) $(CMOCKA_TEST_CALC_INLINE) $(CMOCKA_TEST_CALC_WIDE) $(CMOCKA_TEST_CALC_REDUCE) $(CMOCKA_TEST_CALC_OPS) $(CMOCKA_TEST_MULTI_CALC_BATCH) $(CMOCKA_TEST_CALC_EXPR) $(CMOCKA_TEST_CALC_JIT) $(CMOCKA_TEST_CALC_ROLLING) $(CMOCKA_TEST_CALC_POOL) $(CMOCKA_TEST_CALC_ASYNC) $(CMOCKA_TEST_CALC_ARROW) $(CMOCKA_TEST_CALC_SELECT) $(CMOCKA_TEST_CALC_ENCODED) $(CMOCKA_TEST_CALC_GROUP) $(CMOCKA_TEST_CALC_BIGINT) $(CMOCKA_TEST_CALC_LINALG) $(CMOCKA_TEST_MULTI_CALC_POLY)
 	@echo "CMocka test executables built successfully"
 	@echo "  - $(CMOCKA_TEST_CALC)"
 	@echo "  - $(CMOCKA_TEST_GREETING)"
 	@echo "  - $(CMOCKA_TEST_MULTI_CALC) (with mock)"
+	@echo "  - $(CMOCKA_TEST_CALC_BATCH)"
+	@echo "  - $(CMOCKA_TEST_CALC_CHECKED)"
+	@echo "  - $(CMOCKA_TEST_CALC_DIVIDER)"
+	@echo "  - $(CMOCKA_TEST_CALC_INLINE) (with mock)"
+	@echo "  - $(CMOCKA_TEST_CALC_WIDE)"
+	@echo "  - $(CMOCKA_TEST_CALC_REDUCE)"
+	@echo "  - $(CMOCKA_TEST_CALC_OPS)"
+	@echo "  - $(CMOCKA_TEST_MULTI_CALC_BATCH)"
+	@echo "  - $(CMOCKA_TEST_CALC_EXPR)"
+	@echo "  - $(CMOCKA_TEST_CALC_JIT)"
+	@echo "  - $(CMOCKA_TEST_CALC_ROLLING)"
+	@echo "  - $(CMOCKA_TEST_CALC_POOL)"
+	@echo "  - $(CMOCKA_TEST_CALC_ASYNC)"
+	@echo "  - $(CMOCKA_TEST_CALC_ARROW)"
+	@echo "  - $(CMOCKA_TEST_CALC_SELECT)"
+	@echo "  - $(CMOCKA_TEST_CALC_ENCODED)"
+	@echo "  - $(CMOCKA_TEST_CALC_GROUP)"
+	@echo "  - $(CMOCKA_TEST_CALC_BIGINT)"
+	@echo "  - $(CMOCKA_TEST_CALC_LINALG)"
+	@echo "  - $(CMOCKA_TEST_MULTI_CALC_POLY)"
 
 # Build cmocka_test_calc executable
 $(CMOCKA_TEST_CALC): $(UT_OUTPUT_DIR)/test_calc.o
@@ -108,6 +291,135 @@ $(CMOCKA_TEST_MULTI_CALC): $(UT_OUTPUT_DIR)/test_multi_calc.o
 	@$(MKDIR) $(dir $@)
 	$(CC) $< -o $@ $(CMOCKA_MOCK_LDFLAGS)
 
+# Build cmocka_test_calc_batch executable
+$(CMOCKA_TEST_CALC_BATCH): $(UT_OUTPUT_DIR)/test_calc_batch.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_checked executable
+$(CMOCKA_TEST_CALC_CHECKED): $(UT_OUTPUT_DIR)/test_calc_checked.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_divider executable
+$(CMOCKA_TEST_CALC_DIVIDER): $(UT_OUTPUT_DIR)/test_calc_divider.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_inline executable (with --wrap, checks inlining)
+$(CMOCKA_TEST_CALC_INLINE): $(UT_OUTPUT_DIR)/test_calc_inline.o
+	@echo "Building test executable (with mock): $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_MOCK_LDFLAGS)
+
+# Build cmocka_test_calc_wide executable
+$(CMOCKA_TEST_CALC_WIDE): $(UT_OUTPUT_DIR)/test_calc_wide.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_reduce executable
+$(CMOCKA_TEST_CALC_REDUCE): $(UT_OUTPUT_DIR)/test_calc_reduce.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_ops executable
+$(CMOCKA_TEST_CALC_OPS): $(UT_OUTPUT_DIR)/test_calc_ops.o $(CMOCKA_CALC_OPS_PLUGIN)
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# The test finds the backend through a path compiled into it
+$(UT_OUTPUT_DIR)/test_calc_ops.o: CMOCKA_CFLAGS += -DCALC_OPS_PLUGIN='"$(CMOCKA_CALC_OPS_PLUGIN)"'
+
+# Build the backend shared object (needs only the SDK headers)
+$(CMOCKA_CALC_OPS_PLUGIN): ut_cmocka/plugin/calc_ops_plugin.c
+	@echo "Building backend plugin: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $(CMOCKA_CFLAGS) -shared -fPIC $< -o $@
+
+# Build cmocka_test_multi_calc_batch executable
+$(CMOCKA_TEST_MULTI_CALC_BATCH): $(UT_OUTPUT_DIR)/test_multi_calc_batch.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_expr executable
+$(CMOCKA_TEST_CALC_EXPR): $(UT_OUTPUT_DIR)/test_calc_expr.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_jit executable
+$(CMOCKA_TEST_CALC_JIT): $(UT_OUTPUT_DIR)/test_calc_jit.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_rolling executable
+$(CMOCKA_TEST_CALC_ROLLING): $(UT_OUTPUT_DIR)/test_calc_rolling.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_pool executable
+$(CMOCKA_TEST_CALC_POOL): $(UT_OUTPUT_DIR)/test_calc_pool.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_async executable
+$(CMOCKA_TEST_CALC_ASYNC): $(UT_OUTPUT_DIR)/test_calc_async.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_arrow executable
+$(CMOCKA_TEST_CALC_ARROW): $(UT_OUTPUT_DIR)/test_calc_arrow.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_select executable
+$(CMOCKA_TEST_CALC_SELECT): $(UT_OUTPUT_DIR)/test_calc_select.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_encoded executable
+$(CMOCKA_TEST_CALC_ENCODED): $(UT_OUTPUT_DIR)/test_calc_encoded.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_group executable
+$(CMOCKA_TEST_CALC_GROUP): $(UT_OUTPUT_DIR)/test_calc_group.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_bigint executable
+$(CMOCKA_TEST_CALC_BIGINT): $(UT_OUTPUT_DIR)/test_calc_bigint.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_calc_linalg executable
+$(CMOCKA_TEST_CALC_LINALG): $(UT_OUTPUT_DIR)/test_calc_linalg.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
+# Build cmocka_test_multi_calc_poly executable
+$(CMOCKA_TEST_MULTI_CALC_POLY): $(UT_OUTPUT_DIR)/test_multi_calc_poly.o
+	@echo "Building test executable: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $< -o $@ $(CMOCKA_LDFLAGS)
+
 # Compile UT source files
 $(UT_OUTPUT_DIR)/%.o: $(CMOCKA_SRC_DIR)/%.c
 	@echo "Compiling: $<"
@@ -117,4 +429,4 @@ $(UT_OUTPUT_DIR)/%.o: $(CMOCKA_SRC_DIR)/%.c
 # Clean CMocka UT artifacts
 .PHONY: clean-ut-cmocka
 clean-ut-cmocka:
-	$(RM) $(UT_OUTPUT_DIR) $(CMOCKA_REPORT_DIR) $(CMOCKA_TEST_CALC) $(CMOCKA_TEST_GREETING) $(CMOCKA_TEST_MULTI_CALC)
+	$(RM) $(UT_OUTPUT_DIR) $(CMOCKA_REPORT_DIR) $(CMOCKA_TEST_CALC) $(CMOCKA_TEST_GREETING) $(CMOCKA_TEST_MULTI_CALC) $(CMOCKA_TEST_CALC_BATCH) $(CMOCKA_TEST_CALC_CHECKED) $(CMOCKA_TEST_CALC_DIVIDER) $(CMOCKA_TEST_CALC_INLINE) $(CMOCKA_TEST_CALC_WIDE) $(CMOCKA_TEST_CALC_REDUCE) $(CMOCKA_TEST_CALC_OPS) $(CMOCKA_CALC_OPS_PLUGIN) $(CMOCKA_TEST_MULTI_CALC_BATCH) $(CMOCKA_TEST_CALC_EXPR) $(CMOCKA_TEST_CALC_JIT) $(CMOCKA_TEST_CALC_ROLLING) $(CMOCKA_TEST_CALC_POOL) $(CMOCKA_TEST_CALC_ASYNC) $(CMOCKA_TEST_CALC_ARROW) $(CMOCKA_TEST_CALC_SELECT) $(CMOCKA_TEST_CALC_ENCODED) $(CMOCKA_TEST_CALC_GROUP) $(CMOCKA_TEST_CALC_BIGINT) $(CMOCKA_TEST_CALC_LINALG) $(CMOCKA_TEST_MULTI_CALC_POLY)
@@ -23,13 +23,34 @@ CMOCKA_COV_UT_OBJS := $(patsubst $(CMOCKA_SRC_DIR)/%.c, $(CMOCKA_COV_UT_OUTPUT_D
 CMOCKA_COV_TEST_CALC := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc
 CMOCKA_COV_TEST_GREETING := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_greeting
 CMOCKA_COV_TEST_MULTI_CALC := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_multi_calc
+CMOCKA_COV_TEST_CALC_BATCH := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_batch
+CMOCKA_COV_TEST_CALC_CHECKED := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_checked
+CMOCKA_COV_TEST_CALC_DIVIDER := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_divider
+CMOCKA_COV_TEST_CALC_INLINE := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_inline
+CMOCKA_COV_TEST_CALC_WIDE := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_wide
+CMOCKA_COV_TEST_CALC_REDUCE := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_reduce
+CMOCKA_COV_TEST_CALC_OPS := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_ops
+CMOCKA_COV_TEST_MULTI_CALC_BATCH := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_multi_calc_batch
+CMOCKA_COV_TEST_CALC_EXPR := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_expr
+CMOCKA_COV_TEST_CALC_JIT := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_jit
+CMOCKA_COV_TEST_CALC_ROLLING := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_rolling
+CMOCKA_COV_TEST_CALC_POOL := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_pool
+CMOCKA_COV_TEST_CALC_ASYNC := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_async
+CMOCKA_COV_TEST_CALC_ARROW := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_arrow
+CMOCKA_COV_TEST_CALC_SELECT := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_select
+CMOCKA_COV_TEST_CALC_ENCODED := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_encoded
+CMOCKA_COV_TEST_CALC_GROUP := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_group
+CMOCKA_COV_TEST_CALC_BIGINT := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_bigint
+CMOCKA_COV_TEST_CALC_LINALG := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_calc_linalg
+CMOCKA_COV_TEST_MULTI_CALC_POLY := $(CMOCKA_COV_OUTPUT_DIR)/cmocka_test_multi_calc_poly
+CMOCKA_COV_CALC_OPS_PLUGIN := $(CMOCKA_COV_OUTPUT_DIR)/libcmocka_calc_ops_plugin.so
 
 # Coverage SDK library
 CMOCKA_COV_SDK_LIB := $(CMOCKA_COV_OUTPUT_DIR)/libsdk_cov.a
 
 # UT specific flags for coverage build
 CMOCKA_COV_UT_CFLAGS := $(CMOCKA_COV_CFLAGS) -Isdk/include -I$(CMOCKA_INC_DIR)
-CMOCKA_COV_UT_LDFLAGS := $(CMOCKA_COV_LDFLAGS) -L$(CMOCKA_COV_OUTPUT_DIR) -L$(CMOCKA_LIB_DIR) -lsdk_cov -lcmocka -Wl,-rpath,$(CMOCKA_LIB_DIR)
+CMOCKA_COV_UT_LDFLAGS := $(CMOCKA_COV_LDFLAGS) -L$(CMOCKA_COV_OUTPUT_DIR) -L$(CMOCKA_LIB_DIR) -lsdk_cov -pthread -ldl -lcmocka -Wl,-rpath,$(CMOCKA_LIB_DIR)
 
 # Mock test specific LDFLAGS for coverage
 CMOCKA_COV_MOCK_LDFLAGS := $(CMOCKA_COV_UT_LDFLAGS) \
@@ -63,6 +84,66 @@ ut_cmocka_cov_run: ut_cmocka_cov_build
 	@echo ""
 	@echo "--- Running cmocka_test_multi_calc (coverage) ---"
 	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_MULTI_CALC)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_batch (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_BATCH)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_checked (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_CHECKED)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_divider (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_DIVIDER)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_inline (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_INLINE)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_wide (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_WIDE)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_reduce (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_REDUCE)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_ops (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_OPS)
+	@echo ""
+	@echo "--- Running cmocka_test_multi_calc_batch (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_MULTI_CALC_BATCH)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_expr (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_EXPR)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_jit (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_JIT)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_rolling (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_ROLLING)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_pool (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_POOL)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_async (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_ASYNC)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_arrow (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_ARROW)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_select (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_SELECT)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_encoded (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_ENCODED)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_group (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_GROUP)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_bigint (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_BIGINT)
+	@echo ""
+	@echo "--- Running cmocka_test_calc_linalg (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_CALC_LINALG)
+	@echo ""
+	@echo "--- Running cmocka_test_multi_calc_poly (coverage) ---"
+	@LD_LIBRARY_PATH=$(CMOCKA_LIB_DIR):$$LD_LIBRARY_PATH $(CMOCKA_COV_TEST_MULTI_CALC_POLY)
 
 # Generate coverage report using lcov and genhtml
 .PHONY: ut_cmocka_cov_report
@@ -95,7 +176,7 @@ $(CMOCKA_COV_SDK_OUTPUT_DIR)/%.o: sdk/src/%.c
 
 # Build coverage test executables
 .PHONY: ut_cmocka_cov_build
-ut_cmocka_cov_build: $(CMOCKA_COV_SDK_LIB) $(CMOCKA_COV_TEST_CALC) $(CMOCKA_COV_TEST_GREETING) $(CMOCKA_COV_TEST_MULTI_CALC)
+ut_cmocka_cov_build: $(CMOCKA_COV_SDK_LIB) $(CMOCKA_COV_TEST_CALC) $(CMOCKA_COV_TEST_GREETING) $(CMOCKA_COV_TEST_MULTI_CALC) $(CMOCKA_COV_TEST_CALC_BATCH) $(CMOCKA_COV_TEST_CALC_CHECKED) $(CMOCKA_COV_TEST_CALC_DIVIDER) $(CMOCKA_COV_TEST_CALC_INLINE) $(CMOCKA_COV_TEST_CALC_WIDE) $(CMOCKA_COV_TEST_CALC_REDUCE) $(CMOCKA_COV_TEST_CALC_OPS) $(CMOCKA_COV_TEST_MULTI_CALC_BATCH) $(CMOCKA_COV_TEST_CALC_EXPR) $(CMOCKA_COV_TEST_CALC_JIT) $(CMOCKA_COV_TEST_CALC_ROLLING) $(CMOCKA_COV_TEST_CALC_POOL) $(CMOCKA_COV_TEST_CALC_ASYNC) $(CMOCKA_COV_TEST_CALC_ARROW) $(CMOCKA_COV_TEST_CALC_SELECT) $(CMOCKA_COV_TEST_CALC_ENCODED) $(CMOCKA_COV_TEST_CALC_GROUP) $(CMOCKA_COV_TEST_CALC_BIGINT) $(CMOCKA_COV_TEST_CALC_LINALG) $(CMOCKA_COV_TEST_MULTI_CALC_POLY)
 	@echo "CMocka coverage test executables built successfully"
 
 # Build coverage cmocka_test_calc
@@ -113,6 +194,114 @@ $(CMOCKA_COV_TEST_MULTI_CALC): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_multi_calc.o $(C
 	@echo "Building coverage test (with mock): $@"
 	$(CC) $< -o $@ $(CMOCKA_COV_MOCK_LDFLAGS)
 
+# Build coverage cmocka_test_calc_batch
+$(CMOCKA_COV_TEST_CALC_BATCH): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_batch.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_checked
+$(CMOCKA_COV_TEST_CALC_CHECKED): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_checked.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_divider
+$(CMOCKA_COV_TEST_CALC_DIVIDER): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_divider.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_inline (with mock)
+$(CMOCKA_COV_TEST_CALC_INLINE): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_inline.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test (with mock): $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_MOCK_LDFLAGS)
+
+# Build coverage cmocka_test_calc_wide
+$(CMOCKA_COV_TEST_CALC_WIDE): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_wide.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_reduce
+$(CMOCKA_COV_TEST_CALC_REDUCE): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_reduce.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_ops
+$(CMOCKA_COV_TEST_CALC_OPS): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_ops.o $(CMOCKA_COV_SDK_LIB) $(CMOCKA_COV_CALC_OPS_PLUGIN)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+$(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_ops.o: CMOCKA_COV_UT_CFLAGS += -DCALC_OPS_PLUGIN='"$(CMOCKA_COV_CALC_OPS_PLUGIN)"'
+
+# Build the backend shared object (not instrumented)
+$(CMOCKA_COV_CALC_OPS_PLUGIN): ut_cmocka/plugin/calc_ops_plugin.c
+	@echo "Building backend plugin: $@"
+	@$(MKDIR) $(dir $@)
+	$(CC) $(CFLAGS) -Isdk/include -shared -fPIC $< -o $@
+
+# Build coverage cmocka_test_multi_calc_batch
+$(CMOCKA_COV_TEST_MULTI_CALC_BATCH): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_multi_calc_batch.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_expr
+$(CMOCKA_COV_TEST_CALC_EXPR): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_expr.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_jit
+$(CMOCKA_COV_TEST_CALC_JIT): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_jit.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_rolling
+$(CMOCKA_COV_TEST_CALC_ROLLING): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_rolling.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_pool
+$(CMOCKA_COV_TEST_CALC_POOL): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_pool.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_async
+$(CMOCKA_COV_TEST_CALC_ASYNC): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_async.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_arrow
+$(CMOCKA_COV_TEST_CALC_ARROW): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_arrow.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_select
+$(CMOCKA_COV_TEST_CALC_SELECT): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_select.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_encoded
+$(CMOCKA_COV_TEST_CALC_ENCODED): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_encoded.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_group
+$(CMOCKA_COV_TEST_CALC_GROUP): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_group.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_bigint
+$(CMOCKA_COV_TEST_CALC_BIGINT): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_bigint.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_calc_linalg
+$(CMOCKA_COV_TEST_CALC_LINALG): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_calc_linalg.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
+# Build coverage cmocka_test_multi_calc_poly
+$(CMOCKA_COV_TEST_MULTI_CALC_POLY): $(CMOCKA_COV_UT_OUTPUT_DIR)/test_multi_calc_poly.o $(CMOCKA_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CC) $< -o $@ $(CMOCKA_COV_UT_LDFLAGS)
+
 # Compile UT source files with coverage
 $(CMOCKA_COV_UT_OUTPUT_DIR)/%.o: $(CMOCKA_SRC_DIR)/%.c
 	@echo "Compiling test (coverage): $<"
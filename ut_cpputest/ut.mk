@@ -23,7 +23,7 @@ CPPUTEST_REPORT_DIR := $(BUILD_DIR)/ut-cpputest-report
 
 # UT specific flags (use installed SDK from build directory)
 CPPUTEST_CXXFLAGS := $(CFLAGS) -std=c++11 -I$(SDK_INSTALL_INC_DIR) -I$(CPPUTEST_INC_DIR)
-CPPUTEST_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CPPUTEST_LIB_DIR) -lsdk -lCppUTest -lCppUTestExt
+CPPUTEST_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(CPPUTEST_LIB_DIR) -lsdk -pthread -ldl -lCppUTest -lCppUTestExt
 
 # Mock test specific LDFLAGS (--wrap options for mocking calc functions)
 CPPUTEST_MOCK_LDFLAGS := $(CPPUTEST_LDFLAGS) \
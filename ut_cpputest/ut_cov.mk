@@ -29,7 +29,7 @@ CPPUTEST_COV_SDK_LIB := $(CPPUTEST_COV_OUTPUT_DIR)/libsdk_cov.a
 
 # UT specific flags for coverage build
 CPPUTEST_COV_UT_CXXFLAGS := $(CPPUTEST_COV_CXXFLAGS) -Isdk/include -I$(CPPUTEST_INC_DIR)
-CPPUTEST_COV_UT_LDFLAGS := $(CPPUTEST_COV_LDFLAGS) -L$(CPPUTEST_COV_OUTPUT_DIR) -L$(CPPUTEST_LIB_DIR) -lsdk_cov -lCppUTest -lCppUTestExt
+CPPUTEST_COV_UT_LDFLAGS := $(CPPUTEST_COV_LDFLAGS) -L$(CPPUTEST_COV_OUTPUT_DIR) -L$(CPPUTEST_LIB_DIR) -lsdk_cov -pthread -ldl -lCppUTest -lCppUTestExt
 
 # Mock test specific LDFLAGS for coverage
 CPPUTEST_COV_MOCK_LDFLAGS := $(CPPUTEST_COV_UT_LDFLAGS) \
@@ -0,0 +1,232 @@
+/**
+ * @file test_calc_async.cpp
+ * @brief doctest unit tests for the C++20 coroutine facade (calc-async.hpp)
+ *
+ * Demonstrates doctest features:
+ * - SUBCASE to share one executor between related checks
+ * - CHECK_THROWS_AS on an exception crossing coroutine boundaries
+ * - Counting allocations with a replaced operator new and -Wl,--wrap=malloc
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "calc-async.hpp"
+#include "test_data.hpp"
+
+// C headers need extern "C"
+extern "C" {
+#include "calc-batch.h"
+#include "greeting.h"
+#include "multi-calc-batch.h"
+}
+
+namespace async = sdk::async;
+
+/* ========== Allocation counters ========== */
+
+static std::atomic<unsigned long> cxx_allocations{0};
+static std::atomic<unsigned long> c_allocations{0};
+
+void *operator new(std::size_t size) {
+    cxx_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+// libsdk is linked with -Wl,--wrap=malloc: its malloc calls land here
+extern "C" void *__real_malloc(std::size_t size);
+extern "C" void *__wrap_malloc(std::size_t size) {
+    c_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+/* ========== Coroutines under test ========== */
+
+static const int LEN = 1000;
+
+struct columns {
+    std::vector<int> a, b, c, d;
+
+    columns() {
+        uint32_t seed = 12345u;
+        a = test_data::random_ints(LEN, seed);
+        b = test_data::random_ints(LEN, seed, 32);      // Some zero divisors
+        c = test_data::random_ints(LEN, seed);
+        d = test_data::random_ints(LEN, seed);
+    }
+};
+
+static async::task<void> all_batches(async::executor &ex, const columns &in,
+                                     std::vector<std::vector<int>> &out) {
+    co_await async::add_batch(ex, in.a.data(), in.b.data(), out[0].data(), LEN);
+    co_await async::subtract_batch(ex, in.a.data(), in.b.data(), out[1].data(), LEN);
+    co_await async::multiply_batch(ex, in.a.data(), in.b.data(), out[2].data(), LEN);
+    co_await async::divide_batch(ex, in.a.data(), in.b.data(), out[3].data(), LEN);
+    co_await async::expression_batch(ex, in.a.data(), in.b.data(), in.c.data(), in.d.data(),
+                                     out[4].data(), LEN);
+}
+
+static async::task<std::thread::id> resumed_on(async::executor &ex) {
+    co_await async::schedule(ex);
+    co_return std::this_thread::get_id();
+}
+
+static async::task<int> sum_of_adds(async::executor &ex, int rounds) {
+    int x[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    int one[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+    for (int r = 0; r < rounds; r++) {
+        co_await async::add_batch(ex, x, one, x, 8);
+    }
+    co_return x[0] + x[7];
+}
+
+static async::task<int> nested(async::executor &ex) {
+    int first = co_await sum_of_adds(ex, 10);
+    int second = co_await sum_of_adds(ex, 20);
+    co_return first + second;
+}
+
+static async::task<int> throws_after_await(async::executor &ex) {
+    co_await async::schedule(ex);
+    throw std::runtime_error("boom");
+}
+
+/* ========== Test cases ========== */
+
+TEST_CASE("batch awaits match the C functions") {
+    async::executor ex(2, 64);
+    columns in;
+    std::vector<std::vector<int>> out(5, std::vector<int>(LEN));
+    std::vector<int> expected(LEN);
+
+    async::sync_wait(all_batches(ex, in, out));
+
+    calc_add_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out[0] == expected);
+    calc_subtract_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out[1] == expected);
+    calc_multiply_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out[2] == expected);
+    calc_divide_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out[3] == expected);
+    multi_calc_expression_batch(in.a.data(), in.b.data(), in.c.data(), in.d.data(),
+                                expected.data(), LEN);
+    CHECK(out[4] == expected);
+}
+
+TEST_CASE("greeting awaits") {
+    async::executor ex(1, 8);
+    static const char *const names[] = {"Alice", nullptr};
+    char text[2][CALC_JOB_TEXT_LEN];
+
+    auto greet = [](async::executor &ex, char (*text)[CALC_JOB_TEXT_LEN]) -> async::task<void> {
+        co_await async::say_hello(ex, names, 2, text[0]);
+    };
+    async::sync_wait(greet(ex, text));
+    CHECK(std::string(text[0]) == "Hello, Alice!");
+    CHECK(std::string(text[1]) == "Hello, stranger!");
+}
+
+TEST_CASE("coroutines resume on the executor") {
+    async::executor ex(2, 64);
+
+    SUBCASE("schedule moves to a worker") {
+        CHECK(async::sync_wait(resumed_on(ex)) != std::this_thread::get_id());
+    }
+    SUBCASE("tasks compose") {
+        // x[0] + x[7] grows by 2 per round
+        CHECK(async::sync_wait(sum_of_adds(ex, 100)) == 9 + 200);
+        CHECK(async::sync_wait(nested(ex)) == (9 + 20) + (9 + 40));
+    }
+    SUBCASE("exceptions reach sync_wait") {
+        CHECK_THROWS_AS(async::sync_wait(throws_after_await(ex)), std::runtime_error);
+    }
+}
+
+TEST_CASE("full queue runs the work inline") {
+    async::executor ex(1, 2);
+    std::atomic<bool> open{false};
+    calc_job_desc_t gate{};
+    gate.kind = CALC_JOB_CUSTOM;
+    gate.fn = [](void *arg) {
+        while (!static_cast<std::atomic<bool> *>(arg)->load()) {
+            std::this_thread::yield();
+        }
+    };
+    gate.arg = &open;
+    // One job holds the only worker, two more fill the queue
+    calc_job_t *held[3];
+    for (auto &job : held) {
+        job = calc_async_submit(ex.get(), &gate);
+        REQUIRE(job != nullptr);
+    }
+
+    auto inline_add = [](async::executor &ex, int *out) -> async::task<std::thread::id> {
+        static const int a[4] = {1, 2, 3, 4};
+        co_await async::add_batch(ex, a, a, out, 4);
+        co_return std::this_thread::get_id();
+    };
+    int out[4] = {0, 0, 0, 0};
+    CHECK(async::sync_wait(inline_add(ex, out)) == std::this_thread::get_id());
+    CHECK(out[3] == 8);
+
+    open = true;
+    for (auto job : held) {
+        calc_job_wait(job);
+        calc_job_release(job);
+    }
+}
+
+TEST_CASE("concurrent callers") {
+    async::executor ex(3, 256);
+    std::vector<std::thread> callers;
+    std::atomic<int> wrong{0};
+
+    for (int t = 0; t < 6; t++) {
+        callers.emplace_back([&ex, &wrong] {
+            for (int i = 0; i < 20; i++) {
+                if (async::sync_wait(sum_of_adds(ex, 50)) != 9 + 100) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (auto &t : callers) {
+        t.join();
+    }
+    CHECK(wrong == 0);
+}
+
+TEST_CASE("awaits do not allocate in steady state") {
+    async::executor ex(1, 64);
+
+    // Warm up the frame pool and the job cache
+    async::sync_wait(sum_of_adds(ex, 100));
+    async::sync_wait(sum_of_adds(ex, 100));
+
+    unsigned long cxx_before = cxx_allocations.load();
+    unsigned long c_before = c_allocations.load();
+    CHECK(async::sync_wait(sum_of_adds(ex, 1000)) == 9 + 2000);
+    CHECK(cxx_allocations.load() - cxx_before == 0);
+    CHECK(c_allocations.load() - c_before == 0);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_calc_facade.cpp
+ * @brief doctest unit tests for the C++ facade (calc.hpp / multi-calc.hpp)
+ *
+ * Demonstrates doctest features:
+ * - TEST_CASE_TEMPLATE over several integer types
+ * - Compile-time checks with static_assert next to run-time CHECKs
+ * - Comparing two implementations over a grid of edge values
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "calc.hpp"
+#include "multi-calc.hpp"
+#include "test_data.hpp"
+
+// C headers need extern "C"
+extern "C" {
+#include "calc.h"
+#include "calc-batch.h"
+#include "calc-wide.h"
+#include "multi-calc.h"
+}
+
+namespace calc = sdk::calc;
+namespace multi_calc = sdk::multi_calc;
+
+/* ========== Compile-time evaluation ========== */
+
+static_assert(calc::add(2, 3) == 5, "add folds");
+static_assert(calc::subtract(2, 3) == -1, "subtract folds");
+static_assert(calc::multiply(-4, 6) == -24, "multiply folds");
+static_assert(calc::divide(7, 2) == 3, "divide folds");
+static_assert(calc::divide(-7, 2) == -3, "divide truncates toward zero");
+static_assert(calc::divide(42, 0) == 0, "divide by zero is 0");
+static_assert(calc::add(INT_MAX, 1) == INT_MIN, "add wraps");
+static_assert(calc::multiply(INT_MAX, 2) == -2, "multiply wraps");
+static_assert(calc::divide(INT_MIN, -1) == INT_MIN, "MIN / -1 wraps");
+static_assert(calc::add<int64_t>(INT64_MAX, 1) == INT64_MIN, "int64_t add wraps");
+static_assert(calc::divide<int64_t>(INT64_MIN, -1) == INT64_MIN, "int64_t MIN / -1 wraps");
+static_assert(calc::multiply<short>(300, 300) == static_cast<short>(90000), "short wraps");
+static_assert(calc::subtract(0u, 1u) == UINT_MAX, "unsigned wraps");
+static_assert(calc::divide(UINT_MAX, UINT_MAX) == 1u, "unsigned has no -1 case");
+
+static_assert(multi_calc::expression(2, 3, 10, 4) == 30, "expression folds");
+static_assert(multi_calc::average(10, 20, 30) == 20, "average folds");
+static constexpr int kValues[] = { INT_MAX, INT_MAX, INT_MAX, 1, -7 };
+static_assert(multi_calc::average_n(kValues) == 1288490187, "average_n folds without overflow");
+static_assert(multi_calc::average_n(kValues, 0) == 0, "empty average is 0");
+
+/* ========== Bit-for-bit agreement with the C library ========== */
+
+static std::vector<int> edge_values() {
+    std::vector<int> v = { INT_MIN, INT_MIN + 1, -65536, -46341, -3, -2, -1,
+                           0, 1, 2, 3, 46341, 65536, INT_MAX - 1, INT_MAX };
+    uint32_t seed = 12345u;
+    const std::vector<int> random = test_data::random_ints(32, seed);
+    v.insert(v.end(), random.begin(), random.end());
+    return v;
+}
+
+TEST_CASE("int facade matches calc.h") {
+    const std::vector<int> values = edge_values();
+
+    for (int a : values) {
+        for (int b : values) {
+            CAPTURE(a);
+            CAPTURE(b);
+            REQUIRE(calc::add(a, b) == calc_add(a, b));
+            REQUIRE(calc::subtract(a, b) == calc_subtract(a, b));
+            REQUIRE(calc::multiply(a, b) == calc_multiply(a, b));
+            if (a == INT_MIN && b == -1) {
+                // calc_divide traps here; the batch version defines it
+                int out;
+                calc_divide_batch(&a, &b, &out, 1);
+                REQUIRE(calc::divide(a, b) == out);
+            } else {
+                REQUIRE(calc::divide(a, b) == calc_divide(a, b));
+            }
+        }
+    }
+}
+
+TEST_CASE("int64_t facade matches calc-wide.h") {
+    std::vector<int64_t> values = { INT64_MIN, INT64_MIN + 1, -1, 0, 1, INT64_MAX };
+    for (int v : edge_values()) {
+        values.push_back(static_cast<int64_t>(v) * 3037000493LL);
+    }
+
+    for (int64_t a : values) {
+        for (int64_t b : values) {
+            CAPTURE(a);
+            CAPTURE(b);
+            REQUIRE(calc::add(a, b) == calc_add_i64(a, b));
+            REQUIRE(calc::subtract(a, b) == calc_subtract_i64(a, b));
+            REQUIRE(calc::multiply(a, b) == calc_multiply_i64(a, b));
+            REQUIRE(calc::divide(a, b) == calc_divide_i64(a, b));
+        }
+    }
+}
+
+TEST_CASE("multi-calc facade matches multi-calc.h") {
+    const std::vector<int> values = edge_values();
+
+    for (size_t i = 0; i + 3 < values.size(); i++) {
+        int a = values[i], b = values[i + 1], c = values[i + 2], d = values[i + 3];
+        CAPTURE(i);
+        REQUIRE(multi_calc::expression(a, b, c, d) == multi_calc_expression(a, b, c, d));
+        REQUIRE(multi_calc::average(a, b, c) == multi_calc_average(a, b, c));
+    }
+    for (size_t n = 0; n <= values.size(); n++) {
+        CAPTURE(n);
+        REQUIRE(multi_calc::average_n(values.data(), n) == multi_calc_average_n(values.data(), n));
+    }
+}
+
+/* ========== Other integer types ========== */
+
+TEST_CASE_TEMPLATE("facade wraps like two's complement", T, signed char, short, int, long long,
+                   unsigned char, unsigned short, unsigned, unsigned long long) {
+    const T max = std::numeric_limits<T>::max();
+    const T min = std::numeric_limits<T>::min();
+
+    CHECK(calc::add(max, T(1)) == min);
+    CHECK(calc::subtract(min, T(1)) == max);
+    CHECK(calc::multiply(max, T(2)) == (std::is_signed<T>::value ? T(-2) : T(max - 1)));
+    CHECK(calc::divide(max, T(0)) == T(0));
+    CHECK(calc::divide(T(7), T(2)) == T(3));
+    CHECK(multi_calc::expression(T(1), T(2), T(5), T(3)) == T(6));
+}
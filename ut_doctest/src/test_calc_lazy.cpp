@@ -0,0 +1,173 @@
+/**
+ * @file test_calc_lazy.cpp
+ * @brief doctest unit tests for the expression templates (calc-lazy.hpp)
+ *
+ * Demonstrates doctest features:
+ * - TEST_CASE_TEMPLATE to run the same checks on several integer types
+ * - static_assert next to CHECK for expressions evaluated at compile time
+ */
+
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "calc-lazy.hpp"
+#include "test_data.hpp"
+
+// C headers need extern "C"
+extern "C" {
+#include "calc-batch.h"
+#include "multi-calc-batch.h"
+}
+
+namespace lazy = sdk::lazy;
+
+/* ========== Test data ========== */
+
+// Not a multiple of the block, so the scalar tail runs too
+static const int LEN = 1000 + 7;
+
+struct columns {
+    std::vector<int> a, b, c, d;
+
+    columns() {
+        static const int edges[] = {INT_MAX, INT_MIN, -1, 0, 1, INT_MIN + 1};
+        uint32_t seed = 4242u;
+        a = test_data::random_ints(LEN, seed);
+        b = test_data::random_ints(LEN, seed, 32);      // Some zero divisors
+        c = test_data::random_ints(LEN, seed);
+        d = test_data::random_ints(LEN, seed);
+        // Overflow, MIN / -1 and division by zero at fixed rows
+        for (int i = 0; i < 6; i++) {
+            for (int j = 0; j < 6; j++) {
+                a[i * 6 + j] = edges[i];
+                b[i * 6 + j] = edges[j];
+            }
+        }
+    }
+};
+
+/* ========== Test cases ========== */
+
+TEST_CASE("single operations match the batch functions") {
+    columns in;
+    std::vector<int> out(LEN);
+    std::vector<int> expected(LEN);
+
+    lazy::evaluate(lazy::add(in.a, in.b), out);
+    calc_add_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out == expected);
+
+    lazy::evaluate(lazy::subtract(in.a, in.b), out);
+    calc_subtract_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out == expected);
+
+    lazy::evaluate(lazy::multiply(in.a, in.b), out);
+    calc_multiply_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out == expected);
+
+    lazy::evaluate(lazy::divide(in.a, in.b), out);
+    calc_divide_batch(in.a.data(), in.b.data(), expected.data(), LEN);
+    CHECK(out == expected);
+}
+
+TEST_CASE("nested expressions match chained batch calls") {
+    columns in;
+    std::vector<int> expected(LEN);
+
+    SUBCASE("(a + b) * (c - d) is the multi-calc expression") {
+        multi_calc_expression_batch(in.a.data(), in.b.data(), in.c.data(), in.d.data(),
+                                    expected.data(), LEN);
+        CHECK(lazy::evaluate(lazy::multiply(lazy::add(in.a, in.b),
+                                            lazy::subtract(in.c, in.d))) == expected);
+        // Same tree written with operators
+        CHECK(lazy::evaluate(lazy::add(in.a, in.b) * lazy::subtract(in.c, in.d)) == expected);
+    }
+    SUBCASE("(a * b - c) / d") {
+        std::vector<int> tmp(LEN);
+        calc_multiply_batch(in.a.data(), in.b.data(), tmp.data(), LEN);
+        calc_subtract_batch(tmp.data(), in.c.data(), tmp.data(), LEN);
+        calc_divide_batch(tmp.data(), in.d.data(), expected.data(), LEN);
+        auto expr = lazy::multiply(in.a, in.b) - in.c;
+        CHECK(lazy::evaluate(expr / in.d) == expected);
+    }
+}
+
+TEST_CASE("scalars broadcast to every row") {
+    columns in;
+    std::vector<int> ones(LEN, 1);
+    std::vector<int> threes(LEN, 3);
+    std::vector<int> expected(LEN);
+    std::vector<int> tmp(LEN);
+
+    calc_add_batch(in.a.data(), ones.data(), tmp.data(), LEN);
+    calc_multiply_batch(tmp.data(), threes.data(), expected.data(), LEN);
+    CHECK(lazy::evaluate(lazy::multiply(lazy::add(in.a, 1), 3)) == expected);
+    CHECK(lazy::evaluate(lazy::add(in.a, 1) * 3) == expected);
+
+    calc_divide_batch(ones.data(), in.b.data(), expected.data(), LEN);
+    CHECK(lazy::evaluate(lazy::divide(1, in.b)) == expected);
+}
+
+TEST_CASE("output may be one of the inputs") {
+    columns in;
+    std::vector<int> expected(LEN);
+    std::vector<int> tmp(LEN);
+
+    calc_add_batch(in.a.data(), in.b.data(), tmp.data(), LEN);
+    calc_multiply_batch(tmp.data(), in.a.data(), expected.data(), LEN);
+    lazy::evaluate(lazy::multiply(lazy::add(in.a, in.b), in.a), in.a);
+    CHECK(in.a == expected);
+}
+
+TEST_CASE("lengths") {
+    std::vector<int> a = {1, 2, 3, 4, 5};
+    std::vector<int> b = {10, 20, 30};
+
+    SUBCASE("the shortest column sets the result size") {
+        CHECK(lazy::add(a, b).size() == 3);
+        CHECK(lazy::evaluate(lazy::add(a, b)) == std::vector<int>{11, 22, 33});
+    }
+    SUBCASE("out sets the rows evaluated") {
+        std::array<int, 2> out{};
+        lazy::evaluate(lazy::add(a, b), out);
+        CHECK(out == std::array<int, 2>{11, 22});
+    }
+    SUBCASE("spans and empty columns") {
+        std::span<const int> part(a.data() + 1, 2);
+        CHECK(lazy::evaluate(lazy::subtract(part, 1)) == std::vector<int>{1, 2});
+        CHECK(lazy::evaluate(lazy::add(std::span<const int>(), 1)).empty());
+    }
+}
+
+TEST_CASE_TEMPLATE("integer types", T, int8_t, uint16_t, int64_t, unsigned long) {
+    std::vector<T> a = {std::numeric_limits<T>::max(), std::numeric_limits<T>::min(), T(7)};
+    std::vector<T> b = {T(1), T(-1), T(0)};
+    std::vector<T> out = lazy::evaluate(lazy::divide(lazy::add(a, b), b));
+
+    REQUIRE(out.size() == 3);
+    for (size_t i = 0; i < out.size(); i++) {
+        CHECK(out[i] == sdk::calc::divide(sdk::calc::add(a[i], b[i]), b[i]));
+    }
+}
+
+TEST_CASE("constant evaluation") {
+    constexpr auto square_plus_one = [] {
+        std::array<int, 20> x{};
+        std::array<int, 20> out{};
+        for (int i = 0; i < 20; i++) {
+            x[i] = i;
+        }
+        lazy::evaluate(lazy::add(lazy::multiply(x, x), 1), out);
+        return out;
+    }();
+    static_assert(square_plus_one[19] == 19 * 19 + 1, "evaluate() must work at compile time");
+    CHECK(square_plus_one[0] == 1);
+    CHECK(square_plus_one[4] == 17);
+}
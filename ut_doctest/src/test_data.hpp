@@ -0,0 +1,48 @@
+#ifndef __TEST_DATA_HPP__
+#define __TEST_DATA_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Seeded test data shared by the doctest tests
+ *
+ * The same LCG and scaling as ut_cmocka/src/test_data.h: every generator
+ * advances a seed passed by reference, so a test gets the same data on
+ * every run and consecutive calls continue one sequence.
+ */
+
+namespace test_data {
+
+/* Advance the generator and return the new state */
+inline uint32_t next(uint32_t &seed) {
+    seed = seed * 1103515245u + 12345u;
+    return seed;
+}
+
+/* Random int in [-range, range], or over the whole int range if range is 0 */
+inline int random_int(uint32_t &seed, uint32_t range = 0) {
+    const uint32_t v = next(seed);
+
+    if (range == 0) {
+        return static_cast<int>(v);
+    }
+    // Scale the high bits (the low bits of an LCG are not random); the
+    // subtraction is done in 64 bits: the scaled value may pass INT_MAX
+    const uint64_t scaled = (static_cast<uint64_t>(v) * (2u * static_cast<uint64_t>(range) + 1)) >> 32;
+    return static_cast<int>(static_cast<int64_t>(scaled) - static_cast<int64_t>(range));
+}
+
+/* n values of random_int */
+inline std::vector<int> random_ints(std::size_t n, uint32_t &seed, uint32_t range = 0) {
+    std::vector<int> v(n);
+    for (std::size_t i = 0; i < n; i++) {
+        v[i] = random_int(seed, range);
+    }
+    return v;
+}
+
+}  // namespace test_data
+
+#endif /* __TEST_DATA_HPP__ */
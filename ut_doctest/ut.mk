@@ -21,10 +21,19 @@ DOCTEST_SRCS := $(wildcard $(DOCTEST_SRC_DIR)/*.cpp)
 DOCTEST_TEST_CALC := $(DOCTEST_OUTPUT_DIR)/doctest_test_calc
 DOCTEST_TEST_GREETING := $(DOCTEST_OUTPUT_DIR)/doctest_test_greeting
 DOCTEST_TEST_MULTI_CALC := $(DOCTEST_OUTPUT_DIR)/doctest_test_multi_calc
+DOCTEST_TEST_CALC_FACADE := $(DOCTEST_OUTPUT_DIR)/doctest_test_calc_facade
+DOCTEST_TEST_CALC_ASYNC := $(DOCTEST_OUTPUT_DIR)/doctest_test_calc_async
+DOCTEST_TEST_CALC_LAZY := $(DOCTEST_OUTPUT_DIR)/doctest_test_calc_lazy
 
 # UT specific flags (header-only, no library linking needed)
 DOCTEST_UT_CXXFLAGS := $(CXXFLAGS) -std=c++11 -I$(SDK_INSTALL_INC_DIR) -I$(DOCTEST_INC_DIR)
-DOCTEST_UT_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -lsdk
+DOCTEST_UT_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -lsdk -pthread -ldl
+
+# The coroutine facade (calc-async.hpp) and calc-lazy.hpp need C++20; the later -std wins
+DOCTEST_CXX20_FLAGS := -std=c++20
+
+# Counts the SDK's own allocations in test_calc_async
+DOCTEST_MALLOC_LDFLAGS := -Wl,--wrap=malloc
 
 # Mock test specific LDFLAGS (with --wrap options)
 DOCTEST_MOCK_LDFLAGS := $(DOCTEST_UT_LDFLAGS) \
@@ -44,7 +53,7 @@ ut_doctest: ut_doctest_run ut_doctest_report
 
 # Build all doctest test executables
 .PHONY: ut_doctest_build
-ut_doctest_build: sdk_install $(DOCTEST_TEST_CALC) $(DOCTEST_TEST_GREETING) $(DOCTEST_TEST_MULTI_CALC)
+ut_doctest_build: sdk_install $(DOCTEST_TEST_CALC) $(DOCTEST_TEST_GREETING) $(DOCTEST_TEST_MULTI_CALC) $(DOCTEST_TEST_CALC_FACADE) $(DOCTEST_TEST_CALC_ASYNC) $(DOCTEST_TEST_CALC_LAZY)
 	@echo "doctest test executables built successfully"
 
 # Run all doctest tests (terminal output)
@@ -63,6 +72,15 @@ ut_doctest_run: ut_doctest_build
 	@echo ""
 	@echo "--- Running doctest_test_multi_calc ---"
 	@$(DOCTEST_TEST_MULTI_CALC)
+	@echo ""
+	@echo "--- Running doctest_test_calc_facade ---"
+	@$(DOCTEST_TEST_CALC_FACADE)
+	@echo ""
+	@echo "--- Running doctest_test_calc_async ---"
+	@$(DOCTEST_TEST_CALC_ASYNC)
+	@echo ""
+	@echo "--- Running doctest_test_calc_lazy ---"
+	@$(DOCTEST_TEST_CALC_LAZY)
 
 # Generate test reports (JUnit XML -> HTML)
 .PHONY: ut_doctest_report
@@ -76,6 +94,9 @@ ut_doctest_report: ut_doctest_build
 	@$(DOCTEST_TEST_CALC) --reporters=junit --out=$(DOCTEST_REPORT_DIR)/test_calc.xml || true
 	@$(DOCTEST_TEST_GREETING) --reporters=junit --out=$(DOCTEST_REPORT_DIR)/test_greeting.xml || true
 	@$(DOCTEST_TEST_MULTI_CALC) --reporters=junit --out=$(DOCTEST_REPORT_DIR)/test_multi_calc.xml || true
+	@$(DOCTEST_TEST_CALC_FACADE) --reporters=junit --out=$(DOCTEST_REPORT_DIR)/test_calc_facade.xml || true
+	@$(DOCTEST_TEST_CALC_ASYNC) --reporters=junit --out=$(DOCTEST_REPORT_DIR)/test_calc_async.xml || true
+	@$(DOCTEST_TEST_CALC_LAZY) --reporters=junit --out=$(DOCTEST_REPORT_DIR)/test_calc_lazy.xml || true
 	@echo "Merging XML reports..."
 	@echo '<?xml version="1.0" encoding="UTF-8"?>' > $(DOCTEST_REPORT_DIR)/combined.xml
 	@echo '<testsuites>' >> $(DOCTEST_REPORT_DIR)/combined.xml
@@ -107,6 +128,24 @@ $(DOCTEST_TEST_MULTI_CALC): $(DOCTEST_SRC_DIR)/test_multi_calc.cpp | sdk_install
 	@$(MKDIR) $(dir $@)
 	$(CXX) $(DOCTEST_UT_CXXFLAGS) $< -o $@ $(DOCTEST_MOCK_LDFLAGS)
 
+# Build doctest_test_calc_facade (header-only facade vs the C library)
+$(DOCTEST_TEST_CALC_FACADE): $(DOCTEST_SRC_DIR)/test_calc_facade.cpp | sdk_install
+	@echo "Building test: $@"
+	@$(MKDIR) $(dir $@)
+	$(CXX) $(DOCTEST_UT_CXXFLAGS) $< -o $@ $(DOCTEST_UT_LDFLAGS)
+
+# Build doctest_test_calc_async (C++20 coroutines, malloc counted)
+$(DOCTEST_TEST_CALC_ASYNC): $(DOCTEST_SRC_DIR)/test_calc_async.cpp | sdk_install
+	@echo "Building test: $@"
+	@$(MKDIR) $(dir $@)
+	$(CXX) $(DOCTEST_UT_CXXFLAGS) $(DOCTEST_CXX20_FLAGS) $< -o $@ $(DOCTEST_UT_LDFLAGS) $(DOCTEST_MALLOC_LDFLAGS)
+
+# Build doctest_test_calc_lazy (C++20 expression templates)
+$(DOCTEST_TEST_CALC_LAZY): $(DOCTEST_SRC_DIR)/test_calc_lazy.cpp | sdk_install
+	@echo "Building test: $@"
+	@$(MKDIR) $(dir $@)
+	$(CXX) $(DOCTEST_UT_CXXFLAGS) $(DOCTEST_CXX20_FLAGS) $< -o $@ $(DOCTEST_UT_LDFLAGS)
+
 # Clean doctest artifacts
 .PHONY: clean-doctest
 clean-doctest:
@@ -24,13 +24,16 @@ DOCTEST_COV_UT_OBJS := $(patsubst $(DOCTEST_SRC_DIR)/%.cpp, $(DOCTEST_COV_UT_OUT
 DOCTEST_COV_TEST_CALC := $(DOCTEST_COV_OUTPUT_DIR)/doctest_test_calc
 DOCTEST_COV_TEST_GREETING := $(DOCTEST_COV_OUTPUT_DIR)/doctest_test_greeting
 DOCTEST_COV_TEST_MULTI_CALC := $(DOCTEST_COV_OUTPUT_DIR)/doctest_test_multi_calc
+DOCTEST_COV_TEST_CALC_FACADE := $(DOCTEST_COV_OUTPUT_DIR)/doctest_test_calc_facade
+DOCTEST_COV_TEST_CALC_ASYNC := $(DOCTEST_COV_OUTPUT_DIR)/doctest_test_calc_async
+DOCTEST_COV_TEST_CALC_LAZY := $(DOCTEST_COV_OUTPUT_DIR)/doctest_test_calc_lazy
 
 # Coverage SDK library
 DOCTEST_COV_SDK_LIB := $(DOCTEST_COV_OUTPUT_DIR)/libsdk_cov.a
 
 # UT specific flags for coverage build
 DOCTEST_COV_UT_CXXFLAGS := $(DOCTEST_COV_CXXFLAGS) -Isdk/include -I$(DOCTEST_INC_DIR)
-DOCTEST_COV_UT_LDFLAGS := $(DOCTEST_COV_LDFLAGS) -L$(DOCTEST_COV_OUTPUT_DIR) -lsdk_cov
+DOCTEST_COV_UT_LDFLAGS := $(DOCTEST_COV_LDFLAGS) -L$(DOCTEST_COV_OUTPUT_DIR) -lsdk_cov -pthread -ldl
 
 # Mock test specific LDFLAGS for coverage
 DOCTEST_COV_MOCK_LDFLAGS := $(DOCTEST_COV_UT_LDFLAGS) \
@@ -64,6 +67,15 @@ ut_doctest_cov_run: ut_doctest_cov_build
 	@echo ""
 	@echo "--- Running doctest_test_multi_calc (coverage) ---"
 	@$(DOCTEST_COV_TEST_MULTI_CALC)
+	@echo ""
+	@echo "--- Running doctest_test_calc_facade (coverage) ---"
+	@$(DOCTEST_COV_TEST_CALC_FACADE)
+	@echo ""
+	@echo "--- Running doctest_test_calc_async (coverage) ---"
+	@$(DOCTEST_COV_TEST_CALC_ASYNC)
+	@echo ""
+	@echo "--- Running doctest_test_calc_lazy (coverage) ---"
+	@$(DOCTEST_COV_TEST_CALC_LAZY)
 
 # Generate coverage report using lcov and genhtml
 .PHONY: ut_doctest_cov_report
@@ -96,7 +108,7 @@ $(DOCTEST_COV_SDK_OUTPUT_DIR)/%.o: sdk/src/%.c
 
 # Build coverage test executables
 .PHONY: ut_doctest_cov_build
-ut_doctest_cov_build: $(DOCTEST_COV_SDK_LIB) $(DOCTEST_COV_TEST_CALC) $(DOCTEST_COV_TEST_GREETING) $(DOCTEST_COV_TEST_MULTI_CALC)
+ut_doctest_cov_build: $(DOCTEST_COV_SDK_LIB) $(DOCTEST_COV_TEST_CALC) $(DOCTEST_COV_TEST_GREETING) $(DOCTEST_COV_TEST_MULTI_CALC) $(DOCTEST_COV_TEST_CALC_FACADE) $(DOCTEST_COV_TEST_CALC_ASYNC) $(DOCTEST_COV_TEST_CALC_LAZY)
 	@echo "doctest coverage test executables built successfully"
 
 # Build coverage doctest_test_calc
@@ -114,6 +126,25 @@ $(DOCTEST_COV_TEST_MULTI_CALC): $(DOCTEST_COV_UT_OUTPUT_DIR)/test_multi_calc.o $
 	@echo "Building coverage test (with mock): $@"
 	$(CXX) $< -o $@ $(DOCTEST_COV_MOCK_LDFLAGS)
 
+# Build coverage doctest_test_calc_facade
+$(DOCTEST_COV_TEST_CALC_FACADE): $(DOCTEST_COV_UT_OUTPUT_DIR)/test_calc_facade.o $(DOCTEST_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CXX) $< -o $@ $(DOCTEST_COV_UT_LDFLAGS)
+
+# Build coverage doctest_test_calc_async
+$(DOCTEST_COV_TEST_CALC_ASYNC): $(DOCTEST_COV_UT_OUTPUT_DIR)/test_calc_async.o $(DOCTEST_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CXX) $< -o $@ $(DOCTEST_COV_UT_LDFLAGS) $(DOCTEST_MALLOC_LDFLAGS)
+
+$(DOCTEST_COV_UT_OUTPUT_DIR)/test_calc_async.o: DOCTEST_COV_UT_CXXFLAGS += $(DOCTEST_CXX20_FLAGS)
+
+# Build coverage doctest_test_calc_lazy
+$(DOCTEST_COV_TEST_CALC_LAZY): $(DOCTEST_COV_UT_OUTPUT_DIR)/test_calc_lazy.o $(DOCTEST_COV_SDK_LIB)
+	@echo "Building coverage test: $@"
+	$(CXX) $< -o $@ $(DOCTEST_COV_UT_LDFLAGS)
+
+$(DOCTEST_COV_UT_OUTPUT_DIR)/test_calc_lazy.o: DOCTEST_COV_UT_CXXFLAGS += $(DOCTEST_CXX20_FLAGS)
+
 # Compile UT source files with coverage (C++ files)
 $(DOCTEST_COV_UT_OUTPUT_DIR)/%.o: $(DOCTEST_SRC_DIR)/%.cpp
 	@echo "Compiling test (coverage): $<"
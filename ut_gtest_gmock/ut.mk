@@ -24,7 +24,7 @@ CXXFLAGS := -Wall -Wextra -g -std=c++17
 
 # UT specific flags
 GTEST_CXXFLAGS := $(CXXFLAGS) -I$(SDK_INSTALL_INC_DIR) -I$(GTEST_INC_DIR)
-GTEST_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(GTEST_LIB_DIR) -lsdk -lgtest -lgmock -lpthread
+GTEST_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(GTEST_LIB_DIR) -lsdk -lgtest -lgmock -lpthread -ldl
 
 # Mock test specific LDFLAGS (--wrap options for mocking calc functions)
 GTEST_MOCK_LDFLAGS := $(GTEST_LDFLAGS) \
@@ -30,7 +30,7 @@ GTEST_COV_SDK_LIB := $(GTEST_COV_OUTPUT_DIR)/libsdk_cov.a
 
 # UT specific flags for coverage build
 GTEST_COV_UT_CXXFLAGS := $(GTEST_COV_CXXFLAGS) -Isdk/include -I$(GTEST_INC_DIR)
-GTEST_COV_UT_LDFLAGS := $(GTEST_COV_LDFLAGS) -L$(GTEST_COV_OUTPUT_DIR) -L$(GTEST_LIB_DIR) -lsdk_cov -lgtest -lgmock -lpthread
+GTEST_COV_UT_LDFLAGS := $(GTEST_COV_LDFLAGS) -L$(GTEST_COV_OUTPUT_DIR) -L$(GTEST_LIB_DIR) -lsdk_cov -lgtest -lgmock -lpthread -ldl
 
 # Mock test specific LDFLAGS for coverage
 GTEST_COV_MOCK_LDFLAGS := $(GTEST_COV_UT_LDFLAGS) \
@@ -27,7 +27,7 @@ GTEST_MOCKCPP_CXXFLAGS := $(CXXFLAGS) -I$(SDK_INSTALL_INC_DIR) -isystem $(GTEST_
 
 # Linker flags (no --wrap needed, mockcpp uses runtime API hooking)
 GTEST_MOCKCPP_LDFLAGS := -L$(SDK_INSTALL_LIB_DIR) -L$(GTEST_MOCKCPP_GTEST_LIB) -L$(GTEST_MOCKCPP_MOCKCPP_LIB) \
-    -lsdk -lgtest -lmockcpp -lpthread
+    -lsdk -lgtest -lmockcpp -lpthread -ldl
 
 # Build and run all tests
 .PHONY: ut_gtest_mockcpp
@@ -31,7 +31,7 @@ GTEST_MOCKCPP_COV_SDK_LIB := $(GTEST_MOCKCPP_COV_OUTPUT_DIR)/libsdk_cov.a
 # Use -isystem for third-party libraries to suppress their warnings
 GTEST_MOCKCPP_COV_UT_CXXFLAGS := $(GTEST_MOCKCPP_COV_CXXFLAGS) -Isdk/include -isystem $(GTEST_MOCKCPP_GTEST_INC) -isystem $(GTEST_MOCKCPP_MOCKCPP_INC)
 GTEST_MOCKCPP_COV_UT_LDFLAGS := $(GTEST_MOCKCPP_COV_LDFLAGS) -L$(GTEST_MOCKCPP_COV_OUTPUT_DIR) -L$(GTEST_MOCKCPP_GTEST_LIB) -L$(GTEST_MOCKCPP_MOCKCPP_LIB) \
-    -lsdk_cov -lgtest -lmockcpp -lpthread
+    -lsdk_cov -lgtest -lmockcpp -lpthread -ldl
 
 # Build and run coverage tests, then generate report
 .PHONY: ut_gtest_mockcpp_cov
@@ -29,7 +29,7 @@ UNITY_COV_SDK_LIB := $(UNITY_COV_OUTPUT_DIR)/libsdk_cov.a
 
 # UT specific flags for coverage build
 UNITY_COV_UT_CFLAGS := $(UNITY_COV_CFLAGS) -Isdk/include -I$(UNITY_INC_DIR) -I$(FFF_DIR)
-UNITY_COV_UT_LDFLAGS := $(UNITY_COV_LDFLAGS) -L$(UNITY_COV_OUTPUT_DIR) -L$(UNITY_LIB_DIR) -lsdk_cov -lunity
+UNITY_COV_UT_LDFLAGS := $(UNITY_COV_LDFLAGS) -L$(UNITY_COV_OUTPUT_DIR) -L$(UNITY_LIB_DIR) -lsdk_cov -pthread -ldl -lunity
 
 # Mock test specific LDFLAGS for coverage
 UNITY_COV_MOCK_LDFLAGS := $(UNITY_COV_UT_LDFLAGS) \